@@ -0,0 +1,227 @@
+#pragma once
+#ifndef SIMPLE_BENCHMARK_HPP
+#define SIMPLE_BENCHMARK_HPP
+
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+
+// Self-contained benchmark harness shared by the programs in this directory.
+// It replaces the global allocation functions so that every benchmark can report heap traffic,
+// which means this header must be included by exactly one translation unit per executable.
+
+
+namespace bench {
+
+
+struct AllocationCounters {
+	std::size_t allocations = 0;
+	std::size_t bytes = 0;
+};
+
+/*
+*/
+inline AllocationCounters &allocationCounters() noexcept {
+	static AllocationCounters counters;
+	return counters;
+}
+
+/*
+*/
+template <typename Type>
+inline void doNotOptimize(Type &&value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "g"(&value) : "memory");
+#else
+	static volatile const void *sink;
+	sink = &value;
+#endif
+}
+
+struct Measurement {
+	double nanoseconds = 0.0;
+	double allocations = 0.0;
+	double bytes = 0.0;
+};
+
+/*
+	Runs function the given number of times and returns the average cost of a single call.
+*/
+template <typename Function>
+Measurement measure(std::size_t iterations, Function &&function) {
+
+	function();
+
+	AllocationCounters before = allocationCounters();
+	auto start = std::chrono::steady_clock::now();
+
+	for (std::size_t i = 0; i < iterations; ++i) {
+		function();
+	}
+
+	auto stop = std::chrono::steady_clock::now();
+	AllocationCounters after = allocationCounters();
+
+	Measurement result;
+	result.nanoseconds = std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(iterations);
+	result.allocations = static_cast<double>(after.allocations - before.allocations) / static_cast<double>(iterations);
+	result.bytes = static_cast<double>(after.bytes - before.bytes) / static_cast<double>(iterations);
+	return result;
+}
+
+/*
+*/
+inline void printHeader(const std::string &title) {
+	std::cout << '\n' << title << '\n';
+	std::cout << std::left << std::setw(28) << "case"
+		<< std::right << ' ' << std::setw(15) << "ns/op"
+		<< ' ' << std::setw(12) << "allocs/op"
+		<< ' ' << std::setw(15) << "bytes/op" << '\n';
+}
+
+/*
+	Every field is preceded by a space, so a value wider than its column still stays apart from its neighbours.
+*/
+inline void printRow(const std::string &name, const Measurement &measurement) {
+	std::cout << std::left << std::setw(28) << name
+		<< std::right << std::fixed << std::setprecision(2)
+		<< ' ' << std::setw(15) << measurement.nanoseconds
+		<< ' ' << std::setw(12) << measurement.allocations
+		<< ' ' << std::setw(15) << measurement.bytes << '\n';
+}
+
+/*
+	Collects measurements under a group and a case name so a run can be written out as JSON and compared with earlier runs.
+*/
+class Report {
+
+public:
+
+	/*
+	*/
+	void add(const std::string &group, const std::string &name, std::size_t size, std::size_t iterations, const Measurement &measurement) {
+		m_entries.push_back(Entry{group, name, size, iterations, measurement});
+	}
+
+	/*
+	*/
+	void writeJson(std::ostream &os) const {
+
+		os << "{\n\t\"benchmarks\": [";
+
+		for (std::size_t i = 0; i < m_entries.size(); ++i) {
+			const Entry &entry = m_entries[i];
+
+			os << (i == 0 ? "\n" : ",\n") << "\t\t{";
+			os << "\"group\": ";
+			writeString(os, entry.group);
+			os << ", \"name\": ";
+			writeString(os, entry.name);
+			os << ", \"size\": " << entry.size;
+			os << ", \"iterations\": " << entry.iterations;
+			os << std::fixed << std::setprecision(3);
+			os << ", \"ns_per_op\": " << entry.measurement.nanoseconds;
+			os << ", \"allocs_per_op\": " << entry.measurement.allocations;
+			os << ", \"bytes_per_op\": " << entry.measurement.bytes;
+			os << '}';
+		}
+
+		os << "\n\t]\n}\n";
+	}
+
+private:
+
+	struct Entry {
+		std::string group;
+		std::string name;
+		std::size_t size;
+		std::size_t iterations;
+		Measurement measurement;
+	};
+
+	/*
+	*/
+	static void writeString(std::ostream &os, const std::string &text) {
+
+		os << '"';
+		for (char character : text) {
+			if (character == '"' || character == '\\') {
+				os << '\\';
+			}
+			os << character;
+		}
+		os << '"';
+	}
+
+	std::vector<Entry> m_entries;
+};
+
+}
+
+
+// The replacements forward to malloc/free, which GCC would otherwise report as mismatched once inlined.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+/*
+*/
+void *operator new(std::size_t size) {
+
+	bench::AllocationCounters &counters = bench::allocationCounters();
+	++counters.allocations;
+	counters.bytes += size;
+
+	if (void *pointer = std::malloc(size == 0 ? 1 : size)) {
+		return pointer;
+	}
+
+	throw std::bad_alloc{};
+}
+
+/*
+*/
+void *operator new[](std::size_t size) {
+	return ::operator new(size);
+}
+
+/*
+*/
+void operator delete(void *pointer) noexcept {
+	std::free(pointer);
+}
+
+/*
+*/
+void operator delete[](void *pointer) noexcept {
+	std::free(pointer);
+}
+
+/*
+*/
+void operator delete(void *pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+
+/*
+*/
+void operator delete[](void *pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+
+#endif // SIMPLE_BENCHMARK_HPP
@@ -0,0 +1,72 @@
+#include "Benchmark.hpp"
+#include "SimpleString.hpp"
+#include "SimpleStringBuilder.hpp"
+
+#include <sstream>
+#include <string>
+
+#include <cstddef>
+
+
+// Assembles a CSV-like text from many fragments: a word, a number and a separator per record.
+// The String and std::string cases append in place; the builder cases include the final build().
+
+
+int main() {
+
+	using simple::String;
+	using simple::StringBuilder;
+
+	const char *words[] = {"alpha", "beta", "gamma", "delta", "epsilon", "zeta", "eta", "theta"};
+
+	const std::size_t recordCounts[] = {100, 10000, 1000000};
+
+	for (std::size_t records : recordCounts) {
+
+		std::size_t iterations = std::max<std::size_t>(5, 10000000 / records);
+
+		bench::printHeader(std::to_string(records) + " records");
+
+		bench::printRow("String +=", bench::measure(iterations, [&] {
+			String result;
+			for (std::size_t i = 0; i < records; ++i) {
+				result += words[i % 8];
+				result += ',';
+				result += std::to_string(i).c_str();
+				result += '\n';
+			}
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("std::string +=", bench::measure(iterations, [&] {
+			std::string result;
+			for (std::size_t i = 0; i < records; ++i) {
+				result += words[i % 8];
+				result += ',';
+				result += std::to_string(i);
+				result += '\n';
+			}
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("std::ostringstream", bench::measure(iterations, [&] {
+			std::ostringstream stream;
+			for (std::size_t i = 0; i < records; ++i) {
+				stream << words[i % 8] << ',' << i << '\n';
+			}
+			std::string result = stream.str();
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("StringBuilder", bench::measure(iterations, [&] {
+			StringBuilder builder;
+			for (std::size_t i = 0; i < records; ++i) {
+				builder.append(words[i % 8]).append(',').append(i).append('\n');
+			}
+			String result = builder.build();
+			bench::doNotOptimize(result);
+		}));
+	}
+
+	return 0;
+}
@@ -0,0 +1,109 @@
+#include "Benchmark.hpp"
+#include "SimpleString.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include <cctype>
+#include <cstddef>
+#include <strings.h>
+
+
+// Normalizes mixed-case text to lower case, compares it with a differently cased copy and searches it
+// for a differently cased needle near its end. The baselines are what callers write without these
+// functions: std::tolower per character, strcasecmp, and lower casing both sides before find().
+
+
+namespace {
+
+/*
+*/
+std::string randomText(std::size_t length, std::mt19937 &generator) {
+
+	const char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-: ";
+	std::uniform_int_distribution<std::size_t> index(0, sizeof(alphabet) - 2);
+
+	std::string text(length, ' ');
+	for (char &character : text) {
+		character = alphabet[index(generator)];
+	}
+
+	return text;
+}
+
+/*
+*/
+std::string lowered(std::string text) {
+
+	std::transform(text.begin(), text.end(), text.begin(), [](char character) {
+		return static_cast<char>(std::tolower(static_cast<unsigned char>(character)));
+	});
+
+	return text;
+}
+
+/*
+*/
+std::string swappedCase(std::string text) {
+
+	for (char &character : text) {
+		character = std::isupper(static_cast<unsigned char>(character)) ? static_cast<char>(std::tolower(character)) : static_cast<char>(std::toupper(character));
+	}
+
+	return text;
+}
+
+}
+
+
+int main() {
+
+	using simple::String;
+
+	std::mt19937 generator{12345};
+
+	const std::size_t lengths[] = {16, 1000, 1000000};
+
+	for (std::size_t length : lengths) {
+
+		std::size_t iterations = std::max<std::size_t>(20, 50000000 / length);
+
+		std::string text = randomText(length, generator);
+		std::string other = swappedCase(text);
+		std::string needle = swappedCase(text.substr(length - std::min<std::size_t>(length, 12)));
+
+		String string{text.c_str()};
+		String otherString{other.c_str()};
+
+		bench::printHeader(std::to_string(length) + " characters");
+
+		bench::printRow("String::toLower() &&", bench::measure(iterations, [&] {
+			String copy = string;
+			bench::doNotOptimize(std::move(copy).toLower());
+		}));
+
+		bench::printRow("copy + std::tolower", bench::measure(iterations, [&] {
+			std::string copy = text;
+			bench::doNotOptimize(lowered(std::move(copy)));
+		}));
+
+		bench::printRow("String::equalsIgnoreCase", bench::measure(iterations, [&] {
+			bench::doNotOptimize(string.equalsIgnoreCase(otherString));
+		}));
+
+		bench::printRow("strcasecmp", bench::measure(iterations, [&] {
+			bench::doNotOptimize(strcasecmp(text.c_str(), other.c_str()));
+		}));
+
+		bench::printRow("String::findIgnoreCase", bench::measure(iterations, [&] {
+			bench::doNotOptimize(string.findIgnoreCase(needle.c_str()));
+		}));
+
+		bench::printRow("lower both + find", bench::measure(iterations, [&] {
+			bench::doNotOptimize(lowered(text).find(lowered(needle)));
+		}));
+	}
+
+	return 0;
+}
@@ -0,0 +1,112 @@
+#include "Benchmark.hpp"
+#include "SimpleString.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include <cstddef>
+
+
+// Compares equal strings (the worst case, every character is inspected) across a range of lengths.
+// The scalar loops reproduce the per-character implementation that compare() and operator== used before
+// the vectorized kernels, so the speedup can be read directly off the table.
+
+
+namespace {
+
+/*
+*/
+int scalarCompare(const simple::String &left, const simple::String &right) {
+
+	for (std::size_t i = 0; i < left.size() && i < right.size(); ++i) {
+		if (left[i] < right[i]) {
+			return -1;
+		}
+		else if (left[i] > right[i]) {
+			return 1;
+		}
+	}
+
+	return left.size() < right.size() ? -1 : (left.size() > right.size() ? 1 : 0);
+}
+
+/*
+*/
+bool scalarEqual(const simple::String &left, const simple::String &right) {
+
+	if (left.size() != right.size()) {
+		return false;
+	}
+
+	for (std::size_t i = 0; i < left.size(); ++i) {
+		if (left[i] != right[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+}
+
+
+int main() {
+
+	using simple::String;
+
+	const std::size_t lengths[] = {1, 4, 16, 64, 256, 1024, 4096, 16384, 65536};
+
+	for (std::size_t length : lengths) {
+
+		std::string source(length, 'x');
+		for (std::size_t i = 0; i < length; ++i) {
+			source[i] = static_cast<char>('a' + i % 26);
+		}
+
+		String left = source.c_str();
+		String right = source.c_str();
+		std::string leftStd = source;
+		std::string rightStd = source;
+
+		std::size_t iterations = std::max<std::size_t>(1000, 50000000 / length);
+
+		bench::printHeader("length " + std::to_string(length));
+
+		bench::printRow("scalar compare loop", bench::measure(iterations, [&] {
+			int result = scalarCompare(left, right);
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("String::compare", bench::measure(iterations, [&] {
+			int result = left.compare(right);
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("String::compare(const char *)", bench::measure(iterations, [&] {
+			int result = left.compare(rightStd.c_str());
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("std::string::compare", bench::measure(iterations, [&] {
+			int result = leftStd.compare(rightStd);
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("scalar equality loop", bench::measure(iterations, [&] {
+			bool result = scalarEqual(left, right);
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("String operator==", bench::measure(iterations, [&] {
+			bool result = left == right;
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("std::string operator==", bench::measure(iterations, [&] {
+			bool result = leftStd == rightStd;
+			bench::doNotOptimize(result);
+		}));
+	}
+
+	return 0;
+}
@@ -0,0 +1,67 @@
+#include "Benchmark.hpp"
+#include "SimpleString.hpp"
+
+#include <string>
+
+#include <cstddef>
+
+
+// Builds a + "x" + b + 'c' + d for pieces of several lengths. operator+ makes a String at every step, reusing
+// the rvalue on its left when it has room, while concat() sizes the result once; std::string is the baseline.
+
+
+namespace {
+
+/*
+*/
+std::string piece(std::size_t length, char fill) {
+	return std::string(length, fill);
+}
+
+}
+
+
+int main() {
+
+	using simple::String;
+
+	const std::size_t lengths[] = {3, 24, 200, 4000};
+
+	for (std::size_t length : lengths) {
+
+		std::string aStd = piece(length, 'a');
+		std::string bStd = piece(length, 'b');
+		std::string dStd = piece(length, 'd');
+
+		String a = aStd.c_str();
+		String b = bStd.c_str();
+		String d = dStd.c_str();
+
+		std::size_t iterations = std::max<std::size_t>(1000, 50000000 / (length + 64));
+
+		bench::printHeader("a + \"x\" + b + 'c' + d, pieces of " + std::to_string(length));
+
+		bench::printRow("String operator+", bench::measure(iterations, [&] {
+			String result = a + "x" + b + 'c' + d;
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("String concat()", bench::measure(iterations, [&] {
+			String result = simple::concat(a, "x", b, 'c', d);
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("std::string", bench::measure(iterations, [&] {
+			std::string result = aStd + "x" + bStd + 'c' + dStd;
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("String a, += concat()", bench::measure(iterations, [&] {
+			String result = a;
+			result += simple::concat("x", b, 'c', d);
+			bench::doNotOptimize(result);
+		}));
+	}
+
+	return 0;
+}
@@ -0,0 +1,112 @@
+#include "Benchmark.hpp"
+#include "SimpleString.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include <cstddef>
+
+
+// Builds strings by repeated appends under each growth policy and reports the time and allocations per
+// string, with the share of the final buffer left free in the row label. std::string is the baseline.
+
+
+namespace {
+
+template <typename GrowthPolicy>
+using PolicyString = simple::StringType<char, std::allocator<char>, GrowthPolicy>;
+
+/*
+*/
+template <typename StringType>
+void appendCharacters(StringType &target, std::size_t count) {
+	for (std::size_t i = 0; i < count; ++i) {
+		target += static_cast<char>('a' + i % 26);
+	}
+}
+
+/*
+*/
+template <typename StringType>
+void appendChunks(StringType &target, std::size_t count, const char *chunk) {
+	for (std::size_t i = 0; i < count; ++i) {
+		target += chunk;
+	}
+}
+
+/*
+	Label with the share of the final capacity left free.
+*/
+template <typename StringType>
+std::string slackLabel(const char *name, const StringType &target) {
+
+	std::size_t unused = target.capacity() - target.size();
+
+	return std::string{name} + " chars, " + std::to_string(100 * unused / target.capacity()) + "% free";
+}
+
+/*
+*/
+template <typename GrowthPolicy>
+void measurePolicy(const char *name, std::size_t length, std::size_t iterations, const char *chunk, std::size_t chunkLength) {
+
+	PolicyString<GrowthPolicy> sample;
+	appendCharacters(sample, length);
+
+	bench::printRow(slackLabel(name, sample), bench::measure(iterations, [&] {
+		PolicyString<GrowthPolicy> target;
+		appendCharacters(target, length);
+		bench::doNotOptimize(target);
+	}));
+
+	bench::printRow(std::string{name} + " chunks", bench::measure(iterations, [&] {
+		PolicyString<GrowthPolicy> target;
+		appendChunks(target, length / chunkLength, chunk);
+		bench::doNotOptimize(target);
+	}));
+}
+
+}
+
+
+int main() {
+
+	const std::size_t lengths[] = {100, 10000, 1000000};
+
+	const char chunk[] = "0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqr";
+	const std::size_t chunkLength = sizeof(chunk) - 1;
+
+	for (std::size_t length : lengths) {
+
+		std::size_t iterations = std::max<std::size_t>(10, 20000000 / length);
+
+		bench::printHeader("append to " + std::to_string(length) + " characters");
+
+		measurePolicy<simple::PowerOfTwoGrowth>("PowerOfTwo", length, iterations, chunk, chunkLength);
+		measurePolicy<simple::OneAndHalfGrowth>("OneAndHalf", length, iterations, chunk, chunkLength);
+		measurePolicy<simple::SizeClassGrowth>("SizeClass", length, iterations, chunk, chunkLength);
+
+		// Exact fit reallocates on every append, so the long cases would take minutes.
+		if (length <= 10000) {
+			measurePolicy<simple::ExactGrowth>("Exact", length, iterations, chunk, chunkLength);
+		}
+
+		std::string sample;
+		appendCharacters(sample, length);
+
+		bench::printRow(slackLabel("std::string", sample), bench::measure(iterations, [&] {
+			std::string target;
+			appendCharacters(target, length);
+			bench::doNotOptimize(target);
+		}));
+
+		bench::printRow("std::string chunks", bench::measure(iterations, [&] {
+			std::string target;
+			appendChunks(target, length / chunkLength, chunk);
+			bench::doNotOptimize(target);
+		}));
+	}
+
+	return 0;
+}
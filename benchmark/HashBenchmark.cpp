@@ -0,0 +1,120 @@
+#include "Benchmark.hpp"
+#include "SimpleHashedString.hpp"
+#include "SimpleString.hpp"
+
+#include <functional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+
+
+// Hashes strings of various lengths with String::hash() and std::hash<std::string>, then looks up
+// the same keys in unordered maps keyed by std::string, String and HashedString. The lookup keys are
+// built once up front, so the HashedString map only hashes them at construction.
+
+
+namespace {
+
+/*
+*/
+std::string randomText(std::size_t length, std::mt19937 &generator) {
+
+	std::uniform_int_distribution<int> letter('a', 'z');
+
+	std::string text(length, ' ');
+	for (char &character : text) {
+		character = static_cast<char>(letter(generator));
+	}
+
+	return text;
+}
+
+}
+
+
+int main() {
+
+	using simple::HashedString;
+	using simple::String;
+
+	std::mt19937 generator{12345};
+
+	const std::size_t lengths[] = {8, 16, 32, 64, 256, 4096, 65536};
+
+	bench::printHeader("hash");
+
+	for (std::size_t length : lengths) {
+
+		std::size_t iterations = std::max<std::size_t>(1000, 200000000 / (length + 64));
+
+		std::string textStd = randomText(length, generator);
+		String text = textStd.c_str();
+
+		bench::printRow("String::hash (" + std::to_string(length) + ")", bench::measure(iterations, [&] {
+			std::size_t result = text.hash();
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("std::hash<std::string> (" + std::to_string(length) + ")", bench::measure(iterations, [&] {
+			std::size_t result = std::hash<std::string>{}(textStd);
+			bench::doNotOptimize(result);
+		}));
+	}
+
+	const std::size_t keyCounts[] = {1000, 100000};
+	const std::size_t keyLength = 48;
+
+	for (std::size_t keyCount : keyCounts) {
+
+		std::vector<std::string> keysStd;
+		std::vector<String> keys;
+		std::vector<HashedString> hashedKeys;
+
+		std::unordered_map<std::string, std::size_t> mapStd;
+		std::unordered_map<String, std::size_t> map;
+		std::unordered_map<HashedString, std::size_t> hashedMap;
+
+		for (std::size_t i = 0; i < keyCount; ++i) {
+			keysStd.push_back(randomText(keyLength, generator));
+			keys.emplace_back(keysStd.back().c_str());
+			hashedKeys.emplace_back(keysStd.back().c_str());
+
+			mapStd.emplace(keysStd.back(), i);
+			map.emplace(keys.back(), i);
+			hashedMap.emplace(hashedKeys.back(), i);
+		}
+
+		std::size_t iterations = std::max<std::size_t>(10, 20000000 / keyCount);
+
+		bench::printHeader("unordered_map lookup, " + std::to_string(keyCount) + " keys of " + std::to_string(keyLength));
+
+		bench::printRow("std::string", bench::measure(iterations, [&] {
+			std::size_t total = 0;
+			for (const std::string &key : keysStd) {
+				total += mapStd.find(key)->second;
+			}
+			bench::doNotOptimize(total);
+		}));
+
+		bench::printRow("String", bench::measure(iterations, [&] {
+			std::size_t total = 0;
+			for (const String &key : keys) {
+				total += map.find(key)->second;
+			}
+			bench::doNotOptimize(total);
+		}));
+
+		bench::printRow("HashedString", bench::measure(iterations, [&] {
+			std::size_t total = 0;
+			for (const HashedString &key : hashedKeys) {
+				total += hashedMap.find(key)->second;
+			}
+			bench::doNotOptimize(total);
+		}));
+	}
+
+	return 0;
+}
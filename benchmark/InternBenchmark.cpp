@@ -0,0 +1,135 @@
+#include "Benchmark.hpp"
+#include "SimpleInternPool.hpp"
+#include "SimpleString.hpp"
+
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+
+
+// Identifiers of the form "module/symbol_<n>" stand in for symbol names: long shared prefixes, so comparing
+// strings has to read most of both. Interning pays the hash once; afterwards handles compare and hash as integers.
+
+
+namespace {
+
+/*
+*/
+std::vector<simple::String> makeKeys(std::size_t count) {
+
+	std::vector<simple::String> keys;
+	keys.reserve(count);
+
+	for (std::size_t i = 0; i < count; ++i) {
+		keys.push_back(("compiler/frontend/semantic_analysis/symbol_" + std::to_string(i)).c_str());
+	}
+
+	return keys;
+}
+
+}
+
+
+int main() {
+
+	using simple::InternHandle;
+	using simple::InternPool;
+	using simple::ShardedInternPool;
+	using simple::String;
+
+	const std::size_t count = 100000;
+	const std::vector<String> keys = makeKeys(count);
+
+	InternPool pool;
+	std::vector<InternHandle> handles;
+	handles.reserve(count);
+
+	for (const String &key : keys) {
+		handles.push_back(pool.intern(key));
+	}
+
+	bench::printHeader("equality, " + std::to_string(count) + " neighbouring pairs");
+
+	bench::printRow("String ==", bench::measure(50, [&] {
+		std::size_t equal = 0;
+		for (std::size_t i = 1; i < count; ++i) {
+			equal += keys[i] == keys[i - 1];
+		}
+		bench::doNotOptimize(equal);
+	}));
+
+	bench::printRow("InternHandle ==", bench::measure(50, [&] {
+		std::size_t equal = 0;
+		for (std::size_t i = 1; i < count; ++i) {
+			equal += handles[i] == handles[i - 1];
+		}
+		bench::doNotOptimize(equal);
+	}));
+
+	bench::printHeader("unordered_map, " + std::to_string(count) + " lookups");
+
+	std::unordered_map<String, std::size_t> byString;
+	std::unordered_map<InternHandle, std::size_t> byHandle;
+
+	for (std::size_t i = 0; i < count; ++i) {
+		byString.emplace(keys[i], i);
+		byHandle.emplace(handles[i], i);
+	}
+
+	bench::printRow("String key", bench::measure(20, [&] {
+		std::size_t sum = 0;
+		for (const String &key : keys) {
+			sum += byString.find(key)->second;
+		}
+		bench::doNotOptimize(sum);
+	}));
+
+	bench::printRow("InternHandle key", bench::measure(20, [&] {
+		std::size_t sum = 0;
+		for (InternHandle handle : handles) {
+			sum += byHandle.find(handle)->second;
+		}
+		bench::doNotOptimize(sum);
+	}));
+
+	bench::printHeader("interning " + std::to_string(count) + " strings, each 4 times");
+
+	bench::printRow("InternPool", bench::measure(10, [&] {
+		InternPool fresh;
+		for (int round = 0; round < 4; ++round) {
+			for (const String &key : keys) {
+				bench::doNotOptimize(fresh.intern(key));
+			}
+		}
+	}));
+
+	const unsigned threadCounts[] = {1, 2, 4, 8};
+
+	for (unsigned threads : threadCounts) {
+
+		bench::printRow("ShardedInternPool, " + std::to_string(threads) + " thr", bench::measure(10, [&] {
+			ShardedInternPool shared;
+			std::vector<std::thread> workers;
+
+			// Each thread interns every key, in a different order, so threads keep meeting in the same shards.
+			for (unsigned t = 0; t < threads; ++t) {
+				workers.emplace_back([&, t] {
+					for (int round = 0; round < 4; ++round) {
+						for (std::size_t i = 0; i < count; ++i) {
+							bench::doNotOptimize(shared.intern(keys[(i + t * count / threads) % count]));
+						}
+					}
+				});
+			}
+
+			for (std::thread &worker : workers) {
+				worker.join();
+			}
+		}));
+	}
+
+	return 0;
+}
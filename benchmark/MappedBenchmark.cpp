@@ -0,0 +1,106 @@
+#include "Benchmark.hpp"
+#include "SimpleMappedString.hpp"
+#include "SimpleString.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+
+#include <cstddef>
+
+
+// Counts the lines of a 256 MiB log file, loaded three ways: read into a std::string, appended block by block
+// to a String (the usual way to load a file into one, growing its buffer to twice the file), and mapped with
+// MappedString. The file is in the page cache after it is written, so the rows compare copying against not
+// copying rather than disk speed. Pass a path to scan an existing file instead of a generated one.
+
+
+namespace {
+
+/*
+*/
+void writeLog(const char *path, std::size_t size, std::mt19937 &generator) {
+
+	const char *levels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+	std::uniform_int_distribution<std::size_t> level(0, 3);
+
+	std::ofstream file{path, std::ios::binary};
+	std::string line;
+
+	for (std::size_t written = 0, i = 0; written < size; written += line.size(), ++i) {
+		line = "2024-01-01T00:00:00 " + std::string(levels[level(generator)]) + " request " + std::to_string(i) + " served in " + std::to_string(generator() % 1000) + " us\n";
+		file << line;
+	}
+}
+
+/*
+*/
+std::size_t countLines(const char *first, const char *last) {
+	return static_cast<std::size_t>(std::count(first, last, '\n'));
+}
+
+}
+
+
+int main(int argc, char *argv[]) {
+
+	using simple::MappedString;
+	using simple::String;
+	using simple::StringView;
+
+	constexpr std::size_t SIZE = std::size_t{256} << 20;
+	constexpr std::size_t ITERATIONS = 5;
+
+	const char *generatedPath = "simple_string_mapped_bench.log";
+	const char *path = argc > 1 ? argv[1] : generatedPath;
+
+	if (argc <= 1) {
+		std::mt19937 generator{12345};
+		writeLog(path, SIZE, generator);
+	}
+
+	bench::printHeader(std::string("count lines of ") + path);
+
+	bench::printRow("ifstream to std::string", bench::measure(ITERATIONS, [&] {
+		std::ifstream file{path, std::ios::binary};
+		std::string text{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+		bench::doNotOptimize(countLines(text.data(), text.data() + text.size()));
+	}));
+
+	bench::printRow("append blocks to String", bench::measure(ITERATIONS, [&] {
+		std::ifstream file{path, std::ios::binary};
+		String text;
+		char buffer[1 << 16];
+
+		while (file.read(buffer, sizeof(buffer)) || file.gcount() != 0) {
+			text += StringView{buffer, static_cast<std::size_t>(file.gcount())};
+		}
+
+		bench::doNotOptimize(countLines(text.data(), text.data() + text.size()));
+	}));
+
+	bench::printRow("MappedString", bench::measure(ITERATIONS, [&] {
+		MappedString text{path};
+		bench::doNotOptimize(countLines(text.begin(), text.end()));
+	}));
+
+	bench::printRow("MappedString, split lines", bench::measure(ITERATIONS, [&] {
+		MappedString text{path};
+		std::size_t lines = 0;
+
+		for (StringView line : text.split('\n')) {
+			lines += !line.empty();
+		}
+
+		bench::doNotOptimize(lines);
+	}));
+
+	if (argc <= 1) {
+		std::remove(generatedPath);
+	}
+
+	return 0;
+}
@@ -0,0 +1,159 @@
+#include "Benchmark.hpp"
+#include "SimpleString.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+// Formats and parses 10000 values per iteration. snprintf is given "%.17g", the shortest format that
+// always round-trips with it; appendFloat writes the shortest text for each value instead.
+// The parse inputs are the texts appendInteger and appendFloat wrote, the same for every contender.
+
+
+int main() {
+
+	using simple::String;
+
+	const std::size_t count = 10000;
+
+	std::mt19937_64 random{12345};
+
+	std::vector<long long> integers(count);
+	std::vector<double> uniform(count);
+	std::vector<double> decimals(count);
+
+	for (std::size_t i = 0; i < count; ++i) {
+		integers[i] = static_cast<long long>(random()) >> (random() % 64);
+
+		// Any finite bit pattern, and prices like 1234.56, which are short in decimal.
+		std::uint64_t bits;
+		do {
+			bits = random();
+			std::memcpy(&uniform[i], &bits, sizeof(bits));
+		} while (uniform[i] != uniform[i] || uniform[i] - uniform[i] != 0);
+
+		decimals[i] = static_cast<double>(random() % 10000000) / 100;
+	}
+
+	bench::printHeader("format " + std::to_string(count) + " integers");
+
+	bench::printRow("String::appendInteger", bench::measure(100, [&] {
+		String text;
+		for (long long value : integers) {
+			text.appendInteger(value);
+			text += ' ';
+		}
+		bench::doNotOptimize(text);
+	}));
+
+	bench::printRow("snprintf %lld, String +=", bench::measure(100, [&] {
+		String text;
+		char buffer[32];
+		for (long long value : integers) {
+			std::snprintf(buffer, sizeof(buffer), "%lld", value);
+			text += buffer;
+			text += ' ';
+		}
+		bench::doNotOptimize(text);
+	}));
+
+	bench::printRow("std::to_string, String +=", bench::measure(100, [&] {
+		String text;
+		for (long long value : integers) {
+			text += std::to_string(value).c_str();
+			text += ' ';
+		}
+		bench::doNotOptimize(text);
+	}));
+
+	const std::pair<const char *, const std::vector<double> *> floatSets[] = {{"random bits", &uniform}, {"two decimals", &decimals}};
+
+	for (const auto &set : floatSets) {
+
+		const std::vector<double> &values = *set.second;
+
+		bench::printHeader(std::string{"format "} + std::to_string(count) + " doubles, " + set.first);
+
+		bench::printRow("String::appendFloat", bench::measure(20, [&] {
+			String text;
+			for (double value : values) {
+				text.appendFloat(value);
+				text += ' ';
+			}
+			bench::doNotOptimize(text);
+		}));
+
+		bench::printRow("snprintf %.17g, String +=", bench::measure(20, [&] {
+			String text;
+			char buffer[32];
+			for (double value : values) {
+				std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+				text += buffer;
+				text += ' ';
+			}
+			bench::doNotOptimize(text);
+		}));
+	}
+
+	std::vector<String> integerTexts;
+	std::vector<String> uniformTexts;
+	std::vector<String> decimalTexts;
+
+	for (std::size_t i = 0; i < count; ++i) {
+		integerTexts.push_back(String{}.appendInteger(integers[i]));
+		uniformTexts.push_back(String{}.appendFloat(uniform[i]));
+		decimalTexts.push_back(String{}.appendFloat(decimals[i]));
+	}
+
+	bench::printHeader("parse " + std::to_string(count) + " integers");
+
+	bench::printRow("String::parseInt", bench::measure(100, [&] {
+		unsigned long long sum = 0;
+		for (const String &text : integerTexts) {
+			sum += static_cast<unsigned long long>(text.parseInt<long long>().value);
+		}
+		bench::doNotOptimize(sum);
+	}));
+
+	bench::printRow("strtoll", bench::measure(100, [&] {
+		unsigned long long sum = 0;
+		for (const String &text : integerTexts) {
+			sum += static_cast<unsigned long long>(std::strtoll(text.cstring(), nullptr, 10));
+		}
+		bench::doNotOptimize(sum);
+	}));
+
+	const std::pair<const char *, const std::vector<String> *> textSets[] = {{"random bits", &uniformTexts}, {"two decimals", &decimalTexts}};
+
+	for (const auto &set : textSets) {
+
+		const std::vector<String> &texts = *set.second;
+
+		bench::printHeader(std::string{"parse "} + std::to_string(count) + " doubles, " + set.first);
+
+		bench::printRow("String::parseDouble", bench::measure(20, [&] {
+			double sum = 0;
+			for (const String &text : texts) {
+				sum += text.parseDouble().value;
+			}
+			bench::doNotOptimize(sum);
+		}));
+
+		bench::printRow("strtod", bench::measure(20, [&] {
+			double sum = 0;
+			for (const String &text : texts) {
+				sum += std::strtod(text.cstring(), nullptr);
+			}
+			bench::doNotOptimize(sum);
+		}));
+	}
+
+	return 0;
+}
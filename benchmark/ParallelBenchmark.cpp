@@ -0,0 +1,135 @@
+#include "Benchmark.hpp"
+#include "SimpleString.hpp"
+#include "SimpleStringParallel.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+
+#include <cstddef>
+
+
+// Counts, searches, case converts, replaces and hashes 64 MiB of English-like text, first with the String
+// member functions and then on thread pools of one, two and hardware_concurrency() threads. A pool of one runs
+// every function serially, so it separates the kernels' own gains from the threads'. The case conversion rows
+// convert the same string back and forth, and the replaceAll rows include the copy they consume.
+
+
+namespace {
+
+/*
+*/
+std::string randomWords(std::size_t length, std::mt19937 &generator) {
+
+	const char *words[] = {"the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "And", "Then", "some", "MORE", "text"};
+	std::uniform_int_distribution<std::size_t> index(0, sizeof(words) / sizeof(words[0]) - 1);
+
+	std::string text;
+	text.reserve(length + 8);
+
+	while (text.size() < length) {
+		text += words[index(generator)];
+		text += ' ';
+	}
+
+	text.resize(length);
+	return text;
+}
+
+/*
+*/
+void measurePool(simple::ThreadPool &pool, const simple::String &string, std::size_t iterations) {
+
+	using simple::String;
+	using simple::StringView;
+
+	String converted = string;
+
+	bench::printHeader(std::to_string(string.size() >> 20) + " MiB of words, " + std::to_string(pool.size()) + (pool.size() == 1 ? " thread" : " threads"));
+
+	bench::printRow("count ' '", bench::measure(iterations, [&] {
+		bench::doNotOptimize(simple::parallelCount(pool, string, ' '));
+	}));
+
+	bench::printRow("count \"fox\"", bench::measure(iterations, [&] {
+		bench::doNotOptimize(simple::parallelCount(pool, string, StringView{"fox"}));
+	}));
+
+	bench::printRow("find missing needle", bench::measure(iterations, [&] {
+		bench::doNotOptimize(simple::parallelFind(pool, string, StringView{"zebra"}));
+	}));
+
+	bench::printRow("toLower + toUpper", bench::measure(iterations, [&] {
+		simple::parallelToLower(pool, converted);
+		simple::parallelToUpper(pool, converted);
+		bench::doNotOptimize(converted);
+	}));
+
+	bench::printRow("copy + replaceAll", bench::measure(iterations, [&] {
+		String copy = string;
+		bench::doNotOptimize(simple::parallelReplaceAll(pool, copy, "fox", "wolf"));
+	}));
+
+	bench::printRow("hash", bench::measure(iterations, [&] {
+		bench::doNotOptimize(simple::parallelHash(pool, string));
+	}));
+}
+
+}
+
+
+int main() {
+
+	using simple::String;
+	using simple::StringView;
+
+	std::mt19937 generator{12345};
+
+	constexpr std::size_t LENGTH = std::size_t{64} << 20;
+	constexpr std::size_t ITERATIONS = 5;
+
+	std::string text = randomWords(LENGTH, generator);
+	String string{StringView{text.data(), text.size()}};
+	String converted = string;
+
+	bench::printHeader(std::to_string(LENGTH >> 20) + " MiB of words, serial");
+
+	bench::printRow("std::count ' '", bench::measure(ITERATIONS, [&] {
+		bench::doNotOptimize(std::count(string.begin(), string.end(), ' '));
+	}));
+
+	bench::printRow("find missing needle", bench::measure(ITERATIONS, [&] {
+		bench::doNotOptimize(string.find(StringView{"zebra"}));
+	}));
+
+	bench::printRow("toLower + toUpper &&", bench::measure(ITERATIONS, [&] {
+		converted = std::move(converted).toLower();
+		converted = std::move(converted).toUpper();
+		bench::doNotOptimize(converted);
+	}));
+
+	bench::printRow("copy + replaceAll", bench::measure(ITERATIONS, [&] {
+		String copy = string;
+		bench::doNotOptimize(copy.replaceAll("fox", "wolf"));
+	}));
+
+	bench::printRow("hash()", bench::measure(ITERATIONS, [&] {
+		bench::doNotOptimize(string.hash());
+	}));
+
+	simple::ThreadPool single{1};
+	measurePool(single, string, ITERATIONS);
+
+	simple::ThreadPool pair{2};
+	measurePool(pair, string, ITERATIONS);
+
+	std::size_t hardwareThreads = std::thread::hardware_concurrency();
+
+	if (hardwareThreads > 2) {
+		simple::ThreadPool pool{hardwareThreads};
+		measurePool(pool, string, ITERATIONS);
+	}
+
+	return 0;
+}
@@ -0,0 +1,65 @@
+#include "Benchmark.hpp"
+#include "SimpleString.hpp"
+
+#include <string>
+
+#include <cstddef>
+
+
+// Template substitution: a document of repeated lines, each holding one {name} placeholder, replaced by a value
+// that is shorter, as long, or longer. "erase + insert" is the loop the String API used to force;
+// std::string is the same find-and-replace loop on std::string, each replacement shifting the tail.
+
+
+int main() {
+
+	using simple::String;
+
+	const std::size_t lineCounts[] = {100, 10000};
+	const char *replacements[] = {"Al", "Alice!", "Alexandria Montgomery"};
+
+	for (std::size_t lines : lineCounts) {
+
+		std::string documentStd;
+		for (std::size_t i = 0; i < lines; ++i) {
+			documentStd += "Dear {name}, your order number " + std::to_string(i) + " has shipped.\n";
+		}
+
+		const String document = documentStd.c_str();
+
+		std::size_t iterations = lines >= 10000 ? 10 : 2000;
+
+		for (const char *replacement : replacements) {
+
+			String replacementString = replacement;
+			std::string replacementStd = replacement;
+
+			bench::printHeader(std::to_string(lines) + " placeholders -> \"" + replacement + "\"");
+
+			bench::printRow("String::replaceAll", bench::measure(iterations, [&] {
+				String text = document;
+				bench::doNotOptimize(text.replaceAll("{name}", replacementString));
+				bench::doNotOptimize(text);
+			}));
+
+			bench::printRow("String erase + insert", bench::measure(iterations, [&] {
+				String text = document;
+				for (std::size_t position = 0; (position = text.find("{name}", position)) != String::NOT_FOUND; position += replacementString.size()) {
+					text.erase(position, position + 6);
+					text.insert(replacementString, position);
+				}
+				bench::doNotOptimize(text);
+			}));
+
+			bench::printRow("std::string find + replace", bench::measure(iterations, [&] {
+				std::string text = documentStd;
+				for (std::size_t position = 0; (position = text.find("{name}", position)) != std::string::npos; position += replacementStd.size()) {
+					text.replace(position, 6, replacementStd);
+				}
+				bench::doNotOptimize(text);
+			}));
+		}
+	}
+
+	return 0;
+}
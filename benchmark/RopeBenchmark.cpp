@@ -0,0 +1,124 @@
+#include "Benchmark.hpp"
+#include "SimpleRope.hpp"
+#include "SimpleString.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+
+// Edits large documents in the middle, as String and as Rope, and assembles a document from many
+// paragraphs. Each edit case performs a batch of short inserts and erases at random positions.
+
+
+namespace {
+
+/*
+*/
+std::string randomText(std::size_t length, std::mt19937 &generator) {
+
+	std::uniform_int_distribution<int> letter('a', 'z');
+
+	std::string text(length, ' ');
+	for (char &character : text) {
+		character = static_cast<char>(letter(generator));
+	}
+
+	return text;
+}
+
+}
+
+
+int main() {
+
+	using simple::Rope;
+	using simple::String;
+	using simple::StringView;
+
+	std::mt19937 generator{12345};
+
+	const std::size_t documentSizes[] = {1 << 16, 1 << 20, 1 << 23};
+	const std::size_t edits = 256;
+
+	const std::string insertion = randomText(40, generator);
+	const StringView insertionView{insertion.data(), insertion.size()};
+
+	for (std::size_t documentSize : documentSizes) {
+
+		const std::string text = randomText(documentSize, generator);
+		const String document = text.c_str();
+		const Rope documentRope{document};
+
+		std::vector<std::size_t> positions;
+		for (std::size_t i = 0; i < edits; ++i) {
+			positions.push_back(generator() % (documentSize - insertion.size()));
+		}
+
+		std::size_t iterations = std::max<std::size_t>(3, (std::size_t{1} << 24) / documentSize);
+
+		bench::printHeader(std::to_string(edits) + " inserts and erases in " + std::to_string(documentSize));
+
+		bench::printRow("String", bench::measure(iterations, [&] {
+			String target = document;
+			for (std::size_t position : positions) {
+				target.insert(insertion.c_str(), position);
+				target.erase(position / 2, position / 2 + insertion.size());
+			}
+			bench::doNotOptimize(target);
+		}));
+
+		bench::printRow("Rope", bench::measure(iterations, [&] {
+			Rope target = documentRope;
+			for (std::size_t position : positions) {
+				target.insert(insertionView, position);
+				target.erase(position / 2, position / 2 + insertion.size());
+			}
+			bench::doNotOptimize(target);
+		}));
+
+		bench::printRow("Rope, then flatten", bench::measure(iterations, [&] {
+			Rope target = documentRope;
+			for (std::size_t position : positions) {
+				target.insert(insertionView, position);
+				target.erase(position / 2, position / 2 + insertion.size());
+			}
+			String result = target.flatten();
+			bench::doNotOptimize(result);
+		}));
+	}
+
+	const std::size_t paragraphCount = 4096;
+
+	std::vector<String> paragraphs;
+	for (std::size_t i = 0; i < paragraphCount; ++i) {
+		paragraphs.emplace_back(randomText(64 + generator() % 1024, generator).c_str());
+	}
+
+	bench::printHeader("assemble " + std::to_string(paragraphCount) + " paragraphs, each placed in the middle");
+
+	bench::printRow("String", bench::measure(5, [&] {
+		String target;
+		for (const String &paragraph : paragraphs) {
+			if (target.empty()) {
+				target = paragraph;
+			}
+			else {
+				target.insert(paragraph, target.size() / 2);
+			}
+		}
+		bench::doNotOptimize(target);
+	}));
+
+	bench::printRow("Rope", bench::measure(5, [&] {
+		Rope target;
+		for (const String &paragraph : paragraphs) {
+			target.insert(paragraph, target.size() / 2);
+		}
+		bench::doNotOptimize(target);
+	}));
+
+	return 0;
+}
@@ -0,0 +1,145 @@
+#include "Benchmark.hpp"
+#include "SimpleString.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include <cstddef>
+
+
+// Searches a pseudo-random lowercase text for needles that only occur at its far end (the start for rfind),
+// so every position is inspected. The periodic case is the classic quadratic input for naive search:
+// a run of 'a' searched for a long run of 'a' followed by 'b'.
+
+
+namespace {
+
+/*
+*/
+std::string randomText(std::size_t length, std::mt19937 &generator) {
+
+	std::uniform_int_distribution<int> letter('a', 'z');
+
+	std::string text(length, ' ');
+	for (char &character : text) {
+		character = static_cast<char>(letter(generator));
+	}
+
+	return text;
+}
+
+}
+
+
+int main() {
+
+	using simple::String;
+
+	std::mt19937 generator{12345};
+
+	const std::size_t lengths[] = {256, 4096, 65536};
+	const std::size_t needleLengths[] = {1, 4, 16, 64, 256};
+
+	for (std::size_t length : lengths) {
+
+		std::size_t iterations = std::max<std::size_t>(1000, 50000000 / length);
+
+		for (std::size_t needleLength : needleLengths) {
+
+			if (needleLength >= length) {
+				continue;
+			}
+
+			// Digits never occur in the text, so the needle can only match where it was placed.
+			// The digit sits in the middle so neither end of the needle is rarer than ordinary text.
+			std::string needleStd = randomText(needleLength, generator);
+			needleStd[needleLength / 2] = '0';
+
+			std::string text = randomText(length - needleLength, generator);
+			std::string haystackStd = text + needleStd;
+			std::string reverseHaystackStd = needleStd + text;
+
+			String haystack = haystackStd.c_str();
+			String reverseHaystack = reverseHaystackStd.c_str();
+			String needle = needleStd.c_str();
+
+			bench::printHeader("length " + std::to_string(length) + ", needle " + std::to_string(needleLength));
+
+			bench::printRow("String::find", bench::measure(iterations, [&] {
+				std::size_t result = haystack.find(needle);
+				bench::doNotOptimize(result);
+			}));
+
+			bench::printRow("std::string::find", bench::measure(iterations, [&] {
+				std::size_t result = haystackStd.find(needleStd);
+				bench::doNotOptimize(result);
+			}));
+
+			bench::printRow("String::rfind", bench::measure(iterations, [&] {
+				std::size_t result = reverseHaystack.rfind(needle);
+				bench::doNotOptimize(result);
+			}));
+
+			bench::printRow("std::string::rfind", bench::measure(iterations, [&] {
+				std::size_t result = reverseHaystackStd.rfind(needleStd);
+				bench::doNotOptimize(result);
+			}));
+		}
+
+		std::string textStd = randomText(length - 1, generator) + ",";
+		String text = textStd.c_str();
+
+		bench::printHeader("length " + std::to_string(length) + ", character sets");
+
+		bench::printRow("String::findFirstOf (3)", bench::measure(iterations, [&] {
+			std::size_t result = text.findFirstOf(",;:");
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("std::string::find_first_of (3)", bench::measure(iterations, [&] {
+			std::size_t result = textStd.find_first_of(",;:");
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("String::findFirstOf (16)", bench::measure(iterations, [&] {
+			std::size_t result = text.findFirstOf(",;:.!?()[]{}<>/0");
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("std::string::find_first_of (16)", bench::measure(iterations, [&] {
+			std::size_t result = textStd.find_first_of(",;:.!?()[]{}<>/0");
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("String::findFirstNotOf (26)", bench::measure(iterations, [&] {
+			std::size_t result = text.findFirstNotOf("abcdefghijklmnopqrstuvwxyz");
+			bench::doNotOptimize(result);
+		}));
+
+		bench::printRow("std::string::find_first_not_of (26)", bench::measure(iterations, [&] {
+			std::size_t result = textStd.find_first_not_of("abcdefghijklmnopqrstuvwxyz");
+			bench::doNotOptimize(result);
+		}));
+	}
+
+	std::string periodicStd(65536, 'a');
+	std::string periodicNeedleStd = std::string(255, 'a') + "b";
+
+	String periodic = periodicStd.c_str();
+	String periodicNeedle = periodicNeedleStd.c_str();
+
+	bench::printHeader("periodic worst case, length 65536, needle 256");
+
+	bench::printRow("String::find", bench::measure(100, [&] {
+		std::size_t result = periodic.find(periodicNeedle);
+		bench::doNotOptimize(result);
+	}));
+
+	bench::printRow("std::string::find", bench::measure(100, [&] {
+		std::size_t result = periodicStd.find(periodicNeedleStd);
+		bench::doNotOptimize(result);
+	}));
+
+	return 0;
+}
@@ -0,0 +1,63 @@
+#include "Benchmark.hpp"
+#include "SimpleSharedString.hpp"
+#include "SimpleString.hpp"
+
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+
+// Fans one payload out to 16 consumers, which each keep a copy and read it; one in `modified` of them appends to theirs.
+// String copies the whole buffer every time; SharedString copies only for the consumers that modify.
+
+
+int main() {
+
+	using simple::SharedString;
+	using simple::String;
+
+	const std::size_t sizes[] = {64, 4096, 65536};
+	const std::size_t consumers = 16;
+
+	for (std::size_t size : sizes) {
+
+		std::string payload(size, 'p');
+
+		String string = payload.c_str();
+		SharedString shared = payload.c_str();
+
+		std::size_t iterations = std::max<std::size_t>(1000, 200000000 / (size * consumers + 1024));
+
+		bench::printHeader(std::to_string(size) + " chars to " + std::to_string(consumers) + " consumers");
+
+		for (std::size_t modified : {0, 4}) {
+
+			std::string suffix = modified == 0 ? ", read only" : ", 1 in 4 writes";
+
+			bench::printRow("String" + suffix, bench::measure(iterations, [&] {
+				std::vector<String> copies(consumers, string);
+				for (std::size_t i = 0; i < consumers; ++i) {
+					if (modified != 0 && i % modified == 0) {
+						copies[i] += '!';
+					}
+					bench::doNotOptimize(copies[i].cstring()[size / 2]);
+				}
+				bench::doNotOptimize(copies);
+			}));
+
+			bench::printRow("SharedString" + suffix, bench::measure(iterations, [&] {
+				std::vector<SharedString> copies(consumers, shared);
+				for (std::size_t i = 0; i < consumers; ++i) {
+					if (modified != 0 && i % modified == 0) {
+						copies[i] += '!';
+					}
+					bench::doNotOptimize(copies[i].cstring()[size / 2]);
+				}
+				bench::doNotOptimize(copies);
+			}));
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,162 @@
+#include "Benchmark.hpp"
+#include "SimpleString.hpp"
+#include "SimpleStringSort.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+
+
+// Sorts a million strings in three shapes: short random words, URLs that share a long prefix, and
+// words drawn from a small vocabulary so that most of them have many duplicates. Every iteration sorts
+// a fresh copy, so the "copy only" row is the part of each time that is not sorting.
+
+
+namespace {
+
+/*
+*/
+std::string randomWord(std::mt19937 &generator, std::size_t minimum, std::size_t maximum) {
+
+	std::uniform_int_distribution<std::size_t> length(minimum, maximum);
+	std::uniform_int_distribution<int> letter('a', 'z');
+
+	std::string word(length(generator), ' ');
+	for (char &character : word) {
+		character = static_cast<char>(letter(generator));
+	}
+
+	return word;
+}
+
+/*
+*/
+std::vector<std::string> randomWords(std::size_t count, std::mt19937 &generator) {
+
+	std::vector<std::string> words;
+	for (std::size_t i = 0; i < count; ++i) {
+		words.push_back(randomWord(generator, 4, 16));
+	}
+
+	return words;
+}
+
+/*
+*/
+std::vector<std::string> randomUrls(std::size_t count, std::mt19937 &generator) {
+
+	std::uniform_int_distribution<int> section(0, 3);
+	const char *sections[] = {"articles", "archive", "assets", "account"};
+
+	std::vector<std::string> urls;
+	for (std::size_t i = 0; i < count; ++i) {
+		urls.push_back(std::string("https://www.example.com/") + sections[section(generator)] + "/" + randomWord(generator, 6, 10) + "/" + std::to_string(generator() % 100000));
+	}
+
+	return urls;
+}
+
+/*
+*/
+std::vector<std::string> repeatedWords(std::size_t count, std::mt19937 &generator) {
+
+	std::vector<std::string> vocabulary = randomWords(1000, generator);
+	std::uniform_int_distribution<std::size_t> pick(0, vocabulary.size() - 1);
+
+	std::vector<std::string> words;
+	for (std::size_t i = 0; i < count; ++i) {
+		words.push_back(vocabulary[pick(generator)]);
+	}
+
+	return words;
+}
+
+}
+
+
+int main() {
+
+	using simple::String;
+	using simple::StringView;
+
+	std::mt19937 generator{12345};
+
+	constexpr std::size_t COUNT = 1000000;
+	constexpr std::size_t ITERATIONS = 5;
+
+	std::size_t threadCount = std::max(2u, std::thread::hardware_concurrency());
+
+	struct Shape {
+		const char *name;
+		std::vector<std::string> text;
+	};
+
+	Shape shapes[] = {
+		{"random words", randomWords(COUNT, generator)},
+		{"URLs with a shared prefix", randomUrls(COUNT, generator)},
+		{"1000 distinct words", repeatedWords(COUNT, generator)},
+	};
+
+	for (const Shape &shape : shapes) {
+
+		std::vector<String> strings;
+		for (const std::string &text : shape.text) {
+			strings.emplace_back(StringView{text.data(), text.size()});
+		}
+
+		std::vector<StringView> views(strings.begin(), strings.end());
+
+		bench::printHeader(std::string(shape.name) + ", " + std::to_string(COUNT) + " strings");
+
+		bench::printRow("copy only", bench::measure(ITERATIONS, [&] {
+			std::vector<String> copy = strings;
+			bench::doNotOptimize(copy);
+		}));
+
+		bench::printRow("std::sort + compare()", bench::measure(ITERATIONS, [&] {
+			std::vector<String> copy = strings;
+			std::sort(copy.begin(), copy.end(), [](const String &left, const String &right) {
+				return left.compare(right) < 0;
+			});
+			bench::doNotOptimize(copy);
+		}));
+
+		bench::printRow("std::sort, std::string", bench::measure(ITERATIONS, [&] {
+			std::vector<std::string> copy = shape.text;
+			std::sort(copy.begin(), copy.end());
+			bench::doNotOptimize(copy);
+		}));
+
+		bench::printRow("sortStrings", bench::measure(ITERATIONS, [&] {
+			std::vector<String> copy = strings;
+			simple::sortStrings(copy.begin(), copy.end());
+			bench::doNotOptimize(copy);
+		}));
+
+		bench::printRow("sortStrings, " + std::to_string(threadCount) + " threads", bench::measure(ITERATIONS, [&] {
+			std::vector<String> copy = strings;
+			simple::sortStrings(copy.begin(), copy.end(), threadCount);
+			bench::doNotOptimize(copy);
+		}));
+
+		bench::printRow("std::sort views", bench::measure(ITERATIONS, [&] {
+			std::vector<StringView> copy = views;
+			std::sort(copy.begin(), copy.end(), [](StringView left, StringView right) {
+				return left.compare(right) < 0;
+			});
+			bench::doNotOptimize(copy);
+		}));
+
+		bench::printRow("sortStrings views", bench::measure(ITERATIONS, [&] {
+			std::vector<StringView> copy = views;
+			simple::sortStrings(copy.begin(), copy.end());
+			bench::doNotOptimize(copy);
+		}));
+	}
+
+	return 0;
+}
@@ -0,0 +1,128 @@
+#include "Benchmark.hpp"
+#include "SimpleString.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+
+// Splits CSV-like text into fields and sums their lengths, so every piece is produced and inspected.
+// The std::string baseline is the usual find() loop collecting substr() copies; the lazy range yields
+// views into the original text, and the bulk variant only records delimiter offsets.
+
+
+namespace {
+
+/*
+	Text of the given length made of lowercase fields averaging fieldLength characters, separated by commas.
+*/
+std::string csvText(std::size_t length, std::size_t fieldLength, std::mt19937 &generator) {
+
+	std::uniform_int_distribution<int> letter('a', 'z');
+	std::uniform_int_distribution<std::size_t> field(0, 2 * fieldLength);
+
+	std::string text;
+	text.reserve(length);
+
+	std::size_t next = field(generator);
+	while (text.size() < length) {
+		if (next == 0) {
+			text.push_back(',');
+			next = field(generator);
+		} else {
+			text.push_back(static_cast<char>(letter(generator)));
+			--next;
+		}
+	}
+
+	return text;
+}
+
+}
+
+
+int main() {
+
+	using simple::String;
+
+	std::mt19937 generator{12345};
+
+	const std::size_t fieldLengths[] = {4, 16, 64};
+	const std::size_t length = 65536;
+	const std::size_t iterations = 2000;
+
+	for (std::size_t fieldLength : fieldLengths) {
+
+		std::string textStd = csvText(length, fieldLength, generator);
+		String text = textStd.c_str();
+
+		bench::printHeader("length " + std::to_string(length) + ", fields of about " + std::to_string(fieldLength));
+
+		bench::printRow("String::split", bench::measure(iterations, [&] {
+			std::size_t total = 0;
+			for (simple::StringView piece : text.split(',')) {
+				total += piece.size();
+			}
+			bench::doNotOptimize(total);
+		}));
+
+		bench::printRow("String::splitAny (3)", bench::measure(iterations, [&] {
+			std::size_t total = 0;
+			for (simple::StringView piece : text.splitAny(",;\t")) {
+				total += piece.size();
+			}
+			bench::doNotOptimize(total);
+		}));
+
+		bench::printRow("SplitRange::delimiters", bench::measure(iterations, [&] {
+			std::size_t offsets[256];
+			std::size_t total = 0;
+			std::size_t position = 0;
+
+			auto range = text.split(',');
+			for (;;) {
+				std::size_t count = range.delimiters(offsets, 256, position);
+				total += count;
+				if (count < 256) {
+					break;
+				}
+				position = offsets[count - 1] + 1;
+			}
+			bench::doNotOptimize(total);
+		}));
+
+		bench::printRow("std::string find loop", bench::measure(iterations, [&] {
+			std::size_t total = 0;
+			std::size_t first = 0;
+			for (;;) {
+				std::size_t last = textStd.find(',', first);
+				if (last == std::string::npos) {
+					total += textStd.size() - first;
+					break;
+				}
+				total += last - first;
+				first = last + 1;
+			}
+			bench::doNotOptimize(total);
+		}));
+
+		bench::printRow("std::string find loop (substr)", bench::measure(iterations, [&] {
+			std::vector<std::string> pieces;
+			std::size_t first = 0;
+			for (;;) {
+				std::size_t last = textStd.find(',', first);
+				if (last == std::string::npos) {
+					pieces.push_back(textStd.substr(first));
+					break;
+				}
+				pieces.push_back(textStd.substr(first, last - first));
+				first = last + 1;
+			}
+			bench::doNotOptimize(pieces);
+		}));
+	}
+
+	return 0;
+}
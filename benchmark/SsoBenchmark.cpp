@@ -0,0 +1,63 @@
+#include "Benchmark.hpp"
+#include "SimpleString.hpp"
+
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+
+// Measures construction, copy and concatenation of short strings around the inline capacity,
+// reporting both time and heap allocations per operation.
+
+
+int main() {
+
+	using simple::String;
+
+	constexpr std::size_t ITERATIONS = 1000000;
+	const std::size_t lengths[] = {1, 3, 7, 8, 11, 15, 16, 22, 23, 31, 32, 64};
+
+	for (std::size_t length : lengths) {
+
+		std::string source(length, 'k');
+		const char *cstring = source.c_str();
+
+		String prototype = cstring;
+
+		bench::printHeader("length " + std::to_string(length));
+
+		bench::printRow("String(const char *)", bench::measure(ITERATIONS, [&] {
+			String value = cstring;
+			bench::doNotOptimize(value);
+		}));
+
+		bench::printRow("String(const String &)", bench::measure(ITERATIONS, [&] {
+			String value = prototype;
+			bench::doNotOptimize(value);
+		}));
+
+		bench::printRow("String + char", bench::measure(ITERATIONS, [&] {
+			String value = prototype + '!';
+			bench::doNotOptimize(value);
+		}));
+
+		bench::printRow("std::string(const char *)", bench::measure(ITERATIONS, [&] {
+			std::string value = cstring;
+			bench::doNotOptimize(value);
+		}));
+	}
+
+	std::vector<String> identifiers;
+	identifiers.reserve(ITERATIONS);
+
+	bench::printHeader("bulk identifiers");
+	bench::printRow("1M x 3-char String", bench::measure(1, [&] {
+		identifiers.clear();
+		for (std::size_t i = 0; i < ITERATIONS; ++i) {
+			identifiers.emplace_back("key");
+		}
+	}));
+
+	return 0;
+}
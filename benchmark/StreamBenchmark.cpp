@@ -0,0 +1,141 @@
+#include "Benchmark.hpp"
+#include "SimpleString.hpp"
+
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <cstddef>
+
+
+// Writes log-style lines to a string stream and reads text back line by line and word by word,
+// comparing String with std::string. "per character" is the loop operator<< used to be.
+
+
+namespace {
+
+/*
+	Lines of lowercase words, each line about lineLength characters long.
+*/
+std::string randomLines(std::size_t lines, std::size_t lineLength, std::mt19937 &generator) {
+
+	std::uniform_int_distribution<int> letter('a', 'z');
+	std::uniform_int_distribution<int> wordLength(1, 12);
+
+	std::string text;
+
+	for (std::size_t line = 0; line < lines; ++line) {
+		std::size_t length = 0;
+
+		while (length < lineLength) {
+			int word = wordLength(generator);
+			for (int i = 0; i < word; ++i) {
+				text.push_back(static_cast<char>(letter(generator)));
+			}
+			text.push_back(' ');
+			length += static_cast<std::size_t>(word) + 1;
+		}
+
+		text.back() = '\n';
+	}
+
+	return text;
+}
+
+}
+
+
+int main() {
+
+	using simple::String;
+
+	std::mt19937 generator{12345};
+
+	const std::size_t lineLengths[] = {64, 4096};
+
+	for (std::size_t lineLength : lineLengths) {
+
+		std::string lineStd = randomLines(1, lineLength, generator);
+		String line = lineStd.c_str();
+
+		std::size_t iterations = 20000000 / (lineLength + 64);
+
+		std::ostringstream stream;
+
+		bench::printHeader("write, line of " + std::to_string(lineLength));
+
+		bench::printRow("String", bench::measure(iterations, [&] {
+			stream.seekp(0);
+			stream << line;
+		}));
+
+		bench::printRow("std::string", bench::measure(iterations, [&] {
+			stream.seekp(0);
+			stream << lineStd;
+		}));
+
+		bench::printRow("String, setw", bench::measure(iterations, [&] {
+			stream.seekp(0);
+			stream << std::setw(static_cast<int>(lineLength + 16)) << line;
+		}));
+
+		bench::printRow("std::string, setw", bench::measure(iterations, [&] {
+			stream.seekp(0);
+			stream << std::setw(static_cast<int>(lineLength + 16)) << lineStd;
+		}));
+
+		bench::printRow("per character", bench::measure(iterations, [&] {
+			stream.seekp(0);
+			for (std::size_t i = 0; i < line.size(); ++i) {
+				stream << line[i];
+			}
+		}));
+
+		std::string textStd = randomLines(4000000 / lineLength, lineLength, generator);
+
+		bench::printHeader("read, " + std::to_string(textStd.size()) + " bytes in lines of " + std::to_string(lineLength));
+
+		bench::printRow("getline String", bench::measure(20, [&] {
+			std::istringstream input{textStd};
+			String target;
+			std::size_t total = 0;
+			while (getline(input, target)) {
+				total += target.size();
+			}
+			bench::doNotOptimize(total);
+		}));
+
+		bench::printRow("getline std::string", bench::measure(20, [&] {
+			std::istringstream input{textStd};
+			std::string target;
+			std::size_t total = 0;
+			while (std::getline(input, target)) {
+				total += target.size();
+			}
+			bench::doNotOptimize(total);
+		}));
+
+		bench::printRow(">> String", bench::measure(20, [&] {
+			std::istringstream input{textStd};
+			String target;
+			std::size_t total = 0;
+			while (input >> target) {
+				total += target.size();
+			}
+			bench::doNotOptimize(total);
+		}));
+
+		bench::printRow(">> std::string", bench::measure(20, [&] {
+			std::istringstream input{textStd};
+			std::string target;
+			std::size_t total = 0;
+			while (input >> target) {
+				total += target.size();
+			}
+			bench::doNotOptimize(total);
+		}));
+	}
+
+	return 0;
+}
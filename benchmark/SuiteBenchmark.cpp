@@ -0,0 +1,246 @@
+#include "Benchmark.hpp"
+#include "SimpleString.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <utility>
+
+#include <cstddef>
+
+
+// The simple_string_bench target: every core operation of String next to the same operation on std::string,
+// over sizes on both sides of the small string limit. The table goes to standard output; pass --json <file>
+// to also write the measurements in a form that can be diffed against an earlier run.
+//
+// insert is paired with popback() and erase with an append at the end, so the string keeps its size and
+// capacity between iterations; they run last because they rearrange its contents. The substring && rows
+// include the copy they consume.
+
+
+namespace {
+
+/*
+	Accepts and discards everything, so stream output is measured without the cost of a destination.
+*/
+class NullBuffer : public std::streambuf {
+
+protected:
+
+	/*
+	*/
+	std::streamsize xsputn(const char *, std::streamsize count) override {
+		return count;
+	}
+
+	/*
+	*/
+	int_type overflow(int_type character) override {
+		return traits_type::not_eof(character);
+	}
+};
+
+/*
+*/
+std::string randomText(std::size_t length, std::mt19937 &generator) {
+
+	std::uniform_int_distribution<int> letter('a', 'z');
+
+	std::string text(length, ' ');
+	for (char &character : text) {
+		character = static_cast<char>(letter(generator));
+	}
+
+	return text;
+}
+
+/*
+	Measures one operation on both string types, prints the pair of rows and records both in the report.
+*/
+template <typename SimpleFunction, typename StdFunction>
+void measurePair(bench::Report &report, const std::string &name, std::size_t size, std::size_t iterations, SimpleFunction &&simpleFunction, StdFunction &&stdFunction) {
+
+	bench::Measurement simpleMeasurement = bench::measure(iterations, simpleFunction);
+	bench::Measurement stdMeasurement = bench::measure(iterations, stdFunction);
+
+	bench::printRow(name, simpleMeasurement);
+	bench::printRow("  std::string", stdMeasurement);
+
+	report.add("String", name, size, iterations, simpleMeasurement);
+	report.add("std::string", name, size, iterations, stdMeasurement);
+}
+
+/*
+*/
+int usage(const char *program) {
+	std::cerr << "usage: " << program << " [--json <file>]\n";
+	return 2;
+}
+
+}
+
+
+int main(int argc, char *argv[]) {
+
+	using simple::String;
+
+	const char *jsonPath = nullptr;
+
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+			jsonPath = argv[++i];
+		}
+		else if (std::strncmp(argv[i], "--json=", 7) == 0) {
+			jsonPath = argv[i] + 7;
+		}
+		else {
+			return usage(argv[0]);
+		}
+	}
+
+	std::mt19937 generator{12345};
+	bench::Report report;
+
+	NullBuffer nullBuffer;
+	std::ostream nullStream{&nullBuffer};
+
+	const char fragment[] = "fragment";
+	const std::size_t fragmentSize = sizeof(fragment) - 1;
+
+	const std::size_t sizes[] = {8, 64, 1024, 65536};
+
+	for (std::size_t size : sizes) {
+
+		std::size_t iterations = std::max<std::size_t>(100, 20000000 / (size + 64));
+
+		std::string text = randomText(size, generator);
+		std::string equalText = text;
+
+		String string{text.c_str()};
+		String equalString{equalText.c_str()};
+
+		std::size_t middle = size / 2;
+		std::size_t first = size / 4;
+		std::size_t last = size - size / 4;
+
+		bench::printHeader(std::to_string(size) + " characters");
+
+		measurePair(report, "construct from C string", size, iterations, [&] {
+			String result{text.c_str()};
+			bench::doNotOptimize(result);
+		}, [&] {
+			std::string result{text.c_str()};
+			bench::doNotOptimize(result);
+		});
+
+		measurePair(report, "copy construct", size, iterations, [&] {
+			String result = string;
+			bench::doNotOptimize(result);
+		}, [&] {
+			std::string result = text;
+			bench::doNotOptimize(result);
+		});
+
+		measurePair(report, "move construct + assign", size, iterations, [&] {
+			String result = std::move(string);
+			bench::doNotOptimize(result);
+			string = std::move(result);
+		}, [&] {
+			std::string result = std::move(text);
+			bench::doNotOptimize(result);
+			text = std::move(result);
+		});
+
+		measurePair(report, "+= char, size times", size, iterations, [&] {
+			String result;
+			for (std::size_t i = 0; i < size; ++i) {
+				result += 'x';
+			}
+			bench::doNotOptimize(result);
+		}, [&] {
+			std::string result;
+			for (std::size_t i = 0; i < size; ++i) {
+				result += 'x';
+			}
+			bench::doNotOptimize(result);
+		});
+
+		measurePair(report, "+= string", size, iterations, [&] {
+			String result{fragment};
+			result += string;
+			bench::doNotOptimize(result);
+		}, [&] {
+			std::string result{fragment};
+			result += text;
+			bench::doNotOptimize(result);
+		});
+
+		measurePair(report, "substring const &", size, iterations, [&] {
+			bench::doNotOptimize(string.substring(first, last));
+		}, [&] {
+			bench::doNotOptimize(text.substr(first, last - first));
+		});
+
+		measurePair(report, "copy + substring &&", size, iterations, [&] {
+			String copy = string;
+			bench::doNotOptimize(std::move(copy).substring(first, last));
+		}, [&] {
+			std::string copy = text;
+			bench::doNotOptimize(std::move(copy).substr(first, last - first));
+		});
+
+		measurePair(report, "compare, equal", size, iterations, [&] {
+			bench::doNotOptimize(string.compare(equalString));
+		}, [&] {
+			bench::doNotOptimize(text.compare(equalText));
+		});
+
+		measurePair(report, "operator==, equal", size, iterations, [&] {
+			bench::doNotOptimize(string == equalString);
+		}, [&] {
+			bench::doNotOptimize(text == equalText);
+		});
+
+		measurePair(report, "stream output", size, iterations, [&] {
+			nullStream << string;
+		}, [&] {
+			nullStream << text;
+		});
+
+		measurePair(report, "insert middle + popback", size, iterations, [&] {
+			string.insert(fragment, middle);
+			string.popback(fragmentSize);
+			bench::doNotOptimize(string);
+		}, [&] {
+			text.insert(middle, fragment);
+			text.resize(text.size() - fragmentSize);
+			bench::doNotOptimize(text);
+		});
+
+		measurePair(report, "erase middle + append", size, iterations, [&] {
+			string.erase(middle - fragmentSize / 2, middle + fragmentSize / 2);
+			string += fragment;
+			bench::doNotOptimize(string);
+		}, [&] {
+			text.erase(middle - fragmentSize / 2, fragmentSize);
+			text += fragment;
+			bench::doNotOptimize(text);
+		});
+	}
+
+	if (jsonPath != nullptr) {
+		std::ofstream file{jsonPath};
+		report.writeJson(file);
+
+		if (!file) {
+			std::cerr << "could not write " << jsonPath << '\n';
+			return 1;
+		}
+	}
+
+	return 0;
+}
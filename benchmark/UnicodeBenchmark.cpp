@@ -0,0 +1,108 @@
+#include "Benchmark.hpp"
+#include "SimpleString.hpp"
+#include "SimpleStringUnicode.hpp"
+
+#include <codecvt>
+#include <locale>
+#include <random>
+#include <string>
+
+#include <cstddef>
+
+
+// Validates and transcodes about 1 MB of UTF-8 in four mixes: pure ASCII, Latin text with an accented letter
+// every few words, CJK text (three bytes per character) and emoji (four bytes, a surrogate pair in UTF-16).
+// The baselines are a validator that checks one sequence at a time and the standard library's codecvt facets.
+
+
+namespace {
+
+/*
+*/
+std::u32string randomCodePoints(std::size_t count, char32_t first, char32_t last, unsigned asciiPercent, std::mt19937 &generator) {
+
+	std::uniform_int_distribution<unsigned> percent(0, 99);
+	std::uniform_int_distribution<char32_t> letter('a', 'z');
+	std::uniform_int_distribution<char32_t> other(first, last);
+
+	std::u32string text(count, U' ');
+	for (char32_t &codePoint : text) {
+		codePoint = percent(generator) < asciiPercent ? letter(generator) : other(generator);
+	}
+
+	return text;
+}
+
+}
+
+
+int main() {
+
+	std::mt19937 generator{12345};
+
+	struct Mix {
+		const char *name;
+		std::size_t count;
+		char32_t first;
+		char32_t last;
+		unsigned asciiPercent;
+	};
+
+	const Mix mixes[] = {
+		{"ASCII", 1000000, U'a', U'z', 100},
+		{"Latin", 900000, 0xE0, 0xFF, 95},
+		{"CJK", 350000, 0x4E00, 0x9FFF, 0},
+		{"emoji", 250000, 0x1F600, 0x1F64F, 0},
+	};
+
+	std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> utf32Converter;
+	std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> utf16Converter;
+
+	for (const Mix &mix : mixes) {
+
+		std::u32string codePoints = randomCodePoints(mix.count, mix.first, mix.last, mix.asciiPercent, generator);
+		std::string text = utf32Converter.to_bytes(codePoints);
+		std::u16string wide = utf16Converter.from_bytes(text);
+
+		simple::String string{simple::StringView{text.data(), text.size()}};
+		simple::StringType<char16_t> string16{simple::StringViewType<char16_t>{wide.data(), wide.size()}};
+
+		std::size_t iterations = 50;
+
+		bench::printHeader(std::string(mix.name) + ", " + std::to_string(text.size()) + " bytes");
+
+		bench::printRow("isValidUtf8", bench::measure(iterations, [&] {
+			bench::doNotOptimize(simple::isValidUtf8(string));
+		}));
+
+		bench::printRow("one sequence at a time", bench::measure(iterations, [&] {
+			bench::doNotOptimize(simple::detail::isValidUtf8Scalar(reinterpret_cast<const unsigned char *>(text.data()), text.size()));
+		}));
+
+		bench::printRow("toUtf16", bench::measure(iterations, [&] {
+			bench::doNotOptimize(simple::toUtf16(string));
+		}));
+
+		bench::printRow("codecvt_utf8_utf16 from", bench::measure(iterations, [&] {
+			bench::doNotOptimize(utf16Converter.from_bytes(text));
+		}));
+
+		bench::printRow("toUtf32", bench::measure(iterations, [&] {
+			bench::doNotOptimize(simple::toUtf32(string));
+		}));
+
+		bench::printRow("codecvt_utf8 from", bench::measure(iterations, [&] {
+			bench::doNotOptimize(utf32Converter.from_bytes(text));
+		}));
+
+		bench::printRow("toUtf8 from UTF-16", bench::measure(iterations, [&] {
+			bench::doNotOptimize(simple::toUtf8(string16));
+		}));
+
+		bench::printRow("codecvt_utf8_utf16 to", bench::measure(iterations, [&] {
+			bench::doNotOptimize(utf16Converter.to_bytes(wide));
+		}));
+	}
+
+	return 0;
+}
@@ -0,0 +1,345 @@
+
+#pragma once
+#ifndef SIMPLE_ARENA_HPP
+#define SIMPLE_ARENA_HPP
+
+
+#include "SimpleString.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define SIMPLE_ARENA_HAS_MEMORY_RESOURCE
+#endif
+#endif
+
+
+
+namespace simple {
+
+
+/*
+	Bump allocator that hands out memory from a chain of blocks and only gives it back all at once.
+	Freeing the most recent allocation rolls the bump pointer back, so a string that grows
+	and immediately frees its previous buffer does not leave a hole behind.
+	Not thread-safe; intended for request-scoped data owned by a single thread.
+*/
+class MonotonicArena {
+public:
+
+	// Type Aliases
+
+	using SizeType = std::size_t;
+
+	// Constants
+
+	static constexpr SizeType DEFAULT_BLOCK_SIZE = 4096;
+
+	// Constructors
+
+	explicit MonotonicArena(SizeType = DEFAULT_BLOCK_SIZE) noexcept;
+	MonotonicArena(void *, SizeType) noexcept;
+
+	MonotonicArena(const MonotonicArena &) = delete;
+
+	// Destructor
+
+	~MonotonicArena() noexcept;
+
+	// Assignment Operations
+
+	MonotonicArena &operator=(const MonotonicArena &) = delete;
+
+	// Allocation Functions
+
+	void *allocate(SizeType, SizeType);
+	void deallocate(void *, SizeType) noexcept;
+	void release() noexcept;
+
+	// Statistics Functions
+
+	SizeType allocated() const noexcept;
+
+private:
+
+	// Block header placed at the start of every heap block
+	struct Block {
+		Block *previous;
+		SizeType size;
+	};
+
+	// Data Members
+
+	unsigned char *m_current{};
+	unsigned char *m_end{};
+	Block *m_blocks{};
+
+	unsigned char *m_initialBuffer{};
+	SizeType m_initialSize{};
+
+	SizeType m_blockSize{};
+	SizeType m_allocated{};
+
+	// Utility Functions
+
+	void *allocateBlock(SizeType, SizeType);
+};
+
+
+/*
+	Standard allocator adaptor over a MonotonicArena.
+	Allocators never propagate, so strings keep the arena they were created with.
+*/
+template <typename Type>
+class ArenaAllocator {
+public:
+
+	// Standard Allocator Aliases
+
+	using value_type = Type;
+
+	using propagate_on_container_copy_assignment = std::false_type;
+	using propagate_on_container_move_assignment = std::false_type;
+	using propagate_on_container_swap = std::false_type;
+
+	// Constructors
+
+	ArenaAllocator(MonotonicArena &) noexcept;
+
+	template <typename OtherType>
+	ArenaAllocator(const ArenaAllocator<OtherType> &) noexcept;
+
+	// Allocation Functions
+
+	Type *allocate(std::size_t);
+	void deallocate(Type *, std::size_t) noexcept;
+
+	// Access Functions
+
+	MonotonicArena &arena() const noexcept;
+
+private:
+
+	template <typename OtherType>
+	friend class ArenaAllocator;
+
+	// Data Members
+
+	MonotonicArena *m_arena;
+};
+
+
+// Constants
+
+constexpr MonotonicArena::SizeType MonotonicArena::DEFAULT_BLOCK_SIZE;
+
+
+// Constructors
+
+/*
+*/
+inline MonotonicArena::MonotonicArena(SizeType blockSize) noexcept :
+	m_blockSize{std::max<SizeType>(blockSize, sizeof(Block) * 2)} {}
+
+/*
+	Serves allocations from buffer (for example stack memory) before falling back to heap blocks.
+*/
+inline MonotonicArena::MonotonicArena(void *buffer, SizeType size) noexcept :
+	m_current{static_cast<unsigned char *>(buffer)}, m_end{static_cast<unsigned char *>(buffer) + size},
+	m_initialBuffer{static_cast<unsigned char *>(buffer)}, m_initialSize{size},
+	m_blockSize{std::max<SizeType>(size, DEFAULT_BLOCK_SIZE)} {
+
+	assert(buffer != nullptr || size == 0);
+}
+
+
+// Destructor
+
+/*
+*/
+inline MonotonicArena::~MonotonicArena() noexcept {
+	release();
+}
+
+
+// Allocation Functions
+
+/*
+*/
+inline void *MonotonicArena::allocate(SizeType size, SizeType alignment) {
+
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+	std::uintptr_t current = reinterpret_cast<std::uintptr_t>(m_current);
+	std::uintptr_t aligned = (current + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+
+	if (m_current != nullptr && aligned - current <= static_cast<SizeType>(m_end - m_current) &&
+		size <= static_cast<SizeType>(m_end - m_current) - (aligned - current)) {
+
+		m_current = reinterpret_cast<unsigned char *>(aligned) + size;
+		m_allocated += size;
+
+		return reinterpret_cast<void *>(aligned);
+	}
+
+	return allocateBlock(size, alignment);
+}
+
+/*
+	Only the most recent allocation can actually be reclaimed; anything else waits for release().
+*/
+inline void MonotonicArena::deallocate(void *pointer, SizeType size) noexcept {
+
+	unsigned char *bytes = static_cast<unsigned char *>(pointer);
+
+	if (bytes + size == m_current) {
+		m_current = bytes;
+		m_allocated -= size;
+	}
+}
+
+/*
+	Frees every heap block at once and starts over from the initial buffer.
+*/
+inline void MonotonicArena::release() noexcept {
+
+	while (m_blocks != nullptr) {
+		Block *previous = m_blocks->previous;
+		::operator delete(static_cast<void *>(m_blocks));
+		m_blocks = previous;
+	}
+
+	m_current = m_initialBuffer;
+	m_end = m_initialBuffer + m_initialSize;
+	m_allocated = 0;
+}
+
+/*
+	Blocks double in size so the number of heap allocations stays logarithmic in the bytes served.
+*/
+inline void *MonotonicArena::allocateBlock(SizeType size, SizeType alignment) {
+
+	SizeType required = sizeof(Block) + size + alignment;
+	SizeType blockSize = std::max(m_blockSize, required);
+
+	Block *block = static_cast<Block *>(::operator new(blockSize));
+	block->previous = m_blocks;
+	block->size = blockSize;
+
+	m_blocks = block;
+	m_current = reinterpret_cast<unsigned char *>(block + 1);
+	m_end = reinterpret_cast<unsigned char *>(block) + blockSize;
+
+	if (m_blockSize <= std::numeric_limits<SizeType>::max() / 2) {
+		m_blockSize *= 2;
+	}
+
+	return allocate(size, alignment);
+}
+
+
+// Statistics Functions
+
+/*
+	Bytes currently handed out, excluding alignment padding and block headers.
+*/
+inline MonotonicArena::SizeType MonotonicArena::allocated() const noexcept {
+	return m_allocated;
+}
+
+
+// Constructors
+
+/*
+*/
+template <typename Type>
+ArenaAllocator<Type>::ArenaAllocator(MonotonicArena &arena) noexcept :
+	m_arena{std::addressof(arena)} {}
+
+/*
+*/
+template <typename Type>
+template <typename OtherType>
+ArenaAllocator<Type>::ArenaAllocator(const ArenaAllocator<OtherType> &allocator) noexcept :
+	m_arena{allocator.m_arena} {}
+
+
+// Allocation Functions
+
+/*
+*/
+template <typename Type>
+Type *ArenaAllocator<Type>::allocate(std::size_t count) {
+
+	if (count > std::numeric_limits<std::size_t>::max() / sizeof(Type)) {
+		throw std::bad_array_new_length{};
+	}
+
+	return static_cast<Type *>(m_arena->allocate(count * sizeof(Type), alignof(Type)));
+}
+
+/*
+*/
+template <typename Type>
+void ArenaAllocator<Type>::deallocate(Type *pointer, std::size_t count) noexcept {
+	m_arena->deallocate(pointer, count * sizeof(Type));
+}
+
+
+// Access Functions
+
+/*
+*/
+template <typename Type>
+MonotonicArena &ArenaAllocator<Type>::arena() const noexcept {
+	return *m_arena;
+}
+
+
+// Comparison Operations
+
+/*
+*/
+template <typename Type, typename OtherType>
+bool operator==(const ArenaAllocator<Type> &left, const ArenaAllocator<OtherType> &right) noexcept {
+	return std::addressof(left.arena()) == std::addressof(right.arena());
+}
+
+/*
+*/
+template <typename Type, typename OtherType>
+bool operator!=(const ArenaAllocator<Type> &left, const ArenaAllocator<OtherType> &right) noexcept {
+	return !(left == right);
+}
+
+
+// Default Aliases
+
+template <typename CharType>
+using ArenaStringType = StringType<CharType, ArenaAllocator<CharType>>;
+
+using ArenaString = ArenaStringType<char>;
+
+#if defined(SIMPLE_ARENA_HAS_MEMORY_RESOURCE)
+
+template <typename CharType>
+using PolymorphicStringType = StringType<CharType, std::pmr::polymorphic_allocator<CharType>>;
+
+using PolymorphicString = PolymorphicStringType<char>;
+
+#endif
+
+}
+
+
+#endif // SIMPLE_ARENA_HPP
@@ -0,0 +1,289 @@
+#pragma once
+#ifndef SIMPLE_HASHED_STRING_HPP
+#define SIMPLE_HASHED_STRING_HPP
+
+
+#include "SimpleString.hpp"
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include <cstddef>
+
+
+
+namespace simple {
+
+
+/*
+	Immutable string that hashes its contents once, when it is constructed, and keeps the result.
+	Intended as a hash table key that is looked up repeatedly: std::hash returns the stored value
+	and equality rejects most mismatches by comparing hashes before characters.
+	There is no mutable access, since any change would leave the stored hash stale;
+	copy the string() out and build a new key instead.
+*/
+template <typename CharType, typename Allocator = std::allocator<CharType>>
+class HashedStringType {
+public:
+
+	// Type Aliases
+
+	using ValueType = CharType;
+	using SizeType = std::size_t;
+
+	using AllocatorType = Allocator;
+
+	using ConstReference = const ValueType &;
+	using ConstPointer = const ValueType *;
+
+	using ConstIterator = ConstPointer;
+
+	using StorageType = StringType<ValueType, AllocatorType>;
+	using ViewType = StringViewType<ValueType>;
+
+private:
+
+	// Data Members
+
+	StorageType m_string;
+	SizeType m_hash;
+
+public:
+
+	// Constructors
+
+	HashedStringType(ConstPointer, const AllocatorType & = AllocatorType());
+	explicit HashedStringType(ViewType, const AllocatorType & = AllocatorType());
+	HashedStringType(const StorageType &);
+	HashedStringType(StorageType &&) noexcept;
+	HashedStringType(const HashedStringType &) = default;
+	HashedStringType(HashedStringType &&) noexcept;
+
+	// Assignment Operations
+
+	HashedStringType &operator=(const HashedStringType &) = default;
+	HashedStringType &operator=(HashedStringType &&) noexcept(std::is_nothrow_move_assignable<StorageType>::value);
+
+	// Conversion Operations
+
+	operator ViewType() const noexcept;
+
+	// Size Functions
+
+	SizeType size() const noexcept;
+	bool empty() const noexcept;
+
+	// Data Access Functions
+
+	ConstPointer data() const noexcept;
+	ConstPointer cstring() const noexcept;
+
+	ConstReference operator[](SizeType) const noexcept;
+
+	const StorageType &string() const noexcept;
+
+	// Iterator Functions
+
+	ConstIterator begin() const noexcept;
+	ConstIterator end() const noexcept;
+
+	// Hash Functions
+
+	SizeType hash() const noexcept;
+};
+
+
+// Constructors
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+HashedStringType<ValueType, AllocatorType>::HashedStringType(ConstPointer cstring, const AllocatorType &allocator) :
+	m_string{cstring, allocator}, m_hash{m_string.hash()} {}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+HashedStringType<ValueType, AllocatorType>::HashedStringType(ViewType view, const AllocatorType &allocator) :
+	m_string{view, allocator}, m_hash{m_string.hash()} {}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+HashedStringType<ValueType, AllocatorType>::HashedStringType(const StorageType &other) :
+	m_string{other}, m_hash{m_string.hash()} {}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+HashedStringType<ValueType, AllocatorType>::HashedStringType(StorageType &&other) noexcept :
+	m_string{std::move(other)}, m_hash{m_string.hash()} {}
+
+/*
+	The source is left holding the hash of whatever it still contains, so it stays a consistent key.
+*/
+template <typename ValueType, typename AllocatorType>
+HashedStringType<ValueType, AllocatorType>::HashedStringType(HashedStringType &&other) noexcept :
+	m_string{std::move(other.m_string)}, m_hash{other.m_hash} {
+
+	other.m_hash = other.m_string.hash();
+}
+
+
+// Assignment Operations
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+HashedStringType<ValueType, AllocatorType> &HashedStringType<ValueType, AllocatorType>::operator=(HashedStringType &&other) noexcept(std::is_nothrow_move_assignable<StorageType>::value) {
+
+	SizeType hash = other.m_hash;
+
+	m_string = std::move(other.m_string);
+	m_hash = hash;
+
+	other.m_hash = other.m_string.hash();
+
+	return *this;
+}
+
+
+// Conversion Operations
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+HashedStringType<ValueType, AllocatorType>::operator ViewType() const noexcept {
+	return m_string;
+}
+
+
+// Size Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename HashedStringType<ValueType, AllocatorType>::SizeType HashedStringType<ValueType, AllocatorType>::size() const noexcept {
+	return m_string.size();
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+bool HashedStringType<ValueType, AllocatorType>::empty() const noexcept {
+	return m_string.empty();
+}
+
+
+// Data Access Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename HashedStringType<ValueType, AllocatorType>::ConstPointer HashedStringType<ValueType, AllocatorType>::data() const noexcept {
+	return m_string.data();
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename HashedStringType<ValueType, AllocatorType>::ConstPointer HashedStringType<ValueType, AllocatorType>::cstring() const noexcept {
+	return m_string.cstring();
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename HashedStringType<ValueType, AllocatorType>::ConstReference HashedStringType<ValueType, AllocatorType>::operator[](SizeType index) const noexcept {
+	return m_string[index];
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+const typename HashedStringType<ValueType, AllocatorType>::StorageType &HashedStringType<ValueType, AllocatorType>::string() const noexcept {
+	return m_string;
+}
+
+
+// Iterator Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename HashedStringType<ValueType, AllocatorType>::ConstIterator HashedStringType<ValueType, AllocatorType>::begin() const noexcept {
+	return m_string.begin();
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename HashedStringType<ValueType, AllocatorType>::ConstIterator HashedStringType<ValueType, AllocatorType>::end() const noexcept {
+	return m_string.end();
+}
+
+
+// Hash Functions
+
+/*
+	The stored hash; equal to string().hash() without recomputing it.
+*/
+template <typename ValueType, typename AllocatorType>
+typename HashedStringType<ValueType, AllocatorType>::SizeType HashedStringType<ValueType, AllocatorType>::hash() const noexcept {
+	return m_hash;
+}
+
+
+// Comparison Operations
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+bool operator==(const HashedStringType<ValueType, AllocatorType> &left, const HashedStringType<ValueType, AllocatorType> &right) noexcept {
+	return left.hash() == right.hash() && left.string() == right.string();
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+bool operator!=(const HashedStringType<ValueType, AllocatorType> &left, const HashedStringType<ValueType, AllocatorType> &right) noexcept {
+	return !(left == right);
+}
+
+
+// Output Stream Operations
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename Traits>
+std::basic_ostream<ValueType, Traits> &operator<<(std::basic_ostream<ValueType, Traits> &os, const HashedStringType<ValueType, AllocatorType> &object) {
+	return os << object.string();
+}
+
+
+// Default Alias
+
+using HashedString = HashedStringType<char>;
+
+}
+
+
+namespace std {
+
+/*
+	Returns the stored hash, so lookups with a reused key never touch the characters until the final comparison.
+*/
+template <typename CharType, typename Allocator>
+struct hash<simple::HashedStringType<CharType, Allocator>> {
+	std::size_t operator()(const simple::HashedStringType<CharType, Allocator> &object) const noexcept {
+		return object.hash();
+	}
+};
+
+}
+
+
+#endif // SIMPLE_HASHED_STRING_HPP
@@ -0,0 +1,653 @@
+#pragma once
+#ifndef SIMPLE_INTERN_POOL_HPP
+#define SIMPLE_INTERN_POOL_HPP
+
+
+#include "SimpleArena.hpp"
+#include "SimpleStringKernels.hpp"
+#include "SimpleStringView.hpp"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace simple {
+
+
+// Forward Declarations
+
+template <typename CharType>
+class InternPoolType;
+
+template <typename CharType, std::size_t SHARD_COUNT>
+class ShardedInternPoolType;
+
+
+/*
+	Names one string interned in a pool. Within a pool equal strings get equal handles,
+	so comparing and hashing handles are integer operations. Handles from different pools must not be mixed.
+	A default constructed handle names nothing and compares unequal to every handle a pool returns.
+*/
+class InternHandle {
+public:
+
+	// Type Aliases
+
+	using ValueType = std::uint32_t;
+
+	// Constructors
+
+	InternHandle() noexcept = default;
+
+	// Access Functions
+
+	ValueType value() const noexcept;
+	bool valid() const noexcept;
+
+	// Comparison Operations
+
+	friend bool operator==(InternHandle, InternHandle) noexcept;
+	friend bool operator!=(InternHandle, InternHandle) noexcept;
+	friend bool operator<(InternHandle, InternHandle) noexcept;
+
+private:
+
+	// Data Members
+
+	ValueType m_value{};
+
+	// Constructors
+
+	explicit InternHandle(ValueType) noexcept;
+
+	// Friend Classes
+
+	template <typename>
+	friend class InternPoolType;
+
+	template <typename, std::size_t>
+	friend class ShardedInternPoolType;
+};
+
+
+/*
+	Deduplicating store of strings. Each distinct string is copied once, NUL-terminated, into an arena
+	and never moves, so the views handed out stay valid for the life of the pool.
+	Lookups go through an open-addressing table of handles, probed by the cached hash of each string.
+	Handles are numbered densely from one, in the order strings were first interned, and fit in 32 bits,
+	so intern() throws std::length_error for a new string once the pool holds 2^32 - 1 of them.
+	Not thread-safe; see ShardedInternPoolType.
+*/
+template <typename CharType>
+class InternPoolType {
+public:
+
+	// Type Aliases
+
+	using ValueType = CharType;
+	using SizeType = std::size_t;
+
+	using ConstPointer = const ValueType *;
+
+	using ViewType = StringViewType<ValueType>;
+
+private:
+
+	// Record Types
+
+	struct Record {
+		ConstPointer data;
+		SizeType size;
+		SizeType hash;
+	};
+
+	// Constants
+
+	// Records live in blocks of FIRST_BLOCK, 2 * FIRST_BLOCK, 4 * FIRST_BLOCK... which are never reallocated,
+	// so a record can be read while another is being added.
+	static constexpr SizeType FIRST_BLOCK = 64;
+	static constexpr SizeType BLOCK_COUNT = 32;
+
+	static constexpr SizeType FIRST_TABLE = 64;
+
+	// Data Members
+
+	MonotonicArena m_arena;
+
+	std::array<Record *, BLOCK_COUNT> m_blocks{};
+	SizeType m_size{};
+
+	// Handle values, zero for an empty slot; kept at most half full.
+	std::vector<InternHandle::ValueType> m_table;
+
+	// Record Functions
+
+	const Record &record(InternHandle) const noexcept;
+	Record &addRecord(ViewType, SizeType);
+
+	void rehash();
+
+	// Search Functions
+
+	InternHandle intern(ViewType, SizeType);
+	InternHandle find(ViewType, SizeType) const noexcept;
+
+	// Friend Classes
+
+	template <typename, std::size_t>
+	friend class ShardedInternPoolType;
+
+public:
+
+	// Constructors
+
+	InternPoolType();
+	InternPoolType(const InternPoolType &) = delete;
+
+	// Assignment Operations
+
+	InternPoolType &operator=(const InternPoolType &) = delete;
+
+	// Size Functions
+
+	SizeType size() const noexcept;
+	bool empty() const noexcept;
+
+	// Search Functions
+
+	InternHandle intern(ViewType);
+	InternHandle find(ViewType) const noexcept;
+
+	// Data Access Functions
+
+	ViewType view(InternHandle) const noexcept;
+	ConstPointer cstring(InternHandle) const noexcept;
+};
+
+
+/*
+	Thread-safe pool that spreads strings over SHARD_COUNT independently locked InternPoolTypes,
+	chosen by the top bits of the hash, so threads interning different strings rarely wait for each other.
+	view() and cstring() take no lock: what a handle names never changes once the handle exists.
+	Handles from every shard share one 32-bit range, so each shard holds at most 2^32 / SHARD_COUNT strings
+	(2^28 with the default 16); intern() throws std::length_error for a new string in a full shard.
+*/
+template <typename CharType, std::size_t SHARD_COUNT = 16>
+class ShardedInternPoolType {
+public:
+
+	// Type Aliases
+
+	using ValueType = CharType;
+	using SizeType = std::size_t;
+
+	using ConstPointer = const ValueType *;
+
+	using ViewType = StringViewType<ValueType>;
+
+	static_assert(SHARD_COUNT != 0 && (SHARD_COUNT & (SHARD_COUNT - 1)) == 0, "shard count must be a power of two");
+
+private:
+
+	// Shard Types
+
+	// Padded so that neighbouring shards' locks do not share a cache line.
+	struct Shard {
+		std::mutex mutex;
+		InternPoolType<ValueType> pool;
+		unsigned char padding[64];
+	};
+
+	// Data Members
+
+	std::array<Shard, SHARD_COUNT> m_shards;
+
+	// Shard Functions
+
+	static SizeType shardIndex(SizeType) noexcept;
+	static SizeType shardCapacity(SizeType) noexcept;
+	static InternHandle encodeHandle(InternHandle, SizeType) noexcept;
+
+public:
+
+	// Constructors
+
+	ShardedInternPoolType() = default;
+	ShardedInternPoolType(const ShardedInternPoolType &) = delete;
+
+	// Assignment Operations
+
+	ShardedInternPoolType &operator=(const ShardedInternPoolType &) = delete;
+
+	// Size Functions
+
+	SizeType size() const;
+
+	// Search Functions
+
+	InternHandle intern(ViewType);
+	InternHandle find(ViewType) const;
+
+	// Data Access Functions
+
+	ViewType view(InternHandle) const noexcept;
+	ConstPointer cstring(InternHandle) const noexcept;
+};
+
+
+// Intern Handle
+
+/*
+*/
+inline InternHandle::InternHandle(ValueType value) noexcept :
+	m_value{value} {}
+
+/*
+	Nonzero for a handle returned by a pool.
+*/
+inline InternHandle::ValueType InternHandle::value() const noexcept {
+	return m_value;
+}
+
+/*
+*/
+inline bool InternHandle::valid() const noexcept {
+	return m_value != 0;
+}
+
+/*
+*/
+inline bool operator==(InternHandle left, InternHandle right) noexcept {
+	return left.m_value == right.m_value;
+}
+
+/*
+*/
+inline bool operator!=(InternHandle left, InternHandle right) noexcept {
+	return left.m_value != right.m_value;
+}
+
+/*
+	Orders by handle value, which is not the order of the strings.
+*/
+inline bool operator<(InternHandle left, InternHandle right) noexcept {
+	return left.m_value < right.m_value;
+}
+
+
+// Constants
+
+template <typename ValueType>
+constexpr typename InternPoolType<ValueType>::SizeType InternPoolType<ValueType>::FIRST_BLOCK;
+
+template <typename ValueType>
+constexpr typename InternPoolType<ValueType>::SizeType InternPoolType<ValueType>::BLOCK_COUNT;
+
+template <typename ValueType>
+constexpr typename InternPoolType<ValueType>::SizeType InternPoolType<ValueType>::FIRST_TABLE;
+
+
+// Record Functions
+
+/*
+	Handle value n names record n - 1, which is in block b when FIRST_BLOCK * (2^b - 1) <= n - 1 < FIRST_BLOCK * (2^(b + 1) - 1).
+*/
+template <typename ValueType>
+const typename InternPoolType<ValueType>::Record &InternPoolType<ValueType>::record(InternHandle handle) const noexcept {
+
+	assert(handle.valid());
+
+	SizeType index = handle.value() - 1;
+	unsigned block = detail::highestSetBit(static_cast<std::uint64_t>(index / FIRST_BLOCK + 1));
+
+	return m_blocks[block][index - FIRST_BLOCK * ((SizeType{1} << block) - 1)];
+}
+
+/*
+	Copies view into the arena and appends its record, starting a new block when the last one is full.
+	Throws std::length_error, before changing anything, when the new record would have no handle.
+*/
+template <typename ValueType>
+typename InternPoolType<ValueType>::Record &InternPoolType<ValueType>::addRecord(ViewType view, SizeType hash) {
+
+	if (m_size >= std::numeric_limits<InternHandle::ValueType>::max()) {
+		throw std::length_error{"InternPoolType is full"};
+	}
+
+	unsigned block = detail::highestSetBit(static_cast<std::uint64_t>(m_size / FIRST_BLOCK + 1));
+	SizeType offset = m_size - FIRST_BLOCK * ((SizeType{1} << block) - 1);
+
+	if (offset == 0) {
+		assert(block < BLOCK_COUNT);
+
+		SizeType count = FIRST_BLOCK << block;
+		m_blocks[block] = static_cast<Record *>(m_arena.allocate(count * sizeof(Record), alignof(Record)));
+	}
+
+	ValueType *data = static_cast<ValueType *>(m_arena.allocate((view.size() + 1) * sizeof(ValueType), alignof(ValueType)));
+
+	std::copy(view.data(), view.data() + view.size(), data);
+	data[view.size()] = static_cast<ValueType>('\0');
+
+	Record &record = m_blocks[block][offset];
+	record = Record{data, view.size(), hash};
+
+	++m_size;
+
+	return record;
+}
+
+/*
+	Doubles the table and reinserts every handle by its stored hash.
+*/
+template <typename ValueType>
+void InternPoolType<ValueType>::rehash() {
+
+	std::vector<InternHandle::ValueType> table(std::max(FIRST_TABLE, 2 * m_table.size()), 0);
+	SizeType mask = table.size() - 1;
+
+	for (InternHandle::ValueType value : m_table) {
+		if (value != 0) {
+			SizeType slot = record(InternHandle{value}).hash & mask;
+
+			while (table[slot] != 0) {
+				slot = (slot + 1) & mask;
+			}
+
+			table[slot] = value;
+		}
+	}
+
+	m_table.swap(table);
+}
+
+
+// Private Search Functions
+
+/*
+*/
+template <typename ValueType>
+InternHandle InternPoolType<ValueType>::intern(ViewType view, SizeType hash) {
+
+	if (2 * (m_size + 1) > m_table.size()) {
+		rehash();
+	}
+
+	SizeType mask = m_table.size() - 1;
+	SizeType slot = hash & mask;
+
+	while (m_table[slot] != 0) {
+		const Record &record = this->record(InternHandle{m_table[slot]});
+
+		if (record.hash == hash && ViewType{record.data, record.size} == view) {
+			return InternHandle{m_table[slot]};
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	addRecord(view, hash);
+
+	InternHandle::ValueType value = static_cast<InternHandle::ValueType>(m_size);
+	m_table[slot] = value;
+
+	return InternHandle{value};
+}
+
+/*
+*/
+template <typename ValueType>
+InternHandle InternPoolType<ValueType>::find(ViewType view, SizeType hash) const noexcept {
+
+	if (m_table.empty()) {
+		return InternHandle{};
+	}
+
+	SizeType mask = m_table.size() - 1;
+	SizeType slot = hash & mask;
+
+	while (m_table[slot] != 0) {
+		const Record &record = this->record(InternHandle{m_table[slot]});
+
+		if (record.hash == hash && ViewType{record.data, record.size} == view) {
+			return InternHandle{m_table[slot]};
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	return InternHandle{};
+}
+
+
+// Constructors
+
+/*
+*/
+template <typename ValueType>
+InternPoolType<ValueType>::InternPoolType() :
+	m_arena{MonotonicArena::DEFAULT_BLOCK_SIZE} {}
+
+
+// Size Functions
+
+/*
+	Number of distinct strings interned.
+*/
+template <typename ValueType>
+typename InternPoolType<ValueType>::SizeType InternPoolType<ValueType>::size() const noexcept {
+	return m_size;
+}
+
+/*
+*/
+template <typename ValueType>
+bool InternPoolType<ValueType>::empty() const noexcept {
+	return m_size == 0;
+}
+
+
+// Search Functions
+
+/*
+	Handle of the string equal to view, interning a copy of it first if there is none yet.
+*/
+template <typename ValueType>
+InternHandle InternPoolType<ValueType>::intern(ViewType view) {
+	return intern(view, view.hash());
+}
+
+/*
+	Handle of the string equal to view, or an invalid handle if it was never interned.
+*/
+template <typename ValueType>
+InternHandle InternPoolType<ValueType>::find(ViewType view) const noexcept {
+	return find(view, view.hash());
+}
+
+
+// Data Access Functions
+
+/*
+*/
+template <typename ValueType>
+typename InternPoolType<ValueType>::ViewType InternPoolType<ValueType>::view(InternHandle handle) const noexcept {
+
+	assert(handle.valid() && handle.value() <= m_size);
+
+	const Record &record = this->record(handle);
+
+	return ViewType{record.data, record.size};
+}
+
+/*
+*/
+template <typename ValueType>
+typename InternPoolType<ValueType>::ConstPointer InternPoolType<ValueType>::cstring(InternHandle handle) const noexcept {
+
+	assert(handle.valid() && handle.value() <= m_size);
+
+	return record(handle).data;
+}
+
+
+// Sharded Pool Shard Functions
+
+/*
+	The top bits pick the shard, leaving the low bits, which probe each shard's table, evenly spread.
+*/
+template <typename ValueType, std::size_t SHARD_COUNT>
+typename ShardedInternPoolType<ValueType, SHARD_COUNT>::SizeType ShardedInternPoolType<ValueType, SHARD_COUNT>::shardIndex(SizeType hash) noexcept {
+	return SHARD_COUNT == 1 ? 0 : hash >> (std::numeric_limits<SizeType>::digits - detail::highestSetBit(static_cast<std::uint64_t>(SHARD_COUNT)));
+}
+
+/*
+	The largest shard-local handle whose encoding still fits in InternHandle::ValueType.
+*/
+template <typename ValueType, std::size_t SHARD_COUNT>
+typename ShardedInternPoolType<ValueType, SHARD_COUNT>::SizeType ShardedInternPoolType<ValueType, SHARD_COUNT>::shardCapacity(SizeType index) noexcept {
+	return (SizeType{std::numeric_limits<InternHandle::ValueType>::max()} - index - 1) / SHARD_COUNT + 1;
+}
+
+/*
+	A shard's handle n becomes (n - 1) * SHARD_COUNT + shard + 1, so the shard is recovered from the low bits.
+*/
+template <typename ValueType, std::size_t SHARD_COUNT>
+InternHandle ShardedInternPoolType<ValueType, SHARD_COUNT>::encodeHandle(InternHandle local, SizeType index) noexcept {
+	assert(local.value() <= shardCapacity(index));
+	return InternHandle{static_cast<InternHandle::ValueType>((SizeType{local.value()} - 1) * SHARD_COUNT + index + 1)};
+}
+
+
+// Sharded Pool Size Functions
+
+/*
+*/
+template <typename ValueType, std::size_t SHARD_COUNT>
+typename ShardedInternPoolType<ValueType, SHARD_COUNT>::SizeType ShardedInternPoolType<ValueType, SHARD_COUNT>::size() const {
+
+	SizeType size = 0;
+
+	for (const Shard &shard : m_shards) {
+		std::lock_guard<std::mutex> lock{const_cast<std::mutex &>(shard.mutex)};
+		size += shard.pool.size();
+	}
+
+	return size;
+}
+
+
+// Sharded Pool Search Functions
+
+/*
+	A full shard still returns the handles of strings it already holds.
+*/
+template <typename ValueType, std::size_t SHARD_COUNT>
+InternHandle ShardedInternPoolType<ValueType, SHARD_COUNT>::intern(ViewType view) {
+
+	SizeType hash = view.hash();
+	SizeType index = shardIndex(hash);
+
+	Shard &shard = m_shards[index];
+	InternHandle local;
+
+	{
+		std::lock_guard<std::mutex> lock{shard.mutex};
+
+		if (shard.pool.size() < shardCapacity(index)) {
+			local = shard.pool.intern(view, hash);
+		} else {
+			local = shard.pool.find(view, hash);
+
+			if (!local.valid()) {
+				throw std::length_error{"ShardedInternPoolType shard is full"};
+			}
+		}
+	}
+
+	return encodeHandle(local, index);
+}
+
+/*
+*/
+template <typename ValueType, std::size_t SHARD_COUNT>
+InternHandle ShardedInternPoolType<ValueType, SHARD_COUNT>::find(ViewType view) const {
+
+	SizeType hash = view.hash();
+	SizeType index = shardIndex(hash);
+
+	const Shard &shard = m_shards[index];
+	InternHandle local;
+
+	{
+		std::lock_guard<std::mutex> lock{const_cast<std::mutex &>(shard.mutex)};
+		local = shard.pool.find(view, hash);
+	}
+
+	if (!local.valid()) {
+		return local;
+	}
+
+	return encodeHandle(local, index);
+}
+
+
+// Sharded Pool Data Access Functions
+
+/*
+*/
+template <typename ValueType, std::size_t SHARD_COUNT>
+typename ShardedInternPoolType<ValueType, SHARD_COUNT>::ViewType ShardedInternPoolType<ValueType, SHARD_COUNT>::view(InternHandle handle) const noexcept {
+
+	assert(handle.valid());
+
+	InternHandle::ValueType value = handle.value() - 1;
+
+	// Reads the record directly: the shard's size may be changing under another thread's lock.
+	const auto &record = m_shards[value % SHARD_COUNT].pool.record(InternHandle{static_cast<InternHandle::ValueType>(value / SHARD_COUNT + 1)});
+
+	return ViewType{record.data, record.size};
+}
+
+/*
+*/
+template <typename ValueType, std::size_t SHARD_COUNT>
+typename ShardedInternPoolType<ValueType, SHARD_COUNT>::ConstPointer ShardedInternPoolType<ValueType, SHARD_COUNT>::cstring(InternHandle handle) const noexcept {
+	return view(handle).data();
+}
+
+
+// Default Aliases
+
+using InternPool = InternPoolType<char>;
+using ShardedInternPool = ShardedInternPoolType<char>;
+
+}
+
+
+namespace std {
+
+/*
+	The handle value itself; handles are already distinct small integers.
+*/
+template <>
+struct hash<simple::InternHandle> {
+	std::size_t operator()(simple::InternHandle handle) const noexcept {
+		return handle.value();
+	}
+};
+
+}
+
+
+#endif // SIMPLE_INTERN_POOL_HPP
@@ -0,0 +1,825 @@
+#pragma once
+#ifndef SIMPLE_MAPPED_STRING_HPP
+#define SIMPLE_MAPPED_STRING_HPP
+
+
+#include "SimpleStringSplit.hpp"
+#include "SimpleStringView.hpp"
+
+#include <limits>
+#include <system_error>
+#include <utility>
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_WIN32)
+
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#define SIMPLE_MAPPED_STRING_NOMINMAX
+#endif
+
+#include <windows.h>
+
+#if defined(SIMPLE_MAPPED_STRING_NOMINMAX)
+#undef NOMINMAX
+#undef SIMPLE_MAPPED_STRING_NOMINMAX
+#endif
+
+#else
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif
+
+
+// Memory-Mapped Strings
+//
+// A MappedStringType maps a whole file into memory read-only and reads it as a string of its characters,
+// so a file of any size is scanned straight out of the page cache: nothing is copied and nothing is allocated
+// on the heap, and pages are only read from disk as they are first touched. The file descriptor is closed once
+// the mapping exists. The contents are not NUL terminated, and changes other processes make to the file while
+// it is mapped may or may not show; truncating it underneath the mapping makes reads past the new end fault.
+
+
+
+namespace simple {
+
+
+/*
+	Hint about the order in which a mapped range will be read, passed on to madvise().
+	SEQUENTIAL lets the kernel read further ahead and drop pages soon after they were read;
+	DONT_NEED drops the range's pages now, to be read again from the file if they are touched later.
+*/
+enum class AccessPattern {
+	NORMAL,
+	SEQUENTIAL,
+	RANDOM,
+	WILL_NEED,
+	DONT_NEED
+};
+
+
+/*
+	Read-only string over a memory-mapped file, with the const interface of a view. Views, substrings and
+	split pieces point into the mapping and are valid for as long as it lives. Movable but not copyable.
+	A file whose size is not a multiple of sizeof(CharType) ends at its last whole character;
+	the partial character after it is mapped with the rest of the file but is not part of the string.
+*/
+template <typename CharType>
+class MappedStringType {
+public:
+
+	// Type Aliases
+
+	using ValueType = CharType;
+	using SizeType = std::size_t;
+
+	using ConstReference = const ValueType &;
+	using ConstPointer = const ValueType *;
+	using ConstIterator = ConstPointer;
+
+	using ViewType = StringViewType<ValueType>;
+
+	// Constants
+
+	// Returned by the search functions when there is no match.
+	static constexpr SizeType NOT_FOUND = detail::NOT_FOUND;
+
+private:
+
+	// Data Members
+
+	// Start of the mapping, or null for an empty string, which maps nothing.
+	ConstPointer m_data{};
+	SizeType m_size{};
+
+	// Size of the mapping, which counts the bytes of a trailing partial character that m_size leaves out.
+	SizeType m_bytes{};
+
+	// Mapping Functions
+
+	static void *map(const char *, AccessPattern, SizeType &);
+	static void unmap(const void *, SizeType) noexcept;
+	static void adviseBytes(const void *, SizeType, AccessPattern) noexcept;
+
+public:
+
+	// Constructors
+
+	MappedStringType() noexcept = default;
+	explicit MappedStringType(const char *, AccessPattern = AccessPattern::SEQUENTIAL);
+
+	MappedStringType(const MappedStringType &) = delete;
+	MappedStringType(MappedStringType &&) noexcept;
+
+	// Destructor
+
+	~MappedStringType() noexcept;
+
+	// Assignment Operations
+
+	MappedStringType &operator=(const MappedStringType &) = delete;
+	MappedStringType &operator=(MappedStringType &&) noexcept;
+
+	// Conversion Operations
+
+	operator ViewType() const noexcept;
+	ViewType view() const noexcept;
+
+	// Size Functions
+
+	SizeType size() const noexcept;
+	bool empty() const noexcept;
+
+	// Data Access Functions
+
+	ConstPointer data() const noexcept;
+
+	ConstReference operator[](SizeType) const noexcept;
+
+	ConstReference front() const noexcept;
+	ConstReference back() const noexcept;
+
+	// Iterator Functions
+
+	ConstIterator begin() const noexcept;
+	ConstIterator end() const noexcept;
+
+	ConstIterator cbegin() const noexcept;
+	ConstIterator cend() const noexcept;
+
+	// Mapping Functions
+
+	void advise(AccessPattern) const noexcept;
+	void advise(AccessPattern, SizeType, SizeType) const noexcept;
+
+	void close() noexcept;
+
+	// Substring Functions
+
+	ViewType substring(SizeType) const noexcept;
+	ViewType substring(SizeType, SizeType) const noexcept;
+
+	// Comparison Functions
+
+	int compare(ConstPointer) const noexcept;
+	int compare(ViewType) const noexcept;
+
+	// Search Functions
+
+	SizeType find(ValueType, SizeType = 0) const noexcept;
+	SizeType find(ConstPointer, SizeType = 0) const noexcept;
+	SizeType find(ViewType, SizeType = 0) const noexcept;
+
+	SizeType rfind(ValueType, SizeType = NOT_FOUND) const noexcept;
+	SizeType rfind(ConstPointer, SizeType = NOT_FOUND) const noexcept;
+	SizeType rfind(ViewType, SizeType = NOT_FOUND) const noexcept;
+
+	bool contains(ValueType) const noexcept;
+	bool contains(ConstPointer) const noexcept;
+	bool contains(ViewType) const noexcept;
+
+	bool startsWith(ValueType) const noexcept;
+	bool startsWith(ConstPointer) const noexcept;
+	bool startsWith(ViewType) const noexcept;
+
+	bool endsWith(ValueType) const noexcept;
+	bool endsWith(ConstPointer) const noexcept;
+	bool endsWith(ViewType) const noexcept;
+
+	SizeType findFirstOf(ConstPointer, SizeType = 0) const noexcept;
+	SizeType findFirstOf(ViewType, SizeType = 0) const noexcept;
+	SizeType findFirstNotOf(ConstPointer, SizeType = 0) const noexcept;
+	SizeType findFirstNotOf(ViewType, SizeType = 0) const noexcept;
+
+	// Split Functions
+
+	SplitRange<ValueType> split(ValueType) const noexcept;
+	SplitRange<ValueType> split(ViewType) const noexcept;
+	SplitRange<ValueType> splitAny(ViewType) const noexcept;
+
+	// Hash Functions
+
+	SizeType hash() const noexcept;
+};
+
+
+// Constants
+
+template <typename ValueType>
+constexpr typename MappedStringType<ValueType>::SizeType MappedStringType<ValueType>::NOT_FOUND;
+
+
+// Mapping Functions
+
+#if defined(_WIN32)
+
+/*
+	Windows has no sequential or random advice for an existing view, so those patterns choose how the file is opened.
+*/
+template <typename ValueType>
+void *MappedStringType<ValueType>::map(const char *path, AccessPattern pattern, SizeType &bytes) {
+
+	DWORD flags = pattern == AccessPattern::SEQUENTIAL ? FILE_FLAG_SEQUENTIAL_SCAN : pattern == AccessPattern::RANDOM ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL;
+
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, flags, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE) {
+		throw std::system_error{static_cast<int>(GetLastError()), std::system_category(), path};
+	}
+
+	LARGE_INTEGER size;
+
+	if (!GetFileSizeEx(file, &size)) {
+		DWORD error = GetLastError();
+		CloseHandle(file);
+		throw std::system_error{static_cast<int>(error), std::system_category(), path};
+	}
+
+	if (static_cast<unsigned long long>(size.QuadPart) > std::numeric_limits<SizeType>::max()) {
+		CloseHandle(file);
+		throw std::system_error{std::make_error_code(std::errc::file_too_large), path};
+	}
+
+	bytes = static_cast<SizeType>(size.QuadPart);
+
+	if (bytes < sizeof(ValueType)) {
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	DWORD error = GetLastError();
+	CloseHandle(file);
+
+	if (mapping == nullptr) {
+		throw std::system_error{static_cast<int>(error), std::system_category(), path};
+	}
+
+	void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	error = GetLastError();
+	CloseHandle(mapping);
+
+	if (data == nullptr) {
+		throw std::system_error{static_cast<int>(error), std::system_category(), path};
+	}
+
+	adviseBytes(data, bytes, pattern);
+
+	return data;
+}
+
+/*
+*/
+template <typename ValueType>
+void MappedStringType<ValueType>::unmap(const void *data, SizeType) noexcept {
+	UnmapViewOfFile(data);
+}
+
+/*
+	Only WILL_NEED has a counterpart, and only from Windows 8 on.
+*/
+template <typename ValueType>
+void MappedStringType<ValueType>::adviseBytes(const void *data, SizeType bytes, AccessPattern pattern) noexcept {
+
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+	if (pattern == AccessPattern::WILL_NEED) {
+		WIN32_MEMORY_RANGE_ENTRY range{const_cast<void *>(data), bytes};
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	}
+#else
+	static_cast<void>(data);
+	static_cast<void>(bytes);
+	static_cast<void>(pattern);
+#endif
+}
+
+#else
+
+/*
+	Maps the file at path and returns the start of the mapping, with its size in bytes in bytes,
+	or null when the file holds no whole character. Throws std::system_error if it cannot be mapped.
+*/
+template <typename ValueType>
+void *MappedStringType<ValueType>::map(const char *path, AccessPattern pattern, SizeType &bytes) {
+
+	int file;
+
+	do {
+		file = ::open(path, O_RDONLY | O_CLOEXEC);
+	} while (file == -1 && errno == EINTR);
+
+	if (file == -1) {
+		throw std::system_error{errno, std::generic_category(), path};
+	}
+
+	struct stat status;
+
+	if (::fstat(file, &status) == -1) {
+		int error = errno;
+		::close(file);
+		throw std::system_error{error, std::generic_category(), path};
+	}
+
+	// Pipes, devices and the like have no size to map.
+	if (!S_ISREG(status.st_mode)) {
+		::close(file);
+		throw std::system_error{std::make_error_code(S_ISDIR(status.st_mode) ? std::errc::is_a_directory : std::errc::invalid_argument), path};
+	}
+
+	if (static_cast<std::uintmax_t>(status.st_size) > std::numeric_limits<SizeType>::max()) {
+		::close(file);
+		throw std::system_error{std::make_error_code(std::errc::file_too_large), path};
+	}
+
+	bytes = static_cast<SizeType>(status.st_size);
+
+	if (bytes < sizeof(ValueType)) {
+		::close(file);
+		return nullptr;
+	}
+
+	void *data = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, file, 0);
+	int error = errno;
+	::close(file);
+
+	if (data == MAP_FAILED) {
+		throw std::system_error{error, std::generic_category(), path};
+	}
+
+	if (pattern != AccessPattern::NORMAL) {
+		adviseBytes(data, bytes, pattern);
+	}
+
+	return data;
+}
+
+/*
+*/
+template <typename ValueType>
+void MappedStringType<ValueType>::unmap(const void *data, SizeType bytes) noexcept {
+	::munmap(const_cast<void *>(data), bytes);
+}
+
+/*
+	madvise() takes whole pages; rounding the start down covers the partial page the range begins in.
+*/
+template <typename ValueType>
+void MappedStringType<ValueType>::adviseBytes(const void *data, SizeType bytes, AccessPattern pattern) noexcept {
+
+	int advice = MADV_NORMAL;
+
+	switch (pattern) {
+	case AccessPattern::NORMAL:
+		advice = MADV_NORMAL;
+		break;
+	case AccessPattern::SEQUENTIAL:
+		advice = MADV_SEQUENTIAL;
+		break;
+	case AccessPattern::RANDOM:
+		advice = MADV_RANDOM;
+		break;
+	case AccessPattern::WILL_NEED:
+		advice = MADV_WILLNEED;
+		break;
+	case AccessPattern::DONT_NEED:
+		advice = MADV_DONTNEED;
+		break;
+	}
+
+	std::uintptr_t pageSize = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+	std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(data) & ~(pageSize - 1);
+	std::uintptr_t end = reinterpret_cast<std::uintptr_t>(data) + bytes;
+
+	::madvise(reinterpret_cast<void *>(begin), static_cast<std::size_t>(end - begin), advice);
+}
+
+#endif
+
+
+// Constructors
+
+/*
+	Maps the file at path and applies pattern to the whole of it. Throws std::system_error
+	if the file cannot be opened or mapped, or is too large for the address space.
+*/
+template <typename ValueType>
+MappedStringType<ValueType>::MappedStringType(const char *path, AccessPattern pattern) {
+
+	assert(path != nullptr);
+
+	SizeType bytes = 0;
+
+	m_data = static_cast<ConstPointer>(map(path, pattern, bytes));
+	m_size = m_data != nullptr ? bytes / sizeof(ValueType) : 0;
+	m_bytes = m_data != nullptr ? bytes : 0;
+}
+
+/*
+*/
+template <typename ValueType>
+MappedStringType<ValueType>::MappedStringType(MappedStringType &&other) noexcept :
+	m_data{other.m_data}, m_size{other.m_size}, m_bytes{other.m_bytes} {
+
+	other.m_data = nullptr;
+	other.m_size = 0;
+	other.m_bytes = 0;
+}
+
+
+// Destructor
+
+/*
+*/
+template <typename ValueType>
+MappedStringType<ValueType>::~MappedStringType() noexcept {
+	close();
+}
+
+
+// Assignment Operations
+
+/*
+*/
+template <typename ValueType>
+MappedStringType<ValueType> &MappedStringType<ValueType>::operator=(MappedStringType &&other) noexcept {
+
+	if (this != &other) {
+		close();
+
+		std::swap(m_data, other.m_data);
+		std::swap(m_size, other.m_size);
+		std::swap(m_bytes, other.m_bytes);
+	}
+
+	return *this;
+}
+
+
+// Conversion Operations
+
+/*
+*/
+template <typename ValueType>
+MappedStringType<ValueType>::operator ViewType() const noexcept {
+	return ViewType{m_data, m_size};
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::ViewType MappedStringType<ValueType>::view() const noexcept {
+	return ViewType{m_data, m_size};
+}
+
+
+// Size Functions
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::SizeType MappedStringType<ValueType>::size() const noexcept {
+	return m_size;
+}
+
+/*
+*/
+template <typename ValueType>
+bool MappedStringType<ValueType>::empty() const noexcept {
+	return m_size == 0;
+}
+
+
+// Data Access Functions
+
+/*
+	Null for an empty string.
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::ConstPointer MappedStringType<ValueType>::data() const noexcept {
+	return m_data;
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::ConstReference MappedStringType<ValueType>::operator[](SizeType index) const noexcept {
+
+	assert(index < m_size);
+
+	return m_data[index];
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::ConstReference MappedStringType<ValueType>::front() const noexcept {
+
+	assert(m_size != 0);
+
+	return m_data[0];
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::ConstReference MappedStringType<ValueType>::back() const noexcept {
+
+	assert(m_size != 0);
+
+	return m_data[m_size - 1];
+}
+
+
+// Iterator Functions
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::ConstIterator MappedStringType<ValueType>::begin() const noexcept {
+	return m_data;
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::ConstIterator MappedStringType<ValueType>::end() const noexcept {
+	return m_data + m_size;
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::ConstIterator MappedStringType<ValueType>::cbegin() const noexcept {
+	return m_data;
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::ConstIterator MappedStringType<ValueType>::cend() const noexcept {
+	return m_data + m_size;
+}
+
+
+// Mapping Functions
+
+/*
+*/
+template <typename ValueType>
+void MappedStringType<ValueType>::advise(AccessPattern pattern) const noexcept {
+	advise(pattern, 0, m_size);
+}
+
+/*
+	Applies pattern to the pages holding the characters from first up to last. It is only a hint:
+	the contents stay the same whatever it is, and systems without the matching advice ignore it.
+	A scan over a file much larger than memory can drop each part with DONT_NEED once it is done with it.
+*/
+template <typename ValueType>
+void MappedStringType<ValueType>::advise(AccessPattern pattern, SizeType first, SizeType last) const noexcept {
+
+	assert(first <= last && last <= m_size);
+
+	if (first != last) {
+		adviseBytes(m_data + first, (last - first) * sizeof(ValueType), pattern);
+	}
+}
+
+/*
+	Unmaps the file, leaving an empty string. Views into it must no longer be used.
+*/
+template <typename ValueType>
+void MappedStringType<ValueType>::close() noexcept {
+
+	if (m_data != nullptr) {
+		unmap(m_data, m_bytes);
+	}
+
+	m_data = nullptr;
+	m_size = 0;
+	m_bytes = 0;
+}
+
+
+// Substring Functions
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::ViewType MappedStringType<ValueType>::substring(SizeType first) const noexcept {
+	return view().substring(first);
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::ViewType MappedStringType<ValueType>::substring(SizeType first, SizeType last) const noexcept {
+	return view().substring(first, last);
+}
+
+
+// Comparison Functions
+
+/*
+*/
+template <typename ValueType>
+int MappedStringType<ValueType>::compare(ConstPointer cstring) const noexcept {
+	return view().compare(cstring);
+}
+
+/*
+*/
+template <typename ValueType>
+int MappedStringType<ValueType>::compare(ViewType other) const noexcept {
+	return view().compare(other);
+}
+
+
+// Search Functions
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::SizeType MappedStringType<ValueType>::find(ValueType character, SizeType position) const noexcept {
+	return view().find(character, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::SizeType MappedStringType<ValueType>::find(ConstPointer cstring, SizeType position) const noexcept {
+	return view().find(cstring, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::SizeType MappedStringType<ValueType>::find(ViewType needle, SizeType position) const noexcept {
+	return view().find(needle, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::SizeType MappedStringType<ValueType>::rfind(ValueType character, SizeType position) const noexcept {
+	return view().rfind(character, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::SizeType MappedStringType<ValueType>::rfind(ConstPointer cstring, SizeType position) const noexcept {
+	return view().rfind(cstring, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::SizeType MappedStringType<ValueType>::rfind(ViewType needle, SizeType position) const noexcept {
+	return view().rfind(needle, position);
+}
+
+/*
+*/
+template <typename ValueType>
+bool MappedStringType<ValueType>::contains(ValueType character) const noexcept {
+	return view().contains(character);
+}
+
+/*
+*/
+template <typename ValueType>
+bool MappedStringType<ValueType>::contains(ConstPointer cstring) const noexcept {
+	return view().contains(cstring);
+}
+
+/*
+*/
+template <typename ValueType>
+bool MappedStringType<ValueType>::contains(ViewType needle) const noexcept {
+	return view().contains(needle);
+}
+
+/*
+*/
+template <typename ValueType>
+bool MappedStringType<ValueType>::startsWith(ValueType character) const noexcept {
+	return view().startsWith(character);
+}
+
+/*
+*/
+template <typename ValueType>
+bool MappedStringType<ValueType>::startsWith(ConstPointer cstring) const noexcept {
+	return view().startsWith(cstring);
+}
+
+/*
+*/
+template <typename ValueType>
+bool MappedStringType<ValueType>::startsWith(ViewType prefix) const noexcept {
+	return view().startsWith(prefix);
+}
+
+/*
+*/
+template <typename ValueType>
+bool MappedStringType<ValueType>::endsWith(ValueType character) const noexcept {
+	return view().endsWith(character);
+}
+
+/*
+*/
+template <typename ValueType>
+bool MappedStringType<ValueType>::endsWith(ConstPointer cstring) const noexcept {
+	return view().endsWith(cstring);
+}
+
+/*
+*/
+template <typename ValueType>
+bool MappedStringType<ValueType>::endsWith(ViewType suffix) const noexcept {
+	return view().endsWith(suffix);
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::SizeType MappedStringType<ValueType>::findFirstOf(ConstPointer set, SizeType position) const noexcept {
+	return view().findFirstOf(set, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::SizeType MappedStringType<ValueType>::findFirstOf(ViewType set, SizeType position) const noexcept {
+	return view().findFirstOf(set, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::SizeType MappedStringType<ValueType>::findFirstNotOf(ConstPointer set, SizeType position) const noexcept {
+	return view().findFirstNotOf(set, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::SizeType MappedStringType<ValueType>::findFirstNotOf(ViewType set, SizeType position) const noexcept {
+	return view().findFirstNotOf(set, position);
+}
+
+
+// Split Functions
+
+/*
+	Lines of a mapped log, for example, are split(ValueType('\n')); the pieces point into the mapping.
+*/
+template <typename ValueType>
+SplitRange<ValueType> MappedStringType<ValueType>::split(ValueType delimiter) const noexcept {
+	return view().split(delimiter);
+}
+
+/*
+*/
+template <typename ValueType>
+SplitRange<ValueType> MappedStringType<ValueType>::split(ViewType delimiter) const noexcept {
+	return view().split(delimiter);
+}
+
+/*
+*/
+template <typename ValueType>
+SplitRange<ValueType> MappedStringType<ValueType>::splitAny(ViewType set) const noexcept {
+	return view().splitAny(set);
+}
+
+
+// Hash Functions
+
+/*
+	Same value as the hash of a view of this string.
+*/
+template <typename ValueType>
+typename MappedStringType<ValueType>::SizeType MappedStringType<ValueType>::hash() const noexcept {
+	return view().hash();
+}
+
+
+// Default Alias
+
+using MappedString = MappedStringType<char>;
+
+}
+
+
+#endif // SIMPLE_MAPPED_STRING_HPP
@@ -0,0 +1,658 @@
+#pragma once
+#ifndef SIMPLE_ROPE_HPP
+#define SIMPLE_ROPE_HPP
+
+
+#include "SimpleString.hpp"
+
+#include <algorithm>
+#include <ios>
+#include <memory>
+#include <ostream>
+#include <utility>
+
+#include <cassert>
+#include <cstddef>
+
+
+
+namespace simple {
+
+
+/*
+	Sequence of characters stored as a balanced binary tree of string leaves, for large texts that are edited
+	in the middle or assembled from many pieces. Insertion, erasure, concatenation and substring take
+	O(log n) node operations plus O(LEAF_CAPACITY) character copies, independent of the total length.
+	Characters are never gathered into one buffer until flatten() is called; forEachChunk() visits the leaves in
+	order, so the text can be written out without that copy.
+
+	Nodes are immutable and shared between ropes: copying a rope copies one pointer, and an edit builds
+	new nodes along the paths it touches only. A rope is either unchanged or fully edited when an
+	allocation throws. Random access with operator[] walks the tree and is O(log n).
+*/
+template <typename CharType>
+class RopeType {
+public:
+
+	// Type Aliases
+
+	using ValueType = CharType;
+	using SizeType = std::size_t;
+
+	using DifferenceType = std::ptrdiff_t;
+
+	using ConstReference = const ValueType &;
+	using ConstPointer = const ValueType *;
+
+	using StorageType = StringType<ValueType>;
+	using ViewType = StringViewType<ValueType>;
+
+	// Constants
+
+	// Most characters stored in one leaf. Leaves hold up to a page, which bounds the copy made by an edit.
+	static constexpr SizeType LEAF_CAPACITY = 4096 / sizeof(ValueType) - 1;
+
+private:
+
+	// Node Types
+
+	struct Node;
+
+	using NodePointer = std::shared_ptr<const Node>;
+
+	/*
+		A leaf holds text and has no children, an inner node has both children and no text.
+		size counts the characters below the node and height is zero for leaves.
+	*/
+	struct Node {
+		NodePointer left;
+		NodePointer right;
+		StorageType text;
+		SizeType size;
+		unsigned height;
+	};
+
+	// Data Members
+
+	NodePointer m_root;
+
+	// Node Functions
+
+	static NodePointer makeLeaf(StorageType &&);
+	static NodePointer makeNode(NodePointer, NodePointer);
+	static NodePointer makeTree(ViewType);
+
+	static unsigned height(const NodePointer &) noexcept;
+	static NodePointer balance(NodePointer, NodePointer);
+	static NodePointer join(NodePointer, NodePointer);
+	static std::pair<NodePointer, NodePointer> split(const NodePointer &, SizeType);
+	static NodePointer replaceInLeaf(const NodePointer &, SizeType, SizeType, ViewType);
+
+	template <typename Function>
+	static void visit(const Node &, Function &);
+
+	// Constructors
+
+	explicit RopeType(NodePointer) noexcept;
+
+public:
+
+	// Constructors
+
+	RopeType() noexcept = default;
+	explicit RopeType(ConstPointer);
+	explicit RopeType(ViewType);
+	explicit RopeType(const StorageType &);
+	explicit RopeType(StorageType &&);
+
+	// Size Functions
+
+	SizeType size() const noexcept;
+	bool empty() const noexcept;
+
+	// Data Access Functions
+
+	ConstReference operator[](SizeType) const noexcept;
+
+	// Mutation Functions
+
+	void clear() noexcept;
+
+	void insert(ViewType, SizeType = 0);
+	void insert(const RopeType &, SizeType = 0);
+
+	void erase(SizeType, SizeType);
+
+	RopeType &operator+=(ViewType);
+	RopeType &operator+=(const RopeType &);
+
+	RopeType substring(SizeType, SizeType) const;
+
+	// Conversion Functions
+
+	StorageType flatten() const;
+
+	// Chunk Functions
+
+	template <typename Function>
+	void forEachChunk(Function) const;
+
+	// Mutation Operations
+
+	template <typename ValueType>
+	friend RopeType<ValueType> operator+(const RopeType<ValueType> &, const RopeType<ValueType> &);
+};
+
+
+// Constants
+
+template <typename ValueType>
+constexpr typename RopeType<ValueType>::SizeType RopeType<ValueType>::LEAF_CAPACITY;
+
+
+// Node Functions
+
+/*
+*/
+template <typename ValueType>
+typename RopeType<ValueType>::NodePointer RopeType<ValueType>::makeLeaf(StorageType &&text) {
+
+	assert(text.size() != 0);
+	assert(text.size() <= LEAF_CAPACITY);
+
+	SizeType size = text.size();
+
+	return std::make_shared<const Node>(Node{nullptr, nullptr, std::move(text), size, 0});
+}
+
+/*
+*/
+template <typename ValueType>
+typename RopeType<ValueType>::NodePointer RopeType<ValueType>::makeNode(NodePointer left, NodePointer right) {
+
+	assert(left != nullptr && right != nullptr);
+
+	SizeType size = left->size + right->size;
+	unsigned height = std::max(left->height, right->height) + 1;
+
+	return std::make_shared<const Node>(Node{std::move(left), std::move(right), StorageType{}, size, height});
+}
+
+/*
+	Balanced tree over full leaves of text, with any remainder in the last leaf.
+*/
+template <typename ValueType>
+typename RopeType<ValueType>::NodePointer RopeType<ValueType>::makeTree(ViewType text) {
+
+	if (text.empty()) {
+		return nullptr;
+	}
+
+	if (text.size() <= LEAF_CAPACITY) {
+		return makeLeaf(StorageType{text});
+	}
+
+	SizeType leaves = (text.size() + LEAF_CAPACITY - 1) / LEAF_CAPACITY;
+	SizeType middle = leaves / 2 * LEAF_CAPACITY;
+
+	return makeNode(makeTree(ViewType{text.data(), middle}), makeTree(ViewType{text.data() + middle, text.size() - middle}));
+}
+
+/*
+*/
+template <typename ValueType>
+unsigned RopeType<ValueType>::height(const NodePointer &node) noexcept {
+	return node != nullptr ? node->height : 0;
+}
+
+/*
+	Joins two trees whose heights differ by at most two into one AVL-balanced tree, rotating once or twice.
+*/
+template <typename ValueType>
+typename RopeType<ValueType>::NodePointer RopeType<ValueType>::balance(NodePointer left, NodePointer right) {
+
+	if (left->height > right->height + 1) {
+		if (height(left->left) >= height(left->right)) {
+			return makeNode(left->left, makeNode(left->right, std::move(right)));
+		}
+
+		const NodePointer &middle = left->right;
+		return makeNode(makeNode(left->left, middle->left), makeNode(middle->right, std::move(right)));
+	}
+
+	if (right->height > left->height + 1) {
+		if (height(right->right) >= height(right->left)) {
+			return makeNode(makeNode(std::move(left), right->left), right->right);
+		}
+
+		const NodePointer &middle = right->left;
+		return makeNode(makeNode(std::move(left), middle->left), makeNode(middle->right, right->right));
+	}
+
+	return makeNode(std::move(left), std::move(right));
+}
+
+/*
+	Concatenates two trees by descending the taller one's inner spine to the height of the other,
+	which takes O(difference in height) steps. A short leaf is carried all the way down to its neighbouring leaf
+	and merged with it when they fit in one, so repeated small edits do not fragment the text into tiny leaves.
+*/
+template <typename ValueType>
+typename RopeType<ValueType>::NodePointer RopeType<ValueType>::join(NodePointer left, NodePointer right) {
+
+	if (left == nullptr) {
+		return right;
+	}
+
+	if (right == nullptr) {
+		return left;
+	}
+
+	if (left->height == 0 && right->height == 0 && left->size + right->size <= LEAF_CAPACITY) {
+		StorageType text;
+		text.reserve(left->size + right->size);
+
+		text += ViewType{left->text};
+		text += ViewType{right->text};
+
+		return makeLeaf(std::move(text));
+	}
+
+	bool shortRight = right->height == 0 && right->size <= LEAF_CAPACITY / 2;
+	bool shortLeft = left->height == 0 && left->size <= LEAF_CAPACITY / 2;
+
+	if (left->height > right->height + 1 || (shortRight && left->height != 0)) {
+		return balance(left->left, join(left->right, std::move(right)));
+	}
+
+	if (right->height > left->height + 1 || (shortLeft && right->height != 0)) {
+		return balance(join(std::move(left), right->left), right->right);
+	}
+
+	return makeNode(std::move(left), std::move(right));
+}
+
+/*
+	Splits a tree into the characters before index and those from index on. The pieces on each side are joined
+	back together on the way up; their heights increase along the path, so the joins cost O(log n) in total.
+*/
+template <typename ValueType>
+std::pair<typename RopeType<ValueType>::NodePointer, typename RopeType<ValueType>::NodePointer> RopeType<ValueType>::split(const NodePointer &node, SizeType index) {
+
+	if (index == 0) {
+		return {nullptr, node};
+	}
+
+	if (index == node->size) {
+		return {node, nullptr};
+	}
+
+	if (node->height == 0) {
+		return {makeLeaf(node->text.substring(index)), makeLeaf(node->text.substring(index, node->size))};
+	}
+
+	SizeType leftSize = node->left->size;
+
+	if (index < leftSize) {
+		auto pieces = split(node->left, index);
+		return {std::move(pieces.first), join(std::move(pieces.second), node->right)};
+	}
+
+	if (index > leftSize) {
+		auto pieces = split(node->right, index - leftSize);
+		return {join(node->left, std::move(pieces.first)), std::move(pieces.second)};
+	}
+
+	return {node->left, node->right};
+}
+
+/*
+	Replaces the characters from first to last with text when they all lie in one leaf and the result fits in it,
+	copying that leaf and the nodes above it only. Returns null, leaving the split and join path to the caller,
+	when the range crosses leaves or the leaf would end up empty or too long.
+*/
+template <typename ValueType>
+typename RopeType<ValueType>::NodePointer RopeType<ValueType>::replaceInLeaf(const NodePointer &node, SizeType first, SizeType last, ViewType text) {
+
+	if (node->height == 0) {
+		SizeType size = node->size - (last - first) + text.size();
+
+		if (size == 0 || size > LEAF_CAPACITY) {
+			return nullptr;
+		}
+
+		const ValueType *data = node->text.data();
+
+		StorageType result;
+		result.reserve(size);
+
+		result += ViewType{data, first};
+		result += text;
+		result += ViewType{data + last, node->size - last};
+
+		return makeLeaf(std::move(result));
+	}
+
+	SizeType leftSize = node->left->size;
+
+	if (last <= leftSize) {
+		NodePointer left = replaceInLeaf(node->left, first, last, text);
+		return left != nullptr ? makeNode(std::move(left), node->right) : nullptr;
+	}
+
+	if (first >= leftSize) {
+		NodePointer right = replaceInLeaf(node->right, first - leftSize, last - leftSize, text);
+		return right != nullptr ? makeNode(node->left, std::move(right)) : nullptr;
+	}
+
+	return nullptr;
+}
+
+/*
+*/
+template <typename ValueType>
+template <typename Function>
+void RopeType<ValueType>::visit(const Node &node, Function &function) {
+
+	if (node.height == 0) {
+		function(ViewType{node.text});
+		return;
+	}
+
+	visit(*node.left, function);
+	visit(*node.right, function);
+}
+
+
+// Constructors
+
+/*
+*/
+template <typename ValueType>
+RopeType<ValueType>::RopeType(NodePointer root) noexcept :
+	m_root{std::move(root)} {}
+
+/*
+*/
+template <typename ValueType>
+RopeType<ValueType>::RopeType(ConstPointer cstring) :
+	m_root{makeTree(ViewType{cstring})} {}
+
+/*
+*/
+template <typename ValueType>
+RopeType<ValueType>::RopeType(ViewType view) :
+	m_root{makeTree(view)} {}
+
+/*
+*/
+template <typename ValueType>
+RopeType<ValueType>::RopeType(const StorageType &object) :
+	m_root{makeTree(ViewType{object})} {}
+
+/*
+	Adopts the buffer as the only leaf if it is short enough, otherwise copies it into leaves.
+*/
+template <typename ValueType>
+RopeType<ValueType>::RopeType(StorageType &&object) :
+	m_root{object.size() != 0 && object.size() <= LEAF_CAPACITY ? makeLeaf(std::move(object)) : makeTree(ViewType{object})} {}
+
+
+// Size Functions
+
+/*
+*/
+template <typename ValueType>
+typename RopeType<ValueType>::SizeType RopeType<ValueType>::size() const noexcept {
+	return m_root != nullptr ? m_root->size : 0;
+}
+
+/*
+*/
+template <typename ValueType>
+bool RopeType<ValueType>::empty() const noexcept {
+	return m_root == nullptr;
+}
+
+
+// Data Access Functions
+
+/*
+*/
+template <typename ValueType>
+typename RopeType<ValueType>::ConstReference RopeType<ValueType>::operator[](SizeType index) const noexcept {
+
+	assert(index < size());
+
+	const Node *node = m_root.get();
+
+	while (node->height != 0) {
+		if (index < node->left->size) {
+			node = node->left.get();
+		}
+		else {
+			index -= node->left->size;
+			node = node->right.get();
+		}
+	}
+
+	return node->text[index];
+}
+
+
+// Mutation Functions
+
+/*
+*/
+template <typename ValueType>
+void RopeType<ValueType>::clear() noexcept {
+	m_root.reset();
+}
+
+/*
+*/
+template <typename ValueType>
+void RopeType<ValueType>::insert(ViewType view, SizeType index) {
+
+	assert(index <= size());
+
+	if (view.empty()) {
+		return;
+	}
+
+	if (m_root != nullptr && view.size() <= LEAF_CAPACITY) {
+		NodePointer root = replaceInLeaf(m_root, index, index, view);
+
+		if (root != nullptr) {
+			m_root = std::move(root);
+			return;
+		}
+	}
+
+	insert(RopeType{view}, index);
+}
+
+/*
+*/
+template <typename ValueType>
+void RopeType<ValueType>::insert(const RopeType &object, SizeType index) {
+
+	assert(index <= size());
+
+	if (object.empty()) {
+		return;
+	}
+
+	if (empty()) {
+		m_root = object.m_root;
+		return;
+	}
+
+	auto pieces = split(m_root, index);
+
+	m_root = join(join(std::move(pieces.first), object.m_root), std::move(pieces.second));
+}
+
+/*
+	Removes the characters from first up to, but not including, last. An empty range removes nothing.
+*/
+template <typename ValueType>
+void RopeType<ValueType>::erase(SizeType first, SizeType last) {
+
+	assert(first <= last);
+	assert(last <= size());
+
+	if (first == last) {
+		return;
+	}
+
+	NodePointer root = replaceInLeaf(m_root, first, last, ViewType{});
+
+	if (root != nullptr) {
+		m_root = std::move(root);
+		return;
+	}
+
+	auto tail = split(m_root, last);
+	auto head = split(tail.first, first);
+
+	m_root = join(std::move(head.first), std::move(tail.second));
+}
+
+/*
+*/
+template <typename ValueType>
+RopeType<ValueType> &RopeType<ValueType>::operator+=(ViewType view) {
+
+	if (!view.empty()) {
+		m_root = join(m_root, makeTree(view));
+	}
+
+	return *this;
+}
+
+/*
+*/
+template <typename ValueType>
+RopeType<ValueType> &RopeType<ValueType>::operator+=(const RopeType &object) {
+
+	m_root = join(m_root, object.m_root);
+
+	return *this;
+}
+
+/*
+	Shares every leaf strictly inside the range with this rope; only the two boundary leaves are copied.
+	An empty range gives an empty rope.
+*/
+template <typename ValueType>
+RopeType<ValueType> RopeType<ValueType>::substring(SizeType first, SizeType last) const {
+
+	assert(first <= last);
+	assert(last <= size());
+
+	if (first == last) {
+		return RopeType{};
+	}
+
+	return RopeType{split(split(m_root, last).first, first).second};
+}
+
+
+// Conversion Functions
+
+/*
+	Gathers the leaves into one string, allocating once.
+*/
+template <typename ValueType>
+typename RopeType<ValueType>::StorageType RopeType<ValueType>::flatten() const {
+
+	StorageType result;
+	result.reserve(size());
+
+	forEachChunk([&result](ViewType chunk) {
+		result += chunk;
+	});
+
+	return result;
+}
+
+
+// Chunk Functions
+
+/*
+	Calls function with a view of each leaf, in order. The views stay valid while any rope shares the leaves.
+*/
+template <typename ValueType>
+template <typename Function>
+void RopeType<ValueType>::forEachChunk(Function function) const {
+	if (m_root != nullptr) {
+		visit(*m_root, function);
+	}
+}
+
+
+// Mutation Operations
+
+/*
+*/
+template <typename ValueType>
+RopeType<ValueType> operator+(const RopeType<ValueType> &left, const RopeType<ValueType> &right) {
+	return RopeType<ValueType>{RopeType<ValueType>::join(left.m_root, right.m_root)};
+}
+
+
+// Output Stream Operations
+
+/*
+	Writes the leaves one after another without flattening, padded as a single field.
+*/
+template <typename ValueType, typename Traits>
+std::basic_ostream<ValueType, Traits> &operator<<(std::basic_ostream<ValueType, Traits> &os, const RopeType<ValueType> &object) {
+
+	typename std::basic_ostream<ValueType, Traits>::sentry sentry{os};
+
+	if (!sentry) {
+		return os;
+	}
+
+	std::streamsize padding = std::max<std::streamsize>(os.width() - static_cast<std::streamsize>(object.size()), 0);
+	bool left = (os.flags() & std::ios_base::adjustfield) == std::ios_base::left;
+
+	bool good = true;
+
+	try {
+		if (padding != 0 && !left) {
+			good = detail::writeFill(os, padding);
+		}
+
+		object.forEachChunk([&os, &good](StringViewType<ValueType> chunk) {
+			std::streamsize count = static_cast<std::streamsize>(chunk.size());
+			good = good && os.rdbuf()->sputn(chunk.data(), count) == count;
+		});
+
+		if (good && padding != 0 && left) {
+			good = detail::writeFill(os, padding);
+		}
+	} catch (...) {
+		good = false;
+	}
+
+	os.width(0);
+
+	if (!good) {
+		os.setstate(std::ios_base::badbit);
+	}
+
+	return os;
+}
+
+
+// Default Alias
+
+using Rope = RopeType<char>;
+
+}
+
+
+#endif // SIMPLE_ROPE_HPP
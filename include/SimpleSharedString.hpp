@@ -0,0 +1,752 @@
+#pragma once
+#ifndef SIMPLE_SHARED_STRING_HPP
+#define SIMPLE_SHARED_STRING_HPP
+
+
+#include "SimpleString.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <utility>
+
+#include <cassert>
+#include <cstddef>
+
+
+
+namespace simple {
+
+
+/*
+	String whose copies share one buffer until one of them is modified (copy-on-write).
+	Copying and assigning only adjust an atomic reference count, so a large payload handed to many readers
+	is never duplicated; the first mutation through a shared copy detaches it onto a buffer of its own.
+	Copies may be used from different threads, as with std::shared_ptr; one object is not safe to mutate concurrently.
+	Mutable references from operator[], front() and back() stay tied to their copy: once one has been handed out,
+	the buffer is no longer shared by later copies, which take a private copy instead.
+*/
+template <typename CharType, typename Allocator = std::allocator<CharType>>
+class SharedStringType : private Allocator {
+public:
+
+	// Type Aliases
+
+	using ValueType = CharType;
+	using SizeType = std::size_t;
+
+	using AllocatorType = Allocator;
+
+	using Reference = ValueType &;
+	using ConstReference = const ValueType &;
+
+	using ConstPointer = const ValueType *;
+
+	using ConstIterator = ConstPointer;
+
+	using StorageType = StringType<ValueType, AllocatorType>;
+	using ViewType = StringViewType<ValueType>;
+
+private:
+
+	// Node Types
+
+	// One allocation per distinct buffer, holding the count of SharedStringTypes that refer to it.
+	struct Node {
+		std::atomic<SizeType> references;
+		bool shareable;
+		StorageType string;
+
+		explicit Node(StorageType &&string) noexcept :
+			references{1}, shareable{true}, string{std::move(string)} {}
+	};
+
+	using AllocatorTraits = std::allocator_traits<Allocator>;
+	using NodeAllocator = typename AllocatorTraits::template rebind_alloc<Node>;
+	using NodeAllocatorTraits = std::allocator_traits<NodeAllocator>;
+
+	// Constants
+
+	static constexpr ValueType NUL_TERMINATION = '\0';
+
+	// Data Members
+
+	// Null for an empty string that has never been modified.
+	Node *m_node{};
+
+	// Storage Functions
+
+	AllocatorType &allocatorReference() noexcept;
+	const AllocatorType &allocatorReference() const noexcept;
+
+	static Node *makeNode(StorageType &&);
+	static Node *share(Node *);
+	static void release(Node *) noexcept;
+
+	StorageType &mutableString();
+
+public:
+
+	// Constructors
+
+	SharedStringType() noexcept(noexcept(AllocatorType()));
+	explicit SharedStringType(const AllocatorType &) noexcept;
+	SharedStringType(ConstPointer, const AllocatorType & = AllocatorType());
+	explicit SharedStringType(ViewType, const AllocatorType & = AllocatorType());
+	SharedStringType(const StorageType &);
+	SharedStringType(StorageType &&);
+	SharedStringType(const SharedStringType &);
+	SharedStringType(SharedStringType &&) noexcept;
+
+	// Destructor
+
+	~SharedStringType() noexcept;
+
+	// Assignment Operations
+
+	SharedStringType &operator=(const SharedStringType &);
+	SharedStringType &operator=(SharedStringType &&) noexcept;
+
+	// Conversion Operations
+
+	operator ViewType() const noexcept;
+
+	// Allocator Functions
+
+	AllocatorType allocator() const noexcept;
+
+	// Sharing Functions
+
+	SizeType useCount() const noexcept;
+	bool unique() const noexcept;
+
+	// Size Functions
+
+	SizeType size() const noexcept;
+	bool empty() const noexcept;
+
+	// Data Access Functions
+
+	ConstPointer data() const noexcept;
+	ConstPointer cstring() const noexcept;
+
+	ConstReference operator[](SizeType) const noexcept;
+	Reference operator[](SizeType);
+
+	ConstReference front() const noexcept;
+	Reference front();
+	ConstReference back() const noexcept;
+	Reference back();
+
+	StorageType string() const &;
+	StorageType string() &&;
+
+	// Iterator Functions
+
+	ConstIterator begin() const noexcept;
+	ConstIterator end() const noexcept;
+
+	// Mutation Functions
+
+	void clear() noexcept;
+
+	void popback(SizeType = 1);
+
+	void erase(SizeType);
+	void erase(SizeType, SizeType);
+
+	void insert(ValueType, SizeType = 0);
+	void insert(ConstPointer, SizeType = 0);
+	void insert(ViewType, SizeType = 0);
+
+	void replace(SizeType, SizeType, ViewType);
+	SizeType replaceAll(ViewType, ViewType);
+
+	SharedStringType &operator+=(ValueType);
+	SharedStringType &operator+=(ConstPointer);
+	SharedStringType &operator+=(ViewType);
+
+	SharedStringType substring(SizeType, SizeType) const;
+
+	// Hash Functions
+
+	SizeType hash() const noexcept;
+};
+
+
+// Constants
+
+template <typename ValueType, typename AllocatorType>
+constexpr typename SharedStringType<ValueType, AllocatorType>::ValueType SharedStringType<ValueType, AllocatorType>::NUL_TERMINATION;
+
+
+// Storage Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+AllocatorType &SharedStringType<ValueType, AllocatorType>::allocatorReference() noexcept {
+	return *this;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+const AllocatorType &SharedStringType<ValueType, AllocatorType>::allocatorReference() const noexcept {
+	return *this;
+}
+
+/*
+	Moves string into a new node with a single reference, allocated with the string's own allocator.
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::Node *SharedStringType<ValueType, AllocatorType>::makeNode(StorageType &&string) {
+
+	NodeAllocator allocator{string.allocator()};
+
+	Node *node = NodeAllocatorTraits::allocate(allocator, 1);
+	NodeAllocatorTraits::construct(allocator, node, std::move(string));
+
+	return node;
+}
+
+/*
+	Adds a reference to node, unless mutable references into it have been handed out:
+	then the caller gets a private copy, so writes through those references stay with their owner.
+	The increment can be relaxed; whoever passes node along already holds a reference that keeps it alive.
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::Node *SharedStringType<ValueType, AllocatorType>::share(Node *node) {
+
+	if (node == nullptr) {
+		return nullptr;
+	}
+
+	if (!node->shareable) {
+		return makeNode(StorageType{node->string});
+	}
+
+	node->references.fetch_add(1, std::memory_order_relaxed);
+
+	return node;
+}
+
+/*
+	Drops a reference and frees node with the last one. The node's own string supplies the allocator,
+	so it is freed the way it was allocated whichever copy happens to release it last.
+*/
+template <typename ValueType, typename AllocatorType>
+void SharedStringType<ValueType, AllocatorType>::release(Node *node) noexcept {
+
+	if (node == nullptr || node->references.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+		return;
+	}
+
+	NodeAllocator allocator{node->string.allocator()};
+
+	NodeAllocatorTraits::destroy(allocator, node);
+	NodeAllocatorTraits::deallocate(allocator, node, 1);
+}
+
+/*
+	The string this object may modify: a new empty one if there is none, or a private copy if the buffer is shared.
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::StorageType &SharedStringType<ValueType, AllocatorType>::mutableString() {
+
+	if (m_node == nullptr) {
+		m_node = makeNode(StorageType{allocatorReference()});
+	}
+	else if (m_node->references.load(std::memory_order_acquire) != 1) {
+		Node *node = makeNode(StorageType{m_node->string, allocatorReference()});
+
+		release(m_node);
+		m_node = node;
+	}
+
+	return m_node->string;
+}
+
+
+// Constructors
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType>::SharedStringType() noexcept(noexcept(AllocatorType())) :
+	AllocatorType{} {}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType>::SharedStringType(const AllocatorType &allocator) noexcept :
+	AllocatorType{allocator} {}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType>::SharedStringType(ConstPointer cstring, const AllocatorType &allocator) :
+	AllocatorType{allocator}, m_node{makeNode(StorageType{cstring, allocator})} {}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType>::SharedStringType(ViewType view, const AllocatorType &allocator) :
+	AllocatorType{allocator}, m_node{makeNode(StorageType{view, allocator})} {}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType>::SharedStringType(const StorageType &string) :
+	AllocatorType{string.allocator()}, m_node{makeNode(StorageType{string})} {}
+
+/*
+	Takes over the buffer of string without copying its characters.
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType>::SharedStringType(StorageType &&string) :
+	AllocatorType{string.allocator()}, m_node{makeNode(std::move(string))} {}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType>::SharedStringType(const SharedStringType &object) :
+	AllocatorType{AllocatorTraits::select_on_container_copy_construction(object.allocatorReference())}, m_node{share(object.m_node)} {}
+
+/*
+	Leaves object empty.
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType>::SharedStringType(SharedStringType &&object) noexcept :
+	AllocatorType{object.allocatorReference()}, m_node{object.m_node} {
+
+	object.m_node = nullptr;
+}
+
+
+// Destructor
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType>::~SharedStringType() noexcept {
+	release(m_node);
+}
+
+
+// Assignment Operations
+
+/*
+	Shares the buffer of object; the allocator is not replaced, since every node frees itself with its own.
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType> &SharedStringType<ValueType, AllocatorType>::operator=(const SharedStringType &object) {
+
+	Node *node = share(object.m_node);
+
+	release(m_node);
+	m_node = node;
+
+	return *this;
+}
+
+/*
+	Leaves object empty.
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType> &SharedStringType<ValueType, AllocatorType>::operator=(SharedStringType &&object) noexcept {
+
+	if (this != &object) {
+		release(m_node);
+
+		m_node = object.m_node;
+		object.m_node = nullptr;
+	}
+
+	return *this;
+}
+
+
+// Conversion Operations
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType>::operator ViewType() const noexcept {
+	return ViewType{data(), size()};
+}
+
+
+// Allocator Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+AllocatorType SharedStringType<ValueType, AllocatorType>::allocator() const noexcept {
+	return allocatorReference();
+}
+
+
+// Sharing Functions
+
+/*
+	Number of SharedStringTypes sharing this buffer, including this one; zero when there is no buffer.
+	Only a snapshot when other threads hold copies.
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::SizeType SharedStringType<ValueType, AllocatorType>::useCount() const noexcept {
+	return m_node != nullptr ? m_node->references.load(std::memory_order_acquire) : 0;
+}
+
+/*
+	Whether a mutation would modify the buffer in place rather than copy it first.
+*/
+template <typename ValueType, typename AllocatorType>
+bool SharedStringType<ValueType, AllocatorType>::unique() const noexcept {
+	return useCount() <= 1;
+}
+
+
+// Size Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::SizeType SharedStringType<ValueType, AllocatorType>::size() const noexcept {
+	return m_node != nullptr ? m_node->string.size() : 0;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+bool SharedStringType<ValueType, AllocatorType>::empty() const noexcept {
+	return size() == 0;
+}
+
+
+// Data Access Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::ConstPointer SharedStringType<ValueType, AllocatorType>::data() const noexcept {
+	return m_node != nullptr ? m_node->string.data() : &NUL_TERMINATION;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::ConstPointer SharedStringType<ValueType, AllocatorType>::cstring() const noexcept {
+	return data();
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::ConstReference SharedStringType<ValueType, AllocatorType>::operator[](SizeType index) const noexcept {
+
+	assert(index < size());
+
+	return data()[index];
+}
+
+/*
+	Detaches the buffer if it is shared, and keeps it from being shared again (see SharedStringType).
+	Call this on a const object, or through a const reference, to read without detaching.
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::Reference SharedStringType<ValueType, AllocatorType>::operator[](SizeType index) {
+
+	assert(index < size());
+
+	StorageType &string = mutableString();
+	m_node->shareable = false;
+
+	return string[index];
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::ConstReference SharedStringType<ValueType, AllocatorType>::front() const noexcept {
+	return (*this)[0];
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::Reference SharedStringType<ValueType, AllocatorType>::front() {
+	return (*this)[0];
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::ConstReference SharedStringType<ValueType, AllocatorType>::back() const noexcept {
+	return (*this)[size() - 1];
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::Reference SharedStringType<ValueType, AllocatorType>::back() {
+	return (*this)[size() - 1];
+}
+
+/*
+	A copy of the characters as an ordinary string.
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::StorageType SharedStringType<ValueType, AllocatorType>::string() const & {
+	return m_node != nullptr ? StorageType{m_node->string} : StorageType{allocatorReference()};
+}
+
+/*
+	Moves the buffer out when nothing else shares it, and copies it otherwise. Leaves this object empty.
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::StorageType SharedStringType<ValueType, AllocatorType>::string() && {
+
+	if (m_node == nullptr) {
+		return StorageType{allocatorReference()};
+	}
+
+	StorageType result = m_node->references.load(std::memory_order_acquire) == 1 ? std::move(m_node->string) : StorageType{m_node->string};
+
+	release(m_node);
+	m_node = nullptr;
+
+	return result;
+}
+
+
+// Iterator Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::ConstIterator SharedStringType<ValueType, AllocatorType>::begin() const noexcept {
+	return data();
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::ConstIterator SharedStringType<ValueType, AllocatorType>::end() const noexcept {
+	return data() + size();
+}
+
+
+// Mutation Functions
+
+/*
+	Drops this object's reference rather than clearing a buffer other copies may still be reading.
+*/
+template <typename ValueType, typename AllocatorType>
+void SharedStringType<ValueType, AllocatorType>::clear() noexcept {
+	release(m_node);
+	m_node = nullptr;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+void SharedStringType<ValueType, AllocatorType>::popback(SizeType count) {
+	mutableString().popback(count);
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+void SharedStringType<ValueType, AllocatorType>::erase(SizeType index) {
+	mutableString().erase(index);
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+void SharedStringType<ValueType, AllocatorType>::erase(SizeType first, SizeType last) {
+	mutableString().erase(first, last);
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+void SharedStringType<ValueType, AllocatorType>::insert(ValueType character, SizeType index) {
+	mutableString().insert(character, index);
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+void SharedStringType<ValueType, AllocatorType>::insert(ConstPointer cstring, SizeType index) {
+	mutableString().insert(cstring, index);
+}
+
+/*
+	An empty replace() inserts, and StringType::replace() copies view first only when it points into the
+	unshared buffer; a view of a shared buffer stays valid across the detach, as for operator+=.
+*/
+template <typename ValueType, typename AllocatorType>
+void SharedStringType<ValueType, AllocatorType>::insert(ViewType view, SizeType index) {
+
+	assert(index < size());
+
+	mutableString().replace(index, index, view);
+}
+
+/*
+	with may view this string's buffer: StringType::replace() copies it first when it does.
+*/
+template <typename ValueType, typename AllocatorType>
+void SharedStringType<ValueType, AllocatorType>::replace(SizeType first, SizeType last, ViewType with) {
+	mutableString().replace(first, last, with);
+}
+
+/*
+	Detaches only when there is something to replace, so a shared buffer without matches stays shared.
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::SizeType SharedStringType<ValueType, AllocatorType>::replaceAll(ViewType needle, ViewType replacement) {
+
+	if (ViewType{*this}.find(needle) == ViewType::NOT_FOUND) {
+		return 0;
+	}
+
+	return mutableString().replaceAll(needle, replacement);
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType> &SharedStringType<ValueType, AllocatorType>::operator+=(ValueType character) {
+
+	mutableString() += character;
+
+	return *this;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType> &SharedStringType<ValueType, AllocatorType>::operator+=(ConstPointer cstring) {
+
+	mutableString() += cstring;
+
+	return *this;
+}
+
+/*
+	A view of a shared buffer stays valid across the detach, since the old buffer is only released afterwards
+	if another copy still holds it; a view of an unshared buffer is handled by StringType itself.
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType> &SharedStringType<ValueType, AllocatorType>::operator+=(ViewType view) {
+
+	mutableString() += view;
+
+	return *this;
+}
+
+/*
+	Characters [first, last) as a new, unshared string.
+*/
+template <typename ValueType, typename AllocatorType>
+SharedStringType<ValueType, AllocatorType> SharedStringType<ValueType, AllocatorType>::substring(SizeType first, SizeType last) const {
+
+	assert(first <= last && last <= size());
+
+	return SharedStringType{ViewType{data() + first, last - first}, allocatorReference()};
+}
+
+
+// Hash Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename SharedStringType<ValueType, AllocatorType>::SizeType SharedStringType<ValueType, AllocatorType>::hash() const noexcept {
+	return ViewType{*this}.hash();
+}
+
+
+// Comparison Operations
+
+/*
+	Copies sharing a buffer are equal without comparing characters.
+*/
+template <typename ValueType, typename AllocatorType>
+bool operator==(const SharedStringType<ValueType, AllocatorType> &left, const SharedStringType<ValueType, AllocatorType> &right) noexcept {
+	return left.data() == right.data() ? left.size() == right.size() : StringViewType<ValueType>{left} == StringViewType<ValueType>{right};
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+bool operator==(const SharedStringType<ValueType, AllocatorType> &left, const ValueType *right) noexcept {
+	return StringViewType<ValueType>{left} == StringViewType<ValueType>{right};
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+bool operator==(const ValueType *left, const SharedStringType<ValueType, AllocatorType> &right) noexcept {
+	return right == left;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+bool operator!=(const SharedStringType<ValueType, AllocatorType> &left, const SharedStringType<ValueType, AllocatorType> &right) noexcept {
+	return !(left == right);
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+bool operator!=(const SharedStringType<ValueType, AllocatorType> &left, const ValueType *right) noexcept {
+	return !(left == right);
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+bool operator!=(const ValueType *left, const SharedStringType<ValueType, AllocatorType> &right) noexcept {
+	return !(left == right);
+}
+
+
+// Output Stream Operations
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename Traits>
+std::basic_ostream<ValueType, Traits> &operator<<(std::basic_ostream<ValueType, Traits> &os, const SharedStringType<ValueType, AllocatorType> &object) {
+	return os << StringViewType<ValueType>{object};
+}
+
+
+// Default Alias
+
+using SharedString = SharedStringType<char>;
+
+}
+
+
+namespace std {
+
+/*
+	Same value as std::hash of a String or StringView with the same characters.
+*/
+template <typename CharType, typename Allocator>
+struct hash<simple::SharedStringType<CharType, Allocator>> {
+	std::size_t operator()(const simple::SharedStringType<CharType, Allocator> &object) const noexcept {
+		return object.hash();
+	}
+};
+
+}
+
+
+#endif // SIMPLE_SHARED_STRING_HPP
@@ -5,14 +5,27 @@
 
 
 #include <algorithm>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <new>
 #include <iostream>
+#include <type_traits>
 #include <utility>
 
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+
+#include "SimpleStringCase.hpp"
+#include "SimpleStringConcat.hpp"
+#include "SimpleStringGrowth.hpp"
+#include "SimpleStringKernels.hpp"
+#include "SimpleStringSearch.hpp"
+#include "SimpleStringStats.hpp"
+#include "SimpleStringView.hpp"
 
 
 #if defined(_MSC_VER)
@@ -36,8 +49,29 @@
 namespace simple {
 
 
-template <typename CharType>
-class StringType {
+// Forward Declarations
+
+template <typename CharType, typename Allocator>
+class StringBuilderType;
+
+namespace detail {
+
+template <typename StorageType>
+struct Transcoder;
+
+template <typename StorageType>
+struct ParallelReplacer;
+
+}
+
+
+/*
+	Allocator is held as an empty base where possible, so stateless allocators add nothing to the object size.
+	It must allocate plain CharType pointers and may not be a final class.
+	GrowthPolicy sizes every new buffer (see SimpleStringGrowth.hpp).
+*/
+template <typename CharType, typename Allocator = std::allocator<CharType>, typename GrowthPolicy = PowerOfTwoGrowth>
+class StringType : private Allocator {
 public:
 
 	// Type Aliases
@@ -45,6 +79,9 @@ public:
 	using ValueType = CharType;
 	using SizeType = std::size_t;
 
+	using AllocatorType = Allocator;
+	using GrowthPolicyType = GrowthPolicy;
+
 	using DifferenceType = std::ptrdiff_t;
 
 	using Reference = ValueType &;
@@ -53,38 +90,125 @@ public:
 	using Pointer = ValueType *;
 	using ConstPointer = const ValueType *;
 
+	// Iterators are plain pointers, so standard algorithms take their memmove and memcmp paths.
+	using Iterator = Pointer;
+	using ConstIterator = ConstPointer;
+	using ReverseIterator = std::reverse_iterator<Iterator>;
+	using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+	using ViewType = StringViewType<ValueType>;
+
+	// Constants
+
+	// Returned by the search functions when there is no match.
+	static constexpr SizeType NOT_FOUND = detail::NOT_FOUND;
 
 private:
 
-	// Data Members
+	// Allocator Aliases
 
-	Pointer m_data{};
-	SizeType m_size{};
-	SizeType m_capacity{};
+	using AllocatorTraits = std::allocator_traits<Allocator>;
+
+	static_assert(std::is_same<typename AllocatorTraits::value_type, ValueType>::value, "allocator must allocate CharType");
+	static_assert(std::is_same<typename AllocatorTraits::pointer, Pointer>::value, "allocator must use raw pointers");
 
 	// Constants
 
 	static constexpr ValueType NUL_TERMINATION = '\0';
 
+	static constexpr bool PROPAGATE_ON_COPY = AllocatorTraits::propagate_on_container_copy_assignment::value;
+	static constexpr bool PROPAGATE_ON_MOVE = AllocatorTraits::propagate_on_container_move_assignment::value;
+
+	// Stands in for std::allocator_traits::is_always_equal, which is not available before C++17.
+	static constexpr bool ALWAYS_EQUAL = std::is_empty<Allocator>::value;
+
+	// Number of characters (including the NUL termination) stored inline before a heap buffer is needed.
+	// The inline buffer overlays m_capacity, so short strings never allocate.
+	static constexpr SizeType LOCAL_CAPACITY = (2 * sizeof(SizeType)) / sizeof(ValueType);
+
+	static_assert(LOCAL_CAPACITY >= 2, "inline buffer must hold at least one character");
+
+	// Data Members
+
+	Pointer m_data{m_local};
+	SizeType m_size{};
+
+	union {
+		SizeType m_capacity;
+		ValueType m_local[LOCAL_CAPACITY]{};
+	};
+
 	// Utility Functions
 
-	static SizeType lookupCapacity(SizeType) noexcept;
+	static SizeType lookupCapacity(SizeType, SizeType = 0) noexcept;
 	static SizeType cstringSize(ConstPointer) noexcept;
 
+	template <typename Left, typename Right>
+	static StringType concatenate(const ConcatExpression<StringType, Left, Right> &, StringType *);
+
+	template <typename FloatType>
+	StringType &appendFloatingPoint(FloatType);
+
+	static Pointer replaceMatches(Pointer, ConstPointer, SizeType, ViewType, ViewType, SizeType &) noexcept;
+
+	bool overlaps(ViewType) const noexcept;
+
+	// Storage Functions
+
+	AllocatorType &allocatorReference() noexcept;
+	const AllocatorType &allocatorReference() const noexcept;
+
+	Pointer allocateStorage(SizeType, SizeType, AllocationCause);
+	void freeStorage(Pointer, SizeType) noexcept;
+
+	void propagateAllocator(const AllocatorType &, SizeType, std::true_type);
+	void propagateAllocator(const AllocatorType &, SizeType, std::false_type) noexcept;
+	void propagateAllocator(AllocatorType &&, std::true_type) noexcept;
+	void propagateAllocator(AllocatorType &&, std::false_type) noexcept;
+
+	bool isLocal() const noexcept;
+	void initialize(SizeType, AllocationCause = AllocationCause::CONSTRUCT);
+	void grow(SizeType, AllocationCause);
+	void replaceStorage(Pointer, SizeType) noexcept;
+	void resetLocal() noexcept;
+
 	// Constructors
 
-	StringType(Pointer, SizeType, SizeType) noexcept;
+	StringType(Pointer, SizeType, SizeType, const AllocatorType & = AllocatorType()) noexcept;
+
+	// Friend Classes
+
+	// Hands its result over through the adopting constructor.
+	template <typename, typename>
+	friend class StringBuilderType;
+
+	// Writes converted text straight into a buffer of the final size and hands it over the same way.
+	template <typename>
+	friend struct detail::Transcoder;
+
+	// Fills a buffer of the final size from several threads at once and hands it over the same way.
+	template <typename>
+	friend struct detail::ParallelReplacer;
 
 public:
 
 	// Constructors
 
-	StringType() noexcept;
-	explicit StringType(std::initializer_list<ValueType>);
-	StringType(ValueType, SizeType = 1);
-	StringType(ConstPointer);
+	StringType() noexcept(noexcept(AllocatorType()));
+	explicit StringType(const AllocatorType &) noexcept;
+	explicit StringType(std::initializer_list<ValueType>, const AllocatorType & = AllocatorType());
+	StringType(ValueType, SizeType = 1, const AllocatorType & = AllocatorType());
+	StringType(ConstPointer, const AllocatorType & = AllocatorType());
+	explicit StringType(ViewType, const AllocatorType & = AllocatorType());
 	StringType(const StringType &);
+	StringType(const StringType &, const AllocatorType &);
 	StringType(StringType &&) noexcept;
+	StringType(StringType &&, const AllocatorType &);
+
+	template <typename Left, typename Right>
+	StringType(const ConcatExpression<StringType, Left, Right> &);
+	template <typename Left, typename Right>
+	StringType(ConcatExpression<StringType, Left, Right> &&);
 
 	// Destructor
 
@@ -95,7 +219,15 @@ public:
 	StringType &operator=(ValueType);
 	StringType &operator=(ConstPointer);
 	StringType &operator=(const StringType &);
-	StringType &operator=(StringType &&) noexcept;
+	StringType &operator=(StringType &&) noexcept(PROPAGATE_ON_MOVE || ALWAYS_EQUAL);
+
+	// Conversion Operations
+
+	operator ViewType() const noexcept;
+
+	// Allocator Functions
+
+	AllocatorType allocator() const noexcept;
 
 	// Size Functions
 
@@ -122,6 +254,24 @@ public:
 	ConstReference back() const noexcept;
 	Reference back() noexcept;
 
+	// Iterator Functions
+
+	ConstIterator begin() const noexcept;
+	Iterator begin() noexcept;
+	ConstIterator end() const noexcept;
+	Iterator end() noexcept;
+
+	ConstIterator cbegin() const noexcept;
+	ConstIterator cend() const noexcept;
+
+	ConstReverseIterator rbegin() const noexcept;
+	ReverseIterator rbegin() noexcept;
+	ConstReverseIterator rend() const noexcept;
+	ReverseIterator rend() noexcept;
+
+	ConstReverseIterator crbegin() const noexcept;
+	ConstReverseIterator crend() const noexcept;
+
 	// Mutation Functions
 
 	void clear() noexcept;
@@ -137,550 +287,928 @@ public:
 	void insert(const StringType &, SizeType = 0);
 	void insert(StringType &&, SizeType = 0);
 
+	void replace(SizeType, SizeType, ViewType);
+	SizeType replaceAll(ViewType, ViewType);
+
 	StringType &operator+=(ValueType);
 	StringType &operator+=(ConstPointer);
 	StringType &operator+=(const StringType &);
 	StringType &operator+=(StringType &&);
+	StringType &operator+=(ViewType);
+
+	template <typename Left, typename Right>
+	StringType &operator+=(const ConcatExpression<StringType, Left, Right> &);
 
 	StringType substring(SizeType) const &;
 	StringType substring(SizeType, SizeType) const &;
 	StringType substring(SizeType) && noexcept;
 	StringType substring(SizeType, SizeType) && noexcept;
 
+	StringType toLower() const &;
+	StringType toLower() && noexcept;
+	StringType toUpper() const &;
+	StringType toUpper() && noexcept;
+
 	// Comparison Functions
 
 	int compare(ConstPointer) const noexcept;
-	int compare(const StringType &) const noexcept;
-
-	// Mutation Operations
-
-	template <typename ValueType>
-	friend StringType<ValueType> operator+(const StringType<ValueType> &, const StringType<ValueType> &);
-	template <typename ValueType>
-	friend StringType<ValueType> operator+(const StringType<ValueType> &, ConstPointer);
-	template <typename ValueType>
-	friend StringType<ValueType> operator+(ConstPointer, const StringType<ValueType> &);
-	template <typename ValueType>
-	friend StringType<ValueType> operator+(const StringType<ValueType> &, ValueType);
-	template <typename ValueType>
-	friend StringType<ValueType> operator+(ValueType, const StringType<ValueType> &);
-
-	template <typename ValueType>
-	friend StringType<ValueType> operator+(StringType<ValueType> &&, StringType<ValueType> &&);
-	template <typename ValueType>
-	friend StringType<ValueType> operator+(const StringType<ValueType> &, StringType<ValueType> &&);
-	template <typename ValueType>
-	friend StringType<ValueType> operator+(StringType<ValueType> &&, const StringType<ValueType> &);
-	template <typename ValueType>
-	friend StringType<ValueType> operator+(StringType<ValueType> &&, ConstPointer);
-	template <typename ValueType>
-	friend StringType<ValueType> operator+(ConstPointer, StringType<ValueType> &&);
-	template <typename ValueType>
-	friend StringType<ValueType> operator+(StringType<ValueType> &&, ValueType);
-	template <typename ValueType>
-	friend StringType<ValueType> operator+(ValueType, StringType<ValueType> &&);
+	int compare(ViewType) const noexcept;
 
-	// Comparison Operations
+	int compareIgnoreCase(ConstPointer) const noexcept;
+	int compareIgnoreCase(ViewType) const noexcept;
 
-	template <typename ValueType>
-	friend bool operator==(const StringType<ValueType> &, const StringType<ValueType> &) noexcept;
-	template <typename ValueType>
-	friend bool operator==(const StringType<ValueType> &, ConstPointer) noexcept;
-	template <typename ValueType>
-	friend bool operator==(ConstPointer, const StringType<ValueType> &) noexcept;
-	template <typename ValueType>
-	friend bool operator!=(const StringType<ValueType> &, const StringType<ValueType> &) noexcept;
-	template <typename ValueType>
-	friend bool operator!=(const StringType<ValueType> &, ConstPointer) noexcept;
-	template <typename ValueType>
-	friend bool operator!=(ConstPointer, const StringType<ValueType> &) noexcept;
-
-	// Output Stream Operations
-
-	template <typename ValueType>
-	friend std::ostream &operator<<(std::ostream &, const StringType<ValueType> &);
-};
+	bool equalsIgnoreCase(ConstPointer) const noexcept;
+	bool equalsIgnoreCase(ViewType) const noexcept;
 
+	// Search Functions
 
-// Utility Functions
+	SizeType find(ValueType, SizeType = 0) const noexcept;
+	SizeType find(ConstPointer, SizeType = 0) const noexcept;
+	SizeType find(ViewType, SizeType = 0) const noexcept;
 
-/*
-*/
-template <typename ValueType>
-typename StringType<ValueType>::SizeType StringType<ValueType>::lookupCapacity(SizeType size) noexcept {
+	SizeType rfind(ValueType, SizeType = NOT_FOUND) const noexcept;
+	SizeType rfind(ConstPointer, SizeType = NOT_FOUND) const noexcept;
+	SizeType rfind(ViewType, SizeType = NOT_FOUND) const noexcept;
 
-	assert_assume(size < std::numeric_limits<SizeType>::max());
+	SizeType findIgnoreCase(ValueType, SizeType = 0) const noexcept;
+	SizeType findIgnoreCase(ConstPointer, SizeType = 0) const noexcept;
+	SizeType findIgnoreCase(ViewType, SizeType = 0) const noexcept;
 
-	if (size == 0) {
-		return 0;
-	}
+	bool contains(ValueType) const noexcept;
+	bool contains(ConstPointer) const noexcept;
+	bool contains(ViewType) const noexcept;
 
-	++size;
+	bool startsWith(ValueType) const noexcept;
+	bool startsWith(ConstPointer) const noexcept;
+	bool startsWith(ViewType) const noexcept;
 
-	static constexpr SizeType SEED = 15;
-	SizeType capacity = SEED;
+	bool endsWith(ValueType) const noexcept;
+	bool endsWith(ConstPointer) const noexcept;
+	bool endsWith(ViewType) const noexcept;
 
-	while (size > capacity) {
-		capacity *= 2;
-	}
+	SizeType findFirstOf(ConstPointer, SizeType = 0) const noexcept;
+	SizeType findFirstOf(ViewType, SizeType = 0) const noexcept;
+	SizeType findFirstNotOf(ConstPointer, SizeType = 0) const noexcept;
+	SizeType findFirstNotOf(ViewType, SizeType = 0) const noexcept;
 
-	return capacity;
-}
+	// Split Functions
 
-/*
-*/
-template <typename ValueType>
-typename StringType<ValueType>::SizeType StringType<ValueType>::cstringSize(ConstPointer cstring) noexcept {
+	SplitRange<ValueType> split(ValueType) const & noexcept;
+	SplitRange<ValueType> split(ViewType) const & noexcept;
+	SplitRange<ValueType> splitAny(ViewType) const & noexcept;
 
-	SizeType size = 0;
+	// The pieces would refer to a string destroyed at the end of the full expression.
+	SplitRange<ValueType> split(ValueType) const && = delete;
+	SplitRange<ValueType> split(ViewType) const && = delete;
+	SplitRange<ValueType> splitAny(ViewType) const && = delete;
 
-	while (cstring[size] != NUL_TERMINATION) {
-		++size;
-	}
+	// Numeric Functions
 
-	return size;
-}
+	template <typename IntegerType, typename = typename std::enable_if<std::is_integral<IntegerType>::value && !std::is_same<IntegerType, bool>::value>::type>
+	StringType &appendInteger(IntegerType);
 
+	StringType &appendFloat(float);
+	StringType &appendFloat(double);
 
-// Constructors
+	template <typename IntegerType = int>
+	ParseResult<IntegerType> parseInt(unsigned = 10) const noexcept;
+	ParseResult<double> parseDouble() const;
 
-/*
-*/
-template <typename ValueType>
-StringType<ValueType>::StringType(Pointer data, SizeType size, SizeType capacity) noexcept :
-	m_data{data}, m_size{size}, m_capacity{capacity} {
+	// Hash Functions
 
-	assert_assume(data != nullptr || (size == 0 && capacity == 0));
-	assert_assume(size < capacity || (size == 0 && capacity == 0));
-}
+	SizeType hash() const noexcept;
 
-/*
-*/
-template <typename ValueType>
-StringType<ValueType>::StringType() noexcept = default;
+	// Comparison Operations
 
-/*
-*/
-template <typename ValueType>
-StringType<ValueType>::StringType(std::initializer_list<ValueType> list) {
+	template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+	friend bool operator==(const StringType<ValueType, AllocatorType, GrowthPolicyType> &, const StringType<ValueType, AllocatorType, GrowthPolicyType> &) noexcept;
+	template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+	friend bool operator==(const StringType<ValueType, AllocatorType, GrowthPolicyType> &, typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstPointer) noexcept;
+	template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+	friend bool operator==(typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstPointer, const StringType<ValueType, AllocatorType, GrowthPolicyType> &) noexcept;
+	template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+	friend bool operator!=(const StringType<ValueType, AllocatorType, GrowthPolicyType> &, const StringType<ValueType, AllocatorType, GrowthPolicyType> &) noexcept;
+	template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+	friend bool operator!=(const StringType<ValueType, AllocatorType, GrowthPolicyType> &, typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstPointer) noexcept;
+	template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+	friend bool operator!=(typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstPointer, const StringType<ValueType, AllocatorType, GrowthPolicyType> &) noexcept;
+
+	// Stream Operations
+
+	template <typename ValueType, typename AllocatorType, typename GrowthPolicyType, typename Traits>
+	friend std::basic_ostream<ValueType, Traits> &operator<<(std::basic_ostream<ValueType, Traits> &, const StringType<ValueType, AllocatorType, GrowthPolicyType> &);
+	template <typename ValueType, typename AllocatorType, typename GrowthPolicyType, typename Traits>
+	friend std::basic_istream<ValueType, Traits> &operator>>(std::basic_istream<ValueType, Traits> &, StringType<ValueType, AllocatorType, GrowthPolicyType> &);
+	template <typename ValueType, typename AllocatorType, typename GrowthPolicyType, typename Traits>
+	friend std::basic_istream<ValueType, Traits> &getline(std::basic_istream<ValueType, Traits> &, StringType<ValueType, AllocatorType, GrowthPolicyType> &, ValueType);
+	template <typename ValueType, typename AllocatorType, typename GrowthPolicyType, typename Traits>
+	friend std::basic_istream<ValueType, Traits> &getline(std::basic_istream<ValueType, Traits> &, StringType<ValueType, AllocatorType, GrowthPolicyType> &);
+};
 
-	if (list.size() == 0) {
-		return;
-	}
 
-	SizeType capacity = lookupCapacity(list.size());
-	assume(list.size() < capacity);
+// Constants
 
-	m_data = new ValueType[capacity];
-	m_size = list.size();
-	m_capacity = capacity;
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+constexpr typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::NOT_FOUND;
 
-	std::copy(list.begin(), list.end(), m_data);
-	m_data[m_size] = NUL_TERMINATION;
-}
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+constexpr typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ValueType StringType<ValueType, AllocatorType, GrowthPolicyType>::NUL_TERMINATION;
 
-/*
-*/
-template <typename ValueType>
-StringType<ValueType>::StringType(ValueType character, SizeType size) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+constexpr typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::LOCAL_CAPACITY;
 
-	if (size == 0) {
-		return;
-	}
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+constexpr bool StringType<ValueType, AllocatorType, GrowthPolicyType>::PROPAGATE_ON_COPY;
 
-	SizeType capacity = lookupCapacity(size);
-	assume(size < capacity);
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+constexpr bool StringType<ValueType, AllocatorType, GrowthPolicyType>::PROPAGATE_ON_MOVE;
 
-	m_data = new ValueType[capacity];
-	m_size = size;
-	m_capacity = capacity;
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+constexpr bool StringType<ValueType, AllocatorType, GrowthPolicyType>::ALWAYS_EQUAL;
 
-	std::fill(m_data, m_data + m_size, character);
 
-	m_data[m_size] = NUL_TERMINATION;
-}
+// Utility Functions
 
 /*
+	Capacity of a new buffer for size characters; current is the capacity being outgrown, or zero.
 */
-template <typename ValueType>
-StringType<ValueType>::StringType(ConstPointer cstring) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::lookupCapacity(SizeType size, SizeType current) noexcept {
 
-	assert_assume(cstring != nullptr);
+	assert_assume(size < std::numeric_limits<SizeType>::max());
 
-	SizeType size = cstringSize(cstring);
+	SizeType capacity = GrowthPolicyType::template capacity<ValueType>(size + 1, current);
+	assert_assume(capacity > size);
 
-	if (size == 0) {
-		return;
-	}
+	return capacity;
+}
 
-	SizeType capacity = lookupCapacity(size);
-	assume(size < capacity);
+/*
+	Scans for the NUL termination a whole vector at a time (see detail::terminatedLength).
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::cstringSize(ConstPointer cstring) noexcept {
 
-	m_data = new ValueType[capacity];
-	m_size = size;
-	m_capacity = capacity;
+	assert_assume(cstring != nullptr);
 
-	std::copy(cstring, cstring + m_size, m_data);
-	m_data[m_size] = NUL_TERMINATION;
+	return detail::terminatedLength(cstring);
 }
 
 /*
+	Builds the string an expression stands for with one allocation sized for the whole of it,
+	unless donor, the leftmost operand, has room for everything and the rest can be appended to it.
 */
-template <typename ValueType>
-StringType<ValueType>::StringType(const StringType &object) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+template <typename Left, typename Right>
+StringType<ValueType, AllocatorType, GrowthPolicyType> StringType<ValueType, AllocatorType, GrowthPolicyType>::concatenate(const ConcatExpression<StringType, Left, Right> &expression, StringType *donor) {
 
-	if (object.m_size == 0) {
-		return;
-	}
+	SizeType size = expression.size();
 
-	SizeType capacity = lookupCapacity(object.m_size);
-	assume(object.m_size < capacity);
+	if (donor != nullptr && donor->capacity() > size) {
+		expression.copyTail(donor->m_data + donor->m_size);
 
-	m_data = new ValueType[capacity];
-	m_size = object.m_size;
-	m_capacity = capacity;
+		donor->m_size = size;
+		donor->m_data[size] = NUL_TERMINATION;
 
-	std::copy(object.m_data, object.m_data + m_size, m_data);
-	m_data[m_size] = NUL_TERMINATION;
-}
+		return std::move(*donor);
+	}
 
-/*
-*/
-template <typename ValueType>
-StringType<ValueType>::StringType(StringType &&object) noexcept :
-	m_data{object.m_data}, m_size{object.m_size}, m_capacity{object.m_capacity} {
+	const StringType *owner = expression.owner();
+	assert_assume(owner != nullptr);
+
+	StringType result{AllocatorTraits::select_on_container_copy_construction(owner->allocatorReference())};
+	result.initialize(size, AllocationCause::CONCATENATE);
+
+	expression.copy(result.m_data);
 
-	object.m_data = nullptr;
-	object.m_size = 0;
-	object.m_capacity = 0;
+	return result;
 }
 
 
-// Destructor
+// Storage Functions
 
 /*
 */
-template <typename ValueType>
-StringType<ValueType>::~StringType() noexcept {
-
-	delete[] m_data;
-	m_data = nullptr;
-	m_size = 0;
-	m_capacity = 0;
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::AllocatorType &StringType<ValueType, AllocatorType, GrowthPolicyType>::allocatorReference() noexcept {
+	return *this;
 }
 
-
-// Assignment Operations
-
 /*
 */
-template <typename ValueType>
-StringType<ValueType> &StringType<ValueType>::operator=(ValueType character) {
-
-	SizeType size = 1;
-	SizeType capacity = lookupCapacity(size);
-	assume(size < capacity);
-
-	if (m_capacity < capacity) {
-		Pointer data = new ValueType[capacity];
-
-		delete[] m_data;
-		m_data = data;
-		m_capacity = capacity;
-	}
-
-	m_size = size;
-
-	m_data[0] = character;
-	m_data[m_size] = NUL_TERMINATION;
-
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+const typename StringType<ValueType, AllocatorType, GrowthPolicyType>::AllocatorType &StringType<ValueType, AllocatorType, GrowthPolicyType>::allocatorReference() const noexcept {
 	return *this;
 }
 
 /*
 */
-template <typename ValueType>
-StringType<ValueType> &StringType<ValueType>::operator=(ConstPointer cstring) {
-
-	assert_assume(cstring != nullptr);
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::Pointer StringType<ValueType, AllocatorType, GrowthPolicyType>::allocateStorage(SizeType capacity, SizeType size, AllocationCause cause) {
 
-	SizeType size = cstringSize(cstring);
+	assert_assume(capacity > LOCAL_CAPACITY);
+	assert_assume(size < capacity);
 
-	if (size == 0) {
-		if (m_capacity > 0) {
-			m_data[0] = NUL_TERMINATION;
-			m_size = 0;
-		}
-		return *this;
-	}
+	Pointer data = AllocatorTraits::allocate(allocatorReference(), capacity);
 
-	SizeType capacity = lookupCapacity(size);
-	assume(size < capacity);
+	detail::recordAllocation(cause, capacity * sizeof(ValueType), (capacity - size - 1) * sizeof(ValueType));
 
-	if (m_capacity < capacity) {
-		Pointer data = new ValueType[capacity];
+	return data;
+}
 
-		delete[] m_data;
-		m_data = data;
-		m_capacity = capacity;
-	}
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::freeStorage(Pointer data, SizeType capacity) noexcept {
 
-	m_size = size;
+	assert_assume(data != nullptr);
+	assert_assume(capacity > LOCAL_CAPACITY);
 
-	std::copy(cstring, cstring + m_size, m_data);
-	m_data[m_size] = NUL_TERMINATION;
+	AllocatorTraits::deallocate(allocatorReference(), data, capacity);
 
-	return *this;
+	detail::recordDeallocation(capacity * sizeof(ValueType));
 }
 
 /*
+	Switches to a copy of allocator, leaving the string empty with room for size characters.
+	The new buffer is obtained before anything is released, so a failed allocation leaves the string unmodified.
 */
-template <typename ValueType>
-StringType<ValueType> &StringType<ValueType>::operator=(const StringType &object) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::propagateAllocator(const AllocatorType &allocator, SizeType size, std::true_type) {
 
-	if (object.m_size == 0) {
-		if (m_capacity > 0) {
-			m_data[0] = NUL_TERMINATION;
-			m_size = object.m_size;
-		}
-		return *this;
-	}
+	AllocatorType copy = allocator;
 
-	SizeType capacity = lookupCapacity(object.m_size);
-	assume(object.m_size < capacity);
+	Pointer data = nullptr;
+	SizeType capacity = 0;
 
-	if (m_capacity < capacity) {
-		Pointer data = new ValueType[capacity];
+	if (size >= LOCAL_CAPACITY) {
+		capacity = lookupCapacity(size);
+		data = AllocatorTraits::allocate(copy, capacity);
 
-		delete[] m_data;
-		m_data = data;
-		m_capacity = capacity;
+		detail::recordAllocation(AllocationCause::ASSIGN, capacity * sizeof(ValueType), (capacity - size - 1) * sizeof(ValueType));
 	}
 
-	m_size = object.m_size;
-
-	std::copy(object.m_data, object.m_data + m_size, m_data);
-	m_data[m_size] = NUL_TERMINATION;
+	deallocate();
+	allocatorReference() = std::move(copy);
 
-	return *this;
+	if (data != nullptr) {
+		m_data = data;
+		m_capacity = capacity;
+	}
 }
 
 /*
 */
-template <typename ValueType>
-StringType<ValueType> &StringType<ValueType>::operator=(StringType &&object) noexcept {
-
-	Pointer data = object.m_data;
-	SizeType size = object.m_size;
-	SizeType capacity = object.m_capacity;
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::propagateAllocator(const AllocatorType &, SizeType, std::false_type) noexcept {}
 
-	object.m_data = nullptr;
-	object.m_size = 0;
-	object.m_capacity = 0;
-
-	delete[] m_data;
-	m_data = data;
-	m_size = size;
-	m_capacity = capacity;
+/*
+	Releases the current buffer through the old allocator before taking allocator over.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::propagateAllocator(AllocatorType &&allocator, std::true_type) noexcept {
 
-	return *this;
+	deallocate();
+	allocatorReference() = std::move(allocator);
 }
 
-
-// Size Functions
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::propagateAllocator(AllocatorType &&, std::false_type) noexcept {}
 
 /*
 */
-template <typename ValueType>
-bool StringType<ValueType>::empty() const noexcept {
-	return m_size == 0;
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool StringType<ValueType, AllocatorType, GrowthPolicyType>::isLocal() const noexcept {
+	return m_data == m_local;
 }
 
 /*
+	Sets up storage for size characters on a string that is still empty and local.
+	The characters themselves are left for the caller to write.
 */
-template <typename ValueType>
-typename StringType<ValueType>::SizeType StringType<ValueType>::size() const noexcept {
-	return m_size;
-}
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::initialize(SizeType size, AllocationCause cause) {
 
+	assert_assume(isLocal() && m_size == 0);
 
-// Capacity Functions
+	if (size >= LOCAL_CAPACITY) {
+		SizeType capacity = lookupCapacity(size);
+		assume(size < capacity);
 
-/*
-*/
-template <typename ValueType>
-typename StringType<ValueType>::SizeType StringType<ValueType>::capacity() const noexcept {
-	return m_capacity;
+		m_data = allocateStorage(capacity, size, cause);
+		m_capacity = capacity;
+	}
+
+	m_size = size;
+	m_data[m_size] = NUL_TERMINATION;
 }
 
 /*
+	Makes room for size characters, keeping the contents; reserve() and the appends differ only in the cause they record.
 */
-template <typename ValueType>
-void StringType<ValueType>::reserve(SizeType size) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::grow(SizeType size, AllocationCause cause) {
 
-	SizeType capacity = lookupCapacity(size);
-	assume(size < capacity);
+	if (capacity() <= size) {
+		SizeType capacity = lookupCapacity(size, this->capacity());
+		assume(size < capacity);
 
-	if (m_capacity < capacity) {
-		Pointer data = new ValueType[capacity];
+		Pointer data = allocateStorage(capacity, size, cause);
 
 		std::copy(m_data, m_data + m_size, data);
 		data[m_size] = NUL_TERMINATION;
 
-		delete[] m_data;
-		m_data = data;
-		m_capacity = capacity;
+		replaceStorage(data, capacity);
 	}
 }
 
 /*
+	Frees the current heap buffer, if any, and takes ownership of data without touching m_size.
 */
-template <typename ValueType>
-void StringType<ValueType>::shrink() {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::replaceStorage(Pointer data, SizeType capacity) noexcept {
 
-	if (m_size == 0) {
+	assert_assume(data != nullptr && data != m_local);
 
-		delete[] m_data;
-		m_data = nullptr;
-		m_size = 0;
-		m_capacity = 0;
-
-		return;
+	if (!isLocal()) {
+		freeStorage(m_data, m_capacity);
 	}
 
-	SizeType capacity = lookupCapacity(m_size);
-	assume(m_size < capacity);
-
-	if (m_capacity > capacity) {
-		Pointer data = new ValueType[capacity];
-
-		std::copy(m_data, m_data + m_size, data);
-		data[m_size] = NUL_TERMINATION;
-
-		delete[] m_data;
-		m_data = data;
-		m_capacity = capacity;
-	}
+	m_data = data;
+	m_capacity = capacity;
 }
 
 /*
+	Points the string back at its empty inline buffer without freeing anything.
+	Used once the heap buffer has been freed or handed over to another string.
 */
-template <typename ValueType>
-void StringType<ValueType>::deallocate() noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::resetLocal() noexcept {
 
-	delete[] m_data;
-	m_data = nullptr;
+	m_data = m_local;
 	m_size = 0;
-	m_capacity = 0;
+	m_local[0] = NUL_TERMINATION;
 }
 
 
-// Data Access Functions
+// Constructors
 
 /*
+	Adopts a heap buffer that was obtained from (a copy of) allocator.
 */
-template <typename ValueType>
-typename StringType<ValueType>::ConstPointer StringType<ValueType>::data() const noexcept {
-	return m_data;
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType>::StringType(Pointer data, SizeType size, SizeType capacity, const AllocatorType &allocator) noexcept :
+	AllocatorType{allocator}, m_data{data}, m_size{size} {
+
+	assert_assume(data != nullptr);
+	assert_assume(size < capacity && capacity > LOCAL_CAPACITY);
+
+	m_capacity = capacity;
 }
 
 /*
 */
-template <typename ValueType>
-typename StringType<ValueType>::ConstPointer StringType<ValueType>::cstring() const noexcept {
-	return m_capacity > 0 ? m_data : std::addressof(NUL_TERMINATION);
-}
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType>::StringType() noexcept(noexcept(AllocatorType())) = default;
 
 /*
 */
-template <typename ValueType>
-typename StringType<ValueType>::ConstReference StringType<ValueType>::operator[](SizeType index) const noexcept {
-
-	assert_assume(index < m_size);
-
-	return m_data[index];
-}
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType>::StringType(const AllocatorType &allocator) noexcept :
+	AllocatorType{allocator} {}
 
 /*
 */
-template <typename ValueType>
-typename StringType<ValueType>::Reference StringType<ValueType>::operator[](SizeType index) noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType>::StringType(std::initializer_list<ValueType> list, const AllocatorType &allocator) :
+	AllocatorType{allocator} {
 
-	assert_assume(index < m_size);
+	initialize(list.size());
 
-	return m_data[index];
+	std::copy(list.begin(), list.end(), m_data);
 }
 
 /*
 */
-template <typename ValueType>
-typename StringType<ValueType>::ConstReference StringType<ValueType>::front() const noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType>::StringType(ValueType character, SizeType size, const AllocatorType &allocator) :
+	AllocatorType{allocator} {
 
-	assert_assume(m_size > 0);
+	initialize(size);
 
-	return m_data[0];
+	std::fill_n(m_data, m_size, character);
 }
 
 /*
 */
-template <typename ValueType>
-typename StringType<ValueType>::Reference StringType<ValueType>::front() noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType>::StringType(ConstPointer cstring, const AllocatorType &allocator) :
+	AllocatorType{allocator} {
 
-	assert_assume(m_size > 0);
+	assert_assume(cstring != nullptr);
 
-	return m_data[0];
+	initialize(cstringSize(cstring));
+
+	std::copy(cstring, cstring + m_size, m_data);
 }
 
 /*
+	Copies the characters a view refers to into a string of its own.
 */
-template <typename ValueType>
-typename StringType<ValueType>::ConstReference StringType<ValueType>::back() const noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType>::StringType(ViewType view, const AllocatorType &allocator) :
+	AllocatorType{allocator} {
 
-	assert_assume(m_size > 0);
+	initialize(view.size());
 
-	return m_data[m_size - 1];
+	std::copy(view.data(), view.data() + m_size, m_data);
 }
 
 /*
 */
-template <typename ValueType>
-typename StringType<ValueType>::Reference StringType<ValueType>::back() noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType>::StringType(const StringType &object) :
+	AllocatorType{AllocatorTraits::select_on_container_copy_construction(object.allocatorReference())} {
 
-	assert_assume(m_size > 0);
+	initialize(object.m_size);
 
-	return m_data[m_size - 1];
+	std::copy(object.m_data, object.m_data + m_size, m_data);
 }
 
-// Mutations Functions
-
 /*
 */
-template <typename ValueType>
-void StringType<ValueType>::clear() noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+template <typename Left, typename Right>
+StringType<ValueType, AllocatorType, GrowthPolicyType>::StringType(const ConcatExpression<StringType, Left, Right> &expression) :
+	StringType{concatenate(expression, nullptr)} {}
 
-	m_size = 0;
-	if (m_capacity > 0) {
-		m_data[0] = NUL_TERMINATION;
-	}
-}
+/*
+	An rvalue expression is being consumed, so an rvalue string at its left may give up its buffer.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+template <typename Left, typename Right>
+StringType<ValueType, AllocatorType, GrowthPolicyType>::StringType(ConcatExpression<StringType, Left, Right> &&expression) :
+	StringType{concatenate(expression, expression.donor())} {}
 
 /*
 */
-template <typename ValueType>
-void StringType<ValueType>::popback(SizeType count) noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType>::StringType(const StringType &object, const AllocatorType &allocator) :
+	AllocatorType{allocator} {
 
-	assert_assume(count <= m_size);
+	initialize(object.m_size);
 
-	m_size -= count;
-	m_data[m_size] = NUL_TERMINATION;
+	std::copy(object.m_data, object.m_data + m_size, m_data);
 }
 
 /*
 */
-template <typename ValueType>
-void StringType<ValueType>::trim(SizeType count) noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType>::StringType(StringType &&object) noexcept :
+	AllocatorType{std::move(object.allocatorReference())}, m_size{object.m_size} {
 
-	assert_assume(count <= m_size);
+	if (object.isLocal()) {
+		std::copy(object.m_local, object.m_local + object.m_size + 1, m_local);
+	}
+	else {
+		m_data = object.m_data;
+		m_capacity = object.m_capacity;
+
+		detail::recordSteal();
+	}
+
+	object.resetLocal();
+}
+
+/*
+	A heap buffer can only be taken over when allocator is able to free it; otherwise the contents are copied.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType>::StringType(StringType &&object, const AllocatorType &allocator) :
+	AllocatorType{allocator} {
+
+	if (!object.isLocal() && allocatorReference() == object.allocatorReference()) {
+		m_data = object.m_data;
+		m_size = object.m_size;
+		m_capacity = object.m_capacity;
+
+		object.resetLocal();
+		detail::recordSteal();
+
+		return;
+	}
+
+	initialize(object.m_size);
+
+	std::copy(object.m_data, object.m_data + m_size, m_data);
+}
+
+
+// Destructor
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType>::~StringType() noexcept {
+
+	if (!isLocal()) {
+		freeStorage(m_data, m_capacity);
+	}
+}
+
+
+// Assignment Operations
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> &StringType<ValueType, AllocatorType, GrowthPolicyType>::operator=(ValueType character) {
+
+	m_size = 1;
+
+	m_data[0] = character;
+	m_data[m_size] = NUL_TERMINATION;
+
+	return *this;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> &StringType<ValueType, AllocatorType, GrowthPolicyType>::operator=(ConstPointer cstring) {
+
+	assert_assume(cstring != nullptr);
+
+	SizeType size = cstringSize(cstring);
+
+	if (capacity() <= size) {
+		SizeType capacity = lookupCapacity(size);
+		assume(size < capacity);
+
+		replaceStorage(allocateStorage(capacity, size, AllocationCause::ASSIGN), capacity);
+	}
+
+	m_size = size;
+
+	std::copy(cstring, cstring + m_size, m_data);
+	m_data[m_size] = NUL_TERMINATION;
+
+	return *this;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> &StringType<ValueType, AllocatorType, GrowthPolicyType>::operator=(const StringType &object) {
+
+	if (PROPAGATE_ON_COPY && allocatorReference() != object.allocatorReference()) {
+		propagateAllocator(object.allocatorReference(), object.m_size, std::integral_constant<bool, PROPAGATE_ON_COPY>{});
+	}
+	else if (capacity() <= object.m_size) {
+		SizeType capacity = lookupCapacity(object.m_size);
+		assume(object.m_size < capacity);
+
+		replaceStorage(allocateStorage(capacity, object.m_size, AllocationCause::ASSIGN), capacity);
+	}
+
+	m_size = object.m_size;
+
+	std::copy(object.m_data, object.m_data + m_size, m_data);
+	m_data[m_size] = NUL_TERMINATION;
+
+	return *this;
+}
+
+/*
+	A local source is copied into the current buffer so that any heap buffer already held is kept.
+	A heap buffer is only taken over when the allocators allow it; otherwise the contents are copied.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> &StringType<ValueType, AllocatorType, GrowthPolicyType>::operator=(StringType &&object) noexcept(PROPAGATE_ON_MOVE || ALWAYS_EQUAL) {
+
+	if (this == std::addressof(object)) {
+		return *this;
+	}
+
+	if (PROPAGATE_ON_MOVE && !ALWAYS_EQUAL && allocatorReference() != object.allocatorReference()) {
+		propagateAllocator(std::move(object.allocatorReference()), std::integral_constant<bool, PROPAGATE_ON_MOVE>{});
+	}
+
+	if (object.isLocal()) {
+		std::copy(object.m_local, object.m_local + object.m_size + 1, m_data);
+	}
+	else if (PROPAGATE_ON_MOVE || ALWAYS_EQUAL || allocatorReference() == object.allocatorReference()) {
+		replaceStorage(object.m_data, object.m_capacity);
+		detail::recordSteal();
+	}
+	else {
+		return *this = static_cast<const StringType &>(object);
+	}
+
+	m_size = object.m_size;
+
+	object.resetLocal();
+
+	return *this;
+}
+
+
+// Conversion Operations
+
+/*
+	Views are how a string is inspected without copying; they remain valid until the string is modified.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType>::operator ViewType() const noexcept {
+	return ViewType{m_data, m_size};
+}
+
+
+// Allocator Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::AllocatorType StringType<ValueType, AllocatorType, GrowthPolicyType>::allocator() const noexcept {
+	return allocatorReference();
+}
+
+
+// Size Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool StringType<ValueType, AllocatorType, GrowthPolicyType>::empty() const noexcept {
+	return m_size == 0;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::size() const noexcept {
+	return m_size;
+}
+
+
+// Capacity Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::capacity() const noexcept {
+	return isLocal() ? LOCAL_CAPACITY : m_capacity;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::reserve(SizeType size) {
+	grow(size, AllocationCause::RESERVE);
+}
+
+/*
+	Moves the contents back into the inline buffer when they fit there.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::shrink() {
+
+	if (isLocal()) {
+		return;
+	}
+
+	if (m_size < LOCAL_CAPACITY) {
+		Pointer data = m_data;
+		SizeType capacity = m_capacity;
+
+		std::copy(data, data + m_size, m_local);
+		m_local[m_size] = NUL_TERMINATION;
+		m_data = m_local;
+
+		freeStorage(data, capacity);
+
+		return;
+	}
+
+	SizeType capacity = lookupCapacity(m_size);
+	assume(m_size < capacity);
+
+	if (m_capacity > capacity) {
+		Pointer data = allocateStorage(capacity, m_size, AllocationCause::SHRINK);
+
+		std::copy(m_data, m_data + m_size, data);
+		data[m_size] = NUL_TERMINATION;
+
+		replaceStorage(data, capacity);
+	}
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::deallocate() noexcept {
+
+	if (!isLocal()) {
+		freeStorage(m_data, m_capacity);
+	}
+
+	resetLocal();
+}
+
+
+// Data Access Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstPointer StringType<ValueType, AllocatorType, GrowthPolicyType>::data() const noexcept {
+	return m_data;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstPointer StringType<ValueType, AllocatorType, GrowthPolicyType>::cstring() const noexcept {
+	return m_data;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstReference StringType<ValueType, AllocatorType, GrowthPolicyType>::operator[](SizeType index) const noexcept {
+
+	assert_assume(index < m_size);
+
+	return m_data[index];
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::Reference StringType<ValueType, AllocatorType, GrowthPolicyType>::operator[](SizeType index) noexcept {
+
+	assert_assume(index < m_size);
+
+	return m_data[index];
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstReference StringType<ValueType, AllocatorType, GrowthPolicyType>::front() const noexcept {
+
+	assert_assume(m_size > 0);
+
+	return m_data[0];
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::Reference StringType<ValueType, AllocatorType, GrowthPolicyType>::front() noexcept {
+
+	assert_assume(m_size > 0);
+
+	return m_data[0];
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstReference StringType<ValueType, AllocatorType, GrowthPolicyType>::back() const noexcept {
+
+	assert_assume(m_size > 0);
+
+	return m_data[m_size - 1];
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::Reference StringType<ValueType, AllocatorType, GrowthPolicyType>::back() noexcept {
+
+	assert_assume(m_size > 0);
+
+	return m_data[m_size - 1];
+}
+
+
+// Iterator Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstIterator StringType<ValueType, AllocatorType, GrowthPolicyType>::begin() const noexcept {
+	return m_data;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::Iterator StringType<ValueType, AllocatorType, GrowthPolicyType>::begin() noexcept {
+	return m_data;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstIterator StringType<ValueType, AllocatorType, GrowthPolicyType>::end() const noexcept {
+	return m_data + m_size;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::Iterator StringType<ValueType, AllocatorType, GrowthPolicyType>::end() noexcept {
+	return m_data + m_size;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstIterator StringType<ValueType, AllocatorType, GrowthPolicyType>::cbegin() const noexcept {
+	return m_data;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstIterator StringType<ValueType, AllocatorType, GrowthPolicyType>::cend() const noexcept {
+	return m_data + m_size;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstReverseIterator StringType<ValueType, AllocatorType, GrowthPolicyType>::rbegin() const noexcept {
+	return ConstReverseIterator{end()};
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ReverseIterator StringType<ValueType, AllocatorType, GrowthPolicyType>::rbegin() noexcept {
+	return ReverseIterator{end()};
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstReverseIterator StringType<ValueType, AllocatorType, GrowthPolicyType>::rend() const noexcept {
+	return ConstReverseIterator{begin()};
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ReverseIterator StringType<ValueType, AllocatorType, GrowthPolicyType>::rend() noexcept {
+	return ReverseIterator{begin()};
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstReverseIterator StringType<ValueType, AllocatorType, GrowthPolicyType>::crbegin() const noexcept {
+	return ConstReverseIterator{end()};
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstReverseIterator StringType<ValueType, AllocatorType, GrowthPolicyType>::crend() const noexcept {
+	return ConstReverseIterator{begin()};
+}
+
+// Mutations Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::clear() noexcept {
+
+	m_size = 0;
+	m_data[0] = NUL_TERMINATION;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::popback(SizeType count) noexcept {
+
+	assert_assume(count <= m_size);
+
+	m_size -= count;
+	m_data[m_size] = NUL_TERMINATION;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::trim(SizeType count) noexcept {
+
+	assert_assume(count <= m_size);
 
 	std::copy(m_data + count, m_data + m_size, m_data);
 
@@ -690,8 +1218,8 @@ void StringType<ValueType>::trim(SizeType count) noexcept {
 
 /*
 */
-template <typename ValueType>
-void StringType<ValueType>::erase(SizeType index) noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::erase(SizeType index) noexcept {
 
 	assert_assume(index < m_size);
 
@@ -703,8 +1231,8 @@ void StringType<ValueType>::erase(SizeType index) noexcept {
 
 /*
 */
-template <typename ValueType>
-void StringType<ValueType>::erase(SizeType first, SizeType last) noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::erase(SizeType first, SizeType last) noexcept {
 
 	assert_assume(first < last);
 	assert_assume(last <= m_size);
@@ -717,24 +1245,22 @@ void StringType<ValueType>::erase(SizeType first, SizeType last) noexcept {
 
 /*
 */
-template <typename ValueType>
-void StringType<ValueType>::insert(ValueType character, SizeType index) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::insert(ValueType character, SizeType index) {
 
 	assert_assume(index < m_size);
 
-	SizeType capacity = lookupCapacity(m_size + 1);
-	assume(m_size + 1 < capacity);
+	if (capacity() <= m_size + 1) {
+		SizeType capacity = lookupCapacity(m_size + 1, this->capacity());
+		assume(m_size + 1 < capacity);
 
-	if (m_capacity < capacity) {
-		Pointer data = new ValueType[capacity];
+		Pointer data = allocateStorage(capacity, m_size + 1, AllocationCause::INSERT);
 
 		std::copy(m_data, m_data + index, data);
 		std::copy(m_data + index, m_data + m_size, data + index + 1);
 		data[index] = character;
 
-		delete[] m_data;
-		m_data = data;
-		m_capacity = capacity;
+		replaceStorage(data, capacity);
 	}
 	else {
 		std::copy_backward(m_data + index, m_data + m_size, m_data + m_size + 1);
@@ -747,8 +1273,8 @@ void StringType<ValueType>::insert(ValueType character, SizeType index) {
 
 /*
 */
-template <typename ValueType>
-void StringType<ValueType>::insert(ConstPointer cstring, SizeType index) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::insert(ConstPointer cstring, SizeType index) {
 
 	assert_assume(cstring != nullptr);
 	assert_assume(index < m_size);
@@ -759,19 +1285,17 @@ void StringType<ValueType>::insert(ConstPointer cstring, SizeType index) {
 		return;
 	}
 
-	SizeType capacity = lookupCapacity(m_size + size);
-	assume(m_size + size < capacity);
+	if (capacity() <= m_size + size) {
+		SizeType capacity = lookupCapacity(m_size + size, this->capacity());
+		assume(m_size + size < capacity);
 
-	if (m_capacity < capacity) {
-		Pointer data = new ValueType[capacity];
+		Pointer data = allocateStorage(capacity, m_size + size, AllocationCause::INSERT);
 
 		std::copy(m_data, m_data + index, data);
 		std::copy(m_data + index, m_data + m_size, data + index + size);
 		std::copy(cstring, cstring + size, data + index);
 
-		delete[] m_data;
-		m_data = data;
-		m_capacity = capacity;
+		replaceStorage(data, capacity);
 	}
 	else {
 		std::copy_backward(m_data + index, m_data + m_size, m_data + m_size + size);
@@ -784,8 +1308,8 @@ void StringType<ValueType>::insert(ConstPointer cstring, SizeType index) {
 
 /*
 */
-template <typename ValueType>
-void StringType<ValueType>::insert(const StringType &object, SizeType index) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::insert(const StringType &object, SizeType index) {
 
 	assert_assume(index < m_size);
 
@@ -793,19 +1317,17 @@ void StringType<ValueType>::insert(const StringType &object, SizeType index) {
 		return;
 	}
 
-	SizeType capacity = lookupCapacity(m_size + object.m_size);
-	assume(m_size + object.m_size < capacity);
+	if (capacity() <= m_size + object.m_size) {
+		SizeType capacity = lookupCapacity(m_size + object.m_size, this->capacity());
+		assume(m_size + object.m_size < capacity);
 
-	if (m_capacity < capacity) {
-		Pointer data = new ValueType[capacity];
+		Pointer data = allocateStorage(capacity, m_size + object.m_size, AllocationCause::INSERT);
 
 		std::copy(m_data, m_data + index, data);
 		std::copy(m_data + index, m_data + m_size, data + index + object.m_size);
 		std::copy(object.m_data, object.m_data + object.m_size, data + index);
 
-		delete[] m_data;
-		m_data = data;
-		m_capacity = capacity;
+		replaceStorage(data, capacity);
 	}
 	else {
 		std::copy_backward(m_data + index, m_data + m_size, m_data + m_size + object.m_size);
@@ -817,9 +1339,11 @@ void StringType<ValueType>::insert(const StringType &object, SizeType index) {
 }
 
 /*
+	Only a heap buffer can be stolen from object; when it would have fit inline, *this has room anyway.
+	The buffer must also come from an equal allocator so that it can be freed through this string.
 */
-template <typename ValueType>
-void StringType<ValueType>::insert(StringType &&object, SizeType index) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::insert(StringType &&object, SizeType index) {
 
 	assert_assume(index < m_size);
 
@@ -827,886 +1351,931 @@ void StringType<ValueType>::insert(StringType &&object, SizeType index) {
 		return;
 	}
 
-	SizeType capacity = lookupCapacity(m_size + object.m_size);
-	assume(m_size + object.m_size < capacity);
+	SizeType size = m_size + object.m_size;
 
-	if (m_capacity < capacity) {
+	if (capacity() <= size) {
 
-		if (object.m_capacity >= capacity) {
+		if (object.capacity() > size && allocatorReference() == object.allocatorReference()) {
+			assume(!object.isLocal());
 
 			std::copy_backward(object.m_data, object.m_data + object.m_size, object.m_data + object.m_size + index);
 			std::copy(m_data, m_data + index, object.m_data);
 			std::copy(m_data + index, m_data + m_size, object.m_data + object.m_size + index);
 
-			delete[] m_data;
-			m_data = object.m_data;
-			m_size += object.m_size;
-			m_capacity = object.m_capacity;
-
-			object.m_data = nullptr;
-			object.m_size = 0;
-			object.m_capacity = 0;
+			replaceStorage(object.m_data, object.m_capacity);
+			object.resetLocal();
+			detail::recordSteal();
 		}
 		else {
-			Pointer data = new ValueType[capacity];
+			SizeType capacity = lookupCapacity(size, this->capacity());
+			assume(size < capacity);
+
+			Pointer data = allocateStorage(capacity, size, AllocationCause::INSERT);
 
 			std::copy(m_data, m_data + index, data);
 			std::copy(m_data + index, m_data + m_size, data + index + object.m_size);
 			std::copy(object.m_data, object.m_data + object.m_size, data + index);
 
-			delete[] m_data;
-			m_data = data;
-			m_capacity = capacity;
+			replaceStorage(data, capacity);
 		}
 	}
 	else {
-		std::copy_backward(m_data + index, m_data + m_size, m_data + m_size + object.m_size);
+		std::copy_backward(m_data + index, m_data + m_size, m_data + size);
 		std::copy(object.m_data, object.m_data + object.m_size, m_data + index);
 	}
 
-	m_size += object.m_size;
+	m_size = size;
 	m_data[m_size] = NUL_TERMINATION;
 }
 
 /*
+	Replaces [first, last) with the characters of with, which may come from this string.
+	The tail moves once, in place when the result fits and into a new buffer otherwise.
 */
-template <typename ValueType>
-StringType<ValueType> &StringType<ValueType>::operator+=(ValueType character) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+void StringType<ValueType, AllocatorType, GrowthPolicyType>::replace(SizeType first, SizeType last, ViewType with) {
 
-	SizeType capacity = lookupCapacity(m_size + 1);
-	assume(m_size + 1 < capacity);
+	assert_assume(first <= last);
+	assert_assume(last <= m_size);
 
-	if (m_capacity < capacity) {
-		Pointer data = new ValueType[capacity];
+	if (overlaps(with)) {
+		StringType copy{with, allocatorReference()};
+		replace(first, last, ViewType{copy});
+		return;
+	}
 
-		std::copy(m_data, m_data + m_size, data);
+	SizeType removed = last - first;
+	SizeType added = with.size();
+	SizeType size = m_size - removed + added;
 
-		delete[] m_data;
-		m_data = data;
-		m_capacity = capacity;
+	if (capacity() <= size) {
+		SizeType capacity = lookupCapacity(size, this->capacity());
+		assume(size < capacity);
+
+		Pointer data = allocateStorage(capacity, size, AllocationCause::REPLACE);
+
+		std::copy(m_data, m_data + first, data);
+		std::copy(with.data(), with.data() + added, data + first);
+		std::copy(m_data + last, m_data + m_size, data + first + added);
+
+		replaceStorage(data, capacity);
 	}
+	else {
+		if (added < removed) {
+			std::copy(m_data + last, m_data + m_size, m_data + first + added);
+		}
+		else if (added > removed) {
+			std::copy_backward(m_data + last, m_data + m_size, m_data + size);
+		}
 
-	m_data[m_size] = character;
+		std::copy(with.data(), with.data() + added, m_data + first);
+	}
 
-	++m_size;
+	m_size = size;
 	m_data[m_size] = NUL_TERMINATION;
-
-	return *this;
 }
 
 /*
+	Replaces every occurrence of needle, left to right and without overlaps, and returns how many there were.
+	Each character is written once: a result no longer than the original is compacted in place as matches are found;
+	a longer one is counted first, then built at its final size, in place at the end of the buffer when it fits there.
+	needle must not be empty; needle and replacement may come from this string.
 */
-template <typename ValueType>
-StringType<ValueType> &StringType<ValueType>::operator+=(ConstPointer cstring) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::replaceAll(ViewType needle, ViewType replacement) {
 
-	assert_assume(cstring != nullptr);
+	assert_assume(!needle.empty());
 
-	SizeType size = cstringSize(cstring);
+	if (overlaps(needle) || overlaps(replacement)) {
+		StringType needleCopy{needle, allocatorReference()};
+		StringType replacementCopy{replacement, allocatorReference()};
 
-	if (size == 0) {
-		return *this;
+		return replaceAll(ViewType{needleCopy}, ViewType{replacementCopy});
 	}
 
-	SizeType capacity = lookupCapacity(m_size + size);
-	assume(m_size + size < capacity);
-
-	if (m_capacity < capacity) {
-		Pointer data = new ValueType[capacity];
+	SizeType count = 0;
 
-		std::copy(m_data, m_data + m_size, data);
+	if (replacement.size() <= needle.size()) {
+		m_size = static_cast<SizeType>(replaceMatches(m_data, m_data, m_size, needle, replacement, count) - m_data);
+		m_data[m_size] = NUL_TERMINATION;
 
-		delete[] m_data;
-		m_data = data;
-		m_capacity = capacity;
+		return count;
 	}
 
-	std::copy(cstring, cstring + size, m_data + m_size);
-
-	m_size += size;
-	m_data[m_size] = NUL_TERMINATION;
+	for (SizeType position = 0;; ++count) {
+		SizeType match = detail::findSubstring(m_data + position, m_size - position, needle.data(), needle.size());
 
-	return *this;
-}
+		if (match == detail::NOT_FOUND) {
+			break;
+		}
 
-/*
-*/
-template <typename ValueType>
-StringType<ValueType> &StringType<ValueType>::operator+=(const StringType &object) {
+		position += match + needle.size();
+	}
 
-	if (object.m_size == 0) {
-		return *this;
+	if (count == 0) {
+		return 0;
 	}
 
-	SizeType capacity = lookupCapacity(m_size + object.m_size);
-	assume(m_size + object.m_size < capacity);
+	SizeType size = m_size + count * (replacement.size() - needle.size());
+	SizeType replaced = 0;
 
-	if (m_capacity < capacity) {
-		Pointer data = new ValueType[capacity];
+	if (capacity() <= size) {
+		SizeType capacity = lookupCapacity(size, this->capacity());
+		assume(size < capacity);
 
-		std::copy(m_data, m_data + m_size, data);
+		Pointer data = allocateStorage(capacity, size, AllocationCause::REPLACE);
+		replaceMatches(data, m_data, m_size, needle, replacement, replaced);
 
-		delete[] m_data;
-		m_data = data;
-		m_capacity = capacity;
+		replaceStorage(data, capacity);
+	}
+	else {
+		// Moved to the end of the buffer, the text is read ahead of the output by exactly the room the replacements need.
+		Pointer source = std::copy_backward(m_data, m_data + m_size, m_data + size);
+		replaceMatches(m_data, source, m_size, needle, replacement, replaced);
 	}
 
-	std::copy(object.m_data, object.m_data + object.m_size, m_data + m_size);
+	assert(replaced == count);
 
-	m_size += object.m_size;
+	m_size = size;
 	m_data[m_size] = NUL_TERMINATION;
 
-	return *this;
+	return count;
 }
 
 /*
+	Copies size characters from source to destination with every match of needle replaced, counting the matches,
+	and returns the end of the output. destination may equal source, or lie before it as long as the output
+	never catches up with the input still to be read.
 */
-template <typename ValueType>
-StringType<ValueType> &StringType<ValueType>::operator+=(StringType &&object) {
-
-	if (object.m_size == 0) {
-		return *this;
-	}
-
-	SizeType capacity = lookupCapacity(m_size + object.m_size);
-	assume(m_size + object.m_size < capacity);
-
-	if (m_capacity < capacity) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::Pointer StringType<ValueType, AllocatorType, GrowthPolicyType>::replaceMatches(Pointer destination, ConstPointer source, SizeType size, ViewType needle, ViewType replacement, SizeType &count) noexcept {
 
-		if (object.m_capacity >= capacity) {
+	SizeType read = 0;
 
-			std::copy_backward(object.m_data, object.m_data + object.m_size, object.m_data + object.m_size + m_size);
-			std::copy(m_data, m_data + m_size, object.m_data);
+	for (;;) {
+		SizeType match = detail::findSubstring(source + read, size - read, needle.data(), needle.size());
 
-			delete[] m_data;
-			m_data = object.m_data;
-			m_size += object.m_size;
-			m_capacity = object.m_capacity;
+		if (match == detail::NOT_FOUND) {
+			break;
+		}
 
-			object.m_data = nullptr;
-			object.m_size = 0;
-			object.m_capacity = 0;
+		if (destination != source + read) {
+			std::copy(source + read, source + read + match, destination);
 		}
-		else {
-			Pointer data = new ValueType[capacity];
 
-			std::copy(m_data, m_data + m_size, data);
+		destination = std::copy(replacement.data(), replacement.data() + replacement.size(), destination + match);
 
-			delete[] m_data;
-			m_data = data;
-			m_capacity = capacity;
-		}
+		read += match + needle.size();
+		++count;
 	}
 
-	std::copy(object.m_data, object.m_data + object.m_size, m_data + m_size);
-
-	m_size += object.m_size;
-	m_data[m_size] = NUL_TERMINATION;
+	if (destination != source + read) {
+		std::copy(source + read, source + size, destination);
+	}
 
-	return *this;
+	return destination + (size - read);
 }
 
 /*
+	Whether view points into this string's characters.
 */
-template <typename ValueType>
-StringType<ValueType> StringType<ValueType>::substring(SizeType last) const &{
-
-	assert_assume(last <= m_size);
-
-	SizeType size = last;
-	SizeType capacity = lookupCapacity(size);
-	assume(size < capacity);
-
-	Pointer data = new ValueType[capacity];
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool StringType<ValueType, AllocatorType, GrowthPolicyType>::overlaps(ViewType view) const noexcept {
 
-	std::copy(m_data, m_data + last, data);
-	data[size] = NUL_TERMINATION;
+	std::less<ConstPointer> less;
 
-	return StringType{data, size, capacity};
+	return !view.empty() && !less(view.data(), m_data) && less(view.data(), m_data + m_size);
 }
 
 /*
 */
-template <typename ValueType>
-StringType<ValueType> StringType<ValueType>::substring(SizeType first, SizeType last) const &{
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> &StringType<ValueType, AllocatorType, GrowthPolicyType>::operator+=(ValueType character) {
 
-	assert_assume(first < last);
-	assert_assume(last <= m_size);
+	grow(m_size + 1, AllocationCause::APPEND);
 
-	SizeType size = last - first;
-	SizeType capacity = lookupCapacity(size);
-	assume(size < capacity);
-
-	Pointer data = new ValueType[capacity];
+	m_data[m_size] = character;
 
-	std::copy(m_data + first, m_data + last, data);
-	data[size] = NUL_TERMINATION;
+	++m_size;
+	m_data[m_size] = NUL_TERMINATION;
 
-	return StringType{data, size, capacity};
+	return *this;
 }
 
 /*
 */
-template <typename ValueType>
-StringType<ValueType> StringType<ValueType>::substring(SizeType last) && noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> &StringType<ValueType, AllocatorType, GrowthPolicyType>::operator+=(ConstPointer cstring) {
 
-	assert_assume(last <= m_size);
+	assert_assume(cstring != nullptr);
 
-	SizeType size = last;
-	SizeType capacity = m_capacity;
-	Pointer data = m_data;
+	SizeType size = cstringSize(cstring);
 
-	m_data = nullptr;
-	m_size = 0;
-	m_capacity = 0;
+	if (size == 0) {
+		return *this;
+	}
+
+	grow(m_size + size, AllocationCause::APPEND);
 
-	data[size] = NUL_TERMINATION;
+	std::copy(cstring, cstring + size, m_data + m_size);
 
-	return StringType{data, size, capacity};
+	m_size += size;
+	m_data[m_size] = NUL_TERMINATION;
+
+	return *this;
 }
 
 /*
 */
-template <typename ValueType>
-StringType<ValueType> StringType<ValueType>::substring(SizeType first, SizeType last) && noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> &StringType<ValueType, AllocatorType, GrowthPolicyType>::operator+=(const StringType &object) {
 
-	assert_assume(first < last);
-	assert_assume(last <= m_size);
+	if (object.m_size == 0) {
+		return *this;
+	}
 
-	SizeType size = last - first;
-	SizeType capacity = m_capacity;
-	Pointer data = m_data;
+	grow(m_size + object.m_size, AllocationCause::APPEND);
 
-	m_data = nullptr;
-	m_size = 0;
-	m_capacity = 0;
+	std::copy(object.m_data, object.m_data + object.m_size, m_data + m_size);
 
-	std::copy(data + first, data + last, data);
-	data[size] = NUL_TERMINATION;
+	m_size += object.m_size;
+	m_data[m_size] = NUL_TERMINATION;
 
-	return StringType{data, size, capacity};
+	return *this;
 }
 
-// Comparison Functions
-
 /*
+	Only a heap buffer can be stolen from object; when it would have fit inline, *this has room anyway.
+	The buffer must also come from an equal allocator so that it can be freed through this string.
 */
-template <typename ValueType>
-int StringType<ValueType>::compare(ConstPointer cstring) const noexcept {
-
-	assert_assume(cstring != nullptr);
-
-	SizeType i = 0;
-	for (; i < m_size; ++i) {
-
-		if (cstring[i] == NUL_TERMINATION) {
-			break;
-		}
-		else if (m_data[i] < cstring[i]) {
-			return -1;
-		}
-		else if (m_data[i] > cstring[i]) {
-			return 1;
-		}
-	}
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> &StringType<ValueType, AllocatorType, GrowthPolicyType>::operator+=(StringType &&object) {
 
-	if (cstring[i] != NUL_TERMINATION) {
-		return -1;
-	}
-	else if (m_size > i) {
-		return 1;
-	}
-	else {
-		return 0;
+	if (object.m_size == 0) {
+		return *this;
 	}
-}
 
-/*
-*/
-template <typename ValueType>
-int StringType<ValueType>::compare(const StringType &object) const noexcept {
+	SizeType size = m_size + object.m_size;
 
-	for (SizeType i = 0; i < m_size && i < object.m_size; ++i) {
+	if (capacity() <= size && object.capacity() > size && allocatorReference() == object.allocatorReference()) {
+		assume(!object.isLocal());
 
-		if (m_data[i] < object.m_data[i]) {
-			return -1;
-		}
-		else if (m_data[i] > object.m_data[i]) {
-			return 1;
-		}
-	}
+		std::copy_backward(object.m_data, object.m_data + object.m_size, object.m_data + size);
+		std::copy(m_data, m_data + m_size, object.m_data);
 
-	if (m_size < object.m_size) {
-		return -1;
-	}
-	else if (m_size > object.m_size) {
-		return 1;
+		replaceStorage(object.m_data, object.m_capacity);
+		object.resetLocal();
+		detail::recordSteal();
 	}
 	else {
-		return 0;
-	}
-}
-
-// Mutation Operations
-
-/*
-*/
-template <typename ValueType>
-StringType<ValueType> operator+(const StringType<ValueType> &left, const StringType<ValueType> &right) {
-
-	using SizeType = typename StringType<ValueType>::SizeType;
-	using Pointer = typename StringType<ValueType>::Pointer;
+		grow(size, AllocationCause::APPEND);
 
-	if (left.m_size == 0 && right.m_size == 0) {
-		return StringType<ValueType>{};
+		std::copy(object.m_data, object.m_data + object.m_size, m_data + m_size);
 	}
-	else if (left.m_size == 0) {
-		return StringType<ValueType>{ right };
-	}
-	else if (right.m_size == 0) {
-		return StringType<ValueType>{ left };
-	}
-
-	SizeType size = left.m_size + right.m_size;
-	SizeType capacity = StringType<ValueType>::lookupCapacity(size);
-	assume(size < capacity);
-	Pointer data = new ValueType[capacity];
 
-	std::copy(left.m_data, left.m_data + left.m_size, data);
-	std::copy(right.m_data, right.m_data + right.m_size, data + left.m_size);
-	data[size] = StringType<ValueType>::NUL_TERMINATION;
+	m_size = size;
+	m_data[m_size] = NUL_TERMINATION;
 
-	return StringType<ValueType>{ data, size, capacity };
+	return *this;
 }
 
 /*
+	The view may refer to this string's own characters, which grow() can move to a new buffer.
 */
-template <typename ValueType>
-StringType<ValueType> operator+(const StringType<ValueType> &left, typename StringType<ValueType>::ConstPointer right) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> &StringType<ValueType, AllocatorType, GrowthPolicyType>::operator+=(ViewType view) {
 
-	assert_assume(right != nullptr);
+	SizeType size = view.size();
+
+	if (size == 0) {
+		return *this;
+	}
 
-	using SizeType = typename StringType<ValueType>::SizeType;
-	using Pointer = typename StringType<ValueType>::Pointer;
+	ConstPointer source = view.data();
 
-	SizeType rightSize = StringType<ValueType>::cstringSize(right);
+	bool aliased = !std::less<ConstPointer>{}(source, m_data) && std::less<ConstPointer>{}(source, m_data + m_size);
+	SizeType offset = aliased ? static_cast<SizeType>(source - m_data) : 0;
 
-	if (left.m_size == 0 && rightSize == 0) {
-		return StringType<ValueType>{};
-	}
-	else if (left.m_size == 0) {
-		return StringType<ValueType>{ right };
-	}
-	else if (rightSize == 0) {
-		return StringType<ValueType>{ left };
+	grow(m_size + size, AllocationCause::APPEND);
+
+	if (aliased) {
+		source = m_data + offset;
 	}
 
-	SizeType size = left.m_size + rightSize;
-	SizeType capacity = StringType<ValueType>::lookupCapacity(size);
-	assume(size < capacity);
-	Pointer data = new ValueType[capacity];
+	std::copy(source, source + size, m_data + m_size);
 
-	std::copy(left.m_data, left.m_data + left.m_size, data);
-	std::copy(right, right + rightSize, data + left.m_size);
-	data[size] = StringType<ValueType>::NUL_TERMINATION;
+	m_size += size;
+	m_data[m_size] = NUL_TERMINATION;
 
-	return StringType<ValueType>{ data, size, capacity };
+	return *this;
 }
 
 /*
+	Copies the pieces straight into place. When the buffer has to grow, the old one is freed only after
+	the copy, so pieces that refer to this string still read valid characters.
 */
-template <typename ValueType>
-StringType<ValueType> operator+(typename StringType<ValueType>::ConstPointer left, const StringType<ValueType> &right) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+template <typename Left, typename Right>
+StringType<ValueType, AllocatorType, GrowthPolicyType> &StringType<ValueType, AllocatorType, GrowthPolicyType>::operator+=(const ConcatExpression<StringType, Left, Right> &expression) {
 
-	assert_assume(left != nullptr);
+	SizeType size = m_size + expression.size();
 
-	using SizeType = typename StringType<ValueType>::SizeType;
-	using Pointer = typename StringType<ValueType>::Pointer;
+	if (capacity() > size) {
+		expression.copy(m_data + m_size);
+	}
+	else {
+		SizeType capacity = lookupCapacity(size, this->capacity());
+		assume(size < capacity);
 
-	SizeType leftSize = StringType<ValueType>::cstringSize(left);
+		Pointer data = allocateStorage(capacity, size, AllocationCause::APPEND);
 
-	if (leftSize == 0 && right.m_size == 0) {
-		return StringType<ValueType>{};
-	}
-	else if (leftSize == 0) {
-		return StringType<ValueType>{ right };
-	}
-	else if (right.m_size == 0) {
-		return StringType<ValueType>{ left };
-	}
+		std::copy(m_data, m_data + m_size, data);
+		expression.copy(data + m_size);
 
-	SizeType size = leftSize + right.m_size;
-	SizeType capacity = StringType<ValueType>::lookupCapacity(size);
-	assume(size < capacity);
-	Pointer data = new ValueType[capacity];
+		replaceStorage(data, capacity);
+	}
 
-	std::copy(left, left + leftSize, data);
-	std::copy(right.m_data, right.m_data + right.m_size, data + leftSize);
-	data[size] = StringType<ValueType>::NUL_TERMINATION;
+	m_size = size;
+	m_data[m_size] = NUL_TERMINATION;
 
-	return StringType<ValueType>{ data, size, capacity };
+	return *this;
 }
 
 /*
 */
-template <typename ValueType>
-StringType<ValueType> operator+(const StringType<ValueType> &left, ValueType right) {
-
-	using SizeType = typename StringType<ValueType>::SizeType;
-	using Pointer = typename StringType<ValueType>::Pointer;
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> StringType<ValueType, AllocatorType, GrowthPolicyType>::substring(SizeType last) const &{
 
-	if (left.m_size == 0) {
-		return StringType<ValueType>{ right };
-	}
+	assert_assume(last <= m_size);
 
-	SizeType size = left.m_size + 1;
-	SizeType capacity = StringType<ValueType>::lookupCapacity(size);
-	assume(size < capacity);
-	Pointer data = new ValueType[capacity];
+	StringType result{AllocatorTraits::select_on_container_copy_construction(allocatorReference())};
+	result.initialize(last);
 
-	std::copy(left.m_data, left.m_data + left.m_size, data);
-	data[left.m_size] = right;
-	data[size] = StringType<ValueType>::NUL_TERMINATION;
+	std::copy(m_data, m_data + last, result.m_data);
 
-	return StringType<ValueType>{ data, size, capacity };
+	return result;
 }
 
 /*
 */
-template <typename ValueType>
-StringType<ValueType> operator+(ValueType left, const StringType<ValueType> &right) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> StringType<ValueType, AllocatorType, GrowthPolicyType>::substring(SizeType first, SizeType last) const &{
 
-	using SizeType = typename StringType<ValueType>::SizeType;
-	using Pointer = typename StringType<ValueType>::Pointer;
-
-	if (right.m_size == 0) {
-		return StringType<ValueType>{ left };
-	}
+	assert_assume(first < last);
+	assert_assume(last <= m_size);
 
-	SizeType size = 1 + right.m_size;
-	SizeType capacity = StringType<ValueType>::lookupCapacity(size);
-	assume(size < capacity);
-	Pointer data = new ValueType[capacity];
+	StringType result{AllocatorTraits::select_on_container_copy_construction(allocatorReference())};
+	result.initialize(last - first);
 
-	data[0] = left;
-	std::copy(right.m_data, right.m_data + right.m_size, data + 1);
-	data[size] = StringType<ValueType>::NUL_TERMINATION;
+	std::copy(m_data + first, m_data + last, result.m_data);
 
-	return StringType<ValueType>{ data, size, capacity };
+	return result;
 }
 
 /*
 */
-template <typename ValueType>
-StringType<ValueType> operator+(StringType<ValueType> &&left, StringType<ValueType> &&right) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> StringType<ValueType, AllocatorType, GrowthPolicyType>::substring(SizeType last) && noexcept {
 
-	using SizeType = typename StringType<ValueType>::SizeType;
-	using Pointer = typename StringType<ValueType>::Pointer;
+	assert_assume(last <= m_size);
 
-	if (left.m_size == 0 && right.m_size == 0) {
-		return StringType<ValueType>{};
-	}
-	else if (left.m_size == 0) {
-		return StringType<ValueType>{ std::move(right) };
-	}
-	else if (right.m_size == 0) {
-		return StringType<ValueType>{ std::move(left) };
-	}
+	m_size = last;
+	m_data[m_size] = NUL_TERMINATION;
 
-	SizeType size = left.m_size + right.m_size;
-	SizeType capacity = StringType<ValueType>::lookupCapacity(size);
-	assume(size < capacity);
-	Pointer data = nullptr;
+	return std::move(*this);
+}
 
-	if (left.m_capacity >= capacity) {
-		std::copy(right.m_data, right.m_data + right.m_size, left.m_data + left.m_size);
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> StringType<ValueType, AllocatorType, GrowthPolicyType>::substring(SizeType first, SizeType last) && noexcept {
 
-		data = left.m_data;
-		capacity = left.m_capacity;
+	assert_assume(first < last);
+	assert_assume(last <= m_size);
 
-		left.m_data = nullptr;
-		left.m_size = 0;
-		left.m_capacity = 0;
-	}
-	else if (right.m_capacity >= capacity) {
-		std::copy_backward(right.m_data, right.m_data + right.m_size, right.m_data + size);
-		std::copy(left.m_data, left.m_data + left.m_size, right.m_data);
+	std::copy(m_data + first, m_data + last, m_data);
 
-		data = right.m_data;
-		capacity = right.m_capacity;
+	m_size = last - first;
+	m_data[m_size] = NUL_TERMINATION;
 
-		right.m_data = nullptr;
-		right.m_size = 0;
-		right.m_capacity = 0;
-	}
-	else {
-		data = new ValueType[capacity];
+	return std::move(*this);
+}
 
-		std::copy(left.m_data, left.m_data + left.m_size, data);
-		std::copy(right.m_data, right.m_data + right.m_size, data + left.m_size);
-	}
+/*
+	Copy with the ASCII letters in lower case; every other character, including any above 0x7F, is copied unchanged.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> StringType<ValueType, AllocatorType, GrowthPolicyType>::toLower() const &{
+
+	StringType result{AllocatorTraits::select_on_container_copy_construction(allocatorReference())};
+	result.initialize(m_size);
 
-	data[size] = StringType<ValueType>::NUL_TERMINATION;
+	detail::convertCase(m_data, result.m_data, m_size, detail::UPPER_CASE_LETTERS);
 
-	return StringType<ValueType>{ data, size, capacity };
+	return result;
 }
 
 /*
+	Converts in place and hands the same buffer on.
 */
-template <typename ValueType>
-StringType<ValueType> operator+(StringType<ValueType> &&left, const StringType<ValueType> &right) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> StringType<ValueType, AllocatorType, GrowthPolicyType>::toLower() && noexcept {
 
-	using SizeType = typename StringType<ValueType>::SizeType;
-	using Pointer = typename StringType<ValueType>::Pointer;
+	detail::convertCase(m_data, m_data, m_size, detail::UPPER_CASE_LETTERS);
 
-	if (left.m_size == 0 && right.m_size == 0) {
-		return StringType<ValueType>{};
-	}
-	else if (left.m_size == 0) {
-		return StringType<ValueType>{ right };
-	}
-	else if (right.m_size == 0) {
-		return StringType<ValueType>{ std::move(left) };
-	}
+	return std::move(*this);
+}
 
-	SizeType size = left.m_size + right.m_size;
-	SizeType capacity = StringType<ValueType>::lookupCapacity(size);
-	assume(size < capacity);
-	Pointer data = nullptr;
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> StringType<ValueType, AllocatorType, GrowthPolicyType>::toUpper() const &{
 
-	if (left.m_capacity >= capacity) {
-		std::copy(right.m_data, right.m_data + right.m_size, left.m_data + left.m_size);
+	StringType result{AllocatorTraits::select_on_container_copy_construction(allocatorReference())};
+	result.initialize(m_size);
 
-		data = left.m_data;
-		capacity = left.m_capacity;
+	detail::convertCase(m_data, result.m_data, m_size, detail::LOWER_CASE_LETTERS);
 
-		left.m_data = nullptr;
-		left.m_size = 0;
-		left.m_capacity = 0;
-	}
-	else {
-		data = new ValueType[capacity];
+	return result;
+}
 
-		std::copy(left.m_data, left.m_data + left.m_size, data);
-		std::copy(right.m_data, right.m_data + right.m_size, data + left.m_size);
-	}
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> StringType<ValueType, AllocatorType, GrowthPolicyType>::toUpper() && noexcept {
 
-	data[size] = StringType<ValueType>::NUL_TERMINATION;
+	detail::convertCase(m_data, m_data, m_size, detail::LOWER_CASE_LETTERS);
 
-	return StringType<ValueType>{ data, size, capacity };
+	return std::move(*this);
 }
 
+// Comparison Functions
+
 /*
 */
-template <typename ValueType>
-StringType<ValueType> operator+(const StringType<ValueType> &left, StringType<ValueType> &&right) {
-
-	using SizeType = typename StringType<ValueType>::SizeType;
-	using Pointer = typename StringType<ValueType>::Pointer;
-
-	if (left.m_size == 0 && right.m_size == 0) {
-		return StringType<ValueType>{};
-	}
-	else if (left.m_size == 0) {
-		return StringType<ValueType>{ std::move(right) };
-	}
-	else if (right.m_size == 0) {
-		return StringType<ValueType>{ left };
-	}
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+int StringType<ValueType, AllocatorType, GrowthPolicyType>::compare(ConstPointer cstring) const noexcept {
+	return ViewType{*this}.compare(cstring);
+}
 
-	SizeType size = left.m_size + right.m_size;
-	SizeType capacity = StringType<ValueType>::lookupCapacity(size);
-	assume(size < capacity);
-	Pointer data = nullptr;
+/*
+	The first differing character is located with a vectorized kernel and only that pair is compared,
+	so the ordering is still decided by ValueType exactly as before.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+int StringType<ValueType, AllocatorType, GrowthPolicyType>::compare(ViewType view) const noexcept {
+	return ViewType{*this}.compare(view);
+}
 
-	if (right.m_capacity >= capacity) {
-		std::copy_backward(right.m_data, right.m_data + right.m_size, right.m_data + size);
-		std::copy(left.m_data, left.m_data + left.m_size, right.m_data);
+/*
+	ASCII letters compare as their lower case forms; all other characters compare as they are.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+int StringType<ValueType, AllocatorType, GrowthPolicyType>::compareIgnoreCase(ConstPointer cstring) const noexcept {
+	return ViewType{*this}.compareIgnoreCase(cstring);
+}
 
-		data = right.m_data;
-		capacity = right.m_capacity;
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+int StringType<ValueType, AllocatorType, GrowthPolicyType>::compareIgnoreCase(ViewType view) const noexcept {
+	return ViewType{*this}.compareIgnoreCase(view);
+}
 
-		right.m_data = nullptr;
-		right.m_size = 0;
-		right.m_capacity = 0;
-	}
-	else {
-		data = new ValueType[capacity];
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool StringType<ValueType, AllocatorType, GrowthPolicyType>::equalsIgnoreCase(ConstPointer cstring) const noexcept {
+	return ViewType{*this}.equalsIgnoreCase(cstring);
+}
 
-		std::copy(left.m_data, left.m_data + left.m_size, data);
-		std::copy(right.m_data, right.m_data + right.m_size, data + left.m_size);
-	}
+/*
+	Sizes are checked first, so only strings of equal length are scanned.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool StringType<ValueType, AllocatorType, GrowthPolicyType>::equalsIgnoreCase(ViewType view) const noexcept {
+	return ViewType{*this}.equalsIgnoreCase(view);
+}
 
-	data[size] = StringType<ValueType>::NUL_TERMINATION;
+// Search Functions
 
-	return StringType<ValueType>{ data, size, capacity };
+/*
+	Index of the first occurrence at or after position, or NOT_FOUND.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::find(ValueType character, SizeType position) const noexcept {
+	return ViewType{*this}.find(character, position);
 }
 
 /*
+	Short needles are located with a vectorized first and last character filter, longer ones with Two-Way,
+	so the search stays linear in the size of the string whatever the input.
 */
-template <typename ValueType>
-StringType<ValueType> operator+(StringType<ValueType> &&left, typename StringType<ValueType>::ConstPointer right) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::find(ConstPointer cstring, SizeType position) const noexcept {
+	return ViewType{*this}.find(cstring, position);
+}
 
-	using SizeType = typename StringType<ValueType>::SizeType;
-	using Pointer = typename StringType<ValueType>::Pointer;
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::find(ViewType view, SizeType position) const noexcept {
+	return ViewType{*this}.find(view, position);
+}
 
-	assert_assume(right != nullptr);
+/*
+	Index of the last occurrence starting at or before position, or NOT_FOUND.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::rfind(ValueType character, SizeType position) const noexcept {
+	return ViewType{*this}.rfind(character, position);
+}
 
-	SizeType rightSize = StringType<ValueType>::cstringSize(right);
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::rfind(ConstPointer cstring, SizeType position) const noexcept {
+	return ViewType{*this}.rfind(cstring, position);
+}
 
-	if (left.m_size == 0 && rightSize == 0) {
-		return StringType<ValueType>{};
-	}
-	else if (left.m_size == 0) {
-		return StringType<ValueType>{ right };
-	}
-	else if (rightSize == 0) {
-		return StringType<ValueType>{ std::move(left) };
-	}
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::rfind(ViewType view, SizeType position) const noexcept {
+	return ViewType{*this}.rfind(view, position);
+}
 
-	SizeType size = left.m_size + rightSize;
-	SizeType capacity = StringType<ValueType>::lookupCapacity(size);
-	assume(size < capacity);
-	Pointer data = nullptr;
+/*
+	Index of the first occurrence at or after position when ASCII letters match in either case, or NOT_FOUND.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::findIgnoreCase(ValueType character, SizeType position) const noexcept {
+	return ViewType{*this}.findIgnoreCase(character, position);
+}
 
-	if (left.m_capacity >= capacity) {
-		std::copy(right, right + rightSize, left.m_data + left.m_size);
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::findIgnoreCase(ConstPointer cstring, SizeType position) const noexcept {
+	return ViewType{*this}.findIgnoreCase(cstring, position);
+}
 
-		data = left.m_data;
-		capacity = left.m_capacity;
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::findIgnoreCase(ViewType view, SizeType position) const noexcept {
+	return ViewType{*this}.findIgnoreCase(view, position);
+}
 
-		left.m_data = nullptr;
-		left.m_size = 0;
-		left.m_capacity = 0;
-	}
-	else {
-		data = new ValueType[capacity];
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool StringType<ValueType, AllocatorType, GrowthPolicyType>::contains(ValueType character) const noexcept {
+	return ViewType{*this}.contains(character);
+}
 
-		std::copy(left.m_data, left.m_data + left.m_size, data);
-		std::copy(right, right + rightSize, data + left.m_size);
-	}
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool StringType<ValueType, AllocatorType, GrowthPolicyType>::contains(ConstPointer cstring) const noexcept {
+	return ViewType{*this}.contains(cstring);
+}
 
-	data[size] = StringType<ValueType>::NUL_TERMINATION;
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool StringType<ValueType, AllocatorType, GrowthPolicyType>::contains(ViewType view) const noexcept {
+	return ViewType{*this}.contains(view);
+}
 
-	return StringType<ValueType>{ data, size, capacity };
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool StringType<ValueType, AllocatorType, GrowthPolicyType>::startsWith(ValueType character) const noexcept {
+	return ViewType{*this}.startsWith(character);
 }
 
 /*
 */
-template <typename ValueType>
-StringType<ValueType> operator+(typename StringType<ValueType>::ConstPointer left, StringType<ValueType> &&right) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool StringType<ValueType, AllocatorType, GrowthPolicyType>::startsWith(ConstPointer cstring) const noexcept {
+	return ViewType{*this}.startsWith(cstring);
+}
 
-	using SizeType = typename StringType<ValueType>::SizeType;
-	using Pointer = typename StringType<ValueType>::Pointer;
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool StringType<ValueType, AllocatorType, GrowthPolicyType>::startsWith(ViewType view) const noexcept {
+	return ViewType{*this}.startsWith(view);
+}
 
-	assert_assume(left != nullptr);
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool StringType<ValueType, AllocatorType, GrowthPolicyType>::endsWith(ValueType character) const noexcept {
+	return ViewType{*this}.endsWith(character);
+}
 
-	SizeType leftSize = StringType<ValueType>::cstringSize(left);
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool StringType<ValueType, AllocatorType, GrowthPolicyType>::endsWith(ConstPointer cstring) const noexcept {
+	return ViewType{*this}.endsWith(cstring);
+}
 
-	if (leftSize == 0 && right.m_size == 0) {
-		return StringType<ValueType>{};
-	}
-	else if (leftSize == 0) {
-		return StringType<ValueType>{ std::move(right) };
-	}
-	else if (right.m_size == 0) {
-		return StringType<ValueType>{ left };
-	}
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool StringType<ValueType, AllocatorType, GrowthPolicyType>::endsWith(ViewType view) const noexcept {
+	return ViewType{*this}.endsWith(view);
+}
 
-	SizeType size = leftSize + right.m_size;
-	SizeType capacity = StringType<ValueType>::lookupCapacity(size);
-	assume(size < capacity);
-	Pointer data = nullptr;
+/*
+	Index of the first character at or after position that appears in set, or NOT_FOUND.
+	Sets of up to four characters are matched a whole vector at a time, larger ones through a lookup table.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::findFirstOf(ConstPointer set, SizeType position) const noexcept {
+	return ViewType{*this}.findFirstOf(set, position);
+}
 
-	if (right.m_capacity >= capacity) {
-		std::copy_backward(right.m_data, right.m_data + right.m_size, right.m_data + size);
-		std::copy(left, left + leftSize, right.m_data);
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::findFirstOf(ViewType set, SizeType position) const noexcept {
+	return ViewType{*this}.findFirstOf(set, position);
+}
 
-		data = right.m_data;
-		capacity = right.m_capacity;
+/*
+	Index of the first character at or after position that does not appear in set, or NOT_FOUND.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::findFirstNotOf(ConstPointer set, SizeType position) const noexcept {
+	return ViewType{*this}.findFirstNotOf(set, position);
+}
 
-		right.m_data = nullptr;
-		right.m_size = 0;
-		right.m_capacity = 0;
-	}
-	else {
-		data = new ValueType[capacity];
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::findFirstNotOf(ViewType set, SizeType position) const noexcept {
+	return ViewType{*this}.findFirstNotOf(set, position);
+}
 
-		std::copy(left, left + leftSize, data);
-		std::copy(right.m_data, right.m_data + right.m_size, data + leftSize);
-	}
+// Split Functions
 
-	data[size] = StringType<ValueType>::NUL_TERMINATION;
+/*
+	Lazily yields views of the pieces between delimiters; see SplitRange.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+SplitRange<ValueType> StringType<ValueType, AllocatorType, GrowthPolicyType>::split(ValueType delimiter) const & noexcept {
+	return ViewType{*this}.split(delimiter);
+}
 
-	return StringType<ValueType>{ data, size, capacity };
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+SplitRange<ValueType> StringType<ValueType, AllocatorType, GrowthPolicyType>::split(ViewType delimiter) const & noexcept {
+	return ViewType{*this}.split(delimiter);
 }
 
 /*
 */
-template <typename ValueType>
-StringType<ValueType> operator+(StringType<ValueType> &&left, ValueType right) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+SplitRange<ValueType> StringType<ValueType, AllocatorType, GrowthPolicyType>::splitAny(ViewType set) const & noexcept {
+	return ViewType{*this}.splitAny(set);
+}
 
-	using SizeType = typename StringType<ValueType>::SizeType;
-	using Pointer = typename StringType<ValueType>::Pointer;
+// Numeric Functions
 
-	if (left.m_size == 0) {
-		return StringType<ValueType>{ right };
-	}
+/*
+	Appends value in decimal, with a '-' if it is negative. The digits are counted first,
+	so the buffer grows at most once and the digits are written straight into it.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+template <typename IntegerType, typename>
+StringType<ValueType, AllocatorType, GrowthPolicyType> &StringType<ValueType, AllocatorType, GrowthPolicyType>::appendInteger(IntegerType value) {
 
-	SizeType size = left.m_size + 1;
-	SizeType capacity = StringType<ValueType>::lookupCapacity(size);
-	assume(size < capacity);
-	Pointer data = nullptr;
+	bool negative;
+	std::uint64_t magnitude = detail::splitSign(value, negative, std::is_signed<IntegerType>{});
 
-	if (left.m_capacity >= capacity) {
-		left.m_data[left.m_size] = right;
+	unsigned length = detail::decimalLength(magnitude);
+	SizeType size = m_size + (negative ? 1 : 0) + length;
 
-		data = left.m_data;
-		capacity = left.m_capacity;
+	grow(size, AllocationCause::APPEND);
 
-		left.m_data = nullptr;
-		left.m_size = 0;
-		left.m_capacity = 0;
-	}
-	else {
-		data = new ValueType[capacity];
+	Pointer output = m_data + m_size;
 
-		std::copy(left.m_data, left.m_data + left.m_size, data);
-		data[left.m_size] = right;
+	if (negative) {
+		*output++ = static_cast<ValueType>('-');
 	}
 
-	data[size] = StringType<ValueType>::NUL_TERMINATION;
+	detail::writeDecimal(output, magnitude, length);
+
+	m_size = size;
+	m_data[m_size] = NUL_TERMINATION;
 
-	return StringType<ValueType>{ data, size, capacity };
+	return *this;
 }
 
 /*
+	Appends the shortest decimal text that parseDouble(), strtod or strtof reads back as exactly value
+	(see SimpleStringNumeric.hpp for the layout); infinities and NaN are written as inf, -inf and nan.
 */
-template <typename ValueType>
-StringType<ValueType> operator+(ValueType left, StringType<ValueType> &&right) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> &StringType<ValueType, AllocatorType, GrowthPolicyType>::appendFloat(float value) {
+	return appendFloatingPoint(value);
+}
 
-	using SizeType = typename StringType<ValueType>::SizeType;
-	using Pointer = typename StringType<ValueType>::Pointer;
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> &StringType<ValueType, AllocatorType, GrowthPolicyType>::appendFloat(double value) {
+	return appendFloatingPoint(value);
+}
 
-	if (right.m_size == 0) {
-		return StringType<ValueType>{ left };
-	}
+/*
+	Finds the digits first, so the exact length of the text is known before the buffer is touched.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+template <typename FloatType>
+StringType<ValueType, AllocatorType, GrowthPolicyType> &StringType<ValueType, AllocatorType, GrowthPolicyType>::appendFloatingPoint(FloatType value) {
 
-	SizeType size = 1 + right.m_size;
-	SizeType capacity = StringType<ValueType>::lookupCapacity(size);
-	assume(size < capacity);
-	Pointer data = nullptr;
+	detail::FloatDecimal decimal = detail::shortestDecimal(value);
+	SizeType size = m_size + detail::floatTextLength(decimal);
 
-	if (right.m_capacity >= capacity) {
-		std::copy_backward(right.m_data, right.m_data + right.m_size, right.m_data + size);
-		right.m_data[0] = left;
+	grow(size, AllocationCause::APPEND);
 
-		data = right.m_data;
-		capacity = right.m_capacity;
+	detail::writeFloatText(m_data + m_size, decimal);
 
-		right.m_data = nullptr;
-		right.m_size = 0;
-		right.m_capacity = 0;
-	}
-	else {
-		data = new ValueType[capacity];
+	m_size = size;
+	m_data[m_size] = NUL_TERMINATION;
 
-		data[0] = left;
-		std::copy(right.m_data, right.m_data + right.m_size, data + 1);
-	}
+	return *this;
+}
+
+/*
+	Same as parseInt() on a view of this string.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+template <typename IntegerType>
+ParseResult<IntegerType> StringType<ValueType, AllocatorType, GrowthPolicyType>::parseInt(unsigned base) const noexcept {
+	return ViewType{*this}.template parseInt<IntegerType>(base);
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+ParseResult<double> StringType<ValueType, AllocatorType, GrowthPolicyType>::parseDouble() const {
+	return ViewType{*this}.parseDouble();
+}
 
-	data[size] = StringType<ValueType>::NUL_TERMINATION;
+// Hash Functions
 
-	return StringType<ValueType>{ data, size, capacity };
+/*
+	Same value as the hash of a view of this string.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType StringType<ValueType, AllocatorType, GrowthPolicyType>::hash() const noexcept {
+	return ViewType{*this}.hash();
 }
 
 // Comparison Operations
 
 /*
 */
-template <typename ValueType>
-bool operator==(const StringType<ValueType> &left, const StringType<ValueType> &right) noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool operator==(const StringType<ValueType, AllocatorType, GrowthPolicyType> &left, const StringType<ValueType, AllocatorType, GrowthPolicyType> &right) noexcept {
 
-	using SizeType = typename StringType<ValueType>::SizeType;
+	using SizeType = typename StringType<ValueType, AllocatorType, GrowthPolicyType>::SizeType;
 
-	if (left.m_size != right.m_size) {
+	SizeType size = left.m_size;
+
+	if (size != right.m_size) {
 		return false;
 	}
 
-	if (left.m_size == 0) {
+	if (size == 0) {
 		return true;
 	}
 
-	for (SizeType i = 0; i < left.m_size; ++i) {
-
-		if (left.m_data[i] != right.m_data[i]) {
-			return false;
-		}
+	// Strings that differ usually do so at one of the ends, which is much cheaper to check than the middle.
+	if (left.m_data[0] != right.m_data[0] || left.m_data[size - 1] != right.m_data[size - 1]) {
+		return false;
 	}
 
-	return true;
+	return detail::mismatch(left.m_data, right.m_data, size) == size;
 }
 
 /*
 */
-template <typename ValueType>
-bool operator==(const StringType<ValueType> &left, typename StringType<ValueType>::ConstPointer right) noexcept {
-
-	using SizeType = typename StringType<ValueType>::SizeType;
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool operator==(const StringType<ValueType, AllocatorType, GrowthPolicyType> &left, typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstPointer right) noexcept {
 
 	assert_assume(right != nullptr);
 
-	for (SizeType i = 0; i < left.m_size; ++i) {
-
-		if (right[i] == StringType<ValueType>::NUL_TERMINATION || left.m_data[i] != right[i]) {
-			return false;
-		}
+	if (detail::mismatchTerminated(left.m_data, right, left.m_size) != left.m_size) {
+		return false;
 	}
 
-	return right[left.m_size] == StringType<ValueType>::NUL_TERMINATION;
+	return right[left.m_size] == StringType<ValueType, AllocatorType, GrowthPolicyType>::NUL_TERMINATION;
 }
 
 /*
 */
-template <typename ValueType>
-bool operator==(typename StringType<ValueType>::ConstPointer left, const StringType<ValueType> &right) noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool operator==(typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstPointer left, const StringType<ValueType, AllocatorType, GrowthPolicyType> &right) noexcept {
 	return right == left;
 }
 
 /*
 */
-template <typename ValueType>
-bool operator!=(const StringType<ValueType> &left, const StringType<ValueType> &right) noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool operator!=(const StringType<ValueType, AllocatorType, GrowthPolicyType> &left, const StringType<ValueType, AllocatorType, GrowthPolicyType> &right) noexcept {
 	return !(left == right);
 }
 
 /*
 */
-template <typename ValueType>
-bool operator!=(const StringType<ValueType> &left, typename StringType<ValueType>::ConstPointer right) noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool operator!=(const StringType<ValueType, AllocatorType, GrowthPolicyType> &left, typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstPointer right) noexcept {
 	return !(left == right);
 }
 
 /*
 */
-template <typename ValueType>
-bool operator!=(typename StringType<ValueType>::ConstPointer left, const StringType<ValueType> &right) noexcept {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool operator!=(typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ConstPointer left, const StringType<ValueType, AllocatorType, GrowthPolicyType> &right) noexcept {
 	return !(left == right);
 }
 
-// Output Stream Operations
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool operator==(const StringType<ValueType, AllocatorType, GrowthPolicyType> &left, StringViewType<ValueType> right) noexcept {
+	return StringViewType<ValueType>{left} == right;
+}
 
 /*
 */
-template <typename ValueType>
-std::ostream &operator<<(std::ostream &os, const StringType<ValueType> &object) {
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool operator==(StringViewType<ValueType> left, const StringType<ValueType, AllocatorType, GrowthPolicyType> &right) noexcept {
+	return left == StringViewType<ValueType>{right};
+}
 
-	using SizeType = typename StringType<ValueType>::SizeType;
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool operator!=(const StringType<ValueType, AllocatorType, GrowthPolicyType> &left, StringViewType<ValueType> right) noexcept {
+	return !(left == right);
+}
 
-	for (SizeType i = 0; i < object.m_size; ++i) {
-		os << object.m_data[i];
-	}
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType>
+bool operator!=(StringViewType<ValueType> left, const StringType<ValueType, AllocatorType, GrowthPolicyType> &right) noexcept {
+	return !(left == right);
+}
+
+// Stream Operations
+
+/*
+	Writes the whole buffer at once, padded to the stream's field width.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType, typename Traits>
+std::basic_ostream<ValueType, Traits> &operator<<(std::basic_ostream<ValueType, Traits> &os, const StringType<ValueType, AllocatorType, GrowthPolicyType> &object) {
+	return detail::writeCharacters(os, object.m_data, object.m_size);
+}
+
+/*
+	Reads one whitespace-delimited word, copying runs of characters straight from the stream's buffer.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType, typename Traits>
+std::basic_istream<ValueType, Traits> &operator>>(std::basic_istream<ValueType, Traits> &is, StringType<ValueType, AllocatorType, GrowthPolicyType> &object) {
+
+	using ViewType = typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ViewType;
+
+	return detail::readWord(is, [&object] { object.clear(); }, [&object](const ValueType *data, std::size_t size) { object += ViewType{data, size}; });
+}
+
+/*
+	Reads up to delimiter, which is consumed but not stored.
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType, typename Traits>
+std::basic_istream<ValueType, Traits> &getline(std::basic_istream<ValueType, Traits> &is, StringType<ValueType, AllocatorType, GrowthPolicyType> &object, ValueType delimiter) {
 
-	return os;
+	using ViewType = typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ViewType;
+
+	return detail::readLine(is, delimiter, [&object] { object.clear(); }, [&object](const ValueType *data, std::size_t size) { object += ViewType{data, size}; });
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType, typename GrowthPolicyType, typename Traits>
+std::basic_istream<ValueType, Traits> &getline(std::basic_istream<ValueType, Traits> &is, StringType<ValueType, AllocatorType, GrowthPolicyType> &object) {
+
+	using ViewType = typename StringType<ValueType, AllocatorType, GrowthPolicyType>::ViewType;
+
+	return detail::readLine(is, is.widen('\n'), [&object] { object.clear(); }, [&object](const ValueType *data, std::size_t size) { object += ViewType{data, size}; });
 }
 
 
@@ -1717,6 +2286,20 @@ using String = StringType<char>;
 }
 
 
+namespace std {
+
+/*
+*/
+template <typename CharType, typename Allocator, typename GrowthPolicy>
+struct hash<simple::StringType<CharType, Allocator, GrowthPolicy>> {
+	std::size_t operator()(const simple::StringType<CharType, Allocator, GrowthPolicy> &object) const noexcept {
+		return object.hash();
+	}
+};
+
+}
+
+
 #undef assume
 #undef assert_assume
 
@@ -0,0 +1,495 @@
+#pragma once
+#ifndef SIMPLE_STRING_BUILDER_HPP
+#define SIMPLE_STRING_BUILDER_HPP
+
+
+#include "SimpleString.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+
+
+namespace simple {
+
+
+namespace detail {
+
+/*
+	Whether Type is one of the character types, which append() does not format as integers.
+*/
+template <typename Type>
+struct IsCharacter : std::integral_constant<bool, std::is_same<Type, char>::value || std::is_same<Type, wchar_t>::value ||
+	std::is_same<Type, char16_t>::value || std::is_same<Type, char32_t>::value> {};
+
+}
+
+
+/*
+	Accumulates text in a chain of chunks and produces a string from it once, at the end.
+	A full chunk is never reallocated or copied, so appending costs the same however much has been
+	appended before; build() then copies each chunk once into a buffer of exactly the final size.
+	Chunk sizes double from MINIMUM_CHUNK up to MAXIMUM_CHUNK, so short results take a single small chunk.
+*/
+template <typename CharType, typename Allocator = std::allocator<CharType>>
+class StringBuilderType : private Allocator {
+public:
+
+	// Type Aliases
+
+	using ValueType = CharType;
+	using SizeType = std::size_t;
+
+	using AllocatorType = Allocator;
+
+	using Pointer = ValueType *;
+	using ConstPointer = const ValueType *;
+
+	using StorageType = StringType<ValueType, AllocatorType>;
+	using ViewType = StringViewType<ValueType>;
+
+	// Constants
+
+	// Capacity of the first chunk, and of the largest, in characters.
+	static constexpr SizeType MINIMUM_CHUNK = 256 / sizeof(ValueType);
+	static constexpr SizeType MAXIMUM_CHUNK = 65536 / sizeof(ValueType);
+
+private:
+
+	// Allocator Aliases
+
+	using AllocatorTraits = std::allocator_traits<Allocator>;
+
+	// Chunk Types
+
+	struct Chunk {
+		Pointer data;
+		SizeType capacity;
+	};
+
+	using ChunkAllocator = typename AllocatorTraits::template rebind_alloc<Chunk>;
+
+	// Data Members
+
+	std::vector<Chunk, ChunkAllocator> m_chunks;
+
+	// Append position in the last chunk and its end.
+	Pointer m_cursor{};
+	Pointer m_limit{};
+
+	// Characters in every chunk but the last, which are all full.
+	SizeType m_filled{};
+
+	// Storage Functions
+
+	AllocatorType &allocatorReference() noexcept;
+	const AllocatorType &allocatorReference() const noexcept;
+
+	void addChunk();
+	void appendRange(ConstPointer, SizeType);
+
+	template <typename FloatType>
+	void appendFloatingPoint(FloatType);
+
+public:
+
+	// Constructors
+
+	StringBuilderType() noexcept(noexcept(AllocatorType()));
+	explicit StringBuilderType(const AllocatorType &) noexcept;
+	StringBuilderType(const StringBuilderType &) = delete;
+	StringBuilderType(StringBuilderType &&) noexcept;
+
+	// Destructor
+
+	~StringBuilderType() noexcept;
+
+	// Assignment Operations
+
+	StringBuilderType &operator=(const StringBuilderType &) = delete;
+	StringBuilderType &operator=(StringBuilderType &&) = delete;
+
+	// Allocator Functions
+
+	AllocatorType allocator() const noexcept;
+
+	// Size Functions
+
+	SizeType size() const noexcept;
+	bool empty() const noexcept;
+
+	// Mutation Functions
+
+	void clear() noexcept;
+
+	StringBuilderType &append(ValueType);
+	StringBuilderType &append(ValueType, SizeType);
+	StringBuilderType &append(ConstPointer);
+	StringBuilderType &append(ViewType);
+
+	template <typename IntegerType, typename = typename std::enable_if<std::is_integral<IntegerType>::value && !std::is_same<IntegerType, bool>::value && !detail::IsCharacter<IntegerType>::value>::type>
+	StringBuilderType &append(IntegerType);
+
+	// A character of another type is neither formatted as a number nor converted.
+	template <typename OtherCharType>
+	typename std::enable_if<detail::IsCharacter<OtherCharType>::value && !std::is_same<OtherCharType, ValueType>::value, StringBuilderType &>::type append(OtherCharType) = delete;
+
+	StringBuilderType &append(float);
+	StringBuilderType &append(double);
+	StringBuilderType &append(long double);
+
+	// Conversion Functions
+
+	StorageType build() const;
+};
+
+
+// Constants
+
+template <typename ValueType, typename AllocatorType>
+constexpr typename StringBuilderType<ValueType, AllocatorType>::SizeType StringBuilderType<ValueType, AllocatorType>::MINIMUM_CHUNK;
+
+template <typename ValueType, typename AllocatorType>
+constexpr typename StringBuilderType<ValueType, AllocatorType>::SizeType StringBuilderType<ValueType, AllocatorType>::MAXIMUM_CHUNK;
+
+
+// Storage Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+AllocatorType &StringBuilderType<ValueType, AllocatorType>::allocatorReference() noexcept {
+	return *this;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+const AllocatorType &StringBuilderType<ValueType, AllocatorType>::allocatorReference() const noexcept {
+	return *this;
+}
+
+/*
+	Starts a new chunk, twice the size of the last one up to MAXIMUM_CHUNK. The chain has room for the record
+	before the chunk is allocated, so nothing leaks if either allocation throws.
+*/
+template <typename ValueType, typename AllocatorType>
+void StringBuilderType<ValueType, AllocatorType>::addChunk() {
+
+	SizeType capacity = m_chunks.empty() ? MINIMUM_CHUNK : std::min(2 * m_chunks.back().capacity, MAXIMUM_CHUNK);
+
+	m_chunks.reserve(m_chunks.size() + 1);
+
+	Pointer data = AllocatorTraits::allocate(allocatorReference(), capacity);
+
+	if (!m_chunks.empty()) {
+		m_filled += m_chunks.back().capacity;
+	}
+
+	m_chunks.push_back(Chunk{data, capacity});
+
+	m_cursor = data;
+	m_limit = data + capacity;
+}
+
+/*
+	Fills the last chunk and continues in new ones.
+*/
+template <typename ValueType, typename AllocatorType>
+void StringBuilderType<ValueType, AllocatorType>::appendRange(ConstPointer data, SizeType size) {
+
+	while (size != 0) {
+		if (m_cursor == m_limit) {
+			addChunk();
+		}
+
+		SizeType count = std::min(size, static_cast<SizeType>(m_limit - m_cursor));
+
+		m_cursor = std::copy(data, data + count, m_cursor);
+
+		data += count;
+		size -= count;
+	}
+}
+
+/*
+	Formats into a local buffer, since the text may straddle two chunks.
+*/
+template <typename ValueType, typename AllocatorType>
+template <typename FloatType>
+void StringBuilderType<ValueType, AllocatorType>::appendFloatingPoint(FloatType value) {
+
+	ValueType text[detail::FLOAT_TEXT_CAPACITY];
+
+	detail::FloatDecimal decimal = detail::shortestDecimal(value);
+	ValueType *last = detail::writeFloatText(text, decimal);
+
+	appendRange(text, static_cast<SizeType>(last - text));
+}
+
+
+// Constructors
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+StringBuilderType<ValueType, AllocatorType>::StringBuilderType() noexcept(noexcept(AllocatorType())) :
+	m_chunks{ChunkAllocator{allocatorReference()}} {}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+StringBuilderType<ValueType, AllocatorType>::StringBuilderType(const AllocatorType &allocator) noexcept :
+	AllocatorType{allocator}, m_chunks{ChunkAllocator{allocator}} {}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+StringBuilderType<ValueType, AllocatorType>::StringBuilderType(StringBuilderType &&object) noexcept :
+	AllocatorType{std::move(object.allocatorReference())}, m_chunks{std::move(object.m_chunks)},
+	m_cursor{object.m_cursor}, m_limit{object.m_limit}, m_filled{object.m_filled} {
+
+	object.m_chunks.clear();
+	object.m_cursor = nullptr;
+	object.m_limit = nullptr;
+	object.m_filled = 0;
+}
+
+
+// Destructor
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+StringBuilderType<ValueType, AllocatorType>::~StringBuilderType() noexcept {
+	clear();
+}
+
+
+// Allocator Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+AllocatorType StringBuilderType<ValueType, AllocatorType>::allocator() const noexcept {
+	return allocatorReference();
+}
+
+
+// Size Functions
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+typename StringBuilderType<ValueType, AllocatorType>::SizeType StringBuilderType<ValueType, AllocatorType>::size() const noexcept {
+	return m_chunks.empty() ? 0 : m_filled + static_cast<SizeType>(m_cursor - m_chunks.back().data);
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+bool StringBuilderType<ValueType, AllocatorType>::empty() const noexcept {
+	return size() == 0;
+}
+
+
+// Mutation Functions
+
+/*
+	Frees every chunk.
+*/
+template <typename ValueType, typename AllocatorType>
+void StringBuilderType<ValueType, AllocatorType>::clear() noexcept {
+
+	for (const Chunk &chunk : m_chunks) {
+		AllocatorTraits::deallocate(allocatorReference(), chunk.data, chunk.capacity);
+	}
+
+	m_chunks.clear();
+	m_cursor = nullptr;
+	m_limit = nullptr;
+	m_filled = 0;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+StringBuilderType<ValueType, AllocatorType> &StringBuilderType<ValueType, AllocatorType>::append(ValueType character) {
+
+	if (m_cursor == m_limit) {
+		addChunk();
+	}
+
+	*m_cursor++ = character;
+
+	return *this;
+}
+
+/*
+	Appends count copies of character.
+*/
+template <typename ValueType, typename AllocatorType>
+StringBuilderType<ValueType, AllocatorType> &StringBuilderType<ValueType, AllocatorType>::append(ValueType character, SizeType count) {
+
+	while (count != 0) {
+		if (m_cursor == m_limit) {
+			addChunk();
+		}
+
+		SizeType run = std::min(count, static_cast<SizeType>(m_limit - m_cursor));
+
+		m_cursor = std::fill_n(m_cursor, run, character);
+		count -= run;
+	}
+
+	return *this;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+StringBuilderType<ValueType, AllocatorType> &StringBuilderType<ValueType, AllocatorType>::append(ConstPointer cstring) {
+
+	assert(cstring != nullptr);
+
+	return append(ViewType{cstring});
+}
+
+/*
+	Strings convert to views, so this appends them too.
+*/
+template <typename ValueType, typename AllocatorType>
+StringBuilderType<ValueType, AllocatorType> &StringBuilderType<ValueType, AllocatorType>::append(ViewType view) {
+
+	appendRange(view.data(), view.size());
+
+	return *this;
+}
+
+/*
+	Appends an integer in decimal.
+*/
+template <typename ValueType, typename AllocatorType>
+template <typename IntegerType, typename>
+StringBuilderType<ValueType, AllocatorType> &StringBuilderType<ValueType, AllocatorType>::append(IntegerType value) {
+
+	bool negative;
+	std::uint64_t magnitude = detail::splitSign(value, negative, std::is_signed<IntegerType>{});
+
+	// The magnitude is taken as unsigned, so the most negative value needs no special case.
+	ValueType text[21];
+	ValueType *first = text;
+
+	if (negative) {
+		*first++ = static_cast<ValueType>('-');
+	}
+
+	ValueType *last = detail::writeDecimal(first, magnitude, detail::decimalLength(magnitude));
+
+	appendRange(text, static_cast<SizeType>(last - text));
+
+	return *this;
+}
+
+/*
+	Appends the shortest text that reads back as exactly value, as StringType::appendFloat() does.
+*/
+template <typename ValueType, typename AllocatorType>
+StringBuilderType<ValueType, AllocatorType> &StringBuilderType<ValueType, AllocatorType>::append(float value) {
+
+	appendFloatingPoint(value);
+
+	return *this;
+}
+
+/*
+*/
+template <typename ValueType, typename AllocatorType>
+StringBuilderType<ValueType, AllocatorType> &StringBuilderType<ValueType, AllocatorType>::append(double value) {
+
+	appendFloatingPoint(value);
+
+	return *this;
+}
+
+/*
+	Long doubles have no shortest form here; they get max_digits10 significant digits from snprintf.
+	snprintf writes the locale's decimal point, which may take several bytes; it is written as '.' instead,
+	as the other overloads write it.
+*/
+template <typename ValueType, typename AllocatorType>
+StringBuilderType<ValueType, AllocatorType> &StringBuilderType<ValueType, AllocatorType>::append(long double value) {
+
+	char digits[64];
+	int length = std::snprintf(digits, sizeof(digits), "%.*Lg", std::numeric_limits<long double>::max_digits10, value);
+
+	ValueType text[sizeof(digits)];
+	SizeType size = 0;
+
+	for (int i = 0; i < length && i < static_cast<int>(sizeof(digits)) - 1; ++i) {
+		char character = digits[i];
+
+		if ((character >= '0' && character <= '9') || (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') || character == '-' || character == '+') {
+			text[size++] = static_cast<ValueType>(character);
+		}
+		else if (size == 0 || text[size - 1] != static_cast<ValueType>('.')) {
+			text[size++] = static_cast<ValueType>('.');
+		}
+	}
+
+	appendRange(text, size);
+
+	return *this;
+}
+
+
+// Conversion Functions
+
+/*
+	Copies the chunks into one buffer of exactly the final size, which the string adopts as it is.
+	Results short enough for the inline buffer are built there instead.
+*/
+template <typename ValueType, typename AllocatorType>
+typename StringBuilderType<ValueType, AllocatorType>::StorageType StringBuilderType<ValueType, AllocatorType>::build() const {
+
+	SizeType size = this->size();
+
+	if (size < StorageType::LOCAL_CAPACITY) {
+		return StorageType{ViewType{m_chunks.empty() ? nullptr : m_chunks.front().data, size}, allocatorReference()};
+	}
+
+	AllocatorType allocator = allocatorReference();
+	Pointer data = AllocatorTraits::allocate(allocator, size + 1);
+
+	detail::recordAllocation(AllocationCause::CONSTRUCT, (size + 1) * sizeof(ValueType), 0);
+
+	Pointer last = data;
+
+	for (const Chunk &chunk : m_chunks) {
+		ConstPointer end = &chunk == &m_chunks.back() ? m_cursor : chunk.data + chunk.capacity;
+		last = std::copy(static_cast<ConstPointer>(chunk.data), end, last);
+	}
+
+	*last = static_cast<ValueType>('\0');
+
+	return StorageType{data, size, size + 1, allocator};
+}
+
+
+// Default Alias
+
+using StringBuilder = StringBuilderType<char>;
+
+}
+
+
+#endif // SIMPLE_STRING_BUILDER_HPP
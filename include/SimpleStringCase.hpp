@@ -0,0 +1,645 @@
+#pragma once
+#ifndef SIMPLE_STRING_CASE_HPP
+#define SIMPLE_STRING_CASE_HPP
+
+
+#include "SimpleStringKernels.hpp"
+#include "SimpleStringSearch.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+#include <cstddef>
+#include <cstdint>
+
+
+// ASCII Case Handling
+//
+// Only the code units 'A' to 'Z' and 'a' to 'z' have a case. Every other code unit, including
+// all values above 0x7F, is left as it is and compares exactly. Multi-byte UTF-8 sequences only
+// contain bytes above 0x7F, so they pass through unchanged and are never split or corrupted.
+// The result does not depend on the current locale.
+
+
+
+namespace simple {
+namespace detail {
+
+
+// Constants
+
+// First character of each case. The functions below convert the 26 letters starting at the given one.
+constexpr std::uint32_t UPPER_CASE_LETTERS = 'A';
+constexpr std::uint32_t LOWER_CASE_LETTERS = 'a';
+
+constexpr std::uint32_t ALPHABET_SIZE = 26;
+
+// The only bit in which the two cases of an ASCII letter differ.
+constexpr std::uint32_t CASE_BIT = 0x20;
+
+
+// Character Functions
+
+/*
+	Flips the case of character if it is one of the letters starting at letters.
+*/
+template <typename CharType>
+CharType convertCase(CharType character, std::uint32_t letters) noexcept {
+
+	bool letter = character >= static_cast<CharType>(letters) && character < static_cast<CharType>(letters + ALPHABET_SIZE);
+	return letter ? static_cast<CharType>(character ^ static_cast<CharType>(CASE_BIT)) : character;
+}
+
+/*
+*/
+template <typename CharType>
+CharType lowerCase(CharType character) noexcept {
+	return convertCase(character, UPPER_CASE_LETTERS);
+}
+
+
+// Vector Helpers
+//
+// A letter range check is a single signed compare once the first letter is biased down to the lowest
+// signed value of the lane. The matching lanes then have CASE_BIT flipped.
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+*/
+inline __m128i letterMaskSse2(__m128i vector, std::uint32_t letters, std::integral_constant<std::size_t, 1>) noexcept {
+	return _mm_cmplt_epi8(
+		_mm_add_epi8(vector, _mm_set1_epi8(static_cast<char>(0x80u - letters))),
+		_mm_set1_epi8(static_cast<char>(0x80u + ALPHABET_SIZE)));
+}
+
+/*
+*/
+inline __m128i letterMaskSse2(__m128i vector, std::uint32_t letters, std::integral_constant<std::size_t, 2>) noexcept {
+	return _mm_cmplt_epi16(
+		_mm_add_epi16(vector, _mm_set1_epi16(static_cast<short>(0x8000u - letters))),
+		_mm_set1_epi16(static_cast<short>(0x8000u + ALPHABET_SIZE)));
+}
+
+/*
+*/
+inline __m128i letterMaskSse2(__m128i vector, std::uint32_t letters, std::integral_constant<std::size_t, 4>) noexcept {
+	return _mm_cmplt_epi32(
+		_mm_add_epi32(vector, _mm_set1_epi32(static_cast<int>(0x80000000u - letters))),
+		_mm_set1_epi32(static_cast<int>(0x80000000u + ALPHABET_SIZE)));
+}
+
+/*
+*/
+template <typename CharType>
+__m128i toggleLettersSse2(__m128i vector, std::uint32_t letters) noexcept {
+	return _mm_xor_si128(vector, _mm_and_si128(
+		letterMaskSse2(vector, letters, ElementSize<CharType>{}),
+		broadcastSse2(static_cast<CharType>(CASE_BIT))));
+}
+
+#endif
+
+#if defined(SIMPLE_STRING_AVX2)
+
+/*
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline __m256i letterMaskAvx2(__m256i vector, std::uint32_t letters, std::integral_constant<std::size_t, 1>) noexcept {
+	return _mm256_cmpgt_epi8(
+		_mm256_set1_epi8(static_cast<char>(0x80u + ALPHABET_SIZE)),
+		_mm256_add_epi8(vector, _mm256_set1_epi8(static_cast<char>(0x80u - letters))));
+}
+
+/*
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline __m256i letterMaskAvx2(__m256i vector, std::uint32_t letters, std::integral_constant<std::size_t, 2>) noexcept {
+	return _mm256_cmpgt_epi16(
+		_mm256_set1_epi16(static_cast<short>(0x8000u + ALPHABET_SIZE)),
+		_mm256_add_epi16(vector, _mm256_set1_epi16(static_cast<short>(0x8000u - letters))));
+}
+
+/*
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline __m256i letterMaskAvx2(__m256i vector, std::uint32_t letters, std::integral_constant<std::size_t, 4>) noexcept {
+	return _mm256_cmpgt_epi32(
+		_mm256_set1_epi32(static_cast<int>(0x80000000u + ALPHABET_SIZE)),
+		_mm256_add_epi32(vector, _mm256_set1_epi32(static_cast<int>(0x80000000u - letters))));
+}
+
+/*
+*/
+template <typename CharType>
+SIMPLE_STRING_AVX2_TARGET
+__m256i toggleLettersAvx2(__m256i vector, std::uint32_t letters) noexcept {
+	return _mm256_xor_si256(vector, _mm256_and_si256(
+		letterMaskAvx2(vector, letters, ElementSize<CharType>{}),
+		broadcastAvx2(static_cast<CharType>(CASE_BIT))));
+}
+
+#endif
+
+
+// Conversion Kernels
+//
+// Write source to destination with the case of the letters starting at letters flipped.
+// source and destination are either the same range or do not overlap. Converting a character twice
+// leaves it as converting it once, so the final vector may overlap the ones before it.
+
+/*
+*/
+template <typename CharType>
+void convertCaseScalar(const CharType *source, CharType *destination, std::size_t size, std::uint32_t letters) noexcept {
+
+	for (std::size_t i = 0; i < size; ++i) {
+		destination[i] = convertCase(source[i], letters);
+	}
+}
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+*/
+template <typename CharType>
+void convertCaseSse2(const CharType *source, CharType *destination, std::size_t size, std::uint32_t letters) noexcept {
+
+	constexpr std::size_t STEP = 16 / sizeof(CharType);
+
+	if (size < STEP) {
+		convertCaseScalar(source, destination, size, letters);
+		return;
+	}
+
+	std::size_t i = 0;
+
+	for (; i + STEP <= size; i += STEP) {
+		__m128i vector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), toggleLettersSse2<CharType>(vector, letters));
+	}
+
+	if (i != size) {
+		i = size - STEP;
+
+		__m128i vector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), toggleLettersSse2<CharType>(vector, letters));
+	}
+}
+
+#endif
+
+#if defined(SIMPLE_STRING_AVX2)
+
+/*
+	Requires at least 32 bytes.
+*/
+template <typename CharType>
+SIMPLE_STRING_AVX2_TARGET
+void convertCaseAvx2(const CharType *source, CharType *destination, std::size_t size, std::uint32_t letters) noexcept {
+
+	constexpr std::size_t STEP = 32 / sizeof(CharType);
+
+	std::size_t i = 0;
+
+	for (; i + STEP <= size; i += STEP) {
+		__m256i vector = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), toggleLettersAvx2<CharType>(vector, letters));
+	}
+
+	if (i != size) {
+		i = size - STEP;
+
+		__m256i vector = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), toggleLettersAvx2<CharType>(vector, letters));
+	}
+}
+
+#endif
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+*/
+template <typename CharType>
+void convertCase(const CharType *source, CharType *destination, std::size_t size, std::uint32_t letters, std::true_type) noexcept {
+
+#if defined(SIMPLE_STRING_AVX2)
+	constexpr std::size_t AVX2_THRESHOLD = 64;
+
+	if (size * sizeof(CharType) >= AVX2_THRESHOLD && hasAvx2()) {
+		convertCaseAvx2(source, destination, size, letters);
+		return;
+	}
+#endif
+
+	convertCaseSse2(source, destination, size, letters);
+}
+
+/*
+*/
+template <typename CharType>
+void convertCase(const CharType *source, CharType *destination, std::size_t size, std::uint32_t letters, std::false_type) noexcept {
+	convertCaseScalar(source, destination, size, letters);
+}
+
+#endif
+
+/*
+*/
+template <typename CharType>
+void convertCase(const CharType *source, CharType *destination, std::size_t size, std::uint32_t letters) noexcept {
+
+#if defined(SIMPLE_STRING_SSE2)
+	convertCase(source, destination, size, letters, IsVectorizable<CharType>{});
+#else
+	convertCaseScalar(source, destination, size, letters);
+#endif
+}
+
+
+// Case-Insensitive Mismatch Kernels
+//
+// Each returns the index of the first character that differs other than in case, or size if the ranges
+// are equal ignoring case. The vector kernels do not fold both sides: two characters are equal ignoring
+// case when their exclusive or is zero, or is CASE_BIT and either of them is a letter.
+
+/*
+*/
+template <typename CharType>
+std::size_t mismatchIgnoreCaseScalar(const CharType *left, const CharType *right, std::size_t size) noexcept {
+
+	for (std::size_t i = 0; i < size; ++i) {
+		if (lowerCase(left[i]) != lowerCase(right[i])) {
+			return i;
+		}
+	}
+
+	return size;
+}
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+	Zero in the lanes that are equal ignoring case.
+*/
+template <typename CharType>
+__m128i differenceIgnoreCaseSse2(const CharType *left, const CharType *right) noexcept {
+
+	const __m128i caseBit = broadcastSse2(static_cast<CharType>(CASE_BIT));
+
+	__m128i leftVector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(left));
+	__m128i rightVector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(right));
+
+	__m128i letters = letterMaskSse2(_mm_or_si128(leftVector, caseBit), LOWER_CASE_LETTERS, ElementSize<CharType>{});
+	return _mm_andnot_si128(_mm_and_si128(letters, caseBit), _mm_xor_si128(leftVector, rightVector));
+}
+
+/*
+*/
+template <typename CharType>
+std::uint32_t differencesIgnoreCaseSse2(const CharType *left, const CharType *right) noexcept {
+	return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(differenceIgnoreCaseSse2(left, right), _mm_setzero_si128()))) ^ 0xFFFFu;
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t mismatchIgnoreCaseSse2(const CharType *left, const CharType *right, std::size_t size) noexcept {
+
+	constexpr std::size_t STEP = 16 / sizeof(CharType);
+
+	if (size < STEP) {
+		return mismatchIgnoreCaseScalar(left, right, size);
+	}
+
+	std::size_t i = 0;
+
+	for (; i + STEP <= size; i += STEP) {
+		std::uint32_t mask = differencesIgnoreCaseSse2(left + i, right + i);
+		if (mask != 0) {
+			return i + countTrailingZeros(mask) / sizeof(CharType);
+		}
+	}
+
+	if (i == size) {
+		return size;
+	}
+
+	i = size - STEP;
+
+	std::uint32_t mask = differencesIgnoreCaseSse2(left + i, right + i);
+	return mask != 0 ? i + countTrailingZeros(mask) / sizeof(CharType) : size;
+}
+
+#endif
+
+#if defined(SIMPLE_STRING_AVX2)
+
+/*
+*/
+template <typename CharType>
+SIMPLE_STRING_AVX2_TARGET
+__m256i differenceIgnoreCaseAvx2(const CharType *left, const CharType *right) noexcept {
+
+	const __m256i caseBit = broadcastAvx2(static_cast<CharType>(CASE_BIT));
+
+	__m256i leftVector = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(left));
+	__m256i rightVector = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(right));
+
+	__m256i letters = letterMaskAvx2(_mm256_or_si256(leftVector, caseBit), LOWER_CASE_LETTERS, ElementSize<CharType>{});
+	return _mm256_andnot_si256(_mm256_and_si256(letters, caseBit), _mm256_xor_si256(leftVector, rightVector));
+}
+
+/*
+*/
+template <typename CharType>
+SIMPLE_STRING_AVX2_TARGET
+std::uint32_t differencesIgnoreCaseAvx2(const CharType *left, const CharType *right) noexcept {
+	return ~static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(differenceIgnoreCaseAvx2(left, right), _mm256_setzero_si256())));
+}
+
+/*
+	Requires at least 32 bytes.
+*/
+template <typename CharType>
+SIMPLE_STRING_AVX2_TARGET
+std::size_t mismatchIgnoreCaseAvx2(const CharType *left, const CharType *right, std::size_t size) noexcept {
+
+	constexpr std::size_t STEP = 32 / sizeof(CharType);
+
+	std::size_t i = 0;
+
+	// Two vectors per iteration with a single combined branch.
+	for (; i + 2 * STEP <= size; i += 2 * STEP) {
+		__m256i difference = _mm256_or_si256(differenceIgnoreCaseAvx2(left + i, right + i), differenceIgnoreCaseAvx2(left + i + STEP, right + i + STEP));
+
+		if (!_mm256_testz_si256(difference, difference)) {
+			break;
+		}
+	}
+
+	for (; i + STEP <= size; i += STEP) {
+		std::uint32_t mask = differencesIgnoreCaseAvx2(left + i, right + i);
+		if (mask != 0) {
+			return i + countTrailingZeros(mask) / sizeof(CharType);
+		}
+	}
+
+	if (i == size) {
+		return size;
+	}
+
+	i = size - STEP;
+
+	std::uint32_t mask = differencesIgnoreCaseAvx2(left + i, right + i);
+	return mask != 0 ? i + countTrailingZeros(mask) / sizeof(CharType) : size;
+}
+
+#endif
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+*/
+template <typename CharType>
+std::size_t mismatchIgnoreCase(const CharType *left, const CharType *right, std::size_t size, std::true_type) noexcept {
+
+#if defined(SIMPLE_STRING_AVX2)
+	constexpr std::size_t AVX2_THRESHOLD = 64;
+
+	if (size * sizeof(CharType) >= AVX2_THRESHOLD && hasAvx2()) {
+		return mismatchIgnoreCaseAvx2(left, right, size);
+	}
+#endif
+
+	return mismatchIgnoreCaseSse2(left, right, size);
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t mismatchIgnoreCase(const CharType *left, const CharType *right, std::size_t size, std::false_type) noexcept {
+	return mismatchIgnoreCaseScalar(left, right, size);
+}
+
+#endif
+
+/*
+*/
+template <typename CharType>
+std::size_t mismatchIgnoreCase(const CharType *left, const CharType *right, std::size_t size) noexcept {
+
+#if defined(SIMPLE_STRING_SSE2)
+	return mismatchIgnoreCase(left, right, size, IsVectorizable<CharType>{});
+#else
+	return mismatchIgnoreCaseScalar(left, right, size);
+#endif
+}
+
+/*
+	Negative, zero or positive as left orders before, equal to or after right once both are in lower case.
+*/
+template <typename CharType>
+int compareIgnoreCase(const CharType *left, std::size_t leftSize, const CharType *right, std::size_t rightSize) noexcept {
+
+	std::size_t size = std::min(leftSize, rightSize);
+	std::size_t i = mismatchIgnoreCase(left, right, size);
+
+	if (i < size) {
+		return lowerCase(left[i]) < lowerCase(right[i]) ? -1 : 1;
+	}
+
+	if (leftSize < rightSize) {
+		return -1;
+	}
+	else if (leftSize > rightSize) {
+		return 1;
+	}
+	else {
+		return 0;
+	}
+}
+
+
+// Case-Insensitive Pair Filter Kernels
+//
+// The counterpart of scanPairs() with every character of data folded to lower case before it is
+// compared; first and second must already be in lower case.
+
+/*
+*/
+template <typename CharType, typename VisitorType>
+std::size_t scanPairsIgnoreCaseScalar(const CharType *data, std::size_t positions, CharType first, CharType second, std::size_t distance, VisitorType &&visit) {
+
+	for (std::size_t i = 0; i < positions; ++i) {
+		if (lowerCase(data[i]) == first && lowerCase(data[i + distance]) == second && visit(i)) {
+			return i;
+		}
+	}
+
+	return NOT_FOUND;
+}
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+*/
+template <typename CharType>
+std::uint32_t pairCandidatesIgnoreCaseSse2(const CharType *data, __m128i first, __m128i second, std::size_t distance) noexcept {
+
+	__m128i firstBlock = toggleLettersSse2<CharType>(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data)), UPPER_CASE_LETTERS);
+	__m128i secondBlock = toggleLettersSse2<CharType>(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + distance)), UPPER_CASE_LETTERS);
+
+	return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+		compareEqualSse2(firstBlock, first, ElementSize<CharType>{}),
+		compareEqualSse2(secondBlock, second, ElementSize<CharType>{}))));
+}
+
+/*
+*/
+template <typename CharType, typename VisitorType>
+std::size_t scanPairsIgnoreCaseSse2(const CharType *data, std::size_t positions, CharType first, CharType second, std::size_t distance, VisitorType &&visit) {
+
+	constexpr std::size_t WIDTH = 16;
+	constexpr std::size_t STEP = WIDTH / sizeof(CharType);
+	constexpr std::uint32_t GROUP = (1u << sizeof(CharType)) - 1;
+
+	if (positions < STEP) {
+		return scanPairsIgnoreCaseScalar(data, positions, first, second, distance, visit);
+	}
+
+	const __m128i firstVector = broadcastSse2(first);
+	const __m128i secondVector = broadcastSse2(second);
+
+	auto visitMask = [&](std::size_t i, std::uint32_t mask) {
+		while (mask != 0) {
+			unsigned bit = countTrailingZeros(mask);
+			std::size_t index = i + bit / sizeof(CharType);
+
+			if (visit(index)) {
+				return index;
+			}
+
+			mask &= ~(GROUP << bit);
+		}
+
+		return NOT_FOUND;
+	};
+
+	std::size_t i = 0;
+
+	for (; i + STEP <= positions; i += STEP) {
+		std::uint32_t mask = pairCandidatesIgnoreCaseSse2(data + i, firstVector, secondVector, distance);
+		if (mask != 0) {
+			std::size_t index = visitMask(i, mask);
+			if (index != NOT_FOUND) {
+				return index;
+			}
+		}
+	}
+
+	if (i == positions) {
+		return NOT_FOUND;
+	}
+
+	std::size_t overlap = i - (positions - STEP);
+	i = positions - STEP;
+
+	return visitMask(i, pairCandidatesIgnoreCaseSse2(data + i, firstVector, secondVector, distance) & (~0u << (overlap * sizeof(CharType))));
+}
+
+/*
+*/
+template <typename CharType, typename VisitorType>
+std::size_t scanPairsIgnoreCase(const CharType *data, std::size_t positions, CharType first, CharType second, std::size_t distance, VisitorType &&visit, std::true_type) {
+	return scanPairsIgnoreCaseSse2(data, positions, first, second, distance, visit);
+}
+
+/*
+*/
+template <typename CharType, typename VisitorType>
+std::size_t scanPairsIgnoreCase(const CharType *data, std::size_t positions, CharType first, CharType second, std::size_t distance, VisitorType &&visit, std::false_type) {
+	return scanPairsIgnoreCaseScalar(data, positions, first, second, distance, visit);
+}
+
+#endif
+
+/*
+*/
+template <typename CharType, typename VisitorType>
+std::size_t scanPairsIgnoreCase(const CharType *data, std::size_t positions, CharType first, CharType second, std::size_t distance, VisitorType &&visit) {
+
+#if defined(SIMPLE_STRING_SSE2)
+	return scanPairsIgnoreCase(data, positions, first, second, distance, visit, IsVectorizable<CharType>{});
+#else
+	return scanPairsIgnoreCaseScalar(data, positions, first, second, distance, visit);
+#endif
+}
+
+
+// Case-Insensitive Substring Search
+
+// Forward view of a character range as it reads in lower case, for twoWaySearch().
+template <typename CharType>
+struct FoldedSequence {
+
+	const CharType *data;
+	std::size_t size;
+
+	CharType operator[](std::size_t index) const noexcept {
+		return lowerCase(data[index]);
+	}
+
+	std::size_t findPair(CharType first, CharType second, std::size_t distance, std::size_t from, std::size_t to) const noexcept {
+
+		std::size_t index = scanPairsIgnoreCase(data + from, to - from, first, second, distance, [](std::size_t) { return true; });
+		return index != NOT_FOUND ? from + index : NOT_FOUND;
+	}
+};
+
+/*
+	First position of needle in data ignoring case, or NOT_FOUND. An empty needle matches at 0.
+	Short needles use the pair filter on their first and last characters, longer ones Two-Way over
+	folded sequences, so like findSubstring() the search stays linear.
+*/
+template <typename CharType>
+std::size_t findSubstringIgnoreCase(const CharType *data, std::size_t size, const CharType *needle, std::size_t needleSize) noexcept {
+
+	if (needleSize == 0) {
+		return 0;
+	}
+
+	if (needleSize > size) {
+		return NOT_FOUND;
+	}
+
+	if (needleSize <= SHORT_NEEDLE_LIMIT) {
+		std::size_t distance = needleSize - 1;
+
+		return scanPairsIgnoreCase(data, size - distance, lowerCase(needle[0]), lowerCase(needle[distance]), distance, [&](std::size_t i) {
+			return needleSize <= 2 || mismatchIgnoreCase(data + i + 1, needle + 1, needleSize - 2) == needleSize - 2;
+		});
+	}
+
+	return twoWaySearch(FoldedSequence<CharType>{data, size}, size, FoldedSequence<CharType>{needle, needleSize}, needleSize);
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t findIgnoreCase(const CharType *data, std::size_t size, const CharType *needle, std::size_t needleSize, std::size_t position) noexcept {
+
+	if (position > size) {
+		return NOT_FOUND;
+	}
+
+	std::size_t index = findSubstringIgnoreCase(data + position, size - position, needle, needleSize);
+	return index != NOT_FOUND ? position + index : NOT_FOUND;
+}
+
+}
+}
+
+
+#endif // SIMPLE_STRING_CASE_HPP
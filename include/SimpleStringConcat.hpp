@@ -0,0 +1,511 @@
+
+#pragma once
+#ifndef SIMPLE_STRING_CONCAT_HPP
+#define SIMPLE_STRING_CONCAT_HPP
+
+
+#include <algorithm>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include <cassert>
+#include <cstddef>
+
+
+
+namespace simple {
+
+
+// Forward Declarations
+
+template <typename CharType>
+class StringViewType;
+
+template <typename CharType, typename Allocator, typename GrowthPolicy>
+class StringType;
+
+
+// Concatenation Expressions
+//
+// concat(a, "x", b, 'c', d) returns a ConcatExpression instead of a string. The expression keeps the pieces of the
+// chain and adds up their sizes as it is built; converting it to a string allocates once for the total and copies
+// every piece once. An rvalue string operand is moved into the expression, and the leftmost one may lend its buffer
+// to the result. Every other operand is referred to, so it must outlive the expression.
+// operator+ builds the same expression for its two operands and converts it at once, so it returns a string.
+
+namespace detail {
+
+/*
+	Characters of an lvalue string, view or C-style string operand.
+	Owner is the string the characters came from, or void when they did not come from one.
+*/
+template <typename CharType, typename Owner>
+class ConcatRange {
+public:
+
+	ConcatRange(const CharType *data, std::size_t size, const Owner *owner) noexcept :
+		m_data{data}, m_size{size}, m_owner{owner} {}
+
+	std::size_t size() const noexcept {
+		return m_size;
+	}
+
+	CharType *copy(CharType *destination) const noexcept {
+		return std::copy(m_data, m_data + m_size, destination);
+	}
+
+	CharType *copyTail(CharType *destination) const noexcept {
+		return destination;
+	}
+
+	const Owner *owner() const noexcept {
+		return m_owner;
+	}
+
+	void *donor() const noexcept {
+		return nullptr;
+	}
+
+private:
+
+	const CharType *m_data;
+	std::size_t m_size;
+	const Owner *m_owner;
+};
+
+/*
+	An rvalue string operand, moved into the expression so that the expression may outlive the full expression
+	that made it. As the leftmost piece it may hand its buffer to the result.
+*/
+template <typename StringType>
+class ConcatValue {
+public:
+
+	explicit ConcatValue(StringType string) noexcept :
+		m_string{std::move(string)} {}
+
+	std::size_t size() const noexcept {
+		return m_string.size();
+	}
+
+	typename StringType::ValueType *copy(typename StringType::ValueType *destination) const noexcept {
+		return std::copy(m_string.data(), m_string.data() + m_string.size(), destination);
+	}
+
+	typename StringType::ValueType *copyTail(typename StringType::ValueType *destination) const noexcept {
+		return destination;
+	}
+
+	const StringType *owner() const noexcept {
+		return &m_string;
+	}
+
+	void *donor() const noexcept {
+		return const_cast<StringType *>(&m_string);
+	}
+
+private:
+
+	StringType m_string;
+};
+
+/*
+	A single character operand, held by value.
+*/
+template <typename CharType>
+class ConcatCharacter {
+public:
+
+	explicit ConcatCharacter(CharType character) noexcept :
+		m_character{character} {}
+
+	std::size_t size() const noexcept {
+		return 1;
+	}
+
+	CharType *copy(CharType *destination) const noexcept {
+		*destination = m_character;
+		return destination + 1;
+	}
+
+	CharType *copyTail(CharType *destination) const noexcept {
+		return destination;
+	}
+
+	const void *owner() const noexcept {
+		return nullptr;
+	}
+
+	void *donor() const noexcept {
+		return nullptr;
+	}
+
+private:
+
+	CharType m_character;
+};
+
+}
+
+
+/*
+	Unevaluated concatenation of Left and Right, which are pieces or nested expressions.
+	ResultType is the string type it converts to.
+*/
+template <typename ResultType, typename Left, typename Right>
+class ConcatExpression {
+public:
+
+	// Type Aliases
+
+	using ValueType = typename ResultType::ValueType;
+	using SizeType = typename ResultType::SizeType;
+
+	// Constructors
+
+	ConcatExpression(Left, Right) noexcept;
+
+	// Size Functions
+
+	SizeType size() const noexcept;
+
+	// Piece Functions
+
+	ValueType *copy(ValueType *) const noexcept;
+	ValueType *copyTail(ValueType *) const noexcept;
+
+	const ResultType *owner() const noexcept;
+	ResultType *donor() const noexcept;
+
+private:
+
+	// Data Members
+
+	Left m_left;
+	Right m_right;
+	SizeType m_size;
+};
+
+
+// Constructors
+
+/*
+*/
+template <typename ResultType, typename Left, typename Right>
+ConcatExpression<ResultType, Left, Right>::ConcatExpression(Left left, Right right) noexcept :
+	m_left{std::move(left)}, m_right{std::move(right)}, m_size{m_left.size() + m_right.size()} {}
+
+
+// Size Functions
+
+/*
+*/
+template <typename ResultType, typename Left, typename Right>
+typename ConcatExpression<ResultType, Left, Right>::SizeType ConcatExpression<ResultType, Left, Right>::size() const noexcept {
+	return m_size;
+}
+
+
+// Piece Functions
+
+/*
+	Copies every piece, in order, to destination and returns the end of what was written.
+*/
+template <typename ResultType, typename Left, typename Right>
+typename ConcatExpression<ResultType, Left, Right>::ValueType *ConcatExpression<ResultType, Left, Right>::copy(ValueType *destination) const noexcept {
+	return m_right.copy(m_left.copy(destination));
+}
+
+/*
+	Copies every piece but the leftmost one, for when the leftmost piece is already in place.
+*/
+template <typename ResultType, typename Left, typename Right>
+typename ConcatExpression<ResultType, Left, Right>::ValueType *ConcatExpression<ResultType, Left, Right>::copyTail(ValueType *destination) const noexcept {
+	return m_right.copy(m_left.copyTail(destination));
+}
+
+/*
+	The leftmost string operand, whose allocator the result copies.
+*/
+template <typename ResultType, typename Left, typename Right>
+const ResultType *ConcatExpression<ResultType, Left, Right>::owner() const noexcept {
+
+	const ResultType *owner = static_cast<const ResultType *>(m_left.owner());
+
+	return owner != nullptr ? owner : static_cast<const ResultType *>(m_right.owner());
+}
+
+/*
+	The leftmost piece if it is an rvalue string, which may be extended in place instead of allocating.
+*/
+template <typename ResultType, typename Left, typename Right>
+ResultType *ConcatExpression<ResultType, Left, Right>::donor() const noexcept {
+	return static_cast<ResultType *>(m_left.donor());
+}
+
+
+namespace detail {
+
+
+// Operand Traits
+
+/*
+*/
+template <typename Type>
+struct IsStringType : std::false_type {};
+
+template <typename CharType, typename Allocator, typename GrowthPolicy>
+struct IsStringType<StringType<CharType, Allocator, GrowthPolicy>> : std::true_type {};
+
+/*
+	ResultType of the string or expression Operand, or void for any other operand.
+*/
+template <typename Operand, bool = IsStringType<Operand>::value>
+struct ConcatResult {
+	using Type = void;
+};
+
+template <typename Operand>
+struct ConcatResult<Operand, true> {
+	using Type = Operand;
+};
+
+template <typename ResultType, typename Left, typename Right>
+struct ConcatResult<ConcatExpression<ResultType, Left, Right>, false> {
+	using Type = ResultType;
+};
+
+/*
+	Piece for a string operand: a range over an lvalue, or the string itself for an rvalue.
+*/
+template <typename ResultType, typename Operand, bool = std::is_lvalue_reference<Operand>::value>
+struct ConcatStringPiece {
+
+	using Type = ConcatRange<typename ResultType::ValueType, ResultType>;
+
+	static Type make(const ResultType &operand) noexcept {
+		return Type{operand.data(), operand.size(), &operand};
+	}
+};
+
+template <typename ResultType, typename Operand>
+struct ConcatStringPiece<ResultType, Operand, false> {
+
+	using Type = ConcatValue<ResultType>;
+
+	static Type make(Operand &&operand) {
+		return Type{std::forward<Operand>(operand)};
+	}
+};
+
+/*
+	Turns an operand, as deduced by a forwarding reference, into the piece an expression stores.
+	Only the operands an expression with result type ResultType accepts have a make() function.
+*/
+template <typename ResultType, typename Operand, typename Decayed = typename std::decay<Operand>::type, typename = void>
+struct ConcatPiece {};
+
+template <typename ResultType, typename Operand>
+struct ConcatPiece<ResultType, Operand, ResultType> : ConcatStringPiece<ResultType, Operand> {};
+
+template <typename ResultType, typename Operand, typename Left, typename Right>
+struct ConcatPiece<ResultType, Operand, ConcatExpression<ResultType, Left, Right>> {
+
+	using Type = ConcatExpression<ResultType, Left, Right>;
+
+	static Type make(Type operand) noexcept {
+		return operand;
+	}
+};
+
+template <typename ResultType, typename Operand>
+struct ConcatPiece<ResultType, Operand, StringViewType<typename ResultType::ValueType>> {
+
+	using Type = ConcatRange<typename ResultType::ValueType, const void>;
+
+	static Type make(StringViewType<typename ResultType::ValueType> operand) noexcept {
+		return Type{operand.data(), operand.size(), nullptr};
+	}
+};
+
+template <typename ResultType, typename Operand>
+struct ConcatPiece<ResultType, Operand, typename ResultType::ValueType> {
+
+	using Type = ConcatCharacter<typename ResultType::ValueType>;
+
+	static Type make(typename ResultType::ValueType operand) noexcept {
+		return Type{operand};
+	}
+};
+
+template <typename ResultType, typename Operand, typename Decayed>
+struct ConcatPiece<ResultType, Operand, Decayed, typename std::enable_if<std::is_convertible<Decayed, typename ResultType::ConstPointer>::value>::type> {
+
+	using Type = ConcatRange<typename ResultType::ValueType, const void>;
+
+	static Type make(typename ResultType::ConstPointer operand) noexcept {
+
+		assert(operand != nullptr);
+
+		StringViewType<typename ResultType::ValueType> view{operand};
+
+		return Type{view.data(), view.size(), nullptr};
+	}
+};
+
+/*
+	The string type Left and Right have in common: that of whichever is a string or an expression, if both are the same.
+	void when neither is, or when they disagree.
+*/
+template <typename Left, typename Right,
+	typename LeftResult = typename ConcatResult<typename std::decay<Left>::type>::Type,
+	typename RightResult = typename ConcatResult<typename std::decay<Right>::type>::Type>
+struct ConcatCommonResult {
+	using Type = typename std::conditional<std::is_void<LeftResult>::value, RightResult,
+		typename std::conditional<std::is_void<RightResult>::value || std::is_same<LeftResult, RightResult>::value, LeftResult, void>::type>::type;
+};
+
+/*
+*/
+template <typename...>
+struct VoidType {
+	using Type = void;
+};
+
+/*
+	Expression type of Left + Right, when the other operand is accepted as a piece of the common string type.
+	No type otherwise, which removes operator+ from overload resolution.
+*/
+template <typename Left, typename Right, typename ResultType = typename ConcatCommonResult<Left, Right>::Type, typename = void>
+struct ConcatOperands {};
+
+template <typename Left, typename Right, typename ResultType>
+struct ConcatOperands<Left, Right, ResultType, typename VoidType<typename ConcatPiece<ResultType, Left>::Type, typename ConcatPiece<ResultType, Right>::Type>::Type> {
+
+	using LeftPiece = ConcatPiece<ResultType, Left>;
+	using RightPiece = ConcatPiece<ResultType, Right>;
+
+	using Result = ResultType;
+	using Type = ConcatExpression<ResultType, typename LeftPiece::Type, typename RightPiece::Type>;
+
+	static Type make(Left &&left, Right &&right) {
+		return Type{LeftPiece::make(std::forward<Left>(left)), RightPiece::make(std::forward<Right>(right))};
+	}
+};
+
+/*
+	Expression type of concat() on Operands, which joins them from the left.
+	No type when any step is not a concatenation, which removes concat() from overload resolution.
+*/
+template <typename, typename...>
+struct ConcatChain {};
+
+template <typename Left, typename Right>
+struct ConcatChain<typename VoidType<typename ConcatOperands<Left, Right>::Type>::Type, Left, Right> {
+
+	using Type = typename ConcatOperands<Left, Right>::Type;
+
+	static Type make(Left &&left, Right &&right) {
+		return ConcatOperands<Left, Right>::make(std::forward<Left>(left), std::forward<Right>(right));
+	}
+};
+
+template <typename Left, typename Right, typename Next, typename... Rest>
+struct ConcatChain<typename VoidType<typename ConcatChain<void, typename ConcatOperands<Left, Right>::Type, Next, Rest...>::Type>::Type, Left, Right, Next, Rest...> {
+
+	using Joined = typename ConcatOperands<Left, Right>::Type;
+	using Type = typename ConcatChain<void, Joined, Next, Rest...>::Type;
+
+	static Type make(Left &&left, Right &&right, Next &&next, Rest &&...rest) {
+		return ConcatChain<void, Joined, Next, Rest...>::make(ConcatOperands<Left, Right>::make(std::forward<Left>(left), std::forward<Right>(right)), std::forward<Next>(next), std::forward<Rest>(rest)...);
+	}
+};
+
+}
+
+
+// Mutation Operations
+
+/*
+	Builds an expression for the concatenation of two or more operands, at least one of them a string or expression,
+	the others views, C-style strings or characters; see ConcatExpression.
+*/
+template <typename First, typename Second, typename... Rest>
+typename detail::ConcatChain<void, First, Second, Rest...>::Type concat(First &&first, Second &&second, Rest &&...rest) {
+	return detail::ConcatChain<void, First, Second, Rest...>::make(std::forward<First>(first), std::forward<Second>(second), std::forward<Rest>(rest)...);
+}
+
+/*
+	Concatenates a string or expression with a string, expression, view, C-style string or character, on either side.
+	Allocates once for the result, or not at all when an rvalue string on the left has room for it.
+*/
+template <typename Left, typename Right>
+typename detail::ConcatOperands<Left, Right>::Result operator+(Left &&left, Right &&right) {
+
+	using Operands = detail::ConcatOperands<Left, Right>;
+
+	return typename Operands::Result{Operands::make(std::forward<Left>(left), std::forward<Right>(right))};
+}
+
+
+
+// Comparison Operations
+
+/*
+	Comparisons convert the expression to its string first.
+*/
+template <typename ResultType, typename Left, typename Right, typename Other>
+bool operator==(const ConcatExpression<ResultType, Left, Right> &left, const Other &right) {
+	return ResultType{left} == right;
+}
+
+/*
+*/
+template <typename Other, typename ResultType, typename Left, typename Right>
+bool operator==(const Other &left, const ConcatExpression<ResultType, Left, Right> &right) {
+	return left == ResultType{right};
+}
+
+/*
+*/
+template <typename ResultType, typename LeftLeft, typename LeftRight, typename RightLeft, typename RightRight>
+bool operator==(const ConcatExpression<ResultType, LeftLeft, LeftRight> &left, const ConcatExpression<ResultType, RightLeft, RightRight> &right) {
+	return ResultType{left} == ResultType{right};
+}
+
+/*
+*/
+template <typename ResultType, typename Left, typename Right, typename Other>
+bool operator!=(const ConcatExpression<ResultType, Left, Right> &left, const Other &right) {
+	return !(left == right);
+}
+
+/*
+*/
+template <typename Other, typename ResultType, typename Left, typename Right>
+bool operator!=(const Other &left, const ConcatExpression<ResultType, Left, Right> &right) {
+	return !(left == right);
+}
+
+/*
+*/
+template <typename ResultType, typename LeftLeft, typename LeftRight, typename RightLeft, typename RightRight>
+bool operator!=(const ConcatExpression<ResultType, LeftLeft, LeftRight> &left, const ConcatExpression<ResultType, RightLeft, RightRight> &right) {
+	return !(left == right);
+}
+
+
+// Output Stream Operations
+
+/*
+*/
+template <typename ResultType, typename Left, typename Right, typename Traits>
+std::basic_ostream<typename ResultType::ValueType, Traits> &operator<<(std::basic_ostream<typename ResultType::ValueType, Traits> &os, const ConcatExpression<ResultType, Left, Right> &object) {
+	return os << ResultType{object};
+}
+
+}
+
+
+#endif // SIMPLE_STRING_CONCAT_HPP
@@ -0,0 +1,160 @@
+
+#pragma once
+#ifndef SIMPLE_STRING_GROWTH_HPP
+#define SIMPLE_STRING_GROWTH_HPP
+
+
+#include <algorithm>
+#include <limits>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "SimpleStringKernels.hpp"
+
+
+// Growth Policies
+//
+// A growth policy decides how big a new buffer is whenever a string has to allocate one.
+// capacity<CharType>(required, current) receives the smallest acceptable capacity, in characters including
+// the NUL termination, and the capacity of the buffer being outgrown, or zero when the size is all that
+// matters (a first allocation, an assignment or a shrink). It returns the capacity to allocate, at least required.
+// Policies trade memory for reallocations: geometric ones keep appends amortized O(1), exact fit never over-allocates.
+
+
+
+namespace simple {
+
+
+/*
+	Rounds up to the next power of two, so doubling comes for free and allocations are power-of-two sized.
+	Wastes up to half the buffer on large strings. Computed with one bit scan rather than a loop.
+*/
+struct PowerOfTwoGrowth {
+
+	template <typename CharType>
+	static std::size_t capacity(std::size_t required, std::size_t current) noexcept;
+};
+
+/*
+	Grows by half of the current capacity, leaving at most a third of the buffer unused after a reallocation.
+	Takes more reallocations than doubling for the same number of appends.
+*/
+struct OneAndHalfGrowth {
+
+	template <typename CharType>
+	static std::size_t capacity(std::size_t required, std::size_t current) noexcept;
+};
+
+/*
+	Grows like OneAndHalfGrowth, then rounds the allocation up to the next jemalloc size class
+	(multiples of 16 bytes up to 128, then four classes per power of two). The allocator would round
+	the request up to that size anyway, so the string gets to use those bytes instead of wasting them.
+*/
+struct SizeClassGrowth {
+
+	template <typename CharType>
+	static std::size_t capacity(std::size_t required, std::size_t current) noexcept;
+};
+
+/*
+	Allocates exactly what is required, never more. Every append that does not fit reallocates,
+	so it suits strings that are built once, or whose size is reserved up front.
+*/
+struct ExactGrowth {
+
+	template <typename CharType>
+	static std::size_t capacity(std::size_t required, std::size_t current) noexcept;
+};
+
+
+namespace detail {
+
+/*
+	current grown by half, saturating rather than overflowing.
+*/
+inline std::size_t growByHalf(std::size_t current) noexcept {
+
+	constexpr std::size_t MAXIMUM = std::numeric_limits<std::size_t>::max();
+
+	return current <= MAXIMUM - current / 2 ? current + current / 2 : MAXIMUM;
+}
+
+}
+
+
+// Power of Two Growth
+
+/*
+*/
+template <typename CharType>
+std::size_t PowerOfTwoGrowth::capacity(std::size_t required, std::size_t) noexcept {
+
+	if (required <= 2) {
+		return required;
+	}
+
+	unsigned shift = detail::highestSetBit(static_cast<std::uint64_t>(required - 1)) + 1;
+
+	// Beyond the largest power of two there is nothing to round up to.
+	if (shift >= std::numeric_limits<std::size_t>::digits) {
+		return required;
+	}
+
+	return std::size_t{1} << shift;
+}
+
+
+// One and a Half Growth
+
+/*
+*/
+template <typename CharType>
+std::size_t OneAndHalfGrowth::capacity(std::size_t required, std::size_t current) noexcept {
+	return std::max(required, detail::growByHalf(current));
+}
+
+
+// Size Class Growth
+
+/*
+*/
+template <typename CharType>
+std::size_t SizeClassGrowth::capacity(std::size_t required, std::size_t current) noexcept {
+
+	constexpr std::size_t MAXIMUM = std::numeric_limits<std::size_t>::max() / sizeof(CharType);
+
+	std::size_t capacity = std::max(required, detail::growByHalf(current));
+
+	if (capacity > MAXIMUM / 2) {
+		return capacity;
+	}
+
+	std::size_t bytes = capacity * sizeof(CharType);
+	std::size_t spacing = 16;
+
+	if (bytes > 128) {
+		// bytes - 1 lies in [2^group, 2^(group + 1)), which is split into four classes.
+		unsigned group = detail::highestSetBit(static_cast<std::uint64_t>(bytes - 1));
+		spacing = std::size_t{1} << (group - 2);
+	}
+
+	bytes = (bytes + spacing - 1) & ~(spacing - 1);
+
+	return bytes / sizeof(CharType);
+}
+
+
+// Exact Growth
+
+/*
+*/
+template <typename CharType>
+std::size_t ExactGrowth::capacity(std::size_t required, std::size_t) noexcept {
+	return required;
+}
+
+}
+
+
+#endif // SIMPLE_STRING_GROWTH_HPP
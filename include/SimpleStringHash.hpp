@@ -0,0 +1,416 @@
+
+#pragma once
+#ifndef SIMPLE_STRING_HASH_HPP
+#define SIMPLE_STRING_HASH_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include "SimpleStringKernels.hpp"
+
+
+// Hashing
+//
+// Inputs up to a few hundred bytes, which covers most hash table keys, use a multiply-mix construction
+// in the style of wyhash: every 16 bytes are folded into the state with one 64x64 to 128-bit multiply.
+// Longer inputs are consumed 64 bytes at a time by eight independent accumulators in the style of XXH3,
+// which map directly onto SSE2 and AVX2 lanes; every kernel computes exactly the same value.
+// Hashes depend on byte order and on this implementation, so they are not meant to be persisted.
+
+
+
+namespace simple {
+namespace detail {
+
+
+// Constants
+
+// Odd multipliers with balanced bits, mixed into the state between multiplications.
+constexpr std::uint64_t HASH_SECRET[4] = {
+	0x2d358dccaa6c78a5u, 0x8bb84b93962eacc9u, 0x4b33a62ed433d4a3u, 0x4d5a2da51de1aa47u
+};
+
+// Consecutive splitmix64 outputs. Stripe i of a block is keyed with words i to i + 7, so stripes that
+// trade places within a block change the result; the other ranges seed, scramble and merge the accumulators.
+constexpr std::uint64_t HASH_KEYS[48] = {
+	0xe220a8397b1dcdafu, 0x6e789e6aa1b965f4u, 0x06c45d188009454fu, 0xf88bb8a8724c81ecu,
+	0x1b39896a51a8749bu, 0x53cb9f0c747ea2eau, 0x2c829abe1f4532e1u, 0xc584133ac916ab3cu,
+	0x3ee5789041c98ac3u, 0xf3b8488c368cb0a6u, 0x657eecdd3cb13d09u, 0xc2d326e0055bdef6u,
+	0x8621a03fe0bbdb7bu, 0x8e1f7555983aa92fu, 0xb54e0f1600cc4d19u, 0x84bb3f97971d80abu,
+	0x7d29825c75521255u, 0xc3cf17102b7f7f86u, 0x3466e9a083914f64u, 0xd81a8d2b5a4485acu,
+	0xdb01602b100b9ed7u, 0xa9038a921825f10du, 0xedf5f1d90dca2f6au, 0x54496ad67bd2634cu,
+	0xdd7c01d4f5407269u, 0x935e82f1db4c4f7bu, 0x69b82ebc92233300u, 0x40d29eb57de1d510u,
+	0xa2f09dabb45c6316u, 0xee521d7a0f4d3872u, 0xf16952ee72f3454fu, 0x377d35dea8e40225u,
+	0x0c7de8064963bab0u, 0x05582d37111ac529u, 0xd254741f599dc6f7u, 0x69630f7593d108c3u,
+	0x417ef96181daa383u, 0x3c3c41a3b43343a1u, 0x6e19905dcbe531dfu, 0x4fa9fa7324851729u,
+	0x84eb4454a792922au, 0x134f7096918175ceu, 0x07dc930b302278a8u, 0x12c015a97019e937u,
+	0xcc06c31652ebf438u, 0xecee65630a691e37u, 0x3e84ecb1763e79adu, 0x690ed476743aae49u
+};
+
+constexpr std::size_t HASH_INITIAL_KEYS = 24;
+constexpr std::size_t HASH_SCRAMBLE_KEYS = 32;
+constexpr std::size_t HASH_MERGE_KEYS = 40;
+
+// Bytes consumed per accumulator step, and steps between scrambles of the accumulators.
+constexpr std::size_t HASH_STRIPE = 64;
+constexpr std::size_t HASH_STRIPES_PER_BLOCK = 16;
+
+// Inputs longer than this (in bytes) use the accumulators.
+constexpr std::size_t HASH_LONG_THRESHOLD = 256;
+
+constexpr std::uint32_t HASH_SCRAMBLE_PRIME = 0x9e3779b1u;
+
+
+// Multiplication Functions
+
+/*
+	Full 128-bit product of two 64-bit values.
+*/
+inline void multiplyWide(std::uint64_t left, std::uint64_t right, std::uint64_t &low, std::uint64_t &high) noexcept {
+
+#if defined(__SIZEOF_INT128__)
+	__extension__ typedef unsigned __int128 ProductType;
+
+	ProductType product = static_cast<ProductType>(left) * right;
+	low = static_cast<std::uint64_t>(product);
+	high = static_cast<std::uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	low = _umul128(left, right, &high);
+#else
+	std::uint64_t leftLow = left & 0xffffffffu, leftHigh = left >> 32;
+	std::uint64_t rightLow = right & 0xffffffffu, rightHigh = right >> 32;
+
+	std::uint64_t lowLow = leftLow * rightLow;
+	std::uint64_t highLow = leftHigh * rightLow;
+	std::uint64_t lowHigh = leftLow * rightHigh;
+	std::uint64_t highHigh = leftHigh * rightHigh;
+
+	std::uint64_t middle = (lowLow >> 32) + (highLow & 0xffffffffu) + lowHigh;
+
+	low = (middle << 32) | (lowLow & 0xffffffffu);
+	high = highHigh + (highLow >> 32) + (middle >> 32);
+#endif
+}
+
+/*
+	Folds the 128-bit product into 64 bits, so every input bit affects the middle of the result.
+*/
+inline std::uint64_t multiplyFold(std::uint64_t left, std::uint64_t right) noexcept {
+
+	std::uint64_t low, high;
+	multiplyWide(left, right, low, high);
+
+	return low ^ high;
+}
+
+
+// Short Input Hashing
+//
+// The seed is mixed by the caller, which lets the usual constant seed fold away.
+
+/*
+*/
+inline std::uint64_t mixSeed(std::uint64_t seed) noexcept {
+	return seed ^ multiplyFold(seed ^ HASH_SECRET[0], HASH_SECRET[1]);
+}
+
+/*
+*/
+inline std::uint64_t hashFinish(std::uint64_t first, std::uint64_t second, std::uint64_t seed, std::size_t size) noexcept {
+
+	std::uint64_t low, high;
+	multiplyWide(first ^ HASH_SECRET[1], second ^ seed, low, high);
+
+	return multiplyFold(low ^ HASH_SECRET[0] ^ size, high ^ HASH_SECRET[1]);
+}
+
+/*
+	At most 16 bytes; small enough to inline into every caller.
+*/
+inline std::uint64_t hashSmall(const unsigned char *data, std::size_t size, std::uint64_t seed) noexcept {
+
+	std::uint64_t first = 0, second = 0;
+
+	if (size >= 4) {
+		// Two pairs of possibly overlapping 4-byte reads cover 4 to 16 bytes without a loop.
+		std::size_t offset = (size >> 3) << 2;
+
+		first = (std::uint64_t{loadWord<std::uint32_t>(data)} << 32) | loadWord<std::uint32_t>(data + offset);
+		second = (std::uint64_t{loadWord<std::uint32_t>(data + size - 4)} << 32) | loadWord<std::uint32_t>(data + size - 4 - offset);
+	} else if (size > 0) {
+		first = (std::uint64_t{data[0]} << 16) | (std::uint64_t{data[size >> 1]} << 8) | data[size - 1];
+	}
+
+	return hashFinish(first, second, seed, size);
+}
+
+/*
+	More than 16 bytes. Any length works, but the accumulators are faster beyond HASH_LONG_THRESHOLD.
+*/
+inline std::uint64_t hashMedium(const unsigned char *data, std::size_t size, std::uint64_t seed) noexcept {
+
+	std::size_t remaining = size;
+
+	if (remaining > 48) {
+		std::uint64_t seed1 = seed, seed2 = seed;
+
+		do {
+			seed = multiplyFold(loadWord<std::uint64_t>(data) ^ HASH_SECRET[1], loadWord<std::uint64_t>(data + 8) ^ seed);
+			seed1 = multiplyFold(loadWord<std::uint64_t>(data + 16) ^ HASH_SECRET[2], loadWord<std::uint64_t>(data + 24) ^ seed1);
+			seed2 = multiplyFold(loadWord<std::uint64_t>(data + 32) ^ HASH_SECRET[3], loadWord<std::uint64_t>(data + 40) ^ seed2);
+
+			data += 48;
+			remaining -= 48;
+		} while (remaining > 48);
+
+		seed ^= seed1 ^ seed2;
+	}
+
+	while (remaining > 16) {
+		seed = multiplyFold(loadWord<std::uint64_t>(data) ^ HASH_SECRET[1], loadWord<std::uint64_t>(data + 8) ^ seed);
+
+		data += 16;
+		remaining -= 16;
+	}
+
+	return hashFinish(loadWord<std::uint64_t>(data + remaining - 16), loadWord<std::uint64_t>(data + remaining - 8), seed, size);
+}
+
+
+// Accumulator Kernels
+//
+// Each 64-bit lane adds its neighbour's input word and the product of the two halves of its own keyed
+// input word. Every block of stripes ends with a scramble, so the additions cannot cancel across blocks.
+
+/*
+*/
+inline void hashStripesScalar(std::uint64_t *accumulators, const unsigned char *data, std::size_t stripes) noexcept {
+
+	for (std::size_t stripe = 0; stripe < stripes; ++stripe) {
+		const unsigned char *input = data + stripe * HASH_STRIPE;
+		const std::uint64_t *keys = HASH_KEYS + stripe % HASH_STRIPES_PER_BLOCK;
+
+		for (std::size_t lane = 0; lane < 8; ++lane) {
+			std::uint64_t keyed = loadWord<std::uint64_t>(input + 8 * lane) ^ keys[lane];
+
+			accumulators[lane] += loadWord<std::uint64_t>(input + 8 * (lane ^ 1)) + (keyed & 0xffffffffu) * (keyed >> 32);
+		}
+
+		if (stripe % HASH_STRIPES_PER_BLOCK == HASH_STRIPES_PER_BLOCK - 1) {
+			for (std::size_t lane = 0; lane < 8; ++lane) {
+				std::uint64_t value = accumulators[lane];
+				value ^= value >> 47;
+				value ^= HASH_KEYS[HASH_SCRAMBLE_KEYS + lane];
+
+				accumulators[lane] = value * HASH_SCRAMBLE_PRIME;
+			}
+		}
+	}
+}
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+*/
+inline __m128i accumulateSse2(__m128i lane, const __m128i *input, const __m128i *keys) noexcept {
+
+	__m128i value = _mm_loadu_si128(input);
+	__m128i keyed = _mm_xor_si128(value, _mm_loadu_si128(keys));
+
+	__m128i product = _mm_mul_epu32(keyed, _mm_srli_epi64(keyed, 32));
+	__m128i swapped = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+
+	return _mm_add_epi64(lane, _mm_add_epi64(swapped, product));
+}
+
+/*
+*/
+inline __m128i scrambleSse2(__m128i lane, const __m128i *keys) noexcept {
+
+	const __m128i prime = _mm_set1_epi32(static_cast<int>(HASH_SCRAMBLE_PRIME));
+
+	__m128i value = _mm_xor_si128(lane, _mm_srli_epi64(lane, 47));
+	value = _mm_xor_si128(value, _mm_loadu_si128(keys));
+
+	// 64 by 32-bit multiply from two 32 by 32-bit halves.
+	__m128i low = _mm_mul_epu32(value, prime);
+	__m128i high = _mm_mul_epu32(_mm_srli_epi64(value, 32), prime);
+
+	return _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+}
+
+/*
+*/
+inline void hashStripesSse2(std::uint64_t *accumulators, const unsigned char *data, std::size_t stripes) noexcept {
+
+	__m128i *state = reinterpret_cast<__m128i *>(accumulators);
+
+	__m128i lane0 = _mm_loadu_si128(state);
+	__m128i lane1 = _mm_loadu_si128(state + 1);
+	__m128i lane2 = _mm_loadu_si128(state + 2);
+	__m128i lane3 = _mm_loadu_si128(state + 3);
+
+	for (std::size_t stripe = 0; stripe < stripes; ++stripe) {
+		const __m128i *input = reinterpret_cast<const __m128i *>(data + stripe * HASH_STRIPE);
+		const __m128i *keys = reinterpret_cast<const __m128i *>(HASH_KEYS + stripe % HASH_STRIPES_PER_BLOCK);
+
+		lane0 = accumulateSse2(lane0, input, keys);
+		lane1 = accumulateSse2(lane1, input + 1, keys + 1);
+		lane2 = accumulateSse2(lane2, input + 2, keys + 2);
+		lane3 = accumulateSse2(lane3, input + 3, keys + 3);
+
+		if (stripe % HASH_STRIPES_PER_BLOCK == HASH_STRIPES_PER_BLOCK - 1) {
+			const __m128i *scrambleKeys = reinterpret_cast<const __m128i *>(HASH_KEYS + HASH_SCRAMBLE_KEYS);
+
+			lane0 = scrambleSse2(lane0, scrambleKeys);
+			lane1 = scrambleSse2(lane1, scrambleKeys + 1);
+			lane2 = scrambleSse2(lane2, scrambleKeys + 2);
+			lane3 = scrambleSse2(lane3, scrambleKeys + 3);
+		}
+	}
+
+	_mm_storeu_si128(state, lane0);
+	_mm_storeu_si128(state + 1, lane1);
+	_mm_storeu_si128(state + 2, lane2);
+	_mm_storeu_si128(state + 3, lane3);
+}
+
+#endif
+
+#if defined(SIMPLE_STRING_AVX2)
+
+/*
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline __m256i accumulateAvx2(__m256i lane, const __m256i *input, const __m256i *keys) noexcept {
+
+	__m256i value = _mm256_loadu_si256(input);
+	__m256i keyed = _mm256_xor_si256(value, _mm256_loadu_si256(keys));
+
+	__m256i product = _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32));
+	__m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+
+	return _mm256_add_epi64(lane, _mm256_add_epi64(swapped, product));
+}
+
+/*
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline __m256i scrambleAvx2(__m256i lane, const __m256i *keys) noexcept {
+
+	const __m256i prime = _mm256_set1_epi32(static_cast<int>(HASH_SCRAMBLE_PRIME));
+
+	__m256i value = _mm256_xor_si256(lane, _mm256_srli_epi64(lane, 47));
+	value = _mm256_xor_si256(value, _mm256_loadu_si256(keys));
+
+	__m256i low = _mm256_mul_epu32(value, prime);
+	__m256i high = _mm256_mul_epu32(_mm256_srli_epi64(value, 32), prime);
+
+	return _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+}
+
+/*
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline void hashStripesAvx2(std::uint64_t *accumulators, const unsigned char *data, std::size_t stripes) noexcept {
+
+	__m256i *state = reinterpret_cast<__m256i *>(accumulators);
+
+	__m256i lane0 = _mm256_loadu_si256(state);
+	__m256i lane1 = _mm256_loadu_si256(state + 1);
+
+	for (std::size_t stripe = 0; stripe < stripes; ++stripe) {
+		const __m256i *input = reinterpret_cast<const __m256i *>(data + stripe * HASH_STRIPE);
+		const __m256i *keys = reinterpret_cast<const __m256i *>(HASH_KEYS + stripe % HASH_STRIPES_PER_BLOCK);
+
+		lane0 = accumulateAvx2(lane0, input, keys);
+		lane1 = accumulateAvx2(lane1, input + 1, keys + 1);
+
+		if (stripe % HASH_STRIPES_PER_BLOCK == HASH_STRIPES_PER_BLOCK - 1) {
+			const __m256i *scrambleKeys = reinterpret_cast<const __m256i *>(HASH_KEYS + HASH_SCRAMBLE_KEYS);
+
+			lane0 = scrambleAvx2(lane0, scrambleKeys);
+			lane1 = scrambleAvx2(lane1, scrambleKeys + 1);
+		}
+	}
+
+	_mm256_storeu_si256(state, lane0);
+	_mm256_storeu_si256(state + 1, lane1);
+}
+
+#endif
+
+
+// Long Input Hashing
+
+/*
+	The final 1 to 64 bytes are hashed as a short input, seeded with the merged accumulators.
+*/
+inline std::uint64_t hashLong(const unsigned char *data, std::size_t size, std::uint64_t seed) noexcept {
+
+	std::uint64_t accumulators[8];
+	for (std::size_t lane = 0; lane < 8; ++lane) {
+		accumulators[lane] = HASH_KEYS[HASH_INITIAL_KEYS + lane] ^ seed;
+	}
+
+	std::size_t stripes = (size - 1) / HASH_STRIPE;
+
+#if defined(SIMPLE_STRING_AVX2)
+	if (hasAvx2()) {
+		hashStripesAvx2(accumulators, data, stripes);
+	} else {
+		hashStripesSse2(accumulators, data, stripes);
+	}
+#elif defined(SIMPLE_STRING_SSE2)
+	hashStripesSse2(accumulators, data, stripes);
+#else
+	hashStripesScalar(accumulators, data, stripes);
+#endif
+
+	std::uint64_t state = size * HASH_SECRET[2];
+	for (std::size_t pair = 0; pair < 4; ++pair) {
+		state += multiplyFold(accumulators[2 * pair] ^ HASH_KEYS[HASH_MERGE_KEYS + 2 * pair], accumulators[2 * pair + 1] ^ HASH_KEYS[HASH_MERGE_KEYS + 2 * pair + 1]);
+	}
+
+	std::size_t consumed = stripes * HASH_STRIPE;
+	std::size_t remaining = size - consumed;
+
+	state = mixSeed(state);
+
+	return remaining <= 16 ? hashSmall(data + consumed, remaining, state) : hashMedium(data + consumed, remaining, state);
+}
+
+
+// Hash Functions
+
+/*
+*/
+inline std::uint64_t hashBytes(const void *data, std::size_t size, std::uint64_t seed = 0) noexcept {
+
+	const unsigned char *bytes = static_cast<const unsigned char *>(data);
+
+	if (size <= 16) {
+		return hashSmall(bytes, size, mixSeed(seed));
+	}
+
+	if (size <= HASH_LONG_THRESHOLD) {
+		return hashMedium(bytes, size, mixSeed(seed));
+	}
+
+	return hashLong(bytes, size, seed);
+}
+
+/*
+	Hash of the characters' object representation; equal character ranges hash equally whatever holds them.
+*/
+template <typename CharType>
+std::size_t hash(const CharType *data, std::size_t size) noexcept {
+	return static_cast<std::size_t>(hashBytes(data, size * sizeof(CharType)));
+}
+
+}
+}
+
+
+#endif // SIMPLE_STRING_HASH_HPP
@@ -0,0 +1,789 @@
+
+#pragma once
+#ifndef SIMPLE_STRING_KERNELS_HPP
+#define SIMPLE_STRING_KERNELS_HPP
+
+
+#include <type_traits>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+// Instruction Set Selection
+//
+// SSE2 kernels are used whenever the target guarantees SSE2 (always the case on x86-64).
+// AVX2 kernels are compiled with a per-function target attribute and selected at runtime,
+// so a binary built for baseline x86-64 still uses them on capable machines.
+// Every other target uses the portable word-at-a-time fallback.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMPLE_STRING_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(SIMPLE_STRING_SSE2) && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#define SIMPLE_STRING_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SIMPLE_STRING_AVX2_TARGET
+#else
+#define SIMPLE_STRING_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+#if defined(_MSC_VER) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define SIMPLE_STRING_LITTLE_ENDIAN
+#endif
+
+// Kernels that read a C string ahead of its terminator never cross into the next page,
+// but the extra bytes are still outside the object as far as AddressSanitizer is concerned.
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 8)
+#define SIMPLE_STRING_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define SIMPLE_STRING_NO_SANITIZE_ADDRESS
+#endif
+
+
+
+namespace simple {
+namespace detail {
+
+
+// Constants
+
+// Smallest page size of any supported target; reads that stay inside one such page cannot fault.
+constexpr std::size_t PAGE_SIZE = 4096;
+
+
+// Bit Functions
+
+/*
+*/
+inline unsigned countTrailingZeros(std::uint32_t value) noexcept {
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanForward(&index, value);
+	return static_cast<unsigned>(index);
+#else
+	return static_cast<unsigned>(__builtin_ctz(value));
+#endif
+}
+
+/*
+*/
+inline unsigned countTrailingZeros(std::uint64_t value) noexcept {
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+	unsigned long index;
+	_BitScanForward64(&index, value);
+	return static_cast<unsigned>(index);
+#elif defined(_MSC_VER) && !defined(__clang__)
+	std::uint32_t low = static_cast<std::uint32_t>(value);
+	return low != 0 ? countTrailingZeros(low) : 32 + countTrailingZeros(static_cast<std::uint32_t>(value >> 32));
+#else
+	return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+}
+
+/*
+	Index of the highest set bit; value must not be zero.
+*/
+inline unsigned highestSetBit(std::uint32_t value) noexcept {
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanReverse(&index, value);
+	return static_cast<unsigned>(index);
+#else
+	return 31u - static_cast<unsigned>(__builtin_clz(value));
+#endif
+}
+
+/*
+*/
+inline unsigned highestSetBit(std::uint64_t value) noexcept {
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+	unsigned long index;
+	_BitScanReverse64(&index, value);
+	return static_cast<unsigned>(index);
+#elif defined(_MSC_VER) && !defined(__clang__)
+	std::uint32_t high = static_cast<std::uint32_t>(value >> 32);
+	return high != 0 ? 32 + highestSetBit(high) : highestSetBit(static_cast<std::uint32_t>(value));
+#else
+	return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#endif
+}
+
+/*
+	Index of the first byte (in memory order) that differs between two unequal words.
+*/
+template <typename WordType>
+unsigned firstDifference(WordType left, WordType right) noexcept {
+
+#if defined(SIMPLE_STRING_LITTLE_ENDIAN)
+	return countTrailingZeros(static_cast<typename std::conditional<sizeof(WordType) == 8, std::uint64_t, std::uint32_t>::type>(left ^ right)) / 8;
+#else
+	unsigned char leftBytes[sizeof(WordType)];
+	unsigned char rightBytes[sizeof(WordType)];
+	std::memcpy(leftBytes, &left, sizeof(WordType));
+	std::memcpy(rightBytes, &right, sizeof(WordType));
+
+	unsigned i = 0;
+	while (leftBytes[i] == rightBytes[i]) {
+		++i;
+	}
+
+	return i;
+#endif
+}
+
+/*
+*/
+template <typename WordType>
+WordType loadWord(const unsigned char *pointer) noexcept {
+
+	WordType word;
+	std::memcpy(&word, pointer, sizeof(WordType));
+	return word;
+}
+
+/*
+*/
+inline bool isPageSafe(const void *pointer, std::size_t bytes) noexcept {
+	return (reinterpret_cast<std::uintptr_t>(pointer) & (PAGE_SIZE - 1)) <= PAGE_SIZE - bytes;
+}
+
+
+// Vector Helpers
+
+// Character types the vector kernels handle directly; anything else takes the scalar path.
+template <typename CharType>
+using IsVectorizable = std::integral_constant<bool, std::is_integral<CharType>::value &&
+	(sizeof(CharType) == 1 || sizeof(CharType) == 2 || sizeof(CharType) == 4)>;
+
+template <typename CharType>
+using ElementSize = std::integral_constant<std::size_t, sizeof(CharType)>;
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+*/
+inline __m128i compareEqualSse2(__m128i left, __m128i right, std::integral_constant<std::size_t, 1>) noexcept {
+	return _mm_cmpeq_epi8(left, right);
+}
+
+/*
+*/
+inline __m128i compareEqualSse2(__m128i left, __m128i right, std::integral_constant<std::size_t, 2>) noexcept {
+	return _mm_cmpeq_epi16(left, right);
+}
+
+/*
+*/
+inline __m128i compareEqualSse2(__m128i left, __m128i right, std::integral_constant<std::size_t, 4>) noexcept {
+	return _mm_cmpeq_epi32(left, right);
+}
+
+/*
+	Copies value into every lane of its width.
+*/
+template <typename CharType>
+__m128i broadcastSse2(CharType value) noexcept {
+
+	if (sizeof(CharType) == 1) {
+		return _mm_set1_epi8(static_cast<char>(value));
+	}
+	if (sizeof(CharType) == 2) {
+		return _mm_set1_epi16(static_cast<short>(value));
+	}
+
+	return _mm_set1_epi32(static_cast<int>(value));
+}
+
+#endif
+
+#if defined(SIMPLE_STRING_AVX2)
+
+/*
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline __m256i compareEqualAvx2(__m256i left, __m256i right, std::integral_constant<std::size_t, 1>) noexcept {
+	return _mm256_cmpeq_epi8(left, right);
+}
+
+/*
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline __m256i compareEqualAvx2(__m256i left, __m256i right, std::integral_constant<std::size_t, 2>) noexcept {
+	return _mm256_cmpeq_epi16(left, right);
+}
+
+/*
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline __m256i compareEqualAvx2(__m256i left, __m256i right, std::integral_constant<std::size_t, 4>) noexcept {
+	return _mm256_cmpeq_epi32(left, right);
+}
+
+/*
+*/
+template <typename CharType>
+SIMPLE_STRING_AVX2_TARGET
+__m256i broadcastAvx2(CharType value) noexcept {
+
+	if (sizeof(CharType) == 1) {
+		return _mm256_set1_epi8(static_cast<char>(value));
+	}
+	if (sizeof(CharType) == 2) {
+		return _mm256_set1_epi16(static_cast<short>(value));
+	}
+
+	return _mm256_set1_epi32(static_cast<int>(value));
+}
+
+/*
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline __m256i minimumAvx2(__m256i left, __m256i right, std::integral_constant<std::size_t, 1>) noexcept {
+	return _mm256_min_epu8(left, right);
+}
+
+/*
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline __m256i minimumAvx2(__m256i left, __m256i right, std::integral_constant<std::size_t, 2>) noexcept {
+	return _mm256_min_epu16(left, right);
+}
+
+/*
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline __m256i minimumAvx2(__m256i left, __m256i right, std::integral_constant<std::size_t, 4>) noexcept {
+	return _mm256_min_epu32(left, right);
+}
+
+#endif
+
+
+// CPU Feature Detection
+
+/*
+*/
+inline bool detectAvx2() noexcept {
+
+#if !defined(SIMPLE_STRING_AVX2)
+	return false;
+#elif defined(__AVX2__)
+	return true;
+#elif defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+		return false;
+	}
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+/*
+*/
+inline bool hasAvx2() noexcept {
+	static const bool result = detectAvx2();
+	return result;
+}
+
+
+// Mismatch Kernels
+//
+// Each returns the index of the first differing byte, or size if the ranges are equal.
+
+/*
+	Ranges shorter than a vector are covered by two overlapping words, so there is no per-byte loop.
+*/
+template <typename WordType>
+std::size_t mismatchBytesOverlapping(const unsigned char *left, const unsigned char *right, std::size_t size) noexcept {
+
+	WordType leftWord = loadWord<WordType>(left);
+	WordType rightWord = loadWord<WordType>(right);
+
+	if (leftWord != rightWord) {
+		return firstDifference(leftWord, rightWord);
+	}
+
+	std::size_t offset = size - sizeof(WordType);
+
+	leftWord = loadWord<WordType>(left + offset);
+	rightWord = loadWord<WordType>(right + offset);
+
+	if (leftWord != rightWord) {
+		return offset + firstDifference(leftWord, rightWord);
+	}
+
+	return size;
+}
+
+/*
+*/
+inline std::size_t mismatchBytesScalar(const unsigned char *left, const unsigned char *right, std::size_t size) noexcept {
+
+	if (size < sizeof(std::uint32_t)) {
+		for (std::size_t i = 0; i < size; ++i) {
+			if (left[i] != right[i]) {
+				return i;
+			}
+		}
+
+		return size;
+	}
+
+	if (size <= sizeof(std::uint64_t)) {
+		return mismatchBytesOverlapping<std::uint32_t>(left, right, size);
+	}
+
+	std::size_t i = 0;
+
+	for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+		std::uint64_t leftWord = loadWord<std::uint64_t>(left + i);
+		std::uint64_t rightWord = loadWord<std::uint64_t>(right + i);
+
+		if (leftWord != rightWord) {
+			return i + firstDifference(leftWord, rightWord);
+		}
+	}
+
+	if (i == size) {
+		return size;
+	}
+
+	return (size - sizeof(std::uint64_t)) + mismatchBytesOverlapping<std::uint64_t>(
+		left + size - sizeof(std::uint64_t), right + size - sizeof(std::uint64_t), sizeof(std::uint64_t));
+}
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+*/
+inline std::size_t mismatchBytesSse2(const unsigned char *left, const unsigned char *right, std::size_t size) noexcept {
+
+	constexpr std::size_t WIDTH = 16;
+
+	if (size < WIDTH) {
+		return mismatchBytesScalar(left, right, size);
+	}
+
+	std::size_t i = 0;
+
+	for (; i + WIDTH <= size; i += WIDTH) {
+		__m128i leftVector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(left + i));
+		__m128i rightVector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(right + i));
+
+		std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(leftVector, rightVector))) ^ 0xFFFFu;
+		if (mask != 0) {
+			return i + countTrailingZeros(mask);
+		}
+	}
+
+	if (i == size) {
+		return size;
+	}
+
+	// The final block overlaps bytes already known to be equal, so its first difference is the first overall.
+	i = size - WIDTH;
+
+	__m128i leftVector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(left + i));
+	__m128i rightVector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(right + i));
+
+	std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(leftVector, rightVector))) ^ 0xFFFFu;
+	return mask != 0 ? i + countTrailingZeros(mask) : size;
+}
+
+#endif
+
+#if defined(SIMPLE_STRING_AVX2)
+
+/*
+	Requires at least 32 bytes; mismatchBytes() only dispatches here for ranges well above that.
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline std::size_t mismatchBytesAvx2(const unsigned char *left, const unsigned char *right, std::size_t size) noexcept {
+
+	constexpr std::size_t WIDTH = 32;
+
+	std::size_t i = 0;
+
+	// Two vectors per iteration with a single combined branch.
+	for (; i + 2 * WIDTH <= size; i += 2 * WIDTH) {
+		__m256i first = _mm256_cmpeq_epi8(
+			_mm256_loadu_si256(reinterpret_cast<const __m256i *>(left + i)),
+			_mm256_loadu_si256(reinterpret_cast<const __m256i *>(right + i)));
+		__m256i second = _mm256_cmpeq_epi8(
+			_mm256_loadu_si256(reinterpret_cast<const __m256i *>(left + i + WIDTH)),
+			_mm256_loadu_si256(reinterpret_cast<const __m256i *>(right + i + WIDTH)));
+
+		if (static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(first, second))) != 0xFFFFFFFFu) {
+			std::uint32_t mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(first));
+			if (mask != 0) {
+				return i + countTrailingZeros(mask);
+			}
+
+			mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(second));
+			return i + WIDTH + countTrailingZeros(mask);
+		}
+	}
+
+	for (; i + WIDTH <= size; i += WIDTH) {
+		std::uint32_t mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+			_mm256_loadu_si256(reinterpret_cast<const __m256i *>(left + i)),
+			_mm256_loadu_si256(reinterpret_cast<const __m256i *>(right + i)))));
+
+		if (mask != 0) {
+			return i + countTrailingZeros(mask);
+		}
+	}
+
+	if (i == size) {
+		return size;
+	}
+
+	i = size - WIDTH;
+
+	std::uint32_t mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+		_mm256_loadu_si256(reinterpret_cast<const __m256i *>(left + i)),
+		_mm256_loadu_si256(reinterpret_cast<const __m256i *>(right + i)))));
+
+	return mask != 0 ? i + countTrailingZeros(mask) : size;
+}
+
+#endif
+
+/*
+	Short ranges skip the dispatch entirely; the AVX2 kernel only pays off once a few vectors are involved.
+*/
+inline std::size_t mismatchBytes(const unsigned char *left, const unsigned char *right, std::size_t size) noexcept {
+
+	constexpr std::size_t VECTOR_THRESHOLD = 16;
+
+	if (size < VECTOR_THRESHOLD) {
+		return mismatchBytesScalar(left, right, size);
+	}
+
+#if defined(SIMPLE_STRING_AVX2)
+	constexpr std::size_t AVX2_THRESHOLD = 64;
+
+	if (size >= AVX2_THRESHOLD && hasAvx2()) {
+		return mismatchBytesAvx2(left, right, size);
+	}
+#endif
+
+#if defined(SIMPLE_STRING_SSE2)
+	return mismatchBytesSse2(left, right, size);
+#else
+	return mismatchBytesScalar(left, right, size);
+#endif
+}
+
+/*
+	Index of the first differing character, or size if the ranges are equal.
+*/
+template <typename CharType>
+std::size_t mismatch(const CharType *left, const CharType *right, std::size_t size) noexcept {
+
+	std::size_t index = mismatchBytes(
+		reinterpret_cast<const unsigned char *>(left),
+		reinterpret_cast<const unsigned char *>(right),
+		size * sizeof(CharType));
+
+	return index / sizeof(CharType);
+}
+
+
+// Terminated Mismatch Kernels
+//
+// Compare a sized range against a NUL terminated string without measuring it first.
+// They return the index of the first character that differs or is a terminator in cstring,
+// or size if neither happens within the range.
+
+/*
+*/
+template <typename CharType>
+std::size_t mismatchTerminatedScalar(const CharType *data, const CharType *cstring, std::size_t size) noexcept {
+
+	for (std::size_t i = 0; i < size; ++i) {
+		if (cstring[i] == CharType{} || data[i] != cstring[i]) {
+			return i;
+		}
+	}
+
+	return size;
+}
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+	cstring is only read a whole vector at a time when that vector stays inside one page,
+	so reading past its terminator can never fault.
+*/
+template <typename CharType>
+SIMPLE_STRING_NO_SANITIZE_ADDRESS
+std::size_t mismatchTerminatedSse2(const CharType *data, const CharType *cstring, std::size_t size) noexcept {
+
+	constexpr std::size_t WIDTH = 16;
+	constexpr std::size_t STEP = WIDTH / sizeof(CharType);
+
+	const __m128i zero = _mm_setzero_si128();
+
+	std::size_t i = 0;
+
+	while (i + STEP <= size) {
+
+		if (!isPageSafe(cstring + i, WIDTH)) {
+			if (cstring[i] == CharType{} || data[i] != cstring[i]) {
+				return i;
+			}
+
+			++i;
+			continue;
+		}
+
+		__m128i dataVector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+		__m128i cstringVector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cstring + i));
+
+		__m128i equal = compareEqualSse2(dataVector, cstringVector, ElementSize<CharType>{});
+		__m128i terminator = compareEqualSse2(cstringVector, zero, ElementSize<CharType>{});
+
+		std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_andnot_si128(terminator, equal))) ^ 0xFFFFu;
+		if (mask != 0) {
+			return i + countTrailingZeros(mask) / sizeof(CharType);
+		}
+
+		i += STEP;
+	}
+
+	return i + mismatchTerminatedScalar(data + i, cstring + i, size - i);
+}
+
+#endif
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+*/
+template <typename CharType>
+std::size_t mismatchTerminated(const CharType *data, const CharType *cstring, std::size_t size, std::true_type) noexcept {
+	return mismatchTerminatedSse2(data, cstring, size);
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t mismatchTerminated(const CharType *data, const CharType *cstring, std::size_t size, std::false_type) noexcept {
+	return mismatchTerminatedScalar(data, cstring, size);
+}
+
+#endif
+
+/*
+*/
+template <typename CharType>
+std::size_t mismatchTerminated(const CharType *data, const CharType *cstring, std::size_t size) noexcept {
+
+#if defined(SIMPLE_STRING_SSE2)
+	return mismatchTerminated(data, cstring, size, IsVectorizable<CharType>{});
+#else
+	return mismatchTerminatedScalar(data, cstring, size);
+#endif
+}
+
+
+// Terminator Search Kernels
+//
+// Return the number of characters before the NUL termination.
+// The vector kernels only issue aligned loads; an aligned vector never straddles a page boundary,
+// so the bytes read past the terminator always belong to a page that is already mapped.
+
+/*
+*/
+template <typename CharType>
+std::size_t terminatedLengthScalar(const CharType *cstring) noexcept {
+
+	std::size_t size = 0;
+
+	while (cstring[size] != CharType{}) {
+		++size;
+	}
+
+	return size;
+}
+
+#if defined(SIMPLE_STRING_AVX2)
+
+/*
+	Continues a scan from a 128 byte aligned block and returns the byte offset of the terminator from it.
+	The four vectors of an iteration therefore always lie in the same page. They are folded with an
+	unsigned minimum, so a single compare per iteration tells whether any of them holds a zero.
+*/
+template <typename CharType>
+SIMPLE_STRING_AVX2_TARGET SIMPLE_STRING_NO_SANITIZE_ADDRESS
+std::size_t terminatorOffsetAvx2(const unsigned char *block) noexcept {
+
+	constexpr std::size_t WIDTH = 32;
+
+	const __m256i zero = _mm256_setzero_si256();
+	const unsigned char *start = block;
+
+	for (;; block += 4 * WIDTH) {
+		__m256i first = _mm256_load_si256(reinterpret_cast<const __m256i *>(block));
+		__m256i second = _mm256_load_si256(reinterpret_cast<const __m256i *>(block + WIDTH));
+		__m256i third = _mm256_load_si256(reinterpret_cast<const __m256i *>(block + 2 * WIDTH));
+		__m256i fourth = _mm256_load_si256(reinterpret_cast<const __m256i *>(block + 3 * WIDTH));
+
+		__m256i minimum = minimumAvx2(
+			minimumAvx2(first, second, ElementSize<CharType>{}),
+			minimumAvx2(third, fourth, ElementSize<CharType>{}), ElementSize<CharType>{});
+
+		if (_mm256_movemask_epi8(compareEqualAvx2(minimum, zero, ElementSize<CharType>{})) == 0) {
+			continue;
+		}
+
+		const __m256i vectors[] = {first, second, third, fourth};
+
+		for (std::size_t i = 0;; ++i) {
+			std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(compareEqualAvx2(vectors[i], zero, ElementSize<CharType>{})));
+			if (mask != 0) {
+				return static_cast<std::size_t>(block - start) + i * WIDTH + countTrailingZeros(mask);
+			}
+		}
+	}
+}
+
+#endif
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+	The first load is aligned down to the vector containing cstring and the lanes before it are discarded.
+	Short strings finish within the first few SSE2 blocks; longer ones continue with AVX2 where available.
+*/
+template <typename CharType>
+SIMPLE_STRING_NO_SANITIZE_ADDRESS
+std::size_t terminatedLengthSse2(const CharType *cstring) noexcept {
+
+	constexpr std::size_t WIDTH = 16;
+	constexpr std::size_t SSE2_BLOCKS = 4;
+
+	const __m128i zero = _mm_setzero_si128();
+
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(cstring);
+	std::size_t offset = reinterpret_cast<std::uintptr_t>(bytes) & (WIDTH - 1);
+	const unsigned char *block = bytes - offset;
+
+	std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(compareEqualSse2(
+		_mm_load_si128(reinterpret_cast<const __m128i *>(block)), zero, ElementSize<CharType>{}))) >> offset;
+
+	if (mask != 0) {
+		return countTrailingZeros(mask) / sizeof(CharType);
+	}
+
+	block += WIDTH;
+
+	for (std::size_t i = 1; i < SSE2_BLOCKS; ++i, block += WIDTH) {
+		mask = static_cast<std::uint32_t>(_mm_movemask_epi8(compareEqualSse2(
+			_mm_load_si128(reinterpret_cast<const __m128i *>(block)), zero, ElementSize<CharType>{})));
+
+		if (mask != 0) {
+			return (static_cast<std::size_t>(block - bytes) + countTrailingZeros(mask)) / sizeof(CharType);
+		}
+	}
+
+#if defined(SIMPLE_STRING_AVX2)
+	constexpr std::size_t AVX2_ALIGNMENT = 128;
+
+	if (hasAvx2()) {
+		for (; (reinterpret_cast<std::uintptr_t>(block) & (AVX2_ALIGNMENT - 1)) != 0; block += WIDTH) {
+			mask = static_cast<std::uint32_t>(_mm_movemask_epi8(compareEqualSse2(
+				_mm_load_si128(reinterpret_cast<const __m128i *>(block)), zero, ElementSize<CharType>{})));
+
+			if (mask != 0) {
+				return (static_cast<std::size_t>(block - bytes) + countTrailingZeros(mask)) / sizeof(CharType);
+			}
+		}
+
+		return (static_cast<std::size_t>(block - bytes) + terminatorOffsetAvx2<CharType>(block)) / sizeof(CharType);
+	}
+#endif
+
+	for (;; block += WIDTH) {
+		mask = static_cast<std::uint32_t>(_mm_movemask_epi8(compareEqualSse2(
+			_mm_load_si128(reinterpret_cast<const __m128i *>(block)), zero, ElementSize<CharType>{})));
+
+		if (mask != 0) {
+			return (static_cast<std::size_t>(block - bytes) + countTrailingZeros(mask)) / sizeof(CharType);
+		}
+	}
+}
+
+/*
+	Characters must be naturally aligned for the lanes of an aligned vector to line up with them.
+	Byte strings go to std::strlen instead, which every C library already ships hand tuned and
+	which measured ahead of the SSE2/AVX2 loop below for anything past a few dozen characters.
+*/
+template <typename CharType>
+std::size_t terminatedLength(const CharType *cstring, std::true_type) noexcept {
+
+	if (sizeof(CharType) == 1) {
+		return std::strlen(reinterpret_cast<const char *>(cstring));
+	}
+
+	if ((reinterpret_cast<std::uintptr_t>(cstring) & (sizeof(CharType) - 1)) != 0) {
+		return terminatedLengthScalar(cstring);
+	}
+
+	return terminatedLengthSse2(cstring);
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t terminatedLength(const CharType *cstring, std::false_type) noexcept {
+	return terminatedLengthScalar(cstring);
+}
+
+#endif
+
+/*
+*/
+template <typename CharType>
+std::size_t terminatedLength(const CharType *cstring) noexcept {
+
+#if defined(SIMPLE_STRING_SSE2)
+	return terminatedLength(cstring, IsVectorizable<CharType>{});
+#else
+	return terminatedLengthScalar(cstring);
+#endif
+}
+
+}
+}
+
+
+#endif // SIMPLE_STRING_KERNELS_HPP
@@ -0,0 +1,836 @@
+#pragma once
+#ifndef SIMPLE_STRING_NUMERIC_HPP
+#define SIMPLE_STRING_NUMERIC_HPP
+
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "SimpleStringHash.hpp"
+#include "SimpleStringKernels.hpp"
+
+
+// Numeric Conversion
+//
+// Integers are written two digits at a time, after counting their digits so the exact length is known up front.
+// Floating point values are written with the fewest digits that read back as the same value, like Ryu and
+// std::to_chars. The digits come from Grisu3 (Loitsch, "Printing Floating-Point Numbers Quickly and Accurately
+// with Integers", 2010), which needs only a small table of cached powers of ten and proves its own answer shortest
+// and closest for about 99.5% of values. It reports the rest, and those ask snprintf for one more digit at a time
+// until the text reads back exactly.
+// Parsing accepts the whole input or nothing. A double with at most 19 significant digits and a decimal exponent
+// within 22 is computed exactly by one multiplication or division (Clinger's fast path); anything else goes to strtod.
+
+
+
+namespace simple {
+
+
+// Parse Results
+
+enum class ParseError {
+	NONE,        // The whole input is a number and value holds it
+	INVALID,     // The input is empty or not entirely a number of the requested form
+	OUT_OF_RANGE // The input is a number the requested type cannot hold
+};
+
+/*
+	Outcome of parseInt(), parseDouble() or a Unicode conversion; value is zero (or empty) unless error is NONE.
+*/
+template <typename Type>
+struct ParseResult {
+
+	Type value;
+	ParseError error;
+
+	explicit operator bool() const noexcept;
+};
+
+
+/*
+	True when the parse succeeded.
+*/
+template <typename Type>
+ParseResult<Type>::operator bool() const noexcept {
+	return error == ParseError::NONE;
+}
+
+
+namespace detail {
+
+
+// Constants
+
+// Longest text written for a float or double: a sign, "0.", five zeros and seventeen digits.
+constexpr std::size_t FLOAT_TEXT_CAPACITY = 25;
+
+constexpr std::uint64_t POWERS_OF_TEN[20] = {
+	1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u,
+	10000000000u, 100000000000u, 1000000000000u, 10000000000000u, 100000000000000u,
+	1000000000000000u, 10000000000000000u, 100000000000000000u, 1000000000000000000u, 10000000000000000000u
+};
+
+// Powers of ten that are exact as doubles.
+constexpr double EXACT_POWERS_OF_TEN[23] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+constexpr char DIGIT_PAIRS[201] =
+	"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+	"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+
+// Integer Formatting
+
+/*
+	Number of decimal digits in value, which is at least one.
+	The bit length gives log10 to within one (1233 / 4096 is just above log10(2)); a comparison settles it.
+*/
+inline unsigned decimalLength(std::uint64_t value) noexcept {
+
+	unsigned guess = ((highestSetBit(value | 1) + 1) * 1233) >> 12;
+
+	return guess + ((value | 1) >= POWERS_OF_TEN[guess] ? 1 : 0);
+}
+
+/*
+	Writes the length digits of value ending at first + length, two at a time, and returns first + length.
+*/
+template <typename CharType>
+CharType *writeDecimal(CharType *first, std::uint64_t value, unsigned length) noexcept {
+
+	assert(length == decimalLength(value));
+
+	CharType *last = first + length;
+	CharType *position = last;
+
+	while (value >= 100) {
+		unsigned pair = static_cast<unsigned>(value % 100) * 2;
+		value /= 100;
+
+		*--position = static_cast<CharType>(DIGIT_PAIRS[pair + 1]);
+		*--position = static_cast<CharType>(DIGIT_PAIRS[pair]);
+	}
+
+	if (value >= 10) {
+		unsigned pair = static_cast<unsigned>(value) * 2;
+
+		*--position = static_cast<CharType>(DIGIT_PAIRS[pair + 1]);
+		*--position = static_cast<CharType>(DIGIT_PAIRS[pair]);
+	}
+	else {
+		*--position = static_cast<CharType>('0' + value);
+	}
+
+	return last;
+}
+
+/*
+	Magnitude of value, with negative set when there is a sign to write.
+*/
+template <typename IntegerType>
+std::uint64_t splitSign(IntegerType value, bool &negative, std::true_type) noexcept {
+
+	using UnsignedType = typename std::make_unsigned<IntegerType>::type;
+
+	negative = value < 0;
+
+	return negative ? static_cast<UnsignedType>(UnsignedType{0} - static_cast<UnsignedType>(value)) : static_cast<UnsignedType>(value);
+}
+
+/*
+*/
+template <typename IntegerType>
+std::uint64_t splitSign(IntegerType value, bool &negative, std::false_type) noexcept {
+
+	negative = false;
+
+	return value;
+}
+
+
+// Floating Point Formatting
+
+/*
+*/
+template <typename FloatType>
+struct FloatTraits;
+
+template <>
+struct FloatTraits<double> {
+
+	using BitsType = std::uint64_t;
+
+	static constexpr int SIGNIFICAND_BITS = 52;
+	static constexpr int EXPONENT_BIAS = 1023 + SIGNIFICAND_BITS;
+	static constexpr int MAXIMUM_DIGITS = std::numeric_limits<double>::max_digits10;
+
+	static double read(const char *text) noexcept {
+		return std::strtod(text, nullptr);
+	}
+};
+
+template <>
+struct FloatTraits<float> {
+
+	using BitsType = std::uint32_t;
+
+	static constexpr int SIGNIFICAND_BITS = 23;
+	static constexpr int EXPONENT_BIAS = 127 + SIGNIFICAND_BITS;
+	static constexpr int MAXIMUM_DIGITS = std::numeric_limits<float>::max_digits10;
+
+	static float read(const char *text) noexcept {
+		return std::strtof(text, nullptr);
+	}
+};
+
+/*
+	A value as significand * 2^exponent, with the significand in a full 64-bit word.
+*/
+struct BinaryFloat {
+	std::uint64_t significand;
+	int exponent;
+};
+
+/*
+	Text of a float or double before layout: value = digits * 10^exponent, digits holding length characters.
+	A literal ("0", "inf", "nan") is kept in digits as it is written.
+*/
+struct FloatDecimal {
+	char digits[FLOAT_TEXT_CAPACITY];
+	int length;
+	int exponent;
+	bool negative;
+	bool literal;
+};
+
+/*
+	10^decimalExponent = significand * 2^binaryExponent, rounded to 64 bits.
+*/
+struct CachedPower {
+	std::uint64_t significand;
+	int binaryExponent;
+	int decimalExponent;
+};
+
+// Every eighth power of ten from 10^-348 to 10^340, enough to bring any double or float into Grisu's working range.
+constexpr CachedPower CACHED_POWERS[87] = {
+	{0xfa8fd5a0081c0288u, -1220, -348}, {0xbaaee17fa23ebf76u, -1193, -340}, {0x8b16fb203055ac76u, -1166, -332},
+	{0xcf42894a5dce35eau, -1140, -324}, {0x9a6bb0aa55653b2du, -1113, -316}, {0xe61acf033d1a45dfu, -1087, -308},
+	{0xab70fe17c79ac6cau, -1060, -300}, {0xff77b1fcbebcdc4fu, -1034, -292}, {0xbe5691ef416bd60cu, -1007, -284},
+	{0x8dd01fad907ffc3cu, -980, -276}, {0xd3515c2831559a83u, -954, -268}, {0x9d71ac8fada6c9b5u, -927, -260},
+	{0xea9c227723ee8bcbu, -901, -252}, {0xaecc49914078536du, -874, -244}, {0x823c12795db6ce57u, -847, -236},
+	{0xc21094364dfb5637u, -821, -228}, {0x9096ea6f3848984fu, -794, -220}, {0xd77485cb25823ac7u, -768, -212},
+	{0xa086cfcd97bf97f4u, -741, -204}, {0xef340a98172aace5u, -715, -196}, {0xb23867fb2a35b28eu, -688, -188},
+	{0x84c8d4dfd2c63f3bu, -661, -180}, {0xc5dd44271ad3cdbau, -635, -172}, {0x936b9fcebb25c996u, -608, -164},
+	{0xdbac6c247d62a584u, -582, -156}, {0xa3ab66580d5fdaf6u, -555, -148}, {0xf3e2f893dec3f126u, -529, -140},
+	{0xb5b5ada8aaff80b8u, -502, -132}, {0x87625f056c7c4a8bu, -475, -124}, {0xc9bcff6034c13053u, -449, -116},
+	{0x964e858c91ba2655u, -422, -108}, {0xdff9772470297ebdu, -396, -100}, {0xa6dfbd9fb8e5b88fu, -369, -92},
+	{0xf8a95fcf88747d94u, -343, -84}, {0xb94470938fa89bcfu, -316, -76}, {0x8a08f0f8bf0f156bu, -289, -68},
+	{0xcdb02555653131b6u, -263, -60}, {0x993fe2c6d07b7facu, -236, -52}, {0xe45c10c42a2b3b06u, -210, -44},
+	{0xaa242499697392d3u, -183, -36}, {0xfd87b5f28300ca0eu, -157, -28}, {0xbce5086492111aebu, -130, -20},
+	{0x8cbccc096f5088ccu, -103, -12}, {0xd1b71758e219652cu, -77, -4}, {0x9c40000000000000u, -50, 4},
+	{0xe8d4a51000000000u, -24, 12}, {0xad78ebc5ac620000u, 3, 20}, {0x813f3978f8940984u, 30, 28},
+	{0xc097ce7bc90715b3u, 56, 36}, {0x8f7e32ce7bea5c70u, 83, 44}, {0xd5d238a4abe98068u, 109, 52},
+	{0x9f4f2726179a2245u, 136, 60}, {0xed63a231d4c4fb27u, 162, 68}, {0xb0de65388cc8ada8u, 189, 76},
+	{0x83c7088e1aab65dbu, 216, 84}, {0xc45d1df942711d9au, 242, 92}, {0x924d692ca61be758u, 269, 100},
+	{0xda01ee641a708deau, 295, 108}, {0xa26da3999aef774au, 322, 116}, {0xf209787bb47d6b85u, 348, 124},
+	{0xb454e4a179dd1877u, 375, 132}, {0x865b86925b9bc5c2u, 402, 140}, {0xc83553c5c8965d3du, 428, 148},
+	{0x952ab45cfa97a0b3u, 455, 156}, {0xde469fbd99a05fe3u, 481, 164}, {0xa59bc234db398c25u, 508, 172},
+	{0xf6c69a72a3989f5cu, 534, 180}, {0xb7dcbf5354e9beceu, 561, 188}, {0x88fcf317f22241e2u, 588, 196},
+	{0xcc20ce9bd35c78a5u, 614, 204}, {0x98165af37b2153dfu, 641, 212}, {0xe2a0b5dc971f303au, 667, 220},
+	{0xa8d9d1535ce3b396u, 694, 228}, {0xfb9b7cd9a4a7443cu, 720, 236}, {0xbb764c4ca7a44410u, 747, 244},
+	{0x8bab8eefb6409c1au, 774, 252}, {0xd01fef10a657842cu, 800, 260}, {0x9b10a4e5e9913129u, 827, 268},
+	{0xe7109bfba19c0c9du, 853, 276}, {0xac2820d9623bf429u, 880, 284}, {0x80444b5e7aa7cf85u, 907, 292},
+	{0xbf21e44003acdd2du, 933, 300}, {0x8e679c2f5e44ff8fu, 960, 308}, {0xd433179d9c8cb841u, 986, 316},
+	{0x9e19db92b4e31ba9u, 1013, 324}, {0xeb96bf6ebadf77d9u, 1039, 332}, {0xaf87023b9bf0ee6bu, 1066, 340}
+};
+
+constexpr int CACHED_POWERS_OFFSET = 348;
+constexpr int CACHED_POWERS_STEP = 8;
+
+// Scaled values are kept with their binary point this far inside a 64-bit word, leaving room for 32-bit digit chunks.
+constexpr int GRISU_MINIMUM_EXPONENT = -60;
+constexpr int GRISU_MAXIMUM_EXPONENT = -32;
+
+/*
+*/
+inline BinaryFloat normalize(BinaryFloat value) noexcept {
+
+	unsigned shift = 63 - highestSetBit(value.significand);
+
+	return BinaryFloat{value.significand << shift, value.exponent - static_cast<int>(shift)};
+}
+
+/*
+	Product rounded to its high 64 bits.
+*/
+inline BinaryFloat multiplyRounded(BinaryFloat left, BinaryFloat right) noexcept {
+
+	std::uint64_t low, high;
+	multiplyWide(left.significand, right.significand, low, high);
+
+	return BinaryFloat{high + (low >> 63), left.exponent + right.exponent + 64};
+}
+
+/*
+	Walks the last digit down towards the exact value while that stays inside the safe interval,
+	then reports whether the result is provably the closest shortest one (Grisu3's round_weed).
+	All quantities are in units of the scaled value, each known to within unit.
+*/
+inline bool roundWeed(char *digits, int length, std::uint64_t distanceTooHighW, std::uint64_t unsafeInterval,
+	std::uint64_t rest, std::uint64_t tenKappa, std::uint64_t unit) noexcept {
+
+	std::uint64_t smallDistance = distanceTooHighW - unit;
+	std::uint64_t bigDistance = distanceTooHighW + unit;
+
+	while (rest < smallDistance && unsafeInterval - rest >= tenKappa &&
+		(rest + tenKappa < smallDistance || smallDistance - rest >= rest + tenKappa - smallDistance)) {
+
+		--digits[length - 1];
+		rest += tenKappa;
+	}
+
+	if (rest < bigDistance && unsafeInterval - rest >= tenKappa &&
+		(rest + tenKappa < bigDistance || bigDistance - rest > rest + tenKappa - bigDistance)) {
+
+		return false;
+	}
+
+	return 2 * unit <= rest && rest <= unsafeInterval - 4 * unit;
+}
+
+/*
+	Grisu3 for a positive, finite, nonzero value. Returns false, leaving decimal unspecified,
+	when the result cannot be proven shortest and correctly rounded.
+*/
+template <typename FloatType>
+bool grisuShortest(FloatType value, FloatDecimal &decimal) noexcept {
+
+	using Traits = FloatTraits<FloatType>;
+	using BitsType = typename Traits::BitsType;
+
+	BitsType bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	std::uint64_t fraction = bits & ((BitsType{1} << Traits::SIGNIFICAND_BITS) - 1);
+	int biasedExponent = static_cast<int>(bits >> Traits::SIGNIFICAND_BITS);
+
+	BinaryFloat exact = biasedExponent == 0
+		? BinaryFloat{fraction, 1 - Traits::EXPONENT_BIAS}
+		: BinaryFloat{fraction | (std::uint64_t{1} << Traits::SIGNIFICAND_BITS), biasedExponent - Traits::EXPONENT_BIAS};
+
+	// Midpoints to the neighbouring values; below a power of two the lower neighbour is twice as close.
+	BinaryFloat upper = normalize(BinaryFloat{(exact.significand << 1) + 1, exact.exponent - 1});
+	BinaryFloat lower = fraction == 0 && biasedExponent > 1
+		? BinaryFloat{(exact.significand << 2) - 1, exact.exponent - 2}
+		: BinaryFloat{(exact.significand << 1) - 1, exact.exponent - 1};
+
+	lower.significand <<= lower.exponent - upper.exponent;
+	lower.exponent = upper.exponent;
+
+	BinaryFloat w = normalize(exact);
+
+	// The smallest cached power that lifts the exponent to at least GRISU_MINIMUM_EXPONENT; log10(2) = 0.30103.
+	int minimum = GRISU_MINIMUM_EXPONENT - (w.exponent + 64);
+	int decimalGuess = static_cast<int>(std::ceil((minimum + 63) * 0.30102999566398114));
+
+	const CachedPower &power = CACHED_POWERS[(CACHED_POWERS_OFFSET + decimalGuess - 1) / CACHED_POWERS_STEP + 1];
+	BinaryFloat scale{power.significand, power.binaryExponent};
+
+	assert(w.exponent + scale.exponent + 64 >= GRISU_MINIMUM_EXPONENT && w.exponent + scale.exponent + 64 <= GRISU_MAXIMUM_EXPONENT);
+
+	BinaryFloat scaledW = multiplyRounded(w, scale);
+	BinaryFloat scaledLower = multiplyRounded(lower, scale);
+	BinaryFloat scaledUpper = multiplyRounded(upper, scale);
+
+	// Digit generation: every digit is taken from tooHigh, the upper bound widened by the rounding error,
+	// until what remains is inside the unsafe interval; roundWeed then decides whether that is safe.
+	std::uint64_t unit = 1;
+	std::uint64_t tooHigh = scaledUpper.significand + unit;
+	std::uint64_t unsafeInterval = tooHigh - (scaledLower.significand - unit);
+
+	int shift = -scaledW.exponent;
+	std::uint64_t one = std::uint64_t{1} << shift;
+
+	std::uint32_t integrals = static_cast<std::uint32_t>(tooHigh >> shift);
+	std::uint64_t fractionals = tooHigh & (one - 1);
+
+	int kappa = static_cast<int>(decimalLength(integrals));
+	std::uint32_t divisor = static_cast<std::uint32_t>(POWERS_OF_TEN[kappa - 1]);
+
+	int length = 0;
+
+	while (kappa > 0) {
+		decimal.digits[length++] = static_cast<char>('0' + integrals / divisor);
+		integrals %= divisor;
+		--kappa;
+
+		std::uint64_t rest = (static_cast<std::uint64_t>(integrals) << shift) + fractionals;
+
+		if (rest < unsafeInterval) {
+			decimal.length = length;
+			decimal.exponent = kappa - power.decimalExponent;
+
+			return roundWeed(decimal.digits, length, tooHigh - scaledW.significand, unsafeInterval, rest, static_cast<std::uint64_t>(divisor) << shift, unit);
+		}
+
+		divisor /= 10;
+	}
+
+	while (length < Traits::MAXIMUM_DIGITS) {
+		fractionals *= 10;
+		unit *= 10;
+		unsafeInterval *= 10;
+
+		decimal.digits[length++] = static_cast<char>('0' + (fractionals >> shift));
+		fractionals &= one - 1;
+		--kappa;
+
+		if (fractionals < unsafeInterval) {
+			decimal.length = length;
+			decimal.exponent = kappa - power.decimalExponent;
+
+			return roundWeed(decimal.digits, length, (tooHigh - scaledW.significand) * unit, unsafeInterval, fractionals, one, unit);
+		}
+	}
+
+	return false;
+}
+
+/*
+	Adds one to the last digit of the significand in text (d.ddde+xx), carrying leftwards;
+	false when the carry would need another leading digit.
+*/
+inline bool incrementSignificand(char *text) noexcept {
+
+	char *position = std::strchr(text, 'e');
+
+	while (position-- != text) {
+		if (*position < '0' || *position > '9') {
+			continue;
+		}
+
+		if (*position != '9') {
+			++*position;
+			return true;
+		}
+
+		*position = '0';
+	}
+
+	return false;
+}
+
+/*
+	Shortest digits for a positive, finite, nonzero value by trying each precision in turn with snprintf,
+	which rounds correctly, so the first text that reads back exactly is also the closest of its length.
+	At a power of two the values above are twice as far apart as those below, and the next decimal up
+	can read back exactly when the closest one, below, does not; that neighbour is tried as well.
+*/
+template <typename FloatType>
+void exactShortest(FloatType value, FloatDecimal &decimal) noexcept {
+
+	using Traits = FloatTraits<FloatType>;
+
+	int binaryExponent;
+	bool powerOfTwo = std::frexp(value, &binaryExponent) == FloatType(0.5);
+
+	char text[40];
+
+	for (int precision = 1;; ++precision) {
+		std::snprintf(text, sizeof(text), "%.*e", precision - 1, static_cast<double>(value));
+
+		if (precision == Traits::MAXIMUM_DIGITS || Traits::read(text) == value) {
+			break;
+		}
+
+		if (powerOfTwo) {
+			char above[sizeof(text)];
+			std::memcpy(above, text, sizeof(text));
+
+			if (incrementSignificand(above) && Traits::read(above) == value) {
+				std::memcpy(text, above, sizeof(text));
+				break;
+			}
+		}
+	}
+
+	// The text is d.ddde+xx, with the locale's decimal point.
+	const char *position = text;
+	int length = 0;
+
+	for (; *position != 'e'; ++position) {
+		if (*position >= '0' && *position <= '9') {
+			decimal.digits[length++] = *position;
+		}
+	}
+
+	decimal.length = length;
+	decimal.exponent = std::atoi(position + 1) - (length - 1);
+}
+
+/*
+*/
+template <typename FloatType>
+FloatDecimal shortestDecimal(FloatType value) noexcept {
+
+	FloatDecimal decimal{};
+	decimal.negative = std::signbit(value);
+
+	const char *literal = std::isnan(value) ? "nan" : std::isinf(value) ? "inf" : value == 0 ? "0" : nullptr;
+
+	if (literal != nullptr) {
+		decimal.literal = true;
+		decimal.negative = decimal.negative && !std::isnan(value);
+		decimal.length = static_cast<int>(std::strlen(literal));
+		std::memcpy(decimal.digits, literal, static_cast<std::size_t>(decimal.length));
+
+		return decimal;
+	}
+
+	FloatType magnitude = std::fabs(value);
+
+	if (!grisuShortest(magnitude, decimal)) {
+		exactShortest(magnitude, decimal);
+	}
+
+	return decimal;
+}
+
+/*
+	Length of the text writeFloatText() produces. Layout follows JavaScript's Number::toString:
+	plain digits while the decimal point is within 21 places of the first digit and no more than six zeros
+	would follow it, scientific notation otherwise.
+*/
+inline std::size_t floatTextLength(const FloatDecimal &decimal) noexcept {
+
+	std::size_t sign = decimal.negative ? 1 : 0;
+
+	if (decimal.literal) {
+		return sign + static_cast<std::size_t>(decimal.length);
+	}
+
+	int length = decimal.length;
+	int point = length + decimal.exponent;
+
+	if (length <= point && point <= 21) {
+		return sign + static_cast<std::size_t>(point);
+	}
+
+	if (0 < point && point <= 21) {
+		return sign + static_cast<std::size_t>(length + 1);
+	}
+
+	if (-6 < point && point <= 0) {
+		return sign + static_cast<std::size_t>(2 - point + length);
+	}
+
+	int exponent = point - 1;
+	std::uint64_t magnitude = static_cast<std::uint64_t>(exponent < 0 ? -exponent : exponent);
+
+	return sign + static_cast<std::size_t>(length + (length > 1 ? 1 : 0) + 2) + decimalLength(magnitude);
+}
+
+/*
+	Writes the text of decimal, exactly floatTextLength(decimal) characters, and returns the end.
+*/
+template <typename CharType>
+CharType *writeFloatText(CharType *output, const FloatDecimal &decimal) noexcept {
+
+	const char *digits = decimal.digits;
+	int length = decimal.length;
+
+	if (decimal.negative) {
+		*output++ = static_cast<CharType>('-');
+	}
+
+	if (decimal.literal) {
+		return std::copy(digits, digits + length, output);
+	}
+
+	int point = length + decimal.exponent;
+
+	if (length <= point && point <= 21) {
+		output = std::copy(digits, digits + length, output);
+		return std::fill_n(output, point - length, static_cast<CharType>('0'));
+	}
+
+	if (0 < point && point <= 21) {
+		output = std::copy(digits, digits + point, output);
+		*output++ = static_cast<CharType>('.');
+		return std::copy(digits + point, digits + length, output);
+	}
+
+	if (-6 < point && point <= 0) {
+		*output++ = static_cast<CharType>('0');
+		*output++ = static_cast<CharType>('.');
+		output = std::fill_n(output, -point, static_cast<CharType>('0'));
+		return std::copy(digits, digits + length, output);
+	}
+
+	*output++ = static_cast<CharType>(digits[0]);
+
+	if (length > 1) {
+		*output++ = static_cast<CharType>('.');
+		output = std::copy(digits + 1, digits + length, output);
+	}
+
+	int exponent = point - 1;
+	std::uint64_t magnitude = static_cast<std::uint64_t>(exponent < 0 ? -exponent : exponent);
+
+	*output++ = static_cast<CharType>('e');
+	*output++ = static_cast<CharType>(exponent < 0 ? '-' : '+');
+
+	return writeDecimal(output, magnitude, decimalLength(magnitude));
+}
+
+
+// Parsing
+
+/*
+	Value of an ASCII digit or letter in bases up to 36, or 36 for any other character.
+*/
+template <typename CharType>
+unsigned digitValue(CharType character) noexcept {
+
+	std::uint32_t code = static_cast<std::uint32_t>(static_cast<typename std::make_unsigned<CharType>::type>(character));
+
+	if (code - '0' < 10) {
+		return code - '0';
+	}
+
+	std::uint32_t lower = code | 0x20;
+
+	return lower - 'a' < 26 ? lower - 'a' + 10 : 36;
+}
+
+/*
+	Whether [data, data + size) equals the lowercase ASCII word, ignoring case.
+*/
+template <typename CharType>
+bool equalsWordIgnoreCase(const CharType *data, std::size_t size, const char *word) noexcept {
+
+	std::size_t length = std::strlen(word);
+
+	if (size != length) {
+		return false;
+	}
+
+	for (std::size_t i = 0; i < size; ++i) {
+		std::uint32_t code = static_cast<std::uint32_t>(static_cast<typename std::make_unsigned<CharType>::type>(data[i]));
+
+		if (code > 0x7f || (code | 0x20) != static_cast<std::uint32_t>(word[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+	An optional '+' or '-' (only '+' for unsigned types) followed by at least one digit in base, and nothing else.
+*/
+template <typename IntegerType, typename CharType>
+ParseResult<IntegerType> parseInteger(const CharType *data, std::size_t size, unsigned base) noexcept {
+
+	static_assert(std::is_integral<IntegerType>::value && !std::is_same<IntegerType, bool>::value, "parseInt needs an integer type");
+
+	assert(base >= 2 && base <= 36);
+
+	using UnsignedType = typename std::make_unsigned<IntegerType>::type;
+
+	std::size_t i = 0;
+	bool negative = false;
+
+	if (size != 0 && (data[0] == static_cast<CharType>('-') || data[0] == static_cast<CharType>('+'))) {
+		negative = data[0] == static_cast<CharType>('-');
+		++i;
+
+		if (negative && !std::is_signed<IntegerType>::value) {
+			return ParseResult<IntegerType>{0, ParseError::INVALID};
+		}
+	}
+
+	if (i == size) {
+		return ParseResult<IntegerType>{0, ParseError::INVALID};
+	}
+
+	UnsignedType limit = static_cast<UnsignedType>(std::numeric_limits<IntegerType>::max()) + (negative ? 1 : 0);
+	UnsignedType value = 0;
+	bool overflow = false;
+
+	for (; i < size; ++i) {
+		unsigned digit = digitValue(data[i]);
+
+		if (digit >= base) {
+			return ParseResult<IntegerType>{0, ParseError::INVALID};
+		}
+
+		if (value > (limit - digit) / base) {
+			overflow = true;
+		}
+		else {
+			value = static_cast<UnsignedType>(value * base + digit);
+		}
+	}
+
+	if (overflow) {
+		return ParseResult<IntegerType>{0, ParseError::OUT_OF_RANGE};
+	}
+
+	return ParseResult<IntegerType>{static_cast<IntegerType>(negative ? UnsignedType{0} - value : value), ParseError::NONE};
+}
+
+/*
+	An optional sign, then digits with an optional decimal point and an optional exponent (1, -2.5, .5e3, 6.E-7),
+	or inf, infinity or nan in any case, and nothing else.
+	Overflow is OUT_OF_RANGE; underflow gives the nearest double, possibly zero, without an error.
+	Inputs off the fast path are handed to strtod, which reads them in the C locale's format only while that is in effect;
+	those over 127 characters are copied to the heap first, so this may throw std::bad_alloc.
+*/
+template <typename CharType>
+ParseResult<double> parseFloatingPoint(const CharType *data, std::size_t size) {
+
+	const ParseResult<double> invalid{0.0, ParseError::INVALID};
+
+	std::size_t i = 0;
+	bool negative = false;
+
+	if (size != 0 && (data[0] == static_cast<CharType>('-') || data[0] == static_cast<CharType>('+'))) {
+		negative = data[0] == static_cast<CharType>('-');
+		++i;
+	}
+
+	if (equalsWordIgnoreCase(data + i, size - i, "inf") || equalsWordIgnoreCase(data + i, size - i, "infinity")) {
+		return ParseResult<double>{negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity(), ParseError::NONE};
+	}
+
+	if (equalsWordIgnoreCase(data + i, size - i, "nan")) {
+		return ParseResult<double>{std::numeric_limits<double>::quiet_NaN(), ParseError::NONE};
+	}
+
+	// Up to 19 significant digits fit in the significand; beyond that only whether any are nonzero matters to the fast path.
+	std::uint64_t significand = 0;
+	int significantDigits = 0;
+	int exponent = 0;
+	bool anyDigits = false;
+	bool truncated = false;
+	bool fraction = false;
+
+	for (; i < size; ++i) {
+		unsigned digit = digitValue(data[i]);
+
+		if (digit < 10) {
+			anyDigits = true;
+
+			if (significand == 0 && digit == 0) {
+				exponent -= fraction ? 1 : 0;
+			}
+			else if (significantDigits < 19) {
+				significand = significand * 10 + digit;
+				++significantDigits;
+				exponent -= fraction ? 1 : 0;
+			}
+			else {
+				exponent += fraction ? 0 : 1;
+				truncated = truncated || digit != 0;
+			}
+		}
+		else if (data[i] == static_cast<CharType>('.') && !fraction) {
+			fraction = true;
+		}
+		else {
+			break;
+		}
+	}
+
+	if (!anyDigits) {
+		return invalid;
+	}
+
+	if (i < size && (data[i] == static_cast<CharType>('e') || data[i] == static_cast<CharType>('E'))) {
+		++i;
+
+		bool negativeExponent = false;
+
+		if (i < size && (data[i] == static_cast<CharType>('-') || data[i] == static_cast<CharType>('+'))) {
+			negativeExponent = data[i] == static_cast<CharType>('-');
+			++i;
+		}
+
+		if (i == size) {
+			return invalid;
+		}
+
+		int written = 0;
+
+		for (; i < size; ++i) {
+			unsigned digit = digitValue(data[i]);
+
+			if (digit >= 10) {
+				return invalid;
+			}
+
+			// Far beyond any double's range; saturating keeps the sum below from overflowing.
+			written = written < 100000 ? written * 10 + static_cast<int>(digit) : written;
+		}
+
+		exponent += negativeExponent ? -written : written;
+	}
+
+	if (i != size) {
+		return invalid;
+	}
+
+	if (significand == 0) {
+		return ParseResult<double>{negative ? -0.0 : 0.0, ParseError::NONE};
+	}
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+	// Both operands are exact, so the one rounding of the product or quotient is the correct one.
+	if (!truncated && significand <= (std::uint64_t{1} << 53) && exponent >= -22 && exponent <= 22) {
+		double value = static_cast<double>(significand);
+		value = exponent < 0 ? value / EXACT_POWERS_OF_TEN[-exponent] : value * EXACT_POWERS_OF_TEN[exponent];
+
+		return ParseResult<double>{negative ? -value : value, ParseError::NONE};
+	}
+#endif
+
+	// Validated above to be ASCII, so each character narrows to itself.
+	char local[128];
+	std::unique_ptr<char[]> heap{size < sizeof(local) ? nullptr : new char[size + 1]};
+	char *text = heap != nullptr ? heap.get() : local;
+
+	for (std::size_t j = 0; j < size; ++j) {
+		text[j] = static_cast<char>(data[j]);
+	}
+	text[size] = '\0';
+
+	double value = std::strtod(text, nullptr);
+
+	if (std::isinf(value)) {
+		return ParseResult<double>{0.0, ParseError::OUT_OF_RANGE};
+	}
+
+	return ParseResult<double>{value, ParseError::NONE};
+}
+
+}
+}
+
+
+#endif // SIMPLE_STRING_NUMERIC_HPP
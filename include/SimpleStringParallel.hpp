@@ -0,0 +1,754 @@
+#pragma once
+#ifndef SIMPLE_STRING_PARALLEL_HPP
+#define SIMPLE_STRING_PARALLEL_HPP
+
+
+#include "SimpleString.hpp"
+#include "SimpleStringCase.hpp"
+#include "SimpleStringHash.hpp"
+#include "SimpleStringSearch.hpp"
+#include "SimpleStringStats.hpp"
+#include "SimpleStringView.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+
+// Parallel Bulk Operations
+//
+// Counting, searching, case conversion, replacement and hashing over very large strings, split into
+// chunks that the threads of a ThreadPool take one at a time. Each function gives the same result as its
+// serial counterpart whatever the pool size or chunking: a match that crosses the end of a chunk is found
+// by the chunk it starts in, which reads up to one needle length past its end, and matches that depend on
+// the one before them are settled left to right afterwards. Strings shorter than the serial threshold are
+// processed on the calling thread alone, where waking the pool would cost more than it saves.
+//
+// The text is read concurrently, so it must not be modified while one of these functions runs.
+
+
+
+namespace simple {
+
+
+/*
+	grainSize is the number of characters in each chunk; a few hundred kilobytes keep a chunk in the
+	private cache of the core working on it while leaving enough chunks to even out the threads' progress.
+*/
+struct ParallelOptions {
+
+	std::size_t grainSize = std::size_t{1} << 18;
+	std::size_t serialThreshold = std::size_t{1} << 20;
+};
+
+
+/*
+	Fixed set of worker threads that run batches of numbered tasks. The thread calling run() works on
+	its batch too, so a pool of size n starts n - 1 threads; if some cannot be started, the pool is
+	simply smaller. Batches submitted from several threads run one after another, and run() called
+	from inside a task runs its batch serially on that thread instead of waiting on the pool.
+*/
+class ThreadPool {
+public:
+
+	// Type Aliases
+
+	using SizeType = std::size_t;
+
+	// Constructors
+
+	explicit ThreadPool(SizeType = std::thread::hardware_concurrency());
+
+	ThreadPool(const ThreadPool &) = delete;
+
+	// Destructor
+
+	~ThreadPool() noexcept;
+
+	// Assignment Operations
+
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	// Size Functions
+
+	SizeType size() const noexcept;
+
+	// Execution Functions
+
+	template <typename Function>
+	void run(SizeType, Function &&);
+
+private:
+
+	// The batch being worked on; it lives on the stack of the thread that called run().
+	struct Batch {
+		void (*invoke)(void *, SizeType);
+		void *function;
+		SizeType count;
+		std::atomic<SizeType> next;
+		std::atomic<bool> failed;
+		std::exception_ptr exception;
+	};
+
+	// Data Members
+
+	std::vector<std::thread> m_threads;
+
+	std::mutex m_submitMutex;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_idle;
+
+	Batch *m_batch{};
+	SizeType m_generation{};
+	SizeType m_busy{};
+	bool m_stopping{};
+
+	// Utility Functions
+
+	static bool &insideTask() noexcept;
+	static void execute(Batch &) noexcept;
+
+	void work() noexcept;
+};
+
+
+// Constructors
+
+/*
+	threadCount includes the calling thread; zero, which hardware_concurrency() may return, counts as one.
+*/
+inline ThreadPool::ThreadPool(SizeType threadCount) {
+
+	if (threadCount > 1) {
+		m_threads.reserve(threadCount - 1);
+	}
+
+	try {
+		for (SizeType i = 1; i < threadCount; ++i) {
+			m_threads.emplace_back([this] { work(); });
+		}
+	}
+	catch (const std::system_error &) {}
+}
+
+
+// Destructor
+
+/*
+*/
+inline ThreadPool::~ThreadPool() noexcept {
+
+	{
+		std::lock_guard<std::mutex> lock{m_mutex};
+		m_stopping = true;
+	}
+
+	m_wake.notify_all();
+
+	for (std::thread &thread : m_threads) {
+		thread.join();
+	}
+}
+
+
+// Size Functions
+
+/*
+	Number of threads that work on a batch, the calling one included.
+*/
+inline ThreadPool::SizeType ThreadPool::size() const noexcept {
+	return m_threads.size() + 1;
+}
+
+
+// Execution Functions
+
+/*
+	Calls function(i) for every i below count and returns once all of the calls have, in no particular order
+	and possibly at the same time. If a call throws, the tasks not yet started are skipped and the first
+	exception is rethrown here.
+*/
+template <typename Function>
+void ThreadPool::run(SizeType count, Function &&function) {
+
+	if (count <= 1 || m_threads.empty() || insideTask()) {
+		for (SizeType i = 0; i < count; ++i) {
+			function(i);
+		}
+
+		return;
+	}
+
+	using FunctionType = typename std::remove_reference<Function>::type;
+
+	Batch batch;
+	batch.invoke = [](void *erased, SizeType i) { (*static_cast<FunctionType *>(erased))(i); };
+	batch.function = const_cast<void *>(static_cast<const volatile void *>(std::addressof(function)));
+	batch.count = count;
+	batch.next.store(0, std::memory_order_relaxed);
+	batch.failed.store(false, std::memory_order_relaxed);
+
+	std::lock_guard<std::mutex> submit{m_submitMutex};
+
+	{
+		std::lock_guard<std::mutex> lock{m_mutex};
+		m_batch = &batch;
+		++m_generation;
+	}
+
+	m_wake.notify_all();
+
+	execute(batch);
+
+	{
+		// Workers only join a batch under the lock, so none can start on this one once it is cleared.
+		std::unique_lock<std::mutex> lock{m_mutex};
+		m_idle.wait(lock, [this] { return m_busy == 0; });
+		m_batch = nullptr;
+	}
+
+	if (batch.exception) {
+		std::rethrow_exception(batch.exception);
+	}
+}
+
+
+// Utility Functions
+
+/*
+	Set while the current thread runs a task of any pool.
+*/
+inline bool &ThreadPool::insideTask() noexcept {
+	static thread_local bool inside = false;
+	return inside;
+}
+
+/*
+	Takes tasks from batch until there are none left or one of them has thrown.
+*/
+inline void ThreadPool::execute(Batch &batch) noexcept {
+
+	bool &inside = insideTask();
+	inside = true;
+
+	for (SizeType i = batch.next.fetch_add(1); i < batch.count && !batch.failed.load(std::memory_order_relaxed); i = batch.next.fetch_add(1)) {
+		try {
+			batch.invoke(batch.function, i);
+		}
+		catch (...) {
+			if (!batch.failed.exchange(true)) {
+				batch.exception = std::current_exception();
+			}
+		}
+	}
+
+	inside = false;
+}
+
+/*
+*/
+inline void ThreadPool::work() noexcept {
+
+	SizeType seen = 0;
+
+	std::unique_lock<std::mutex> lock{m_mutex};
+
+	for (;;) {
+		m_wake.wait(lock, [&] { return m_stopping || (m_batch != nullptr && m_generation != seen); });
+
+		if (m_stopping) {
+			return;
+		}
+
+		seen = m_generation;
+		Batch *batch = m_batch;
+		++m_busy;
+
+		lock.unlock();
+		execute(*batch);
+		lock.lock();
+
+		if (--m_busy == 0) {
+			m_idle.notify_all();
+		}
+	}
+}
+
+
+namespace detail {
+
+// Chunking Functions
+
+/*
+*/
+inline std::size_t grainSize(const ParallelOptions &options) noexcept {
+	return std::max<std::size_t>(options.grainSize, 1);
+}
+
+/*
+*/
+inline bool runsSerially(const ThreadPool &pool, std::size_t size, const ParallelOptions &options) noexcept {
+	return pool.size() == 1 || size < options.serialThreshold || size <= grainSize(options);
+}
+
+/*
+*/
+inline std::size_t chunkCount(std::size_t size, std::size_t grain) noexcept {
+	return size / grain + (size % grain != 0);
+}
+
+
+// Needle Chunk Functions
+//
+// A chunk [first, last) owns the matches that start inside it. Matches are taken left to right without
+// overlaps, so where the scan enters a chunk depends on where the previous chunk's last match ended.
+// Every chunk is first scanned as if it were entered at first; the speculation only fails when a match
+// crossing into the chunk overlaps the chunk's own first match, which needs a needle that overlaps
+// itself (such as "aa"), and only that chunk is then scanned again.
+
+/*
+	Where a chunk's scan was entered, how many matches it took, where its first one starts and where the
+	next chunk's scan is entered: its end, or the end of a match crossing it.
+*/
+struct ChunkMatches {
+	std::size_t entry;
+	std::size_t count;
+	std::size_t first;
+	std::size_t exit;
+};
+
+/*
+*/
+template <typename CharType>
+ChunkMatches scanChunk(const CharType *data, std::size_t size, const CharType *needle, std::size_t needleSize, std::size_t entry, std::size_t last) noexcept {
+
+	ChunkMatches matches{entry, 0, NOT_FOUND, std::max(entry, last)};
+
+	if (entry >= last) {
+		return matches;
+	}
+
+	std::size_t limit = std::min(size, last + needleSize - 1);
+
+	for (std::size_t position = entry; position < last;) {
+		std::size_t match = findSubstring(data + position, limit - position, needle, needleSize);
+
+		if (match == NOT_FOUND) {
+			break;
+		}
+
+		position += match;
+
+		if (matches.count++ == 0) {
+			matches.first = position;
+		}
+
+		position += needleSize;
+		matches.exit = std::max(position, last);
+	}
+
+	return matches;
+}
+
+/*
+	Scans every chunk on the pool, then walks them in order and rescans each one whose speculative entry was wrong.
+*/
+template <typename CharType>
+std::vector<ChunkMatches> matchChunks(ThreadPool &pool, const CharType *data, std::size_t size, const CharType *needle, std::size_t needleSize, std::size_t grain) {
+
+	std::size_t chunks = chunkCount(size, grain);
+	std::vector<ChunkMatches> matches(chunks);
+
+	pool.run(chunks, [&](std::size_t chunk) noexcept {
+		std::size_t first = chunk * grain;
+		matches[chunk] = scanChunk(data, size, needle, needleSize, first, std::min(size, first + grain));
+	});
+
+	for (std::size_t chunk = 1; chunk < chunks; ++chunk) {
+		std::size_t entry = matches[chunk - 1].exit;
+
+		if (entry > matches[chunk].entry && (matches[chunk].first < entry || matches[chunk].exit < entry)) {
+			std::size_t first = chunk * grain;
+			matches[chunk] = scanChunk(data, size, needle, needleSize, entry, std::min(size, first + grain));
+		}
+		else {
+			matches[chunk].entry = entry;
+		}
+	}
+
+	return matches;
+}
+
+
+// Replacement Functions
+
+/*
+*/
+template <typename StorageType>
+struct ParallelReplacer {
+
+	using ValueType = typename StorageType::ValueType;
+	using AllocatorType = typename StorageType::AllocatorType;
+	using AllocatorTraits = std::allocator_traits<AllocatorType>;
+
+	/*
+		Results this short belong in the inline buffer, so they are not built here.
+	*/
+	static bool fitsInline(std::size_t size) noexcept {
+		return size < StorageType::LOCAL_CAPACITY;
+	}
+
+	/*
+		Each chunk copies the text from its entry to its exit with its matches replaced, at an offset that
+		only depends on how many matches the chunks before it took.
+	*/
+	static StorageType replace(ThreadPool &pool, const StorageType &string, const std::vector<ChunkMatches> &matches, std::size_t size, StringViewType<ValueType> needle, StringViewType<ValueType> replacement) {
+
+		std::vector<std::size_t> offsets(matches.size());
+		std::size_t offset = 0;
+
+		for (std::size_t chunk = 0; chunk < matches.size(); ++chunk) {
+			offsets[chunk] = offset;
+			offset += matches[chunk].exit - matches[chunk].entry + matches[chunk].count * replacement.size() - matches[chunk].count * needle.size();
+		}
+
+		assert(offset == size);
+
+		AllocatorType allocator = string.allocator();
+		ValueType *data = AllocatorTraits::allocate(allocator, size + 1);
+
+		detail::recordAllocation(AllocationCause::REPLACE, (size + 1) * sizeof(ValueType), 0);
+
+		pool.run(matches.size(), [&](std::size_t chunk) noexcept {
+			const ChunkMatches &chunkMatches = matches[chunk];
+
+			std::size_t count = 0;
+			StorageType::replaceMatches(data + offsets[chunk], string.data() + chunkMatches.entry, chunkMatches.exit - chunkMatches.entry, needle, replacement, count);
+
+			assert(count == chunkMatches.count);
+		});
+
+		data[size] = ValueType{};
+
+		return StorageType{data, size, size + 1, allocator};
+	}
+};
+
+
+// Hashing Functions
+
+// Bytes hashed as one piece by parallelHash(); inputs up to this size hash to the same value as hash().
+constexpr std::size_t PARALLEL_HASH_CHUNK = std::size_t{1} << 20;
+
+/*
+*/
+inline std::uint64_t hashChunk(const unsigned char *bytes, std::size_t size, std::size_t chunk) noexcept {
+
+	std::size_t first = chunk * PARALLEL_HASH_CHUNK;
+	return hashBytes(bytes + first, std::min(size - first, PARALLEL_HASH_CHUNK));
+}
+
+}
+
+
+// Counting Functions
+
+/*
+	Number of times character occurs in text, which is any string or view (anything with ValueType, data() and size()).
+*/
+template <typename TextType>
+std::size_t parallelCount(ThreadPool &pool, const TextType &text, typename TextType::ValueType character, const ParallelOptions &options = ParallelOptions{}) {
+
+	const auto *data = text.data();
+	std::size_t size = text.size();
+
+	if (detail::runsSerially(pool, size, options)) {
+		return detail::countCharacter(data, size, character);
+	}
+
+	std::size_t grain = detail::grainSize(options);
+	std::atomic<std::size_t> count{0};
+
+	pool.run(detail::chunkCount(size, grain), [&](std::size_t chunk) noexcept {
+		std::size_t first = chunk * grain;
+		count.fetch_add(detail::countCharacter(data + first, std::min(grain, size - first), character), std::memory_order_relaxed);
+	});
+
+	return count.load(std::memory_order_relaxed);
+}
+
+/*
+	Number of occurrences of needle in text, taken left to right without overlaps, as replaceAll() counts them.
+	needle must not be empty.
+*/
+template <typename TextType>
+std::size_t parallelCount(ThreadPool &pool, const TextType &text, StringViewType<typename TextType::ValueType> needle, const ParallelOptions &options = ParallelOptions{}) {
+
+	assert(!needle.empty());
+
+	const auto *data = text.data();
+	std::size_t size = text.size();
+
+	if (detail::runsSerially(pool, size, options)) {
+		return detail::scanChunk(data, size, needle.data(), needle.size(), 0, size).count;
+	}
+
+	std::vector<detail::ChunkMatches> matches = detail::matchChunks(pool, data, size, needle.data(), needle.size(), detail::grainSize(options));
+
+	std::size_t count = 0;
+	for (const detail::ChunkMatches &chunkMatches : matches) {
+		count += chunkMatches.count;
+	}
+
+	return count;
+}
+
+
+// Search Functions
+
+/*
+	Position of the first occurrence of character in text, or NOT_FOUND. Chunks are taken in order, and those
+	after a chunk that already holds a match are skipped, so an early match ends the search early.
+*/
+template <typename TextType>
+std::size_t parallelFind(ThreadPool &pool, const TextType &text, typename TextType::ValueType character, const ParallelOptions &options = ParallelOptions{}) {
+
+	const auto *data = text.data();
+	std::size_t size = text.size();
+
+	if (detail::runsSerially(pool, size, options)) {
+		return detail::findCharacter(data, size, character);
+	}
+
+	std::size_t grain = detail::grainSize(options);
+	std::atomic<std::size_t> found{detail::NOT_FOUND};
+
+	pool.run(detail::chunkCount(size, grain), [&](std::size_t chunk) noexcept {
+		std::size_t first = chunk * grain;
+
+		if (first > found.load(std::memory_order_relaxed)) {
+			return;
+		}
+
+		std::size_t match = detail::findCharacter(data + first, std::min(grain, size - first), character);
+
+		for (std::size_t best = found.load(std::memory_order_relaxed); match != detail::NOT_FOUND && first + match < best;) {
+			if (found.compare_exchange_weak(best, first + match, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+	});
+
+	return found.load(std::memory_order_relaxed);
+}
+
+/*
+	Position of the first occurrence of needle in text, or NOT_FOUND. An empty needle matches at 0.
+*/
+template <typename TextType>
+std::size_t parallelFind(ThreadPool &pool, const TextType &text, StringViewType<typename TextType::ValueType> needle, const ParallelOptions &options = ParallelOptions{}) {
+
+	const auto *data = text.data();
+	std::size_t size = text.size();
+
+	if (needle.empty() || detail::runsSerially(pool, size, options)) {
+		return detail::findSubstring(data, size, needle.data(), needle.size());
+	}
+
+	std::size_t grain = detail::grainSize(options);
+	std::atomic<std::size_t> found{detail::NOT_FOUND};
+
+	pool.run(detail::chunkCount(size, grain), [&](std::size_t chunk) noexcept {
+		std::size_t first = chunk * grain;
+
+		if (first > found.load(std::memory_order_relaxed) || first + needle.size() > size) {
+			return;
+		}
+
+		std::size_t limit = std::min(size, first + grain + needle.size() - 1);
+		std::size_t match = detail::findSubstring(data + first, limit - first, needle.data(), needle.size());
+
+		for (std::size_t best = found.load(std::memory_order_relaxed); match != detail::NOT_FOUND && first + match < best;) {
+			if (found.compare_exchange_weak(best, first + match, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+	});
+
+	return found.load(std::memory_order_relaxed);
+}
+
+
+// Transformation Functions
+
+/*
+	Replaces every character c of string with function(c). function is called from several threads at once,
+	on each character exactly once.
+*/
+template <typename CharType, typename Allocator, typename GrowthPolicy, typename Function>
+void parallelTransform(ThreadPool &pool, StringType<CharType, Allocator, GrowthPolicy> &string, Function function, const ParallelOptions &options = ParallelOptions{}) {
+
+	CharType *data = string.begin();
+	std::size_t size = string.size();
+
+	if (detail::runsSerially(pool, size, options)) {
+		std::transform(data, data + size, data, function);
+		return;
+	}
+
+	std::size_t grain = detail::grainSize(options);
+
+	pool.run(detail::chunkCount(size, grain), [&](std::size_t chunk) {
+		std::size_t first = chunk * grain;
+		std::transform(data + first, data + std::min(size, first + grain), data + first, function);
+	});
+}
+
+/*
+	Converts string to lower case in place, as toLower() would.
+*/
+template <typename CharType, typename Allocator, typename GrowthPolicy>
+void parallelToLower(ThreadPool &pool, StringType<CharType, Allocator, GrowthPolicy> &string, const ParallelOptions &options = ParallelOptions{}) {
+
+	CharType *data = string.begin();
+	std::size_t size = string.size();
+
+	if (detail::runsSerially(pool, size, options)) {
+		detail::convertCase(data, data, size, detail::UPPER_CASE_LETTERS);
+		return;
+	}
+
+	std::size_t grain = detail::grainSize(options);
+
+	pool.run(detail::chunkCount(size, grain), [&](std::size_t chunk) noexcept {
+		std::size_t first = chunk * grain;
+		detail::convertCase(data + first, data + first, std::min(grain, size - first), detail::UPPER_CASE_LETTERS);
+	});
+}
+
+/*
+	Converts string to upper case in place, as toUpper() would.
+*/
+template <typename CharType, typename Allocator, typename GrowthPolicy>
+void parallelToUpper(ThreadPool &pool, StringType<CharType, Allocator, GrowthPolicy> &string, const ParallelOptions &options = ParallelOptions{}) {
+
+	CharType *data = string.begin();
+	std::size_t size = string.size();
+
+	if (detail::runsSerially(pool, size, options)) {
+		detail::convertCase(data, data, size, detail::LOWER_CASE_LETTERS);
+		return;
+	}
+
+	std::size_t grain = detail::grainSize(options);
+
+	pool.run(detail::chunkCount(size, grain), [&](std::size_t chunk) noexcept {
+		std::size_t first = chunk * grain;
+		detail::convertCase(data + first, data + first, std::min(grain, size - first), detail::LOWER_CASE_LETTERS);
+	});
+}
+
+
+// Replacement Functions
+
+/*
+	Replaces every occurrence of needle in string, left to right and without overlaps, and returns how many
+	there were, as replaceAll() does. The matches are counted in parallel first, then every chunk writes its
+	part of a new buffer of the final size. needle must not be empty; needle and replacement may come from string.
+*/
+template <typename CharType, typename Allocator, typename GrowthPolicy>
+std::size_t parallelReplaceAll(ThreadPool &pool, StringType<CharType, Allocator, GrowthPolicy> &string, typename StringType<CharType, Allocator, GrowthPolicy>::ViewType needle, typename StringType<CharType, Allocator, GrowthPolicy>::ViewType replacement, const ParallelOptions &options = ParallelOptions{}) {
+
+	using StorageType = StringType<CharType, Allocator, GrowthPolicy>;
+
+	assert(!needle.empty());
+
+	std::size_t size = string.size();
+
+	if (detail::runsSerially(pool, size, options)) {
+		return string.replaceAll(needle, replacement);
+	}
+
+	std::vector<detail::ChunkMatches> matches = detail::matchChunks(pool, string.data(), size, needle.data(), needle.size(), detail::grainSize(options));
+
+	std::size_t count = 0;
+	for (const detail::ChunkMatches &chunkMatches : matches) {
+		count += chunkMatches.count;
+	}
+
+	if (count == 0) {
+		return 0;
+	}
+
+	std::size_t resultSize = size + count * replacement.size() - count * needle.size();
+
+	// Results that short are rare enough here to be left to the serial path.
+	if (detail::ParallelReplacer<StorageType>::fitsInline(resultSize)) {
+		return string.replaceAll(needle, replacement);
+	}
+
+	string = detail::ParallelReplacer<StorageType>::replace(pool, string, matches, resultSize, needle, replacement);
+
+	return count;
+}
+
+
+// Hashing Functions
+
+/*
+	Hash of text that splits inputs longer than PARALLEL_HASH_CHUNK bytes into pieces of that size, hashes
+	the pieces in parallel and then hashes the list of their hashes. Shorter inputs hash as hash() does;
+	longer ones get a different value, but the same one whatever the pool size and options, as the pieces
+	do not depend on them. A task hashes as many whole pieces as fit in grainSize characters.
+*/
+template <typename TextType>
+std::size_t parallelHash(ThreadPool &pool, const TextType &text, const ParallelOptions &options = ParallelOptions{}) {
+
+	using CharType = typename TextType::ValueType;
+
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(text.data());
+	std::size_t size = text.size() * sizeof(CharType);
+
+	if (size <= detail::PARALLEL_HASH_CHUNK) {
+		return static_cast<std::size_t>(detail::hashBytes(bytes, size));
+	}
+
+	std::size_t pieces = detail::chunkCount(size, detail::PARALLEL_HASH_CHUNK);
+	std::vector<std::uint64_t> hashes(pieces);
+
+	if (detail::runsSerially(pool, text.size(), options)) {
+		for (std::size_t piece = 0; piece < pieces; ++piece) {
+			hashes[piece] = detail::hashChunk(bytes, size, piece);
+		}
+	}
+	else {
+		std::size_t piecesPerTask = std::max<std::size_t>(detail::grainSize(options) * sizeof(CharType) / detail::PARALLEL_HASH_CHUNK, 1);
+
+		pool.run(detail::chunkCount(pieces, piecesPerTask), [&](std::size_t task) noexcept {
+			std::size_t first = task * piecesPerTask;
+
+			for (std::size_t piece = first; piece < std::min(pieces, first + piecesPerTask); ++piece) {
+				hashes[piece] = detail::hashChunk(bytes, size, piece);
+			}
+		});
+	}
+
+	return static_cast<std::size_t>(detail::hashBytes(hashes.data(), pieces * sizeof(std::uint64_t), size));
+}
+
+}
+
+
+#endif // SIMPLE_STRING_PARALLEL_HPP
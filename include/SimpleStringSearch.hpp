@@ -0,0 +1,1203 @@
+
+#pragma once
+#ifndef SIMPLE_STRING_SEARCH_HPP
+#define SIMPLE_STRING_SEARCH_HPP
+
+
+#include "SimpleStringKernels.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+
+namespace simple {
+namespace detail {
+
+
+// Constants
+
+// Returned by every search function when there is no match.
+constexpr std::size_t NOT_FOUND = static_cast<std::size_t>(-1);
+
+// Longest needle (in characters) searched with the candidate filter; longer needles use Two-Way.
+// Verifying a candidate costs at most this many comparisons, so the filter stays linear as well.
+constexpr std::size_t SHORT_NEEDLE_LIMIT = 32;
+
+// Largest character set matched with one vector compare per member; bigger sets use a lookup table.
+constexpr std::size_t VECTOR_SET_LIMIT = 4;
+
+
+// Character Search Kernels
+//
+// Return the index of the first (or last) occurrence of a character, or NOT_FOUND.
+
+/*
+*/
+template <typename CharType>
+std::size_t findCharacterScalar(const CharType *data, std::size_t size, CharType character) noexcept {
+
+	for (std::size_t i = 0; i < size; ++i) {
+		if (data[i] == character) {
+			return i;
+		}
+	}
+
+	return NOT_FOUND;
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t findLastCharacterScalar(const CharType *data, std::size_t size, CharType character) noexcept {
+
+	while (size != 0) {
+		if (data[--size] == character) {
+			return size;
+		}
+	}
+
+	return NOT_FOUND;
+}
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+*/
+template <typename CharType>
+std::size_t findCharacterSse2(const CharType *data, std::size_t size, CharType character) noexcept {
+
+	constexpr std::size_t WIDTH = 16;
+	constexpr std::size_t STEP = WIDTH / sizeof(CharType);
+
+	if (size < STEP) {
+		return findCharacterScalar(data, size, character);
+	}
+
+	const __m128i needle = broadcastSse2(character);
+
+	std::size_t i = 0;
+
+	for (; i + STEP <= size; i += STEP) {
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+
+		std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(compareEqualSse2(block, needle, ElementSize<CharType>{})));
+		if (mask != 0) {
+			return i + countTrailingZeros(mask) / sizeof(CharType);
+		}
+	}
+
+	if (i == size) {
+		return NOT_FOUND;
+	}
+
+	// The final block overlaps characters already known not to match.
+	i = size - STEP;
+
+	__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+
+	std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(compareEqualSse2(block, needle, ElementSize<CharType>{})));
+	return mask != 0 ? i + countTrailingZeros(mask) / sizeof(CharType) : NOT_FOUND;
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t findLastCharacterSse2(const CharType *data, std::size_t size, CharType character) noexcept {
+
+	constexpr std::size_t WIDTH = 16;
+	constexpr std::size_t STEP = WIDTH / sizeof(CharType);
+
+	if (size < STEP) {
+		return findLastCharacterScalar(data, size, character);
+	}
+
+	const __m128i needle = broadcastSse2(character);
+
+	std::size_t i = size;
+
+	while (i >= STEP) {
+		i -= STEP;
+
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+
+		std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(compareEqualSse2(block, needle, ElementSize<CharType>{})));
+		if (mask != 0) {
+			return i + highestSetBit(mask) / sizeof(CharType);
+		}
+	}
+
+	if (i == 0) {
+		return NOT_FOUND;
+	}
+
+	// The first block overlaps characters already known not to match.
+	__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+
+	std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(compareEqualSse2(block, needle, ElementSize<CharType>{})));
+	return mask != 0 ? highestSetBit(mask) / sizeof(CharType) : NOT_FOUND;
+}
+
+#endif
+
+#if defined(SIMPLE_STRING_AVX2)
+
+/*
+	Requires at least one full vector; findCharacter() only dispatches here for ranges well above that.
+*/
+template <typename CharType>
+SIMPLE_STRING_AVX2_TARGET
+std::size_t findCharacterAvx2(const CharType *data, std::size_t size, CharType character) noexcept {
+
+	constexpr std::size_t WIDTH = 32;
+	constexpr std::size_t STEP = WIDTH / sizeof(CharType);
+
+	const __m256i needle = broadcastAvx2(character);
+
+	std::size_t i = 0;
+
+	// Two vectors per iteration with a single combined branch.
+	for (; i + 2 * STEP <= size; i += 2 * STEP) {
+		__m256i first = compareEqualAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)), needle, ElementSize<CharType>{});
+		__m256i second = compareEqualAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + STEP)), needle, ElementSize<CharType>{});
+
+		if (_mm256_movemask_epi8(_mm256_or_si256(first, second)) != 0) {
+			std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(first));
+			if (mask != 0) {
+				return i + countTrailingZeros(mask) / sizeof(CharType);
+			}
+
+			mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(second));
+			return i + STEP + countTrailingZeros(mask) / sizeof(CharType);
+		}
+	}
+
+	for (; i + STEP <= size; i += STEP) {
+		std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(compareEqualAvx2(
+			_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)), needle, ElementSize<CharType>{})));
+
+		if (mask != 0) {
+			return i + countTrailingZeros(mask) / sizeof(CharType);
+		}
+	}
+
+	if (i == size) {
+		return NOT_FOUND;
+	}
+
+	i = size - STEP;
+
+	std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(compareEqualAvx2(
+		_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)), needle, ElementSize<CharType>{})));
+
+	return mask != 0 ? i + countTrailingZeros(mask) / sizeof(CharType) : NOT_FOUND;
+}
+
+/*
+	Mirror image of findCharacterAvx2(), with the same size requirement.
+*/
+template <typename CharType>
+SIMPLE_STRING_AVX2_TARGET
+std::size_t findLastCharacterAvx2(const CharType *data, std::size_t size, CharType character) noexcept {
+
+	constexpr std::size_t WIDTH = 32;
+	constexpr std::size_t STEP = WIDTH / sizeof(CharType);
+
+	const __m256i needle = broadcastAvx2(character);
+
+	std::size_t i = size;
+
+	for (; i >= 2 * STEP; i -= 2 * STEP) {
+		__m256i first = compareEqualAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i - 2 * STEP)), needle, ElementSize<CharType>{});
+		__m256i second = compareEqualAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i - STEP)), needle, ElementSize<CharType>{});
+
+		if (_mm256_movemask_epi8(_mm256_or_si256(first, second)) != 0) {
+			std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(second));
+			if (mask != 0) {
+				return i - STEP + highestSetBit(mask) / sizeof(CharType);
+			}
+
+			mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(first));
+			return i - 2 * STEP + highestSetBit(mask) / sizeof(CharType);
+		}
+	}
+
+	for (; i >= STEP; i -= STEP) {
+		std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(compareEqualAvx2(
+			_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i - STEP)), needle, ElementSize<CharType>{})));
+
+		if (mask != 0) {
+			return i - STEP + highestSetBit(mask) / sizeof(CharType);
+		}
+	}
+
+	if (i == 0) {
+		return NOT_FOUND;
+	}
+
+	std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(compareEqualAvx2(
+		_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data)), needle, ElementSize<CharType>{})));
+
+	return mask != 0 ? highestSetBit(mask) / sizeof(CharType) : NOT_FOUND;
+}
+
+#endif
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+	Byte strings go to std::memchr, which the C library already vectorizes at least as well.
+*/
+template <typename CharType>
+std::size_t findCharacter(const CharType *data, std::size_t size, CharType character, std::true_type) noexcept {
+
+	if (sizeof(CharType) == 1) {
+		const void *found = size != 0 ? std::memchr(data, static_cast<unsigned char>(character), size) : nullptr;
+		return found != nullptr ? static_cast<std::size_t>(static_cast<const CharType *>(found) - data) : NOT_FOUND;
+	}
+
+#if defined(SIMPLE_STRING_AVX2)
+	constexpr std::size_t AVX2_THRESHOLD = 64;
+
+	if (size * sizeof(CharType) >= AVX2_THRESHOLD && hasAvx2()) {
+		return findCharacterAvx2(data, size, character);
+	}
+#endif
+
+	return findCharacterSse2(data, size, character);
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t findCharacter(const CharType *data, std::size_t size, CharType character, std::false_type) noexcept {
+	return findCharacterScalar(data, size, character);
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t findLastCharacter(const CharType *data, std::size_t size, CharType character, std::true_type) noexcept {
+
+#if defined(SIMPLE_STRING_AVX2)
+	constexpr std::size_t AVX2_THRESHOLD = 64;
+
+	if (size * sizeof(CharType) >= AVX2_THRESHOLD && hasAvx2()) {
+		return findLastCharacterAvx2(data, size, character);
+	}
+#endif
+
+	return findLastCharacterSse2(data, size, character);
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t findLastCharacter(const CharType *data, std::size_t size, CharType character, std::false_type) noexcept {
+	return findLastCharacterScalar(data, size, character);
+}
+
+#endif
+
+/*
+*/
+template <typename CharType>
+std::size_t findCharacter(const CharType *data, std::size_t size, CharType character) noexcept {
+
+#if defined(SIMPLE_STRING_SSE2)
+	return findCharacter(data, size, character, IsVectorizable<CharType>{});
+#else
+	return findCharacterScalar(data, size, character);
+#endif
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t findLastCharacter(const CharType *data, std::size_t size, CharType character) noexcept {
+
+#if defined(SIMPLE_STRING_SSE2)
+	return findLastCharacter(data, size, character, IsVectorizable<CharType>{});
+#else
+	return findLastCharacterScalar(data, size, character);
+#endif
+}
+
+// Character Count Kernels
+//
+// Return the number of occurrences of a character. The vector kernels subtract each comparison mask from
+// a vector of byte counters, so a matching character adds one to each of its sizeof(CharType) bytes,
+// and fold the counters into a total before any of them can wrap.
+
+/*
+*/
+template <typename CharType>
+std::size_t countCharacterScalar(const CharType *data, std::size_t size, CharType character) noexcept {
+
+	std::size_t count = 0;
+
+	for (std::size_t i = 0; i < size; ++i) {
+		count += data[i] == character;
+	}
+
+	return count;
+}
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+*/
+template <typename CharType>
+std::size_t countCharacterSse2(const CharType *data, std::size_t size, CharType character) noexcept {
+
+	constexpr std::size_t WIDTH = 16;
+	constexpr std::size_t STEP = WIDTH / sizeof(CharType);
+	constexpr std::size_t BLOCK = 255 * STEP;
+
+	const __m128i needle = broadcastSse2(character);
+
+	std::size_t bytes = 0;
+	std::size_t i = 0;
+
+	while (i + STEP <= size) {
+		std::size_t end = i + std::min(BLOCK, (size - i) / STEP * STEP);
+		__m128i counters = _mm_setzero_si128();
+
+		for (; i < end; i += STEP) {
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+			counters = _mm_sub_epi8(counters, compareEqualSse2(block, needle, ElementSize<CharType>{}));
+		}
+
+		__m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+		bytes += static_cast<std::size_t>(_mm_cvtsi128_si32(sums)) + static_cast<std::size_t>(_mm_extract_epi16(sums, 4));
+	}
+
+	return bytes / sizeof(CharType) + countCharacterScalar(data + i, size - i, character);
+}
+
+#endif
+
+#if defined(SIMPLE_STRING_AVX2)
+
+/*
+*/
+template <typename CharType>
+SIMPLE_STRING_AVX2_TARGET
+std::size_t countCharacterAvx2(const CharType *data, std::size_t size, CharType character) noexcept {
+
+	constexpr std::size_t WIDTH = 32;
+	constexpr std::size_t STEP = WIDTH / sizeof(CharType);
+	constexpr std::size_t BLOCK = 255 * STEP;
+
+	const __m256i needle = broadcastAvx2(character);
+
+	std::size_t bytes = 0;
+	std::size_t i = 0;
+
+	while (i + STEP <= size) {
+		std::size_t end = i + std::min(BLOCK, (size - i) / STEP * STEP);
+		__m256i counters = _mm256_setzero_si256();
+
+		for (; i < end; i += STEP) {
+			__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+			counters = _mm256_sub_epi8(counters, compareEqualAvx2(block, needle, ElementSize<CharType>{}));
+		}
+
+		__m256i sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+		__m128i halves = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+		bytes += static_cast<std::size_t>(_mm_cvtsi128_si32(halves)) + static_cast<std::size_t>(_mm_extract_epi16(halves, 4));
+	}
+
+	return bytes / sizeof(CharType) + countCharacterScalar(data + i, size - i, character);
+}
+
+#endif
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+*/
+template <typename CharType>
+std::size_t countCharacter(const CharType *data, std::size_t size, CharType character, std::true_type) noexcept {
+
+#if defined(SIMPLE_STRING_AVX2)
+	constexpr std::size_t AVX2_THRESHOLD = 64;
+
+	if (size * sizeof(CharType) >= AVX2_THRESHOLD && hasAvx2()) {
+		return countCharacterAvx2(data, size, character);
+	}
+#endif
+
+	return countCharacterSse2(data, size, character);
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t countCharacter(const CharType *data, std::size_t size, CharType character, std::false_type) noexcept {
+	return countCharacterScalar(data, size, character);
+}
+
+#endif
+
+/*
+*/
+template <typename CharType>
+std::size_t countCharacter(const CharType *data, std::size_t size, CharType character) noexcept {
+
+#if defined(SIMPLE_STRING_SSE2)
+	return countCharacter(data, size, character, IsVectorizable<CharType>{});
+#else
+	return countCharacterScalar(data, size, character);
+#endif
+}
+
+
+// Pair Filter Kernels
+//
+// Visit, in order (or in reverse order for the Last variants), every position p below positions where
+// data[p] == first and data[p + distance] == second, until visit(p) returns true; that position is returned,
+// or NOT_FOUND once every candidate was rejected. data must hold positions + distance characters.
+// Requiring two characters to match makes false candidates rare on ordinary text.
+
+/*
+*/
+template <typename CharType, typename VisitorType>
+std::size_t scanPairsScalar(const CharType *data, std::size_t positions, CharType first, CharType second, std::size_t distance, VisitorType &&visit) {
+
+	for (std::size_t i = 0; i < positions; ++i) {
+		if (data[i] == first && data[i + distance] == second && visit(i)) {
+			return i;
+		}
+	}
+
+	return NOT_FOUND;
+}
+
+/*
+*/
+template <typename CharType, typename VisitorType>
+std::size_t scanLastPairsScalar(const CharType *data, std::size_t positions, CharType first, CharType second, std::size_t distance, VisitorType &&visit) {
+
+	for (std::size_t i = positions; i-- != 0;) {
+		if (data[i] == first && data[i + distance] == second && visit(i)) {
+			return i;
+		}
+	}
+
+	return NOT_FOUND;
+}
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+	Bitmask (two bits per char16_t, four per char32_t) of the candidates among the positions starting at data.
+*/
+template <typename CharType>
+std::uint32_t pairCandidatesSse2(const CharType *data, __m128i first, __m128i second, std::size_t distance) noexcept {
+
+	__m128i firstBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+	__m128i secondBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + distance));
+
+	return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+		compareEqualSse2(firstBlock, first, ElementSize<CharType>{}),
+		compareEqualSse2(secondBlock, second, ElementSize<CharType>{}))));
+}
+
+/*
+*/
+template <typename CharType, typename VisitorType>
+std::size_t scanPairsSse2(const CharType *data, std::size_t positions, CharType first, CharType second, std::size_t distance, VisitorType &&visit) {
+
+	constexpr std::size_t WIDTH = 16;
+	constexpr std::size_t STEP = WIDTH / sizeof(CharType);
+	constexpr std::uint32_t GROUP = (1u << sizeof(CharType)) - 1;
+
+	if (positions < STEP) {
+		return scanPairsScalar(data, positions, first, second, distance, visit);
+	}
+
+	const __m128i firstVector = broadcastSse2(first);
+	const __m128i secondVector = broadcastSse2(second);
+
+	auto visitMask = [&](std::size_t i, std::uint32_t mask) {
+		while (mask != 0) {
+			unsigned bit = countTrailingZeros(mask);
+			std::size_t index = i + bit / sizeof(CharType);
+
+			if (visit(index)) {
+				return index;
+			}
+
+			mask &= ~(GROUP << bit);
+		}
+
+		return NOT_FOUND;
+	};
+
+	std::size_t i = 0;
+
+	for (; i + STEP <= positions; i += STEP) {
+		std::uint32_t mask = pairCandidatesSse2(data + i, firstVector, secondVector, distance);
+		if (mask != 0) {
+			std::size_t index = visitMask(i, mask);
+			if (index != NOT_FOUND) {
+				return index;
+			}
+		}
+	}
+
+	if (i == positions) {
+		return NOT_FOUND;
+	}
+
+	// The final block overlaps positions already visited; mask them off rather than visit them twice.
+	std::size_t overlap = i - (positions - STEP);
+	i = positions - STEP;
+
+	return visitMask(i, pairCandidatesSse2(data + i, firstVector, secondVector, distance) & (~0u << (overlap * sizeof(CharType))));
+}
+
+/*
+*/
+template <typename CharType, typename VisitorType>
+std::size_t scanLastPairsSse2(const CharType *data, std::size_t positions, CharType first, CharType second, std::size_t distance, VisitorType &&visit) {
+
+	constexpr std::size_t WIDTH = 16;
+	constexpr std::size_t STEP = WIDTH / sizeof(CharType);
+	constexpr std::uint32_t GROUP = (1u << sizeof(CharType)) - 1;
+
+	if (positions < STEP) {
+		return scanLastPairsScalar(data, positions, first, second, distance, visit);
+	}
+
+	const __m128i firstVector = broadcastSse2(first);
+	const __m128i secondVector = broadcastSse2(second);
+
+	auto visitMask = [&](std::size_t i, std::uint32_t mask) {
+		while (mask != 0) {
+			unsigned bit = highestSetBit(mask) & ~static_cast<unsigned>(sizeof(CharType) - 1);
+			std::size_t index = i + bit / sizeof(CharType);
+
+			if (visit(index)) {
+				return index;
+			}
+
+			mask &= ~(GROUP << bit);
+		}
+
+		return NOT_FOUND;
+	};
+
+	std::size_t i = positions;
+
+	while (i >= STEP) {
+		i -= STEP;
+
+		std::uint32_t mask = pairCandidatesSse2(data + i, firstVector, secondVector, distance);
+		if (mask != 0) {
+			std::size_t index = visitMask(i, mask);
+			if (index != NOT_FOUND) {
+				return index;
+			}
+		}
+	}
+
+	if (i == 0) {
+		return NOT_FOUND;
+	}
+
+	// The first block overlaps positions already visited; only the ones below i are new.
+	return visitMask(0, pairCandidatesSse2(data, firstVector, secondVector, distance) & ((1u << (i * sizeof(CharType))) - 1));
+}
+
+/*
+*/
+template <typename CharType, typename VisitorType>
+std::size_t scanPairs(const CharType *data, std::size_t positions, CharType first, CharType second, std::size_t distance, VisitorType &&visit, std::true_type) {
+	return scanPairsSse2(data, positions, first, second, distance, visit);
+}
+
+/*
+*/
+template <typename CharType, typename VisitorType>
+std::size_t scanPairs(const CharType *data, std::size_t positions, CharType first, CharType second, std::size_t distance, VisitorType &&visit, std::false_type) {
+	return scanPairsScalar(data, positions, first, second, distance, visit);
+}
+
+/*
+*/
+template <typename CharType, typename VisitorType>
+std::size_t scanLastPairs(const CharType *data, std::size_t positions, CharType first, CharType second, std::size_t distance, VisitorType &&visit, std::true_type) {
+	return scanLastPairsSse2(data, positions, first, second, distance, visit);
+}
+
+/*
+*/
+template <typename CharType, typename VisitorType>
+std::size_t scanLastPairs(const CharType *data, std::size_t positions, CharType first, CharType second, std::size_t distance, VisitorType &&visit, std::false_type) {
+	return scanLastPairsScalar(data, positions, first, second, distance, visit);
+}
+
+#endif
+
+/*
+*/
+template <typename CharType, typename VisitorType>
+std::size_t scanPairs(const CharType *data, std::size_t positions, CharType first, CharType second, std::size_t distance, VisitorType &&visit) {
+
+#if defined(SIMPLE_STRING_SSE2)
+	return scanPairs(data, positions, first, second, distance, visit, IsVectorizable<CharType>{});
+#else
+	return scanPairsScalar(data, positions, first, second, distance, visit);
+#endif
+}
+
+/*
+*/
+template <typename CharType, typename VisitorType>
+std::size_t scanLastPairs(const CharType *data, std::size_t positions, CharType first, CharType second, std::size_t distance, VisitorType &&visit) {
+
+#if defined(SIMPLE_STRING_SSE2)
+	return scanLastPairs(data, positions, first, second, distance, visit, IsVectorizable<CharType>{});
+#else
+	return scanLastPairsScalar(data, positions, first, second, distance, visit);
+#endif
+}
+
+
+// Short Needle Search
+//
+// Candidates are positions where the first and last characters of the needle match;
+// only those have the characters in between compared. Needles have at least two characters
+// and are no longer than the haystack.
+
+/*
+*/
+template <typename CharType>
+std::size_t findShortNeedle(const CharType *data, std::size_t size, const CharType *needle, std::size_t needleSize) noexcept {
+
+	return scanPairs(data, size - needleSize + 1, needle[0], needle[needleSize - 1], needleSize - 1, [&](std::size_t i) {
+		return mismatch(data + i + 1, needle + 1, needleSize - 2) == needleSize - 2;
+	});
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t findLastShortNeedle(const CharType *data, std::size_t size, const CharType *needle, std::size_t needleSize) noexcept {
+
+	return scanLastPairs(data, size - needleSize + 1, needle[0], needle[needleSize - 1], needleSize - 1, [&](std::size_t i) {
+		return mismatch(data + i + 1, needle + 1, needleSize - 2) == needleSize - 2;
+	});
+}
+
+
+// Two-Way Search
+//
+// Crochemore and Perrin's algorithm: linear time and constant space for any needle and haystack.
+// It is written against a sequence adapter so the same code searches backwards for rfind().
+
+// Forward view of a character range.
+template <typename CharType>
+struct ForwardSequence {
+
+	const CharType *data;
+	std::size_t size;
+
+	CharType operator[](std::size_t index) const noexcept {
+		return data[index];
+	}
+
+	// First position p in [from, to) with first at p and second at p + distance, or NOT_FOUND.
+	std::size_t findPair(CharType first, CharType second, std::size_t distance, std::size_t from, std::size_t to) const noexcept {
+
+		std::size_t index = scanPairs(data + from, to - from, first, second, distance, [](std::size_t) { return true; });
+		return index != NOT_FOUND ? from + index : NOT_FOUND;
+	}
+};
+
+// Reversed view of a character range; index 0 is the last character.
+template <typename CharType>
+struct ReverseSequence {
+
+	const CharType *data;
+	std::size_t size;
+
+	CharType operator[](std::size_t index) const noexcept {
+		return data[size - 1 - index];
+	}
+
+	// Reversed positions [from, to) map to the forward pairs starting at size - to - distance onwards,
+	// with the two characters swapped; the last such forward pair is the first reversed one.
+	std::size_t findPair(CharType first, CharType second, std::size_t distance, std::size_t from, std::size_t to) const noexcept {
+
+		std::size_t index = scanLastPairs(data + (size - to - distance), to - from, second, first, distance, [](std::size_t) { return true; });
+		return index != NOT_FOUND ? to - 1 - index : NOT_FOUND;
+	}
+};
+
+/*
+	Start of the maximal suffix of needle under the given order, and that suffix's period.
+*/
+template <typename SequenceType, typename CompareType>
+std::size_t maximalSuffix(const SequenceType &needle, std::size_t size, std::size_t &period, CompareType less) noexcept {
+
+	std::size_t suffix = NOT_FOUND;
+	std::size_t j = 0;
+	std::size_t k = 1;
+	std::size_t p = 1;
+
+	// suffix starts one before the range, so suffix + k wraps around to a valid index.
+	while (j + k < size) {
+		auto a = needle[j + k];
+		auto b = needle[suffix + k];
+
+		if (less(a, b)) {
+			j += k;
+			k = 1;
+			p = j - suffix;
+		}
+		else if (a == b) {
+			if (k != p) {
+				++k;
+			}
+			else {
+				j += p;
+				k = 1;
+			}
+		}
+		else {
+			suffix = j++;
+			k = p = 1;
+		}
+	}
+
+	period = p;
+	return suffix + 1;
+}
+
+/*
+	Splits needle at a critical position, where the local period equals the global one.
+	The later of the two maximal suffixes (under opposite orders) is always critical.
+*/
+template <typename SequenceType>
+std::size_t criticalFactorization(const SequenceType &needle, std::size_t size, std::size_t &period) noexcept {
+
+	using ValueType = decltype(needle[0]);
+
+	std::size_t forwardPeriod;
+	std::size_t reversePeriod;
+
+	std::size_t forward = maximalSuffix(needle, size, forwardPeriod, [](ValueType a, ValueType b) { return a < b; });
+	std::size_t reverse = maximalSuffix(needle, size, reversePeriod, [](ValueType a, ValueType b) { return b < a; });
+
+	if (reverse < forward) {
+		period = forwardPeriod;
+		return forward;
+	}
+
+	period = reversePeriod;
+	return reverse;
+}
+
+/*
+	First position of needle in haystack, or NOT_FOUND. Requires 0 < needleSize <= size.
+	A mismatch on the very first comparison jumps straight to the next alignment where both that character
+	and the last one of the needle match, which is where the vector kernels make the common case fast.
+	Every skipped alignment is one the plain algorithm would also have stepped over, so it stays linear.
+*/
+template <typename SequenceType>
+std::size_t twoWaySearch(const SequenceType &haystack, std::size_t size, const SequenceType &needle, std::size_t needleSize) noexcept {
+
+	std::size_t period;
+	std::size_t suffix = criticalFactorization(needle, needleSize, period);
+
+	const std::size_t last = size - needleSize;
+
+	const auto anchor = needle[suffix];
+	const auto closing = needle[needleSize - 1];
+	const std::size_t distance = needleSize - 1 - suffix;
+
+	// Next alignment after j at which both the anchor and the final character line up, or NOT_FOUND.
+	auto skip = [&](std::size_t j) {
+		if (j == last) {
+			return NOT_FOUND;
+		}
+
+		std::size_t position = haystack.findPair(anchor, closing, distance, j + 1 + suffix, last + 1 + suffix);
+		return position != NOT_FOUND ? position - suffix : NOT_FOUND;
+	};
+
+	bool periodic = suffix + period <= needleSize;
+	for (std::size_t i = 0; periodic && i < suffix; ++i) {
+		periodic = needle[i] == needle[i + period];
+	}
+
+	std::size_t j = 0;
+
+	if (periodic) {
+		// The prefix before the critical position repeats with the period, so after a full match
+		// shift the characters known to line up again are remembered and not compared twice.
+		std::size_t memory = 0;
+
+		while (j <= last) {
+			std::size_t i = std::max(suffix, memory);
+
+			while (i < needleSize && needle[i] == haystack[i + j]) {
+				++i;
+			}
+
+			if (i < needleSize) {
+				if (i == suffix && memory == 0) {
+					j = skip(j);
+				}
+				else {
+					j += i - suffix + 1;
+					memory = 0;
+				}
+
+				continue;
+			}
+
+			i = suffix;
+			while (i > memory && needle[i - 1] == haystack[i - 1 + j]) {
+				--i;
+			}
+
+			if (i <= memory) {
+				return j;
+			}
+
+			j += period;
+			memory = needleSize - period;
+		}
+	}
+	else {
+		// Without a repeating prefix any shift up to the longer half of the factorization is safe.
+		period = std::max(suffix, needleSize - suffix) + 1;
+
+		while (j <= last) {
+			std::size_t i = suffix;
+
+			while (i < needleSize && needle[i] == haystack[i + j]) {
+				++i;
+			}
+
+			if (i < needleSize) {
+				j = i == suffix ? skip(j) : j + (i - suffix + 1);
+				continue;
+			}
+
+			i = suffix;
+			while (i > 0 && needle[i - 1] == haystack[i - 1 + j]) {
+				--i;
+			}
+
+			if (i == 0) {
+				return j;
+			}
+
+			j += period;
+		}
+	}
+
+	return NOT_FOUND;
+}
+
+
+// Substring Search
+
+/*
+	First position of needle in data, or NOT_FOUND. An empty needle matches at 0.
+*/
+template <typename CharType>
+std::size_t findSubstring(const CharType *data, std::size_t size, const CharType *needle, std::size_t needleSize) noexcept {
+
+	if (needleSize == 0) {
+		return 0;
+	}
+
+	if (needleSize > size) {
+		return NOT_FOUND;
+	}
+
+	if (needleSize == 1) {
+		return findCharacter(data, size, needle[0]);
+	}
+
+	if (needleSize <= SHORT_NEEDLE_LIMIT) {
+		return findShortNeedle(data, size, needle, needleSize);
+	}
+
+	return twoWaySearch(ForwardSequence<CharType>{data, size}, size, ForwardSequence<CharType>{needle, needleSize}, needleSize);
+}
+
+/*
+	Last position of needle in data, or NOT_FOUND. An empty needle matches at size.
+*/
+template <typename CharType>
+std::size_t findLastSubstring(const CharType *data, std::size_t size, const CharType *needle, std::size_t needleSize) noexcept {
+
+	if (needleSize == 0) {
+		return size;
+	}
+
+	if (needleSize > size) {
+		return NOT_FOUND;
+	}
+
+	if (needleSize == 1) {
+		return findLastCharacter(data, size, needle[0]);
+	}
+
+	if (needleSize <= SHORT_NEEDLE_LIMIT) {
+		return findLastShortNeedle(data, size, needle, needleSize);
+	}
+
+	std::size_t index = twoWaySearch(ReverseSequence<CharType>{data, size}, size, ReverseSequence<CharType>{needle, needleSize}, needleSize);
+	return index != NOT_FOUND ? size - needleSize - index : NOT_FOUND;
+}
+
+
+// Character Set Search Kernels
+//
+// Return the index of the first character whose membership in set equals member, or NOT_FOUND.
+
+/*
+*/
+template <typename CharType>
+bool containsCharacter(const CharType *set, std::size_t setSize, CharType character) noexcept {
+	return std::find(set, set + setSize, character) != set + setSize;
+}
+
+/*
+	Characters below 256 are looked up in a table; only wider ones fall back to scanning the set.
+*/
+template <typename CharType>
+std::size_t findSetMemberScalar(const CharType *data, std::size_t size, const CharType *set, std::size_t setSize, bool member, std::true_type) noexcept {
+
+	using UnsignedType = typename std::make_unsigned<CharType>::type;
+
+	constexpr std::size_t TABLE_SIZE = 256;
+
+	bool table[TABLE_SIZE]{};
+	bool wide = false;
+
+	for (std::size_t i = 0; i < setSize; ++i) {
+		UnsignedType code = static_cast<UnsignedType>(set[i]);
+
+		if (code < TABLE_SIZE) {
+			table[code] = true;
+		}
+		else {
+			wide = true;
+		}
+	}
+
+	for (std::size_t i = 0; i < size; ++i) {
+		UnsignedType code = static_cast<UnsignedType>(data[i]);
+
+		bool found = code < TABLE_SIZE ? table[code] : wide && containsCharacter(set, setSize, data[i]);
+		if (found == member) {
+			return i;
+		}
+	}
+
+	return NOT_FOUND;
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t findSetMemberScalar(const CharType *data, std::size_t size, const CharType *set, std::size_t setSize, bool member, std::false_type) noexcept {
+
+	for (std::size_t i = 0; i < size; ++i) {
+		if (containsCharacter(set, setSize, data[i]) == member) {
+			return i;
+		}
+	}
+
+	return NOT_FOUND;
+}
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+	Small sets are matched with one broadcast compare per member, ORed together.
+*/
+template <typename CharType>
+std::size_t findSetMemberSse2(const CharType *data, std::size_t size, const CharType *set, std::size_t setSize, bool member) noexcept {
+
+	constexpr std::size_t WIDTH = 16;
+	constexpr std::size_t STEP = WIDTH / sizeof(CharType);
+
+	assert(setSize != 0 && setSize <= VECTOR_SET_LIMIT && size >= STEP);
+
+	__m128i members[VECTOR_SET_LIMIT];
+	for (std::size_t k = 0; k < setSize; ++k) {
+		members[k] = broadcastSse2(set[k]);
+	}
+
+	const std::uint32_t invert = member ? 0u : 0xFFFFu;
+
+	auto matches = [&](std::size_t i) {
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+
+		__m128i found = compareEqualSse2(block, members[0], ElementSize<CharType>{});
+		for (std::size_t k = 1; k < setSize; ++k) {
+			found = _mm_or_si128(found, compareEqualSse2(block, members[k], ElementSize<CharType>{}));
+		}
+
+		return static_cast<std::uint32_t>(_mm_movemask_epi8(found)) ^ invert;
+	};
+
+	std::size_t i = 0;
+
+	for (; i + STEP <= size; i += STEP) {
+		std::uint32_t mask = matches(i);
+		if (mask != 0) {
+			return i + countTrailingZeros(mask) / sizeof(CharType);
+		}
+	}
+
+	if (i == size) {
+		return NOT_FOUND;
+	}
+
+	i = size - STEP;
+
+	std::uint32_t mask = matches(i);
+	return mask != 0 ? i + countTrailingZeros(mask) / sizeof(CharType) : NOT_FOUND;
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t findSetMember(const CharType *data, std::size_t size, const CharType *set, std::size_t setSize, bool member, std::true_type) noexcept {
+
+	if (setSize <= VECTOR_SET_LIMIT && size >= 16 / sizeof(CharType)) {
+		return findSetMemberSse2(data, size, set, setSize, member);
+	}
+
+	return findSetMemberScalar(data, size, set, setSize, member, std::true_type{});
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t findSetMember(const CharType *data, std::size_t size, const CharType *set, std::size_t setSize, bool member, std::false_type) noexcept {
+	return findSetMemberScalar(data, size, set, setSize, member, std::is_integral<CharType>{});
+}
+
+#endif
+
+/*
+*/
+template <typename CharType>
+std::size_t findSetMember(const CharType *data, std::size_t size, const CharType *set, std::size_t setSize, bool member) noexcept {
+
+	if (setSize == 0) {
+		return member || size == 0 ? NOT_FOUND : 0;
+	}
+
+#if defined(SIMPLE_STRING_SSE2)
+	return findSetMember(data, size, set, setSize, member, IsVectorizable<CharType>{});
+#else
+	return findSetMemberScalar(data, size, set, setSize, member, std::is_integral<CharType>{});
+#endif
+}
+
+
+// Positional Search
+//
+// The entry points used by the string classes. Positions past the end are clamped the same way
+// std::basic_string does: find() fails beyond size, rfind() searches from the last valid position.
+
+/*
+*/
+template <typename CharType>
+std::size_t find(const CharType *data, std::size_t size, CharType character, std::size_t position) noexcept {
+
+	if (position >= size) {
+		return NOT_FOUND;
+	}
+
+	std::size_t index = findCharacter(data + position, size - position, character);
+	return index != NOT_FOUND ? position + index : NOT_FOUND;
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t find(const CharType *data, std::size_t size, const CharType *needle, std::size_t needleSize, std::size_t position) noexcept {
+
+	if (position > size) {
+		return NOT_FOUND;
+	}
+
+	std::size_t index = findSubstring(data + position, size - position, needle, needleSize);
+	return index != NOT_FOUND ? position + index : NOT_FOUND;
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t reverseFind(const CharType *data, std::size_t size, CharType character, std::size_t position) noexcept {
+
+	if (size == 0) {
+		return NOT_FOUND;
+	}
+
+	return findLastCharacter(data, std::min(position, size - 1) + 1, character);
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t reverseFind(const CharType *data, std::size_t size, const CharType *needle, std::size_t needleSize, std::size_t position) noexcept {
+
+	if (needleSize > size) {
+		return NOT_FOUND;
+	}
+
+	std::size_t start = std::min(position, size - needleSize);
+	return findLastSubstring(data, start + needleSize, needle, needleSize);
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t findFirstOf(const CharType *data, std::size_t size, const CharType *set, std::size_t setSize, std::size_t position) noexcept {
+
+	if (position >= size) {
+		return NOT_FOUND;
+	}
+
+	std::size_t index = findSetMember(data + position, size - position, set, setSize, true);
+	return index != NOT_FOUND ? position + index : NOT_FOUND;
+}
+
+/*
+*/
+template <typename CharType>
+std::size_t findFirstNotOf(const CharType *data, std::size_t size, const CharType *set, std::size_t setSize, std::size_t position) noexcept {
+
+	if (position >= size) {
+		return NOT_FOUND;
+	}
+
+	std::size_t index = findSetMember(data + position, size - position, set, setSize, false);
+	return index != NOT_FOUND ? position + index : NOT_FOUND;
+}
+
+}
+}
+
+
+#endif // SIMPLE_STRING_SEARCH_HPP
@@ -0,0 +1,505 @@
+#pragma once
+#ifndef SIMPLE_STRING_SORT_HPP
+#define SIMPLE_STRING_SORT_HPP
+
+
+#include "SimpleStringView.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+
+// String Sorting
+//
+// sortStrings() orders strings or views as compare() does, without comparing whole strings against each other.
+// Each string is described once by an entry holding its data pointer, size and original position; the entries
+// are sorted, and the strings are then moved out in sorted order into a temporary array and moved back.
+//
+// Large groups of char strings are split 256 ways on the character at the current depth (MSD radix sort).
+// Smaller groups, and strings of wider characters, go through multikey quicksort, which partitions on a key
+// packing the next few characters (seven chars, three char16_ts or one char32_t) and moves to the characters
+// after them only in the group whose key equals the pivot's. Keys are loaded once per group and depth and kept
+// in the entry, so partitioning reads the entries in order instead of chasing every string's buffer, and a
+// prefix shared by a group is read once per entry rather than once per comparison.
+
+
+
+namespace simple {
+
+
+namespace detail {
+
+
+/*
+*/
+template <typename CharType>
+struct SortEntry {
+	const CharType *data;
+	std::size_t size;
+	std::size_t index;
+	std::uint64_t key;
+};
+
+/*
+	Characters map to unsigned values in the order compare() puts them, plus one so that zero can mark the end
+	of a string, which sorts before every character.
+*/
+template <typename CharType>
+struct SortKeys {
+
+	using UnsignedType = typename std::make_unsigned<CharType>::type;
+
+	static constexpr unsigned BITS = 8 * sizeof(CharType) + 1;
+	static constexpr std::size_t CHARACTERS = 64 / BITS;
+	static constexpr std::uint64_t LAST = (std::uint64_t{1} << BITS) - 1;
+
+	static std::uint64_t character(CharType) noexcept;
+	static std::uint64_t load(const SortEntry<CharType> &, std::size_t) noexcept;
+	static bool ended(std::uint64_t) noexcept;
+};
+
+/*
+*/
+template <typename CharType>
+inline std::uint64_t SortKeys<CharType>::character(CharType character) noexcept {
+
+	constexpr UnsignedType MINIMUM = static_cast<UnsignedType>(std::numeric_limits<CharType>::min());
+
+	return static_cast<std::uint64_t>(static_cast<UnsignedType>(static_cast<UnsignedType>(character) - MINIMUM)) + 1;
+}
+
+/*
+	The CHARACTERS characters from depth on, first one in the highest bits; positions past the end are zero.
+*/
+template <typename CharType>
+inline std::uint64_t SortKeys<CharType>::load(const SortEntry<CharType> &entry, std::size_t depth) noexcept {
+
+	std::uint64_t key = 0;
+
+	for (std::size_t k = 0; k < CHARACTERS; ++k) {
+		key <<= BITS;
+
+		if (depth + k < entry.size) {
+			key |= character(entry.data[depth + k]);
+		}
+	}
+
+	return key;
+}
+
+/*
+	Whether the string a key was loaded from ends within it. Strings with equal keys of that kind are equal.
+*/
+template <typename CharType>
+inline bool SortKeys<CharType>::ended(std::uint64_t key) noexcept {
+	return (key & LAST) == 0;
+}
+
+/*
+	Orders two entries whose first depth characters are known to be equal.
+*/
+template <typename CharType>
+inline bool entryLess(const SortEntry<CharType> &left, const SortEntry<CharType> &right, std::size_t depth) noexcept {
+
+	StringViewType<CharType> leftTail{left.data + depth, left.size - depth};
+	StringViewType<CharType> rightTail{right.data + depth, right.size - depth};
+
+	return leftTail.compare(rightTail) < 0;
+}
+
+/*
+*/
+template <typename CharType>
+void insertionSort(SortEntry<CharType> *entries, std::size_t count, std::size_t depth) noexcept {
+
+	for (std::size_t i = 1; i < count; ++i) {
+		SortEntry<CharType> entry = entries[i];
+
+		std::size_t j = i;
+		for (; j > 0 && entryLess(entry, entries[j - 1], depth); --j) {
+			entries[j] = entries[j - 1];
+		}
+
+		entries[j] = entry;
+	}
+}
+
+/*
+*/
+inline std::uint64_t medianOfThree(std::uint64_t first, std::uint64_t second, std::uint64_t third) noexcept {
+	return std::max(std::min(first, second), std::min(std::max(first, second), third));
+}
+
+/*
+	Median of three for small groups, and Tukey's ninther (the median of three medians) for large ones.
+*/
+template <typename CharType>
+std::uint64_t choosePivot(const SortEntry<CharType> *entries, std::size_t count) noexcept {
+
+	constexpr std::size_t NINTHER_THRESHOLD = 512;
+
+	std::size_t middle = count / 2;
+	std::size_t last = count - 1;
+
+	if (count < NINTHER_THRESHOLD) {
+		return medianOfThree(entries[0].key, entries[middle].key, entries[last].key);
+	}
+
+	std::size_t step = count / 8;
+
+	return medianOfThree(
+		medianOfThree(entries[0].key, entries[step].key, entries[2 * step].key),
+		medianOfThree(entries[middle - step].key, entries[middle].key, entries[middle + step].key),
+		medianOfThree(entries[last - 2 * step].key, entries[last - step].key, entries[last].key));
+}
+
+/*
+	Multikey quicksort on packed keys; loaded tells whether the entries already hold their keys for depth.
+	The two smaller of the three parts are sorted recursively and the largest by continuing the loop,
+	so the recursion never goes deeper than log2(count) whatever the data.
+*/
+template <typename CharType>
+void multikeyQuicksort(SortEntry<CharType> *entries, std::size_t count, std::size_t depth, bool loaded) noexcept {
+
+	using Keys = SortKeys<CharType>;
+
+	constexpr std::size_t INSERTION_LIMIT = 16;
+
+	while (count > INSERTION_LIMIT) {
+
+		if (!loaded) {
+			for (std::size_t i = 0; i < count; ++i) {
+				entries[i].key = Keys::load(entries[i], depth);
+			}
+		}
+
+		std::uint64_t pivot = choosePivot(entries, count);
+
+		// Dijkstra's three-way partition: [0, less) < pivot, [less, i) == pivot, [greater, count) > pivot.
+		std::size_t less = 0;
+		std::size_t greater = count;
+
+		for (std::size_t i = 0; i < greater;) {
+			if (entries[i].key < pivot) {
+				std::swap(entries[less++], entries[i++]);
+			}
+			else if (entries[i].key > pivot) {
+				std::swap(entries[i], entries[--greater]);
+			}
+			else {
+				++i;
+			}
+		}
+
+		std::size_t lessCount = less;
+		std::size_t equalCount = greater - less;
+		std::size_t greaterCount = count - greater;
+
+		// Strings that end within an equal key are equal, so that part is already in order.
+		if (Keys::ended(pivot)) {
+			equalCount = 0;
+		}
+
+		if (equalCount >= lessCount && equalCount >= greaterCount) {
+			multikeyQuicksort(entries, lessCount, depth, true);
+			multikeyQuicksort(entries + greater, greaterCount, depth, true);
+
+			entries += less;
+			count = equalCount;
+			depth += Keys::CHARACTERS;
+			loaded = false;
+		}
+		else {
+			if (equalCount != 0) {
+				multikeyQuicksort(entries + less, equalCount, depth + Keys::CHARACTERS, false);
+			}
+
+			if (lessCount >= greaterCount) {
+				multikeyQuicksort(entries + greater, greaterCount, depth, true);
+				count = lessCount;
+			}
+			else {
+				multikeyQuicksort(entries, lessCount, depth, true);
+				entries += greater;
+				count = greaterCount;
+			}
+
+			loaded = true;
+		}
+	}
+
+	insertionSort(entries, count, depth);
+}
+
+/*
+	Counts the entries per value of bucket(entry), which must not exceed 256, and scatters them through scratch,
+	so that afterwards entries holds them grouped by bucket in ascending order and boundaries[b] is where bucket b starts.
+*/
+template <typename CharType, typename Bucket>
+void distribute(SortEntry<CharType> *entries, SortEntry<CharType> *scratch, std::size_t count, std::size_t (&boundaries)[258], Bucket bucket) noexcept {
+
+	std::size_t counts[257] = {};
+
+	for (std::size_t i = 0; i < count; ++i) {
+		++counts[bucket(entries[i])];
+	}
+
+	std::size_t sum = 0;
+	for (std::size_t b = 0; b < 257; ++b) {
+		boundaries[b] = sum;
+		sum += counts[b];
+	}
+	boundaries[257] = sum;
+
+	// A prefix shared by every entry is common (paths, URLs, identifiers), and then nothing needs to move.
+	if (count != 0 && counts[bucket(entries[0])] == count) {
+		return;
+	}
+
+	std::size_t next[257];
+	std::copy(boundaries, boundaries + 257, next);
+
+	for (std::size_t i = 0; i < count; ++i) {
+		scratch[next[bucket(entries[i])]++] = entries[i];
+	}
+
+	std::copy(scratch, scratch + count, entries);
+}
+
+/*
+	MSD radix sort for char strings, splitting on one character per level. The characters come out of the keys,
+	which are loaded at keyDepth and reloaded only when depth has moved past the CHARACTERS they cover,
+	so most levels never touch the strings themselves. keyDepth is NOT_FOUND when no keys are loaded.
+	Bucket 0 holds the strings that end before depth and needs no more work. As in multikeyQuicksort(),
+	the largest bucket is handled by the loop and every other one recursively.
+*/
+template <typename CharType>
+void radixSort(SortEntry<CharType> *entries, SortEntry<CharType> *scratch, std::size_t count, std::size_t depth, std::size_t keyDepth) noexcept {
+
+	using Keys = SortKeys<CharType>;
+
+	static_assert(sizeof(CharType) == 1, "radix sort splits on whole characters");
+
+	constexpr std::size_t RADIX_THRESHOLD = 2048;
+
+	while (count >= RADIX_THRESHOLD) {
+
+		if (keyDepth == NOT_FOUND || depth >= keyDepth + Keys::CHARACTERS) {
+			for (std::size_t i = 0; i < count; ++i) {
+				entries[i].key = Keys::load(entries[i], depth);
+			}
+
+			keyDepth = depth;
+		}
+
+		unsigned shift = static_cast<unsigned>(Keys::BITS * (Keys::CHARACTERS - 1 - (depth - keyDepth)));
+
+		std::size_t boundaries[258];
+		distribute(entries, scratch, count, boundaries, [shift](const SortEntry<CharType> &entry) noexcept {
+			return static_cast<std::size_t>((entry.key >> shift) & Keys::LAST);
+		});
+
+		std::size_t largest = 1;
+		for (std::size_t b = 2; b < 257; ++b) {
+			if (boundaries[b + 1] - boundaries[b] > boundaries[largest + 1] - boundaries[largest]) {
+				largest = b;
+			}
+		}
+
+		for (std::size_t b = 1; b < 257; ++b) {
+			std::size_t size = boundaries[b + 1] - boundaries[b];
+
+			if (b != largest && size > 1) {
+				radixSort(entries + boundaries[b], scratch + boundaries[b], size, depth + 1, keyDepth);
+			}
+		}
+
+		std::size_t offset = boundaries[largest];
+		entries += offset;
+		scratch += offset;
+		count = boundaries[largest + 1] - offset;
+		++depth;
+	}
+
+	multikeyQuicksort(entries, count, depth, false);
+}
+
+/*
+*/
+template <typename CharType>
+void sortEntries(SortEntry<CharType> *entries, SortEntry<CharType> *scratch, std::size_t count, std::size_t depth, std::true_type) noexcept {
+	radixSort(entries, scratch, count, depth, NOT_FOUND);
+}
+
+/*
+*/
+template <typename CharType>
+void sortEntries(SortEntry<CharType> *entries, SortEntry<CharType> *, std::size_t count, std::size_t depth, std::false_type) noexcept {
+	multikeyQuicksort(entries, count, depth, false);
+}
+
+/*
+*/
+template <typename CharType>
+void sortEntries(SortEntry<CharType> *entries, SortEntry<CharType> *scratch, std::size_t count, std::size_t depth) noexcept {
+	sortEntries(entries, scratch, count, depth, std::integral_constant<bool, sizeof(CharType) == 1>{});
+}
+
+/*
+	Splits the entries on the highest byte of their first character, then sorts the buckets on up to threadCount
+	threads, largest bucket first, each thread taking the next one as it finishes. Buckets of char strings
+	already agree on a whole character; those of wider strings start over at depth zero.
+	If a thread cannot be started, the threads that did start (including this one) take on its share.
+*/
+template <typename CharType>
+void sortEntriesParallel(SortEntry<CharType> *entries, SortEntry<CharType> *scratch, std::size_t count, std::size_t threadCount) {
+
+	using Keys = SortKeys<CharType>;
+
+	constexpr unsigned SHIFT = static_cast<unsigned>(Keys::BITS * (Keys::CHARACTERS - 1));
+	constexpr unsigned BYTE_SHIFT = 8 * (sizeof(CharType) - 1);
+
+	for (std::size_t i = 0; i < count; ++i) {
+		entries[i].key = Keys::load(entries[i], 0);
+	}
+
+	std::size_t boundaries[258];
+	distribute(entries, scratch, count, boundaries, [](const SortEntry<CharType> &entry) noexcept {
+		std::uint64_t first = entry.key >> SHIFT;
+		return first != 0 ? static_cast<std::size_t>((first - 1) >> BYTE_SHIFT) + 1 : std::size_t{0};
+	});
+
+	std::size_t buckets[256];
+	std::size_t bucketCount = 0;
+
+	for (std::size_t b = 1; b < 257; ++b) {
+		if (boundaries[b + 1] - boundaries[b] > 1) {
+			buckets[bucketCount++] = b;
+		}
+	}
+
+	std::sort(buckets, buckets + bucketCount, [&boundaries](std::size_t left, std::size_t right) {
+		return boundaries[left + 1] - boundaries[left] > boundaries[right + 1] - boundaries[right];
+	});
+
+	std::size_t depth = sizeof(CharType) == 1 ? 1 : 0;
+	std::atomic<std::size_t> next{0};
+
+	auto work = [&]() noexcept {
+		for (std::size_t i = next.fetch_add(1); i < bucketCount; i = next.fetch_add(1)) {
+			std::size_t b = buckets[i];
+			sortEntries(entries + boundaries[b], scratch + boundaries[b], boundaries[b + 1] - boundaries[b], depth);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount - 1);
+
+	try {
+		for (std::size_t t = 1; t < threadCount && t < bucketCount; ++t) {
+			threads.emplace_back(work);
+		}
+	}
+	catch (const std::system_error &) {}
+
+	work();
+
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
+}
+
+/*
+	Gathers the elements in sorted order into a temporary array and moves them back. Following the cycles of
+	the permutation instead would need no array, but each step there waits on a cache miss at a random position,
+	while the gather's misses are independent of each other and overlap.
+*/
+template <typename RandomIterator, typename CharType>
+void applyOrder(RandomIterator first, const SortEntry<CharType> *entries, std::size_t count) {
+
+	using ElementType = typename std::iterator_traits<RandomIterator>::value_type;
+
+	std::vector<ElementType> sorted;
+	sorted.reserve(count);
+
+	for (std::size_t i = 0; i < count; ++i) {
+		sorted.push_back(std::move(first[entries[i].index]));
+	}
+
+	std::move(sorted.begin(), sorted.end(), first);
+}
+
+/*
+*/
+template <typename RandomIterator>
+void sortStrings(RandomIterator first, RandomIterator last, std::size_t threadCount) {
+
+	using ElementType = typename std::iterator_traits<RandomIterator>::value_type;
+	using CharType = typename ElementType::ValueType;
+
+	constexpr std::size_t PARALLEL_THRESHOLD = 1 << 16;
+
+	std::size_t count = static_cast<std::size_t>(last - first);
+
+	if (count < 2) {
+		return;
+	}
+
+	bool parallel = threadCount > 1 && count >= PARALLEL_THRESHOLD;
+
+	// Only ever written before being read, so they are left uninitialized rather than zeroed.
+	std::unique_ptr<SortEntry<CharType>[]> entries{new SortEntry<CharType>[count]};
+	std::unique_ptr<SortEntry<CharType>[]> scratch{sizeof(CharType) == 1 || parallel ? new SortEntry<CharType>[count] : nullptr};
+
+	for (std::size_t i = 0; i < count; ++i) {
+		const ElementType &element = first[i];
+		entries[i] = SortEntry<CharType>{element.data(), element.size(), i, 0};
+	}
+
+	if (parallel) {
+		sortEntriesParallel(entries.get(), scratch.get(), count, threadCount);
+	}
+	else {
+		sortEntries(entries.get(), scratch.get(), count, 0);
+	}
+
+	applyOrder(first, entries.get(), count);
+}
+
+}
+
+
+/*
+	Sorts [first, last) into the order compare() defines. The elements are StringTypes or StringViewTypes
+	(anything with ValueType, data() and size()) and are moved, never copied. Equal strings may end up in any order.
+	Allocates two arrays of count 32-byte entries (one for strings of wider characters) and room for count elements.
+*/
+template <typename RandomIterator>
+void sortStrings(RandomIterator first, RandomIterator last) {
+	detail::sortStrings(first, last, 1);
+}
+
+/*
+	As above, using up to threadCount threads, including the calling one, once there are enough strings to
+	make that worthwhile. std::thread::hardware_concurrency() is a reasonable choice.
+*/
+template <typename RandomIterator>
+void sortStrings(RandomIterator first, RandomIterator last, std::size_t threadCount) {
+	detail::sortStrings(first, last, threadCount);
+}
+
+}
+
+
+#endif // SIMPLE_STRING_SORT_HPP
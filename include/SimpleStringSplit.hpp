@@ -0,0 +1,551 @@
+
+#pragma once
+#ifndef SIMPLE_STRING_SPLIT_HPP
+#define SIMPLE_STRING_SPLIT_HPP
+
+
+#include <iterator>
+#include <type_traits>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "SimpleStringKernels.hpp"
+#include "SimpleStringSearch.hpp"
+
+
+
+namespace simple {
+
+
+// Defined in SimpleStringView.hpp, which includes this header; a SplitRange is only ever obtained from a view.
+template <typename CharType>
+class StringViewType;
+
+
+namespace detail {
+
+
+/*
+	Yields the positions of the members of a small character set in order, a block at a time.
+	One vector pass marks every delimiter in the next 64 bytes; until those are used up, each call
+	only pops the lowest bit off that mask, so short fields cost a few instructions each.
+	Sets too large for the vector compare fall back to findSetMember() on every call.
+*/
+template <typename CharType>
+class DelimiterScanner {
+public:
+
+	// Constructors
+
+	DelimiterScanner() noexcept = default;
+	DelimiterScanner(const CharType *, std::size_t, const CharType *, std::size_t, std::size_t) noexcept;
+
+	// Scan Functions
+
+	std::size_t next() noexcept;
+
+private:
+
+	// Constants
+
+	// Characters covered by one mask; each character owns sizeof(CharType) bits, only the lowest of which is kept.
+	static constexpr std::size_t BLOCK = 64 / sizeof(CharType);
+
+	static constexpr std::uint64_t LANES =
+		sizeof(CharType) == 1 ? ~std::uint64_t{0} :
+		sizeof(CharType) == 2 ? 0x5555555555555555u : 0x1111111111111111u;
+
+	// Data Members
+
+	const CharType *m_data{};
+	std::size_t m_size{};
+
+	const CharType *m_set{};
+	std::size_t m_setSize{};
+
+	std::size_t m_position{};
+	std::uint64_t m_mask{};
+
+	bool m_vector{};
+
+	// Utility Functions
+
+	std::uint64_t blockMask(std::size_t) const noexcept;
+};
+
+
+// Constants
+
+template <typename CharType>
+constexpr std::size_t DelimiterScanner<CharType>::BLOCK;
+
+template <typename CharType>
+constexpr std::uint64_t DelimiterScanner<CharType>::LANES;
+
+
+// Constructors
+
+/*
+	Scans data for members of set, starting at position.
+*/
+template <typename CharType>
+DelimiterScanner<CharType>::DelimiterScanner(const CharType *data, std::size_t size, const CharType *set, std::size_t setSize, std::size_t position) noexcept :
+	m_data{data}, m_size{size}, m_set{set}, m_setSize{setSize}, m_position{position} {
+
+	assert(position <= size);
+
+#if defined(SIMPLE_STRING_SSE2)
+	m_vector = IsVectorizable<CharType>::value && setSize != 0 && setSize <= VECTOR_SET_LIMIT;
+#endif
+
+	if (m_vector) {
+		m_mask = blockMask(m_position);
+	}
+}
+
+
+// Scan Functions
+
+/*
+	Position of the next delimiter after the previous one returned, or NOT_FOUND.
+*/
+template <typename CharType>
+std::size_t DelimiterScanner<CharType>::next() noexcept {
+
+	if (!m_vector) {
+		if (m_position >= m_size) {
+			return NOT_FOUND;
+		}
+
+		std::size_t index = findSetMember(m_data + m_position, m_size - m_position, m_set, m_setSize, true);
+		if (index == NOT_FOUND) {
+			m_position = m_size;
+			return NOT_FOUND;
+		}
+
+		index += m_position;
+		m_position = index + 1;
+
+		return index;
+	}
+
+	while (m_mask == 0) {
+		m_position += BLOCK;
+
+		if (m_position >= m_size) {
+			return NOT_FOUND;
+		}
+
+		m_mask = blockMask(m_position);
+	}
+
+	unsigned bit = countTrailingZeros(m_mask);
+	m_mask &= m_mask - 1;
+
+	return m_position + bit / sizeof(CharType);
+}
+
+
+// Utility Functions
+
+/*
+*/
+template <typename CharType>
+std::uint64_t DelimiterScanner<CharType>::blockMask(std::size_t first) const noexcept {
+
+	std::uint64_t mask = 0;
+
+#if defined(SIMPLE_STRING_SSE2)
+	if (first + BLOCK <= m_size) {
+		constexpr std::size_t STEP = 16 / sizeof(CharType);
+
+		__m128i members[VECTOR_SET_LIMIT] = {};
+		for (std::size_t k = 0; k < m_setSize; ++k) {
+			members[k] = broadcastSse2(m_set[k]);
+		}
+
+		for (std::size_t part = 0; part < 4; ++part) {
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_data + first + part * STEP));
+
+			__m128i found = compareEqualSse2(block, members[0], ElementSize<CharType>{});
+			for (std::size_t k = 1; k < m_setSize; ++k) {
+				found = _mm_or_si128(found, compareEqualSse2(block, members[k], ElementSize<CharType>{}));
+			}
+
+			mask |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(found))) << (16 * part);
+		}
+
+		return mask & LANES;
+	}
+#endif
+
+	// The final partial block is gathered one character at a time rather than read past the end.
+	for (std::size_t i = first; i < m_size && i < first + BLOCK; ++i) {
+		if (containsCharacter(m_set, m_setSize, m_data[i])) {
+			mask |= std::uint64_t{1} << ((i - first) * sizeof(CharType));
+		}
+	}
+
+	return mask;
+}
+
+}
+
+
+/*
+	Lazy range over the pieces of a view between delimiters, each yielded as a view into the original
+	characters; nothing is copied or allocated. Every delimiter separates two pieces, so adjacent delimiters
+	yield an empty piece, as do delimiters at either end, and an empty source yields a single empty piece.
+	The range refers to the source characters and the iterators refer to the range; neither may outlive them.
+*/
+template <typename CharType>
+class SplitRange {
+public:
+
+	// Type Aliases
+
+	using ValueType = CharType;
+	using SizeType = std::size_t;
+
+	using ViewType = StringViewType<CharType>;
+
+	// Constants
+
+	static constexpr SizeType NOT_FOUND = detail::NOT_FOUND;
+
+	// Delimiter Modes
+
+	enum class Mode {
+		SEQUENCE, // The delimiter is the whole sequence
+		ANY_OF    // Any single character of the sequence is a delimiter
+	};
+
+	// Iterator
+
+	class Iterator {
+	public:
+
+		// Standard Iterator Aliases
+
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = ViewType;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const ViewType *;
+		using reference = const ViewType &;
+
+		// Constructors
+
+		Iterator() noexcept = default;
+
+		// Access Operations
+
+		reference operator*() const noexcept;
+		pointer operator->() const noexcept;
+
+		// Increment Operations
+
+		Iterator &operator++() noexcept;
+		Iterator operator++(int) noexcept;
+
+		// Comparison Operations
+
+		bool operator==(const Iterator &) const noexcept;
+		bool operator!=(const Iterator &) const noexcept;
+
+	private:
+
+		friend class SplitRange;
+
+		// Data Members
+
+		const SplitRange *m_range{};
+
+		// Start of the current piece, or NOT_FOUND once past the last one.
+		SizeType m_first{NOT_FOUND};
+
+		ViewType m_piece{};
+
+		detail::DelimiterScanner<CharType> m_scanner{};
+
+		// Constructors
+
+		explicit Iterator(const SplitRange &) noexcept;
+
+		// Utility Functions
+
+		void advance() noexcept;
+	};
+
+private:
+
+	// Data Members
+
+	ViewType m_source;
+	ViewType m_delimiter{};
+
+	// A single character delimiter is stored here, since there may be no sequence to point at.
+	ValueType m_character{};
+
+	Mode m_mode;
+
+	// Utility Functions
+
+	const ValueType *delimiterData() const noexcept;
+	SizeType delimiterSize() const noexcept;
+	SizeType matchSize() const noexcept;
+	bool scanned() const noexcept;
+
+public:
+
+	// Constructors
+
+	SplitRange(ViewType, ValueType) noexcept;
+	SplitRange(ViewType, ViewType, Mode = Mode::SEQUENCE) noexcept;
+
+	// Range Functions
+
+	Iterator begin() const noexcept;
+	Iterator end() const noexcept;
+
+	// Bulk Functions
+
+	SizeType delimiters(SizeType *, SizeType, SizeType = 0) const noexcept;
+};
+
+
+// Constants
+
+template <typename ValueType>
+constexpr typename SplitRange<ValueType>::SizeType SplitRange<ValueType>::NOT_FOUND;
+
+
+// Constructors
+
+/*
+*/
+template <typename ValueType>
+SplitRange<ValueType>::SplitRange(ViewType source, ValueType delimiter) noexcept :
+	m_source{source}, m_character{delimiter}, m_mode{Mode::ANY_OF} {}
+
+/*
+	The delimiter must not be empty. Its characters are not copied, so it must outlive the range too.
+*/
+template <typename ValueType>
+SplitRange<ValueType>::SplitRange(ViewType source, ViewType delimiter, Mode mode) noexcept :
+	m_source{source}, m_delimiter{delimiter}, m_mode{mode} {
+
+	assert(!delimiter.empty());
+}
+
+
+// Utility Functions
+
+/*
+*/
+template <typename ValueType>
+const ValueType *SplitRange<ValueType>::delimiterData() const noexcept {
+	return m_delimiter.empty() ? &m_character : m_delimiter.data();
+}
+
+/*
+*/
+template <typename ValueType>
+typename SplitRange<ValueType>::SizeType SplitRange<ValueType>::delimiterSize() const noexcept {
+	return m_delimiter.empty() ? 1 : m_delimiter.size();
+}
+
+/*
+	Length of one delimiter occurrence in the source.
+*/
+template <typename ValueType>
+typename SplitRange<ValueType>::SizeType SplitRange<ValueType>::matchSize() const noexcept {
+	return m_mode == Mode::ANY_OF ? 1 : m_delimiter.size();
+}
+
+/*
+	Whether delimiters are single characters, found with the block scanner rather than substring search.
+*/
+template <typename ValueType>
+bool SplitRange<ValueType>::scanned() const noexcept {
+	return m_mode == Mode::ANY_OF || delimiterSize() == 1;
+}
+
+
+// Range Functions
+
+/*
+*/
+template <typename ValueType>
+typename SplitRange<ValueType>::Iterator SplitRange<ValueType>::begin() const noexcept {
+	return Iterator{*this};
+}
+
+/*
+*/
+template <typename ValueType>
+typename SplitRange<ValueType>::Iterator SplitRange<ValueType>::end() const noexcept {
+	return Iterator{};
+}
+
+
+// Bulk Functions
+
+/*
+	Writes the positions of up to capacity delimiters at or after position into offsets and returns how
+	many were written. Piece i then spans from just past delimiter i - 1 up to delimiter i. When the array
+	fills up there may be more; continue from the last offset plus the length of one delimiter.
+*/
+template <typename ValueType>
+typename SplitRange<ValueType>::SizeType SplitRange<ValueType>::delimiters(SizeType *offsets, SizeType capacity, SizeType position) const noexcept {
+
+	assert(offsets != nullptr || capacity == 0);
+	assert(position <= m_source.size());
+
+	SizeType count = 0;
+
+	if (scanned()) {
+		detail::DelimiterScanner<ValueType> scanner{m_source.data(), m_source.size(), delimiterData(), delimiterSize(), position};
+
+		while (count < capacity) {
+			SizeType index = scanner.next();
+			if (index == NOT_FOUND) {
+				break;
+			}
+
+			offsets[count++] = index;
+		}
+
+		return count;
+	}
+
+	while (count < capacity) {
+		SizeType index = m_source.find(m_delimiter, position);
+		if (index == NOT_FOUND) {
+			break;
+		}
+
+		offsets[count++] = index;
+		position = index + m_delimiter.size();
+	}
+
+	return count;
+}
+
+
+// Iterator Constructors
+
+/*
+*/
+template <typename ValueType>
+SplitRange<ValueType>::Iterator::Iterator(const SplitRange &range) noexcept :
+	m_range{&range}, m_first{0} {
+
+	if (range.scanned()) {
+		m_scanner = detail::DelimiterScanner<ValueType>{range.m_source.data(), range.m_source.size(), range.delimiterData(), range.delimiterSize(), 0};
+	}
+
+	advance();
+}
+
+
+// Iterator Access Operations
+
+/*
+*/
+template <typename ValueType>
+typename SplitRange<ValueType>::Iterator::reference SplitRange<ValueType>::Iterator::operator*() const noexcept {
+
+	assert(m_first != NOT_FOUND);
+
+	return m_piece;
+}
+
+/*
+*/
+template <typename ValueType>
+typename SplitRange<ValueType>::Iterator::pointer SplitRange<ValueType>::Iterator::operator->() const noexcept {
+
+	assert(m_first != NOT_FOUND);
+
+	return &m_piece;
+}
+
+
+// Iterator Increment Operations
+
+/*
+*/
+template <typename ValueType>
+typename SplitRange<ValueType>::Iterator &SplitRange<ValueType>::Iterator::operator++() noexcept {
+
+	assert(m_first != NOT_FOUND);
+
+	SizeType last = m_first + m_piece.size();
+
+	// A piece that runs to the end of the source was not ended by a delimiter, so it was the last one.
+	if (last == m_range->m_source.size()) {
+		m_first = NOT_FOUND;
+		return *this;
+	}
+
+	m_first = last + m_range->matchSize();
+	advance();
+
+	return *this;
+}
+
+/*
+*/
+template <typename ValueType>
+typename SplitRange<ValueType>::Iterator SplitRange<ValueType>::Iterator::operator++(int) noexcept {
+
+	Iterator previous = *this;
+	++*this;
+
+	return previous;
+}
+
+
+// Iterator Comparison Operations
+
+/*
+	Iterators over the same range are equal when they are at the same piece; all past-the-end iterators are equal.
+*/
+template <typename ValueType>
+bool SplitRange<ValueType>::Iterator::operator==(const Iterator &other) const noexcept {
+	return m_first == other.m_first;
+}
+
+/*
+*/
+template <typename ValueType>
+bool SplitRange<ValueType>::Iterator::operator!=(const Iterator &other) const noexcept {
+	return !(*this == other);
+}
+
+
+// Iterator Utility Functions
+
+/*
+	Finds the end of the piece starting at m_first.
+*/
+template <typename ValueType>
+void SplitRange<ValueType>::Iterator::advance() noexcept {
+
+	const ViewType &source = m_range->m_source;
+
+	SizeType last = m_range->scanned() ? m_scanner.next() : source.find(m_range->m_delimiter, m_first);
+
+	if (last == NOT_FOUND) {
+		last = source.size();
+	}
+
+	m_piece = source.substring(m_first, last);
+}
+
+}
+
+
+#endif // SIMPLE_STRING_SPLIT_HPP
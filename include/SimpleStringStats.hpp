@@ -0,0 +1,282 @@
+#pragma once
+#ifndef SIMPLE_STRING_STATS_HPP
+#define SIMPLE_STRING_STATS_HPP
+
+
+#include <cstddef>
+
+#if defined(SIMPLE_STRING_STATS)
+#include <atomic>
+#endif
+
+
+// Allocation Statistics
+//
+// Defining SIMPLE_STRING_STATS before including any of the library's headers (in every translation unit)
+// makes strings record each buffer they allocate, free or take over from another string, both per thread
+// and for the whole process. Without it the hooks are empty inline functions and the snapshots stay zero,
+// so nothing is stored or counted and the instrumented paths compile to the same code as before.
+// Only string buffers are counted; a StringBuilder's chunks, rope nodes and intern pool arenas are not.
+
+
+
+namespace simple {
+
+
+/*
+	What a buffer was allocated for. CONSTRUCT, ASSIGN and CONCATENATE give a string new contents;
+	the causes from RESERVE on carry existing contents over into the new buffer, so they are reallocations.
+*/
+enum class AllocationCause : unsigned char {
+	CONSTRUCT,
+	ASSIGN,
+	CONCATENATE,
+	RESERVE,
+	APPEND,
+	INSERT,
+	REPLACE,
+	SHRINK
+};
+
+constexpr std::size_t ALLOCATION_CAUSE_COUNT = 8;
+
+constexpr bool ALLOCATION_STATS_ENABLED =
+#if defined(SIMPLE_STRING_STATS)
+	true;
+#else
+	false;
+#endif
+
+/*
+	Counters accumulated since the start of the program or the last resetAllocationStats().
+	Byte counts are sizes of whole buffers, NUL termination and unused capacity included.
+	peakSlack is the most unused space, in bytes, that any single buffer had when it was allocated.
+*/
+struct AllocationStats {
+
+	std::size_t allocations = 0;
+	std::size_t deallocations = 0;
+	std::size_t bytesAllocated = 0;
+	std::size_t bytesFreed = 0;
+	std::size_t reallocations = 0;
+	std::size_t steals = 0;
+	std::size_t peakSlack = 0;
+
+	std::size_t allocationsByCause[ALLOCATION_CAUSE_COUNT] = {};
+
+	std::size_t allocationsFor(AllocationCause) const noexcept;
+};
+
+
+// Snapshot Functions
+
+AllocationStats threadAllocationStats() noexcept;
+AllocationStats globalAllocationStats() noexcept;
+void resetAllocationStats() noexcept;
+
+
+namespace detail {
+
+// Recording Functions
+
+void recordAllocation(AllocationCause, std::size_t, std::size_t) noexcept;
+void recordDeallocation(std::size_t) noexcept;
+void recordSteal() noexcept;
+
+
+#if defined(SIMPLE_STRING_STATS)
+
+/*
+	Process-wide counters, updated with relaxed atomics next to the calling thread's plain ones.
+*/
+struct GlobalAllocationStats {
+
+	std::atomic<std::size_t> allocations{};
+	std::atomic<std::size_t> deallocations{};
+	std::atomic<std::size_t> bytesAllocated{};
+	std::atomic<std::size_t> bytesFreed{};
+	std::atomic<std::size_t> reallocations{};
+	std::atomic<std::size_t> steals{};
+	std::atomic<std::size_t> peakSlack{};
+
+	std::atomic<std::size_t> allocationsByCause[ALLOCATION_CAUSE_COUNT] = {};
+};
+
+/*
+*/
+inline AllocationStats &threadStats() noexcept {
+	static thread_local AllocationStats stats;
+	return stats;
+}
+
+/*
+*/
+inline GlobalAllocationStats &globalStats() noexcept {
+	static GlobalAllocationStats stats;
+	return stats;
+}
+
+/*
+*/
+inline void add(std::atomic<std::size_t> &counter, std::size_t amount) noexcept {
+	counter.fetch_add(amount, std::memory_order_relaxed);
+}
+
+/*
+*/
+inline std::size_t load(const std::atomic<std::size_t> &counter) noexcept {
+	return counter.load(std::memory_order_relaxed);
+}
+
+#endif
+
+}
+
+
+// Member Functions
+
+/*
+*/
+inline std::size_t AllocationStats::allocationsFor(AllocationCause cause) const noexcept {
+	return allocationsByCause[static_cast<std::size_t>(cause)];
+}
+
+
+// Snapshot Functions
+
+/*
+	The calling thread's counters.
+*/
+inline AllocationStats threadAllocationStats() noexcept {
+#if defined(SIMPLE_STRING_STATS)
+	return detail::threadStats();
+#else
+	return AllocationStats{};
+#endif
+}
+
+/*
+	The counters of all threads together. Each field is read separately, so a snapshot taken
+	while other threads allocate may be slightly inconsistent between fields.
+*/
+inline AllocationStats globalAllocationStats() noexcept {
+
+	AllocationStats snapshot;
+
+#if defined(SIMPLE_STRING_STATS)
+	const detail::GlobalAllocationStats &stats = detail::globalStats();
+
+	snapshot.allocations = detail::load(stats.allocations);
+	snapshot.deallocations = detail::load(stats.deallocations);
+	snapshot.bytesAllocated = detail::load(stats.bytesAllocated);
+	snapshot.bytesFreed = detail::load(stats.bytesFreed);
+	snapshot.reallocations = detail::load(stats.reallocations);
+	snapshot.steals = detail::load(stats.steals);
+	snapshot.peakSlack = detail::load(stats.peakSlack);
+
+	for (std::size_t i = 0; i < ALLOCATION_CAUSE_COUNT; ++i) {
+		snapshot.allocationsByCause[i] = detail::load(stats.allocationsByCause[i]);
+	}
+#endif
+
+	return snapshot;
+}
+
+/*
+	Clears the calling thread's counters and the global ones. Other threads keep their own counts.
+*/
+inline void resetAllocationStats() noexcept {
+#if defined(SIMPLE_STRING_STATS)
+	detail::threadStats() = AllocationStats{};
+
+	detail::GlobalAllocationStats &stats = detail::globalStats();
+
+	stats.allocations.store(0, std::memory_order_relaxed);
+	stats.deallocations.store(0, std::memory_order_relaxed);
+	stats.bytesAllocated.store(0, std::memory_order_relaxed);
+	stats.bytesFreed.store(0, std::memory_order_relaxed);
+	stats.reallocations.store(0, std::memory_order_relaxed);
+	stats.steals.store(0, std::memory_order_relaxed);
+	stats.peakSlack.store(0, std::memory_order_relaxed);
+
+	for (std::atomic<std::size_t> &counter : stats.allocationsByCause) {
+		counter.store(0, std::memory_order_relaxed);
+	}
+#endif
+}
+
+
+namespace detail {
+
+// Recording Functions
+
+#if defined(SIMPLE_STRING_STATS)
+
+/*
+	A buffer of bytes bytes, of which slack bytes are beyond the size it was allocated for.
+*/
+inline void recordAllocation(AllocationCause cause, std::size_t bytes, std::size_t slack) noexcept {
+
+	std::size_t index = static_cast<std::size_t>(cause);
+	bool reallocation = cause >= AllocationCause::RESERVE;
+
+	AllocationStats &local = threadStats();
+	++local.allocations;
+	local.bytesAllocated += bytes;
+	local.reallocations += reallocation;
+	local.peakSlack = local.peakSlack < slack ? slack : local.peakSlack;
+	++local.allocationsByCause[index];
+
+	GlobalAllocationStats &global = globalStats();
+	add(global.allocations, 1);
+	add(global.bytesAllocated, bytes);
+	add(global.reallocations, reallocation);
+	add(global.allocationsByCause[index], 1);
+
+	std::size_t peak = load(global.peakSlack);
+	while (peak < slack && !global.peakSlack.compare_exchange_weak(peak, slack, std::memory_order_relaxed)) {}
+}
+
+/*
+*/
+inline void recordDeallocation(std::size_t bytes) noexcept {
+
+	AllocationStats &local = threadStats();
+	++local.deallocations;
+	local.bytesFreed += bytes;
+
+	GlobalAllocationStats &global = globalStats();
+	add(global.deallocations, 1);
+	add(global.bytesFreed, bytes);
+}
+
+/*
+	A string took over another string's heap buffer instead of allocating.
+*/
+inline void recordSteal() noexcept {
+	++threadStats().steals;
+	add(globalStats().steals, 1);
+}
+
+#else
+
+/*
+*/
+inline void recordAllocation(AllocationCause, std::size_t, std::size_t) noexcept {}
+
+/*
+*/
+inline void recordDeallocation(std::size_t) noexcept {}
+
+/*
+*/
+inline void recordSteal() noexcept {}
+
+#endif
+
+}
+
+}
+
+
+#endif // SIMPLE_STRING_STATS_HPP
@@ -0,0 +1,274 @@
+
+#pragma once
+#ifndef SIMPLE_STRING_STREAM_HPP
+#define SIMPLE_STRING_STREAM_HPP
+
+
+#include <algorithm>
+#include <ios>
+#include <istream>
+#include <limits>
+#include <locale>
+#include <ostream>
+#include <streambuf>
+
+#include <cstddef>
+
+#include "SimpleStringSearch.hpp"
+
+
+
+namespace simple {
+namespace detail {
+
+
+// Stream Buffer Access
+//
+// Reading a stream a character at a time through sgetc() and snextc() costs a call and a check per character.
+// The get area of a buffered stream is scanned in place instead, which needs its protected pointers.
+// A pointer to a protected member formed through a derived class may be applied to any object of the base class,
+// so this is plain standard C++ rather than a cast to an unrelated type.
+
+/*
+*/
+template <typename CharType, typename Traits>
+class StreamBufferAccess : private std::basic_streambuf<CharType, Traits> {
+public:
+
+	// Type Aliases
+
+	using BufferType = std::basic_streambuf<CharType, Traits>;
+
+	// Access Functions
+
+	static CharType *first(BufferType &buffer) {
+		return (buffer.*(&StreamBufferAccess::gptr))();
+	}
+
+	static CharType *last(BufferType &buffer) {
+		return (buffer.*(&StreamBufferAccess::egptr))();
+	}
+
+	static void consume(BufferType &buffer, std::size_t count) {
+		(buffer.*(&StreamBufferAccess::gbump))(static_cast<int>(count));
+	}
+};
+
+
+// Output Functions
+
+/*
+	Writes padding for the remaining field width.
+*/
+template <typename CharType, typename Traits>
+bool writeFill(std::basic_ostream<CharType, Traits> &os, std::streamsize count) {
+
+	CharType fill = os.fill();
+
+	for (std::streamsize i = 0; i < count; ++i) {
+		if (Traits::eq_int_type(os.rdbuf()->sputc(fill), Traits::eof())) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+	Formatted output of a character range as one block, honouring width(), fill() and left/right adjustment
+	like the standard string inserters do.
+*/
+template <typename CharType, typename Traits>
+std::basic_ostream<CharType, Traits> &writeCharacters(std::basic_ostream<CharType, Traits> &os, const CharType *data, std::size_t size) {
+
+	typename std::basic_ostream<CharType, Traits>::sentry sentry{os};
+
+	if (!sentry) {
+		return os;
+	}
+
+	std::streamsize count = static_cast<std::streamsize>(size);
+	std::streamsize padding = std::max<std::streamsize>(os.width() - count, 0);
+	bool left = (os.flags() & std::ios_base::adjustfield) == std::ios_base::left;
+
+	bool good = true;
+
+	try {
+		if (padding != 0 && !left) {
+			good = writeFill(os, padding);
+		}
+
+		good = good && os.rdbuf()->sputn(data, count) == count;
+
+		if (good && padding != 0 && left) {
+			good = writeFill(os, padding);
+		}
+	} catch (...) {
+		good = false;
+	}
+
+	os.width(0);
+
+	if (!good) {
+		os.setstate(std::ios_base::badbit);
+	}
+
+	return os;
+}
+
+
+// Input Functions
+
+/*
+	Hands runs of characters from buffer to append until stop finds a character in a run, at most limit in total.
+	stop(first, last) returns a pointer to the first character that ends the input, or last.
+	That character is left in the stream. Returns whether input ended at such a character rather than
+	at end of file or the limit, and sets eofbit in state when end of file was reached.
+*/
+template <typename CharType, typename Traits, typename Stop, typename Append>
+bool readCharacters(std::basic_streambuf<CharType, Traits> &buffer, std::size_t limit, Stop stop, Append append, std::ios_base::iostate &state) {
+
+	using Access = StreamBufferAccess<CharType, Traits>;
+
+	// gbump() takes an int, so runs are capped to what it can express.
+	constexpr std::size_t RUN_LIMIT = static_cast<std::size_t>(std::numeric_limits<int>::max());
+
+	while (limit != 0) {
+		typename Traits::int_type next = buffer.sgetc();
+
+		if (Traits::eq_int_type(next, Traits::eof())) {
+			state |= std::ios_base::eofbit;
+			return false;
+		}
+
+		CharType *first = Access::first(buffer);
+		CharType *last = Access::last(buffer);
+
+		// An unbuffered stream has no get area to scan, so it is read one character at a time.
+		if (first == last) {
+			CharType character = Traits::to_char_type(next);
+
+			if (stop(&character, &character + 1) != &character + 1) {
+				return true;
+			}
+
+			append(&character, 1);
+			buffer.sbumpc();
+			--limit;
+
+			continue;
+		}
+
+		std::size_t run = std::min({static_cast<std::size_t>(last - first), limit, RUN_LIMIT});
+		const CharType *end = stop(first, first + run);
+		std::size_t count = static_cast<std::size_t>(end - first);
+
+		append(first, count);
+		Access::consume(buffer, count);
+		limit -= count;
+
+		if (count != run) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+	Formatted extraction of one whitespace-delimited word, the way the standard string extractor behaves:
+	leading whitespace is skipped, at most width() characters are read if it is set, and failbit is set
+	when nothing was extracted. clear and append operate on the destination string.
+*/
+template <typename CharType, typename Traits, typename Clear, typename Append>
+std::basic_istream<CharType, Traits> &readWord(std::basic_istream<CharType, Traits> &is, Clear clear, Append append) {
+
+	std::ios_base::iostate state = std::ios_base::goodbit;
+	std::size_t extracted = 0;
+
+	typename std::basic_istream<CharType, Traits>::sentry sentry{is};
+
+	if (sentry) {
+		clear();
+
+		std::streamsize width = is.width();
+		std::size_t limit = width > 0 ? static_cast<std::size_t>(width) : NOT_FOUND;
+
+		const std::ctype<CharType> &ctype = std::use_facet<std::ctype<CharType>>(is.getloc());
+
+		auto stop = [&ctype](const CharType *first, const CharType *last) {
+			return ctype.scan_is(std::ctype_base::space, first, last);
+		};
+
+		auto counted = [&append, &extracted](const CharType *data, std::size_t size) {
+			append(data, size);
+			extracted += size;
+		};
+
+		try {
+			readCharacters(*is.rdbuf(), limit, stop, counted, state);
+		} catch (...) {
+			state |= std::ios_base::badbit;
+		}
+
+		is.width(0);
+	}
+
+	if (extracted == 0) {
+		state |= std::ios_base::failbit;
+	}
+
+	is.setstate(state);
+
+	return is;
+}
+
+/*
+	Unformatted extraction up to delimiter, which is consumed but not stored, the way std::getline() behaves:
+	failbit is set only when nothing at all was extracted, not even the delimiter.
+*/
+template <typename CharType, typename Traits, typename Clear, typename Append>
+std::basic_istream<CharType, Traits> &readLine(std::basic_istream<CharType, Traits> &is, CharType delimiter, Clear clear, Append append) {
+
+	std::ios_base::iostate state = std::ios_base::goodbit;
+	std::size_t extracted = 0;
+
+	typename std::basic_istream<CharType, Traits>::sentry sentry{is, true};
+
+	if (sentry) {
+		clear();
+
+		auto stop = [delimiter](const CharType *first, const CharType *last) {
+			std::size_t index = findCharacter(first, static_cast<std::size_t>(last - first), delimiter);
+			return index == NOT_FOUND ? last : first + index;
+		};
+
+		auto counted = [&append, &extracted](const CharType *data, std::size_t size) {
+			append(data, size);
+			extracted += size;
+		};
+
+		try {
+			if (readCharacters(*is.rdbuf(), NOT_FOUND, stop, counted, state)) {
+				is.rdbuf()->sbumpc();
+				++extracted;
+			}
+		} catch (...) {
+			state |= std::ios_base::badbit;
+		}
+	}
+
+	if (extracted == 0) {
+		state |= std::ios_base::failbit;
+	}
+
+	is.setstate(state);
+
+	return is;
+}
+
+}
+}
+
+
+#endif // SIMPLE_STRING_STREAM_HPP
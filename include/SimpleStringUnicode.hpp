@@ -0,0 +1,1126 @@
+#pragma once
+#ifndef SIMPLE_STRING_UNICODE_HPP
+#define SIMPLE_STRING_UNICODE_HPP
+
+
+#include "SimpleString.hpp"
+#include "SimpleStringKernels.hpp"
+#include "SimpleStringNumeric.hpp"
+#include "SimpleStringView.hpp"
+
+#include <algorithm>
+#include <memory>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+// Unicode Encodings
+//
+// StringType<char> holds UTF-8, StringType<char16_t> UTF-16 and StringType<char32_t> UTF-32.
+// Conversions validate their input in full, measure the result exactly and then write it once,
+// straight into the buffer the returned string adopts.
+
+
+
+namespace simple {
+namespace detail {
+
+
+// Constants
+
+constexpr char32_t ASCII_LIMIT = 0x80;
+constexpr char32_t TWO_BYTE_LIMIT = 0x800;
+constexpr char32_t BASIC_PLANE_LIMIT = 0x10000;
+constexpr char32_t CODE_POINT_LIMIT = 0x110000;
+
+constexpr char32_t HIGH_SURROGATE_FIRST = 0xD800;
+constexpr char32_t LOW_SURROGATE_FIRST = 0xDC00;
+constexpr char32_t SURROGATE_LAST = 0xDFFF;
+
+// Error classes for the UTF-8 lookup tables (Keiser and Lemire, "Validating UTF-8 In Less Than One
+// Instruction Per Byte"). Each table maps a nibble of a byte pair to the errors that nibble allows;
+// a pair is invalid when all three lookups agree on at least one error.
+constexpr std::uint8_t UTF8_TOO_SHORT = 1 << 0;
+constexpr std::uint8_t UTF8_TOO_LONG = 1 << 1;
+constexpr std::uint8_t UTF8_OVERLONG_3 = 1 << 2;
+constexpr std::uint8_t UTF8_TOO_LARGE = 1 << 3;
+constexpr std::uint8_t UTF8_SURROGATE = 1 << 4;
+constexpr std::uint8_t UTF8_OVERLONG_2 = 1 << 5;
+constexpr std::uint8_t UTF8_TOO_LARGE_1000 = 1 << 6;
+constexpr std::uint8_t UTF8_OVERLONG_4 = 1 << 6;
+constexpr std::uint8_t UTF8_TWO_CONTINUATIONS = 1 << 7;
+
+// Errors decided by the high nibble of the first byte alone.
+constexpr std::uint8_t UTF8_CARRY = UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTINUATIONS;
+
+// Indexed by the high nibble of the first byte of the pair.
+constexpr std::uint8_t UTF8_FIRST_HIGH[16] = {
+	UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+	UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+	UTF8_TWO_CONTINUATIONS, UTF8_TWO_CONTINUATIONS, UTF8_TWO_CONTINUATIONS, UTF8_TWO_CONTINUATIONS,
+	UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+	UTF8_TOO_SHORT,
+	UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+	UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4
+};
+
+// Indexed by the low nibble of the first byte of the pair.
+constexpr std::uint8_t UTF8_FIRST_LOW[16] = {
+	UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+	UTF8_CARRY | UTF8_OVERLONG_2,
+	UTF8_CARRY,
+	UTF8_CARRY,
+	UTF8_CARRY | UTF8_TOO_LARGE,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000
+};
+
+// Indexed by the high nibble of the second byte of the pair.
+constexpr std::uint8_t UTF8_SECOND_HIGH[16] = {
+	UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+	UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+	UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+	UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+	UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+	UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+	UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT
+};
+
+
+// UTF-8 Validation Kernels
+
+/*
+	Length of the well-formed sequence at the start of data, or 0 if there is none.
+	Overlong forms, surrogates and values past U+10FFFF are all excluded by narrowing the range of the second byte.
+*/
+inline std::size_t utf8SequenceLength(const unsigned char *data, std::size_t size) noexcept {
+
+	unsigned char lead = data[0];
+
+	if (lead < ASCII_LIMIT) {
+		return 1;
+	}
+
+	std::size_t length;
+	unsigned char low = 0x80;
+	unsigned char high = 0xBF;
+
+	if (lead < 0xC2) {
+		return 0;
+	}
+	else if (lead < 0xE0) {
+		length = 2;
+	}
+	else if (lead < 0xF0) {
+		length = 3;
+		low = lead == 0xE0 ? 0xA0 : low;
+		high = lead == 0xED ? 0x9F : high;
+	}
+	else if (lead < 0xF5) {
+		length = 4;
+		low = lead == 0xF0 ? 0x90 : low;
+		high = lead == 0xF4 ? 0x8F : high;
+	}
+	else {
+		return 0;
+	}
+
+	if (size < length || data[1] < low || data[1] > high) {
+		return 0;
+	}
+
+	for (std::size_t i = 2; i < length; ++i) {
+		if ((data[i] & 0xC0) != 0x80) {
+			return 0;
+		}
+	}
+
+	return length;
+}
+
+/*
+*/
+inline bool isValidUtf8Scalar(const unsigned char *data, std::size_t size) noexcept {
+
+	for (std::size_t i = 0; i < size;) {
+		std::size_t length = utf8SequenceLength(data + i, size - i);
+		if (length == 0) {
+			return false;
+		}
+
+		i += length;
+	}
+
+	return true;
+}
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+	SSE2 has no byte shuffle for the table lookups, so it only skips ASCII a vector at a time
+	and checks the vectors that contain anything else one sequence at a time.
+*/
+inline bool isValidUtf8Sse2(const unsigned char *data, std::size_t size) noexcept {
+
+	constexpr std::size_t WIDTH = 16;
+
+	std::size_t i = 0;
+
+	while (i < size) {
+		if (i + WIDTH <= size && _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i))) == 0) {
+			i += WIDTH;
+			continue;
+		}
+
+		std::size_t end = std::min(i + WIDTH, size);
+
+		while (i < end) {
+			std::size_t length = utf8SequenceLength(data + i, size - i);
+			if (length == 0) {
+				return false;
+			}
+
+			i += length;
+		}
+	}
+
+	return true;
+}
+
+#endif
+
+#if defined(SIMPLE_STRING_AVX2)
+
+/*
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline __m256i lookupAvx2(const std::uint8_t (&table)[16], __m256i index) noexcept {
+	return _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(table))), index);
+}
+
+/*
+	Non-zero in every byte that breaks a rule, given the block before it.
+	The tables check each byte against the one before it; the third and fourth bytes of longer sequences
+	are required to be continuations separately, and a continuation that the tables accept as the second
+	of two is only valid where exactly that is required.
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline __m256i utf8ErrorsAvx2(__m256i input, __m256i previous) noexcept {
+
+	const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+	// Each lane of the alignments below needs the end of the lane before it, which for the low lane is the previous block.
+	__m256i carried = _mm256_permute2x128_si256(previous, input, 0x21);
+	__m256i previous1 = _mm256_alignr_epi8(input, carried, 15);
+	__m256i previous2 = _mm256_alignr_epi8(input, carried, 14);
+	__m256i previous3 = _mm256_alignr_epi8(input, carried, 13);
+
+	__m256i special = _mm256_and_si256(
+		_mm256_and_si256(
+			lookupAvx2(UTF8_FIRST_HIGH, _mm256_and_si256(_mm256_srli_epi16(previous1, 4), nibble)),
+			lookupAvx2(UTF8_FIRST_LOW, _mm256_and_si256(previous1, nibble))),
+		lookupAvx2(UTF8_SECOND_HIGH, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+
+	__m256i third = _mm256_subs_epu8(previous2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+	__m256i fourth = _mm256_subs_epu8(previous3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+	__m256i required = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+
+	return _mm256_xor_si256(required, special);
+}
+
+/*
+	Non-zero when a sequence starting in the last three bytes runs past the block.
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline __m256i utf8IncompleteAvx2(__m256i input) noexcept {
+
+	const __m256i limits = _mm256_setr_epi8(
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+
+	return _mm256_subs_epu8(input, limits);
+}
+
+/*
+	Blocks that are all ASCII are only checked for a sequence left open by the block before.
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline void checkUtf8BlockAvx2(__m256i input, __m256i &previous, __m256i &incomplete, __m256i &errors) noexcept {
+
+	if (_mm256_movemask_epi8(input) == 0) {
+		errors = _mm256_or_si256(errors, incomplete);
+		incomplete = _mm256_setzero_si256();
+	}
+	else {
+		errors = _mm256_or_si256(errors, utf8ErrorsAvx2(input, previous));
+		incomplete = utf8IncompleteAvx2(input);
+	}
+
+	previous = input;
+}
+
+/*
+	The final partial block is copied into a zero padded one; the padding reads as ASCII,
+	so a sequence cut short by the end of the text is reported like any other.
+*/
+SIMPLE_STRING_AVX2_TARGET
+inline bool isValidUtf8Avx2(const unsigned char *data, std::size_t size) noexcept {
+
+	constexpr std::size_t WIDTH = 32;
+
+	__m256i previous = _mm256_setzero_si256();
+	__m256i incomplete = _mm256_setzero_si256();
+	__m256i errors = _mm256_setzero_si256();
+
+	std::size_t i = 0;
+
+	for (; i + 2 * WIDTH <= size; i += 2 * WIDTH) {
+		__m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+		__m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + WIDTH));
+
+		if (_mm256_movemask_epi8(_mm256_or_si256(first, second)) == 0) {
+			errors = _mm256_or_si256(errors, incomplete);
+			incomplete = _mm256_setzero_si256();
+			previous = second;
+			continue;
+		}
+
+		checkUtf8BlockAvx2(first, previous, incomplete, errors);
+		checkUtf8BlockAvx2(second, previous, incomplete, errors);
+	}
+
+	for (; i + WIDTH <= size; i += WIDTH) {
+		checkUtf8BlockAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)), previous, incomplete, errors);
+	}
+
+	if (i != size) {
+		unsigned char tail[WIDTH] = {};
+		std::memcpy(tail, data + i, size - i);
+
+		checkUtf8BlockAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(tail)), previous, incomplete, errors);
+	}
+
+	errors = _mm256_or_si256(errors, incomplete);
+	return _mm256_testz_si256(errors, errors) != 0;
+}
+
+#endif
+
+/*
+*/
+inline bool isValidUtf8(const char *data, std::size_t size) noexcept {
+
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+
+#if defined(SIMPLE_STRING_AVX2)
+	constexpr std::size_t AVX2_THRESHOLD = 64;
+
+	if (size >= AVX2_THRESHOLD && hasAvx2()) {
+		return isValidUtf8Avx2(bytes, size);
+	}
+#endif
+
+#if defined(SIMPLE_STRING_SSE2)
+	return isValidUtf8Sse2(bytes, size);
+#else
+	return isValidUtf8Scalar(bytes, size);
+#endif
+}
+
+
+// UTF-16 and UTF-32 Validation Kernels
+
+/*
+	Length of the surrogate pair or single unit at the start of data, or 0 for an unpaired surrogate.
+*/
+inline std::size_t utf16SequenceLength(const char16_t *data, std::size_t size) noexcept {
+
+	char32_t unit = data[0];
+
+	if (unit < HIGH_SURROGATE_FIRST || unit > SURROGATE_LAST) {
+		return 1;
+	}
+
+	if (unit >= LOW_SURROGATE_FIRST || size < 2 || data[1] < LOW_SURROGATE_FIRST || data[1] > SURROGATE_LAST) {
+		return 0;
+	}
+
+	return 2;
+}
+
+/*
+	Vectors without surrogates are skipped whole; the others are checked one sequence at a time.
+*/
+inline bool isValidUtf16(const char16_t *data, std::size_t size) noexcept {
+
+	std::size_t i = 0;
+
+#if defined(SIMPLE_STRING_SSE2)
+	constexpr std::size_t STEP = 8;
+
+	const __m128i surrogateBits = _mm_set1_epi16(static_cast<short>(0xF800));
+	const __m128i surrogate = _mm_set1_epi16(static_cast<short>(HIGH_SURROGATE_FIRST));
+
+	while (i + STEP <= size) {
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(block, surrogateBits), surrogate)) == 0) {
+			i += STEP;
+			continue;
+		}
+
+		for (std::size_t end = i + STEP; i < end;) {
+			std::size_t length = utf16SequenceLength(data + i, size - i);
+			if (length == 0) {
+				return false;
+			}
+
+			i += length;
+		}
+	}
+#endif
+
+	while (i < size) {
+		std::size_t length = utf16SequenceLength(data + i, size - i);
+		if (length == 0) {
+			return false;
+		}
+
+		i += length;
+	}
+
+	return true;
+}
+
+/*
+*/
+inline bool isValidUtf32(const char32_t *data, std::size_t size) noexcept {
+
+	std::size_t i = 0;
+
+#if defined(SIMPLE_STRING_SSE2)
+	constexpr std::size_t STEP = 4;
+
+	// Unsigned limit check through a signed compare of biased values.
+	const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+	const __m128i limit = _mm_set1_epi32(static_cast<int>((CODE_POINT_LIMIT - 1) ^ 0x80000000u));
+	const __m128i surrogateBits = _mm_set1_epi32(static_cast<int>(0xFFFFF800u));
+	const __m128i surrogate = _mm_set1_epi32(static_cast<int>(HIGH_SURROGATE_FIRST));
+
+	for (; i + STEP <= size; i += STEP) {
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+
+		__m128i invalid = _mm_or_si128(
+			_mm_cmpgt_epi32(_mm_xor_si128(block, bias), limit),
+			_mm_cmpeq_epi32(_mm_and_si128(block, surrogateBits), surrogate));
+
+		if (_mm_movemask_epi8(invalid) != 0) {
+			return false;
+		}
+	}
+#endif
+
+	for (; i < size; ++i) {
+		if (data[i] >= CODE_POINT_LIMIT || (data[i] >= HIGH_SURROGATE_FIRST && data[i] <= SURROGATE_LAST)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+// Length Kernels
+//
+// Exact number of code units the given valid text takes in another encoding. Every code unit of the
+// source adds a fixed amount, so they are counted a vector at a time without decoding anything.
+// Compare masks are accumulated per byte and summed before a byte can overflow; a set lane wider than
+// a byte adds one to each of its bytes, so those sums are divided by the lane size.
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+*/
+inline std::size_t sumBytesSse2(__m128i counts) noexcept {
+
+	__m128i sums = _mm_sad_epu8(counts, _mm_setzero_si128());
+	return static_cast<std::size_t>(_mm_extract_epi16(sums, 0)) + static_cast<std::size_t>(_mm_extract_epi16(sums, 4));
+}
+
+#endif
+
+/*
+	Code points are the bytes that are not continuations; four byte sequences need a surrogate pair in UTF-16.
+*/
+inline void countUtf8(const char *data, std::size_t size, std::size_t &codePoints, std::size_t &supplementary) noexcept {
+
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+
+	codePoints = 0;
+	supplementary = 0;
+
+	std::size_t i = 0;
+
+#if defined(SIMPLE_STRING_SSE2)
+	constexpr std::size_t WIDTH = 16;
+	constexpr std::size_t BATCH = 255 * WIDTH;
+
+	const __m128i lastContinuation = _mm_set1_epi8(static_cast<char>(0xBF));
+	const __m128i lastThreeByteLead = _mm_set1_epi8(static_cast<char>(0xEF));
+	const __m128i one = _mm_set1_epi8(1);
+
+	while (i + WIDTH <= size) {
+		std::size_t end = i + std::min(BATCH, (size - i) & ~(WIDTH - 1));
+
+		__m128i leads = _mm_setzero_si128();
+		__m128i fourByteLeads = _mm_setzero_si128();
+
+		for (; i < end; i += WIDTH) {
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i));
+
+			leads = _mm_sub_epi8(leads, _mm_cmpgt_epi8(block, lastContinuation));
+			fourByteLeads = _mm_add_epi8(fourByteLeads, _mm_min_epu8(_mm_subs_epu8(block, lastThreeByteLead), one));
+		}
+
+		codePoints += sumBytesSse2(leads);
+		supplementary += sumBytesSse2(fourByteLeads);
+	}
+#endif
+
+	for (; i < size; ++i) {
+		codePoints += (bytes[i] & 0xC0) != 0x80 ? 1 : 0;
+		supplementary += bytes[i] >= 0xF0 ? 1 : 0;
+	}
+}
+
+/*
+*/
+inline std::size_t utf16Length(const char *data, std::size_t size) noexcept {
+
+	std::size_t codePoints;
+	std::size_t supplementary;
+	countUtf8(data, size, codePoints, supplementary);
+
+	return codePoints + supplementary;
+}
+
+/*
+*/
+inline std::size_t utf32Length(const char *data, std::size_t size) noexcept {
+
+	std::size_t codePoints;
+	std::size_t supplementary;
+	countUtf8(data, size, codePoints, supplementary);
+
+	return codePoints;
+}
+
+/*
+	One byte per unit, one more from U+0080 and another from U+0800. Each half of a surrogate pair
+	passes both thresholds but the pair only takes four bytes, so surrogates count one less.
+*/
+inline std::size_t utf8Length(const char16_t *data, std::size_t size) noexcept {
+
+	std::size_t length = size;
+	std::size_t i = 0;
+
+#if defined(SIMPLE_STRING_SSE2)
+	constexpr std::size_t STEP = 8;
+
+	// A unit adds at most two per iteration.
+	constexpr std::size_t BATCH = 127 * STEP;
+
+	const __m128i bias = _mm_set1_epi16(static_cast<short>(0x8000));
+	const __m128i lastAscii = _mm_set1_epi16(static_cast<short>((ASCII_LIMIT - 1) ^ 0x8000));
+	const __m128i lastTwoByte = _mm_set1_epi16(static_cast<short>((TWO_BYTE_LIMIT - 1) ^ 0x8000));
+	const __m128i surrogateBits = _mm_set1_epi16(static_cast<short>(0xF800));
+	const __m128i surrogate = _mm_set1_epi16(static_cast<short>(HIGH_SURROGATE_FIRST));
+
+	std::size_t added = 0;
+
+	while (i + STEP <= size) {
+		std::size_t end = i + std::min(BATCH, (size - i) & ~(STEP - 1));
+
+		__m128i counts = _mm_setzero_si128();
+
+		for (; i < end; i += STEP) {
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+			__m128i biased = _mm_xor_si128(block, bias);
+
+			counts = _mm_sub_epi8(counts, _mm_cmpgt_epi16(biased, lastAscii));
+			counts = _mm_sub_epi8(counts, _mm_cmpgt_epi16(biased, lastTwoByte));
+			counts = _mm_add_epi8(counts, _mm_cmpeq_epi16(_mm_and_si128(block, surrogateBits), surrogate));
+		}
+
+		added += sumBytesSse2(counts);
+	}
+
+	length += added / sizeof(char16_t);
+#endif
+
+	for (; i < size; ++i) {
+		char32_t unit = data[i];
+
+		if (unit >= HIGH_SURROGATE_FIRST && unit <= SURROGATE_LAST) {
+			length += 1;
+		}
+		else {
+			length += (unit >= ASCII_LIMIT ? 1 : 0) + (unit >= TWO_BYTE_LIMIT ? 1 : 0);
+		}
+	}
+
+	return length;
+}
+
+/*
+	Every unit but the second half of a surrogate pair is a code point.
+*/
+inline std::size_t utf32Length(const char16_t *data, std::size_t size) noexcept {
+
+	std::size_t length = size;
+	std::size_t i = 0;
+
+#if defined(SIMPLE_STRING_SSE2)
+	constexpr std::size_t STEP = 8;
+	constexpr std::size_t BATCH = 255 * STEP;
+
+	const __m128i lowSurrogateBits = _mm_set1_epi16(static_cast<short>(0xFC00));
+	const __m128i lowSurrogate = _mm_set1_epi16(static_cast<short>(LOW_SURROGATE_FIRST));
+
+	std::size_t removed = 0;
+
+	while (i + STEP <= size) {
+		std::size_t end = i + std::min(BATCH, (size - i) & ~(STEP - 1));
+
+		__m128i counts = _mm_setzero_si128();
+
+		for (; i < end; i += STEP) {
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+			counts = _mm_sub_epi8(counts, _mm_cmpeq_epi16(_mm_and_si128(block, lowSurrogateBits), lowSurrogate));
+		}
+
+		removed += sumBytesSse2(counts);
+	}
+
+	length -= removed / sizeof(char16_t);
+#endif
+
+	for (; i < size; ++i) {
+		length -= data[i] >= LOW_SURROGATE_FIRST && data[i] <= SURROGATE_LAST ? 1 : 0;
+	}
+
+	return length;
+}
+
+/*
+	Valid code points never reach the sign bit, so plain signed compares measure them.
+*/
+inline std::size_t utf8Length(const char32_t *data, std::size_t size) noexcept {
+
+	std::size_t length = size;
+	std::size_t i = 0;
+
+#if defined(SIMPLE_STRING_SSE2)
+	constexpr std::size_t STEP = 4;
+
+	// A unit adds at most three per iteration.
+	constexpr std::size_t BATCH = 85 * STEP;
+
+	const __m128i lastAscii = _mm_set1_epi32(static_cast<int>(ASCII_LIMIT - 1));
+	const __m128i lastTwoByte = _mm_set1_epi32(static_cast<int>(TWO_BYTE_LIMIT - 1));
+	const __m128i lastBasic = _mm_set1_epi32(static_cast<int>(BASIC_PLANE_LIMIT - 1));
+
+	std::size_t added = 0;
+
+	while (i + STEP <= size) {
+		std::size_t end = i + std::min(BATCH, (size - i) & ~(STEP - 1));
+
+		__m128i counts = _mm_setzero_si128();
+
+		for (; i < end; i += STEP) {
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+
+			counts = _mm_sub_epi8(counts, _mm_cmpgt_epi32(block, lastAscii));
+			counts = _mm_sub_epi8(counts, _mm_cmpgt_epi32(block, lastTwoByte));
+			counts = _mm_sub_epi8(counts, _mm_cmpgt_epi32(block, lastBasic));
+		}
+
+		added += sumBytesSse2(counts);
+	}
+
+	length += added / sizeof(char32_t);
+#endif
+
+	for (; i < size; ++i) {
+		length += (data[i] >= ASCII_LIMIT ? 1 : 0) + (data[i] >= TWO_BYTE_LIMIT ? 1 : 0) + (data[i] >= BASIC_PLANE_LIMIT ? 1 : 0);
+	}
+
+	return length;
+}
+
+/*
+*/
+inline std::size_t utf16Length(const char32_t *data, std::size_t size) noexcept {
+
+	std::size_t length = size;
+	std::size_t i = 0;
+
+#if defined(SIMPLE_STRING_SSE2)
+	constexpr std::size_t STEP = 4;
+	constexpr std::size_t BATCH = 255 * STEP;
+
+	const __m128i lastBasic = _mm_set1_epi32(static_cast<int>(BASIC_PLANE_LIMIT - 1));
+
+	std::size_t added = 0;
+
+	while (i + STEP <= size) {
+		std::size_t end = i + std::min(BATCH, (size - i) & ~(STEP - 1));
+
+		__m128i counts = _mm_setzero_si128();
+
+		for (; i < end; i += STEP) {
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+			counts = _mm_sub_epi8(counts, _mm_cmpgt_epi32(block, lastBasic));
+		}
+
+		added += sumBytesSse2(counts);
+	}
+
+	length += added / sizeof(char32_t);
+#endif
+
+	for (; i < size; ++i) {
+		length += data[i] >= BASIC_PLANE_LIMIT ? 1 : 0;
+	}
+
+	return length;
+}
+
+
+// Code Point Functions
+//
+// Decode one code point from valid text and advance past it, or encode one and advance past the units written.
+
+/*
+*/
+inline char32_t decode(const char *&source) noexcept {
+
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(source);
+	char32_t lead = bytes[0];
+
+	if (lead < 0x80) {
+		source += 1;
+		return lead;
+	}
+
+	if (lead < 0xE0) {
+		source += 2;
+		return ((lead & 0x1F) << 6) | (bytes[1] & 0x3Fu);
+	}
+
+	if (lead < 0xF0) {
+		source += 3;
+		return ((lead & 0x0F) << 12) | ((bytes[1] & 0x3Fu) << 6) | (bytes[2] & 0x3Fu);
+	}
+
+	source += 4;
+	return ((lead & 0x07) << 18) | ((bytes[1] & 0x3Fu) << 12) | ((bytes[2] & 0x3Fu) << 6) | (bytes[3] & 0x3Fu);
+}
+
+/*
+*/
+inline char32_t decode(const char16_t *&source) noexcept {
+
+	char32_t unit = *source++;
+
+	if (unit < HIGH_SURROGATE_FIRST || unit > SURROGATE_LAST) {
+		return unit;
+	}
+
+	char32_t low = *source++;
+	return BASIC_PLANE_LIMIT + ((unit - HIGH_SURROGATE_FIRST) << 10) + (low - LOW_SURROGATE_FIRST);
+}
+
+/*
+*/
+inline char32_t decode(const char32_t *&source) noexcept {
+	return *source++;
+}
+
+/*
+*/
+inline void encode(char32_t codePoint, char *&destination) noexcept {
+
+	if (codePoint < ASCII_LIMIT) {
+		*destination++ = static_cast<char>(codePoint);
+	}
+	else if (codePoint < TWO_BYTE_LIMIT) {
+		*destination++ = static_cast<char>(0xC0 | (codePoint >> 6));
+		*destination++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+	else if (codePoint < BASIC_PLANE_LIMIT) {
+		*destination++ = static_cast<char>(0xE0 | (codePoint >> 12));
+		*destination++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		*destination++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+	else {
+		*destination++ = static_cast<char>(0xF0 | (codePoint >> 18));
+		*destination++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+		*destination++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		*destination++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+}
+
+/*
+*/
+inline void encode(char32_t codePoint, char16_t *&destination) noexcept {
+
+	if (codePoint < BASIC_PLANE_LIMIT) {
+		*destination++ = static_cast<char16_t>(codePoint);
+		return;
+	}
+
+	codePoint -= BASIC_PLANE_LIMIT;
+
+	*destination++ = static_cast<char16_t>(HIGH_SURROGATE_FIRST + (codePoint >> 10));
+	*destination++ = static_cast<char16_t>(LOW_SURROGATE_FIRST + (codePoint & 0x3FF));
+}
+
+/*
+*/
+inline void encode(char32_t codePoint, char32_t *&destination) noexcept {
+	*destination++ = codePoint;
+}
+
+
+// Direct Block Kernels
+//
+// Each converts the vector of valid source units at source when every one of them is a code point that
+// takes exactly one unit in the destination encoding, and returns whether it did. That covers ASCII for
+// conversions to and from UTF-8, and everything outside the supplementary planes between UTF-16 and UTF-32.
+
+#if defined(SIMPLE_STRING_SSE2)
+
+/*
+*/
+inline bool copyDirectSse2(const char *source, char16_t *destination) noexcept {
+
+	__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+
+	if (_mm_movemask_epi8(block) != 0) {
+		return false;
+	}
+
+	const __m128i zero = _mm_setzero_si128();
+
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(destination), _mm_unpacklo_epi8(block, zero));
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(destination + 8), _mm_unpackhi_epi8(block, zero));
+
+	return true;
+}
+
+/*
+*/
+inline bool copyDirectSse2(const char *source, char32_t *destination) noexcept {
+
+	__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+
+	if (_mm_movemask_epi8(block) != 0) {
+		return false;
+	}
+
+	const __m128i zero = _mm_setzero_si128();
+
+	__m128i low = _mm_unpacklo_epi8(block, zero);
+	__m128i high = _mm_unpackhi_epi8(block, zero);
+
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(destination), _mm_unpacklo_epi16(low, zero));
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(destination + 4), _mm_unpackhi_epi16(low, zero));
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(destination + 8), _mm_unpacklo_epi16(high, zero));
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(destination + 12), _mm_unpackhi_epi16(high, zero));
+
+	return true;
+}
+
+/*
+*/
+inline bool copyDirectSse2(const char16_t *source, char *destination) noexcept {
+
+	__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+
+	if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(block, _mm_set1_epi16(static_cast<short>(0xFF80))), _mm_setzero_si128())) != 0xFFFF) {
+		return false;
+	}
+
+	_mm_storel_epi64(reinterpret_cast<__m128i *>(destination), _mm_packus_epi16(block, block));
+
+	return true;
+}
+
+/*
+*/
+inline bool copyDirectSse2(const char16_t *source, char32_t *destination) noexcept {
+
+	__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+
+	__m128i surrogates = _mm_cmpeq_epi16(
+		_mm_and_si128(block, _mm_set1_epi16(static_cast<short>(0xF800))),
+		_mm_set1_epi16(static_cast<short>(HIGH_SURROGATE_FIRST)));
+
+	if (_mm_movemask_epi8(surrogates) != 0) {
+		return false;
+	}
+
+	const __m128i zero = _mm_setzero_si128();
+
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(destination), _mm_unpacklo_epi16(block, zero));
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(destination + 4), _mm_unpackhi_epi16(block, zero));
+
+	return true;
+}
+
+/*
+*/
+inline bool copyDirectSse2(const char32_t *source, char *destination) noexcept {
+
+	__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+
+	if (_mm_movemask_epi8(_mm_cmpgt_epi32(block, _mm_set1_epi32(static_cast<int>(ASCII_LIMIT - 1)))) != 0) {
+		return false;
+	}
+
+	__m128i words = _mm_packs_epi32(block, block);
+	int bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+	std::memcpy(destination, &bytes, sizeof(bytes));
+
+	return true;
+}
+
+/*
+	SSE2 only packs with signed saturation, so the units are biased into the signed range and back.
+*/
+inline bool copyDirectSse2(const char32_t *source, char16_t *destination) noexcept {
+
+	__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+
+	if (_mm_movemask_epi8(_mm_cmpgt_epi32(block, _mm_set1_epi32(static_cast<int>(BASIC_PLANE_LIMIT - 1)))) != 0) {
+		return false;
+	}
+
+	__m128i biased = _mm_sub_epi32(block, _mm_set1_epi32(0x8000));
+	__m128i units = _mm_add_epi16(_mm_packs_epi32(biased, biased), _mm_set1_epi16(static_cast<short>(0x8000)));
+	_mm_storel_epi64(reinterpret_cast<__m128i *>(destination), units);
+
+	return true;
+}
+
+#endif
+
+
+// Transcoding
+
+/*
+	Writes the valid text at source to destination in the other encoding.
+	A vector that is not direct is converted one code point at a time before the next one is tried,
+	so text that is mostly outside ASCII does not pay for a failed check per character.
+*/
+template <typename SourceType, typename DestinationType>
+void transcode(const SourceType *source, std::size_t size, DestinationType *destination) noexcept {
+
+	const SourceType *end = source + size;
+
+#if defined(SIMPLE_STRING_SSE2)
+	constexpr std::size_t STEP = 16 / sizeof(SourceType);
+
+	while (static_cast<std::size_t>(end - source) >= STEP) {
+		if (copyDirectSse2(source, destination)) {
+			source += STEP;
+			destination += STEP;
+			continue;
+		}
+
+		for (const SourceType *block = source + STEP; source < block;) {
+			encode(decode(source), destination);
+		}
+	}
+#endif
+
+	while (source != end) {
+		encode(decode(source), destination);
+	}
+}
+
+/*
+	Builds strings of StorageType from text already known to be valid.
+*/
+template <typename StorageType>
+struct Transcoder {
+
+	using ValueType = typename StorageType::ValueType;
+	using AllocatorType = typename StorageType::AllocatorType;
+	using AllocatorTraits = std::allocator_traits<AllocatorType>;
+
+	/*
+		size is the exact length of the result. Results short enough for the inline buffer are built there instead.
+	*/
+	template <typename SourceType>
+	static StorageType convert(const SourceType *source, std::size_t sourceSize, std::size_t size, const AllocatorType &allocator) {
+
+		if (size < StorageType::LOCAL_CAPACITY) {
+			ValueType buffer[StorageType::LOCAL_CAPACITY];
+			transcode(source, sourceSize, buffer);
+
+			return StorageType{typename StorageType::ViewType{buffer, size}, allocator};
+		}
+
+		AllocatorType copy = allocator;
+		ValueType *data = AllocatorTraits::allocate(copy, size + 1);
+
+		detail::recordAllocation(AllocationCause::CONSTRUCT, (size + 1) * sizeof(ValueType), 0);
+
+		transcode(source, sourceSize, data);
+		data[size] = ValueType{};
+
+		return StorageType{data, size, size + 1, copy};
+	}
+};
+
+}
+
+
+// Validation Functions
+
+/*
+	True when view is well-formed UTF-8: no overlong forms, surrogates, code points past U+10FFFF,
+	stray continuation bytes or sequences cut short.
+*/
+inline bool isValidUtf8(StringViewType<char> view) noexcept {
+	return detail::isValidUtf8(view.data(), view.size());
+}
+
+/*
+	True when every surrogate in view is half of a correctly ordered pair.
+*/
+inline bool isValidUtf16(StringViewType<char16_t> view) noexcept {
+	return detail::isValidUtf16(view.data(), view.size());
+}
+
+/*
+	True when every unit of view is a code point other than a surrogate.
+*/
+inline bool isValidUtf32(StringViewType<char32_t> view) noexcept {
+	return detail::isValidUtf32(view.data(), view.size());
+}
+
+
+// Transcoding Functions
+//
+// Invalid input gives an empty string and ParseError::INVALID rather than replacement characters.
+// Otherwise the result is allocated once, at its exact final size, from a copy of allocator.
+
+/*
+*/
+template <typename AllocatorType = std::allocator<char16_t>>
+ParseResult<StringType<char16_t, AllocatorType>> toUtf16(StringViewType<char> view, const AllocatorType &allocator = AllocatorType()) {
+
+	using ResultType = StringType<char16_t, AllocatorType>;
+
+	if (!detail::isValidUtf8(view.data(), view.size())) {
+		return {ResultType{allocator}, ParseError::INVALID};
+	}
+
+	std::size_t size = detail::utf16Length(view.data(), view.size());
+	return {detail::Transcoder<ResultType>::convert(view.data(), view.size(), size, allocator), ParseError::NONE};
+}
+
+/*
+*/
+template <typename AllocatorType = std::allocator<char32_t>>
+ParseResult<StringType<char32_t, AllocatorType>> toUtf32(StringViewType<char> view, const AllocatorType &allocator = AllocatorType()) {
+
+	using ResultType = StringType<char32_t, AllocatorType>;
+
+	if (!detail::isValidUtf8(view.data(), view.size())) {
+		return {ResultType{allocator}, ParseError::INVALID};
+	}
+
+	std::size_t size = detail::utf32Length(view.data(), view.size());
+	return {detail::Transcoder<ResultType>::convert(view.data(), view.size(), size, allocator), ParseError::NONE};
+}
+
+/*
+*/
+template <typename AllocatorType = std::allocator<char>>
+ParseResult<StringType<char, AllocatorType>> toUtf8(StringViewType<char16_t> view, const AllocatorType &allocator = AllocatorType()) {
+
+	using ResultType = StringType<char, AllocatorType>;
+
+	if (!detail::isValidUtf16(view.data(), view.size())) {
+		return {ResultType{allocator}, ParseError::INVALID};
+	}
+
+	std::size_t size = detail::utf8Length(view.data(), view.size());
+	return {detail::Transcoder<ResultType>::convert(view.data(), view.size(), size, allocator), ParseError::NONE};
+}
+
+/*
+*/
+template <typename AllocatorType = std::allocator<char32_t>>
+ParseResult<StringType<char32_t, AllocatorType>> toUtf32(StringViewType<char16_t> view, const AllocatorType &allocator = AllocatorType()) {
+
+	using ResultType = StringType<char32_t, AllocatorType>;
+
+	if (!detail::isValidUtf16(view.data(), view.size())) {
+		return {ResultType{allocator}, ParseError::INVALID};
+	}
+
+	std::size_t size = detail::utf32Length(view.data(), view.size());
+	return {detail::Transcoder<ResultType>::convert(view.data(), view.size(), size, allocator), ParseError::NONE};
+}
+
+/*
+*/
+template <typename AllocatorType = std::allocator<char>>
+ParseResult<StringType<char, AllocatorType>> toUtf8(StringViewType<char32_t> view, const AllocatorType &allocator = AllocatorType()) {
+
+	using ResultType = StringType<char, AllocatorType>;
+
+	if (!detail::isValidUtf32(view.data(), view.size())) {
+		return {ResultType{allocator}, ParseError::INVALID};
+	}
+
+	std::size_t size = detail::utf8Length(view.data(), view.size());
+	return {detail::Transcoder<ResultType>::convert(view.data(), view.size(), size, allocator), ParseError::NONE};
+}
+
+/*
+*/
+template <typename AllocatorType = std::allocator<char16_t>>
+ParseResult<StringType<char16_t, AllocatorType>> toUtf16(StringViewType<char32_t> view, const AllocatorType &allocator = AllocatorType()) {
+
+	using ResultType = StringType<char16_t, AllocatorType>;
+
+	if (!detail::isValidUtf32(view.data(), view.size())) {
+		return {ResultType{allocator}, ParseError::INVALID};
+	}
+
+	std::size_t size = detail::utf16Length(view.data(), view.size());
+	return {detail::Transcoder<ResultType>::convert(view.data(), view.size(), size, allocator), ParseError::NONE};
+}
+
+}
+
+
+#endif // SIMPLE_STRING_UNICODE_HPP
@@ -0,0 +1,752 @@
+
+#pragma once
+#ifndef SIMPLE_STRING_VIEW_HPP
+#define SIMPLE_STRING_VIEW_HPP
+
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <ostream>
+#include <type_traits>
+
+#include <cassert>
+#include <cstddef>
+
+#include "SimpleStringCase.hpp"
+#include "SimpleStringHash.hpp"
+#include "SimpleStringKernels.hpp"
+#include "SimpleStringNumeric.hpp"
+#include "SimpleStringSearch.hpp"
+#include "SimpleStringSplit.hpp"
+#include "SimpleStringStream.hpp"
+
+
+
+namespace simple {
+
+
+/*
+	Non-owning reference to a range of characters: a pointer and a length, nothing else.
+	The range is not necessarily NUL terminated, so there is no cstring().
+	A view never outlives the string it was taken from; mutating that string invalidates it.
+*/
+template <typename CharType>
+class StringViewType {
+public:
+
+	// Type Aliases
+
+	using ValueType = CharType;
+	using SizeType = std::size_t;
+
+	using DifferenceType = std::ptrdiff_t;
+
+	using ConstReference = const ValueType &;
+	using ConstPointer = const ValueType *;
+
+	using ConstIterator = ConstPointer;
+	using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+	// Constants
+
+	// Returned by the search functions when there is no match.
+	static constexpr SizeType NOT_FOUND = detail::NOT_FOUND;
+
+private:
+
+	// Data Members
+
+	ConstPointer m_data{};
+	SizeType m_size{};
+
+public:
+
+	// Constructors
+
+	StringViewType() noexcept = default;
+	StringViewType(ConstPointer, SizeType) noexcept;
+	StringViewType(ConstPointer) noexcept;
+
+	// Size Functions
+
+	SizeType size() const noexcept;
+	bool empty() const noexcept;
+
+	// Data Access Functions
+
+	ConstPointer data() const noexcept;
+
+	ConstReference operator[](SizeType) const noexcept;
+
+	ConstReference front() const noexcept;
+	ConstReference back() const noexcept;
+
+	// Iterator Functions
+
+	ConstIterator begin() const noexcept;
+	ConstIterator end() const noexcept;
+	ConstIterator cbegin() const noexcept;
+	ConstIterator cend() const noexcept;
+
+	ConstReverseIterator rbegin() const noexcept;
+	ConstReverseIterator rend() const noexcept;
+	ConstReverseIterator crbegin() const noexcept;
+	ConstReverseIterator crend() const noexcept;
+
+	// Mutation Functions
+
+	void popback(SizeType = 1) noexcept;
+	void trim(SizeType = 1) noexcept;
+
+	StringViewType substring(SizeType) const noexcept;
+	StringViewType substring(SizeType, SizeType) const noexcept;
+
+	// Comparison Functions
+
+	int compare(ConstPointer) const noexcept;
+	int compare(StringViewType) const noexcept;
+
+	int compareIgnoreCase(ConstPointer) const noexcept;
+	int compareIgnoreCase(StringViewType) const noexcept;
+
+	bool equalsIgnoreCase(ConstPointer) const noexcept;
+	bool equalsIgnoreCase(StringViewType) const noexcept;
+
+	// Search Functions
+
+	SizeType find(ValueType, SizeType = 0) const noexcept;
+	SizeType find(ConstPointer, SizeType = 0) const noexcept;
+	SizeType find(StringViewType, SizeType = 0) const noexcept;
+
+	SizeType rfind(ValueType, SizeType = NOT_FOUND) const noexcept;
+	SizeType rfind(ConstPointer, SizeType = NOT_FOUND) const noexcept;
+	SizeType rfind(StringViewType, SizeType = NOT_FOUND) const noexcept;
+
+	SizeType findIgnoreCase(ValueType, SizeType = 0) const noexcept;
+	SizeType findIgnoreCase(ConstPointer, SizeType = 0) const noexcept;
+	SizeType findIgnoreCase(StringViewType, SizeType = 0) const noexcept;
+
+	bool contains(ValueType) const noexcept;
+	bool contains(ConstPointer) const noexcept;
+	bool contains(StringViewType) const noexcept;
+
+	bool startsWith(ValueType) const noexcept;
+	bool startsWith(ConstPointer) const noexcept;
+	bool startsWith(StringViewType) const noexcept;
+
+	bool endsWith(ValueType) const noexcept;
+	bool endsWith(ConstPointer) const noexcept;
+	bool endsWith(StringViewType) const noexcept;
+
+	SizeType findFirstOf(ConstPointer, SizeType = 0) const noexcept;
+	SizeType findFirstOf(StringViewType, SizeType = 0) const noexcept;
+	SizeType findFirstNotOf(ConstPointer, SizeType = 0) const noexcept;
+	SizeType findFirstNotOf(StringViewType, SizeType = 0) const noexcept;
+
+	// Split Functions
+
+	SplitRange<ValueType> split(ValueType) const noexcept;
+	SplitRange<ValueType> split(StringViewType) const noexcept;
+	SplitRange<ValueType> splitAny(StringViewType) const noexcept;
+
+	// Numeric Functions
+
+	template <typename IntegerType = int>
+	ParseResult<IntegerType> parseInt(unsigned = 10) const noexcept;
+	ParseResult<double> parseDouble() const;
+
+	// Hash Functions
+
+	SizeType hash() const noexcept;
+};
+
+
+// Constants
+
+template <typename ValueType>
+constexpr typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::NOT_FOUND;
+
+
+// Constructors
+
+/*
+*/
+template <typename ValueType>
+StringViewType<ValueType>::StringViewType(ConstPointer data, SizeType size) noexcept :
+	m_data{data}, m_size{size} {
+
+	assert(data != nullptr || size == 0);
+}
+
+/*
+*/
+template <typename ValueType>
+StringViewType<ValueType>::StringViewType(ConstPointer cstring) noexcept :
+	m_data{cstring}, m_size{detail::terminatedLength(cstring)} {
+
+	assert(cstring != nullptr);
+}
+
+
+// Size Functions
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::size() const noexcept {
+	return m_size;
+}
+
+/*
+*/
+template <typename ValueType>
+bool StringViewType<ValueType>::empty() const noexcept {
+	return m_size == 0;
+}
+
+
+// Data Access Functions
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::ConstPointer StringViewType<ValueType>::data() const noexcept {
+	return m_data;
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::ConstReference StringViewType<ValueType>::operator[](SizeType index) const noexcept {
+
+	assert(index < m_size);
+
+	return m_data[index];
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::ConstReference StringViewType<ValueType>::front() const noexcept {
+
+	assert(m_size != 0);
+
+	return m_data[0];
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::ConstReference StringViewType<ValueType>::back() const noexcept {
+
+	assert(m_size != 0);
+
+	return m_data[m_size - 1];
+}
+
+
+// Iterator Functions
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::ConstIterator StringViewType<ValueType>::begin() const noexcept {
+	return m_data;
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::ConstIterator StringViewType<ValueType>::end() const noexcept {
+	return m_data + m_size;
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::ConstIterator StringViewType<ValueType>::cbegin() const noexcept {
+	return m_data;
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::ConstIterator StringViewType<ValueType>::cend() const noexcept {
+	return m_data + m_size;
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::ConstReverseIterator StringViewType<ValueType>::rbegin() const noexcept {
+	return ConstReverseIterator{end()};
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::ConstReverseIterator StringViewType<ValueType>::rend() const noexcept {
+	return ConstReverseIterator{begin()};
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::ConstReverseIterator StringViewType<ValueType>::crbegin() const noexcept {
+	return ConstReverseIterator{end()};
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::ConstReverseIterator StringViewType<ValueType>::crend() const noexcept {
+	return ConstReverseIterator{begin()};
+}
+
+
+// Mutation Functions
+
+/*
+	Drops count characters from the end of the view; the characters themselves are untouched.
+*/
+template <typename ValueType>
+void StringViewType<ValueType>::popback(SizeType count) noexcept {
+
+	assert(count <= m_size);
+
+	m_size -= count;
+}
+
+/*
+	Drops count characters from the front of the view.
+*/
+template <typename ValueType>
+void StringViewType<ValueType>::trim(SizeType count) noexcept {
+
+	assert(count <= m_size);
+
+	m_data += count;
+	m_size -= count;
+}
+
+/*
+	Unlike StringType::substring(), never copies; the result refers to the same characters.
+*/
+template <typename ValueType>
+StringViewType<ValueType> StringViewType<ValueType>::substring(SizeType last) const noexcept {
+
+	assert(last <= m_size);
+
+	return StringViewType{m_data, last};
+}
+
+/*
+*/
+template <typename ValueType>
+StringViewType<ValueType> StringViewType<ValueType>::substring(SizeType first, SizeType last) const noexcept {
+
+	assert(first <= last);
+	assert(last <= m_size);
+
+	return StringViewType{m_data + first, last - first};
+}
+
+
+// Comparison Functions
+
+/*
+*/
+template <typename ValueType>
+int StringViewType<ValueType>::compare(ConstPointer cstring) const noexcept {
+
+	assert(cstring != nullptr);
+
+	SizeType i = detail::mismatchTerminated(m_data, cstring, m_size);
+
+	if (i == m_size) {
+		return cstring[i] != ValueType{} ? -1 : 0;
+	}
+	else if (cstring[i] == ValueType{} || m_data[i] > cstring[i]) {
+		return 1;
+	}
+	else {
+		return -1;
+	}
+}
+
+/*
+*/
+template <typename ValueType>
+int StringViewType<ValueType>::compare(StringViewType view) const noexcept {
+
+	SizeType size = std::min(m_size, view.m_size);
+	SizeType i = detail::mismatch(m_data, view.m_data, size);
+
+	if (i < size) {
+		return m_data[i] < view.m_data[i] ? -1 : 1;
+	}
+
+	if (m_size < view.m_size) {
+		return -1;
+	}
+	else if (m_size > view.m_size) {
+		return 1;
+	}
+	else {
+		return 0;
+	}
+}
+
+/*
+	Orders the two ranges as compare() would after converting both to lower case;
+	characters other than the ASCII letters are compared unchanged.
+*/
+template <typename ValueType>
+int StringViewType<ValueType>::compareIgnoreCase(ConstPointer cstring) const noexcept {
+	return compareIgnoreCase(StringViewType{cstring});
+}
+
+/*
+*/
+template <typename ValueType>
+int StringViewType<ValueType>::compareIgnoreCase(StringViewType view) const noexcept {
+	return detail::compareIgnoreCase(m_data, m_size, view.m_data, view.m_size);
+}
+
+/*
+*/
+template <typename ValueType>
+bool StringViewType<ValueType>::equalsIgnoreCase(ConstPointer cstring) const noexcept {
+	return equalsIgnoreCase(StringViewType{cstring});
+}
+
+/*
+*/
+template <typename ValueType>
+bool StringViewType<ValueType>::equalsIgnoreCase(StringViewType view) const noexcept {
+	return m_size == view.m_size && detail::mismatchIgnoreCase(m_data, view.m_data, m_size) == m_size;
+}
+
+
+// Search Functions
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::find(ValueType character, SizeType position) const noexcept {
+	return detail::find(m_data, m_size, character, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::find(ConstPointer cstring, SizeType position) const noexcept {
+	return find(StringViewType{cstring}, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::find(StringViewType view, SizeType position) const noexcept {
+	return detail::find(m_data, m_size, view.m_data, view.m_size, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::rfind(ValueType character, SizeType position) const noexcept {
+	return detail::reverseFind(m_data, m_size, character, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::rfind(ConstPointer cstring, SizeType position) const noexcept {
+	return rfind(StringViewType{cstring}, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::rfind(StringViewType view, SizeType position) const noexcept {
+	return detail::reverseFind(m_data, m_size, view.m_data, view.m_size, position);
+}
+
+/*
+	Index of the first occurrence at or after position when ASCII letters match regardless of case, or NOT_FOUND.
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::findIgnoreCase(ValueType character, SizeType position) const noexcept {
+	return detail::findIgnoreCase(m_data, m_size, &character, 1, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::findIgnoreCase(ConstPointer cstring, SizeType position) const noexcept {
+	return findIgnoreCase(StringViewType{cstring}, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::findIgnoreCase(StringViewType view, SizeType position) const noexcept {
+	return detail::findIgnoreCase(m_data, m_size, view.m_data, view.m_size, position);
+}
+
+/*
+*/
+template <typename ValueType>
+bool StringViewType<ValueType>::contains(ValueType character) const noexcept {
+	return find(character) != NOT_FOUND;
+}
+
+/*
+*/
+template <typename ValueType>
+bool StringViewType<ValueType>::contains(ConstPointer cstring) const noexcept {
+	return find(cstring) != NOT_FOUND;
+}
+
+/*
+*/
+template <typename ValueType>
+bool StringViewType<ValueType>::contains(StringViewType view) const noexcept {
+	return find(view) != NOT_FOUND;
+}
+
+/*
+*/
+template <typename ValueType>
+bool StringViewType<ValueType>::startsWith(ValueType character) const noexcept {
+	return m_size != 0 && m_data[0] == character;
+}
+
+/*
+	The prefix is never measured; the comparison stops at its terminator.
+*/
+template <typename ValueType>
+bool StringViewType<ValueType>::startsWith(ConstPointer cstring) const noexcept {
+
+	assert(cstring != nullptr);
+
+	return cstring[detail::mismatchTerminated(m_data, cstring, m_size)] == ValueType{};
+}
+
+/*
+*/
+template <typename ValueType>
+bool StringViewType<ValueType>::startsWith(StringViewType view) const noexcept {
+	return view.m_size <= m_size && detail::mismatch(m_data, view.m_data, view.m_size) == view.m_size;
+}
+
+/*
+*/
+template <typename ValueType>
+bool StringViewType<ValueType>::endsWith(ValueType character) const noexcept {
+	return m_size != 0 && m_data[m_size - 1] == character;
+}
+
+/*
+*/
+template <typename ValueType>
+bool StringViewType<ValueType>::endsWith(ConstPointer cstring) const noexcept {
+	return endsWith(StringViewType{cstring});
+}
+
+/*
+*/
+template <typename ValueType>
+bool StringViewType<ValueType>::endsWith(StringViewType view) const noexcept {
+	return view.m_size <= m_size && detail::mismatch(m_data + m_size - view.m_size, view.m_data, view.m_size) == view.m_size;
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::findFirstOf(ConstPointer set, SizeType position) const noexcept {
+	return findFirstOf(StringViewType{set}, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::findFirstOf(StringViewType set, SizeType position) const noexcept {
+	return detail::findFirstOf(m_data, m_size, set.m_data, set.m_size, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::findFirstNotOf(ConstPointer set, SizeType position) const noexcept {
+	return findFirstNotOf(StringViewType{set}, position);
+}
+
+/*
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::findFirstNotOf(StringViewType set, SizeType position) const noexcept {
+	return detail::findFirstNotOf(m_data, m_size, set.m_data, set.m_size, position);
+}
+
+
+// Split Functions
+
+/*
+	Pieces between occurrences of delimiter, without copying (see SplitRange).
+*/
+template <typename ValueType>
+SplitRange<ValueType> StringViewType<ValueType>::split(ValueType delimiter) const noexcept {
+	return SplitRange<ValueType>{*this, delimiter};
+}
+
+/*
+	The delimiter is a whole sequence here; its characters must outlive the range.
+*/
+template <typename ValueType>
+SplitRange<ValueType> StringViewType<ValueType>::split(StringViewType delimiter) const noexcept {
+	return SplitRange<ValueType>{*this, delimiter, SplitRange<ValueType>::Mode::SEQUENCE};
+}
+
+/*
+	Every character of set is a delimiter on its own.
+*/
+template <typename ValueType>
+SplitRange<ValueType> StringViewType<ValueType>::splitAny(StringViewType set) const noexcept {
+	return SplitRange<ValueType>{*this, set, SplitRange<ValueType>::Mode::ANY_OF};
+}
+
+
+// Numeric Functions
+
+/*
+	The whole view as an integer in base 2 to 36: an optional sign, then digits, with no spaces or prefix.
+	Letters stand for digits above 9 in either case.
+*/
+template <typename ValueType>
+template <typename IntegerType>
+ParseResult<IntegerType> StringViewType<ValueType>::parseInt(unsigned base) const noexcept {
+	return detail::parseInteger<IntegerType>(m_data, m_size, base);
+}
+
+/*
+	The whole view as a decimal floating point number (see detail::parseFloatingPoint for the accepted forms).
+*/
+template <typename ValueType>
+ParseResult<double> StringViewType<ValueType>::parseDouble() const {
+	return detail::parseFloatingPoint(m_data, m_size);
+}
+
+
+// Hash Functions
+
+/*
+	Fast non-cryptographic hash of the characters; strings and views with equal contents hash equally.
+*/
+template <typename ValueType>
+typename StringViewType<ValueType>::SizeType StringViewType<ValueType>::hash() const noexcept {
+	return detail::hash(m_data, m_size);
+}
+
+
+// Comparison Operations
+
+/*
+*/
+template <typename ValueType>
+bool operator==(StringViewType<ValueType> left, StringViewType<ValueType> right) noexcept {
+
+	using SizeType = typename StringViewType<ValueType>::SizeType;
+
+	SizeType size = left.size();
+
+	if (size != right.size()) {
+		return false;
+	}
+
+	if (size == 0) {
+		return true;
+	}
+
+	// Ranges that differ usually do so at one of the ends, which is much cheaper to check than the middle.
+	if (left[0] != right[0] || left[size - 1] != right[size - 1]) {
+		return false;
+	}
+
+	return detail::mismatch(left.data(), right.data(), size) == size;
+}
+
+/*
+*/
+template <typename ValueType>
+bool operator==(StringViewType<ValueType> left, typename StringViewType<ValueType>::ConstPointer right) noexcept {
+
+	assert(right != nullptr);
+
+	return detail::mismatchTerminated(left.data(), right, left.size()) == left.size() && right[left.size()] == ValueType{};
+}
+
+/*
+*/
+template <typename ValueType>
+bool operator==(typename StringViewType<ValueType>::ConstPointer left, StringViewType<ValueType> right) noexcept {
+	return right == left;
+}
+
+/*
+*/
+template <typename ValueType>
+bool operator!=(StringViewType<ValueType> left, StringViewType<ValueType> right) noexcept {
+	return !(left == right);
+}
+
+/*
+*/
+template <typename ValueType>
+bool operator!=(StringViewType<ValueType> left, typename StringViewType<ValueType>::ConstPointer right) noexcept {
+	return !(left == right);
+}
+
+/*
+*/
+template <typename ValueType>
+bool operator!=(typename StringViewType<ValueType>::ConstPointer left, StringViewType<ValueType> right) noexcept {
+	return !(right == left);
+}
+
+
+// Output Stream Operations
+
+/*
+*/
+template <typename ValueType, typename Traits>
+std::basic_ostream<ValueType, Traits> &operator<<(std::basic_ostream<ValueType, Traits> &os, StringViewType<ValueType> view) {
+	return detail::writeCharacters(os, view.data(), view.size());
+}
+
+
+// Default Alias
+
+using StringView = StringViewType<char>;
+
+static_assert(std::is_trivially_copyable<StringView>::value, "views are passed and stored by value");
+
+}
+
+
+namespace std {
+
+/*
+*/
+template <typename CharType>
+struct hash<simple::StringViewType<CharType>> {
+	std::size_t operator()(simple::StringViewType<CharType> view) const noexcept {
+		return view.hash();
+	}
+};
+
+}
+
+
+#endif // SIMPLE_STRING_VIEW_HPP
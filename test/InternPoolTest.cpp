@@ -0,0 +1,179 @@
+#include "Test.hpp"
+#include "SimpleInternPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+
+
+// Checks InternPool's handles, then has several threads intern and look up overlapping sets of strings in one
+// ShardedInternPool while others read through the handles they get back. Built with -fsanitize=thread, this
+// is the check that the shards' locking and the lock-free view() are race-free.
+
+
+namespace {
+
+using simple::InternHandle;
+using simple::InternPool;
+using simple::ShardedInternPool;
+using simple::StringView;
+
+/*
+*/
+std::vector<std::string> words(const char *prefix, std::size_t count) {
+
+	std::vector<std::string> result;
+	result.reserve(count);
+
+	for (std::size_t i = 0; i < count; ++i) {
+		result.push_back(prefix + std::to_string(i * 7919 % 100003));
+	}
+
+	return result;
+}
+
+/*
+*/
+void checkPool() {
+
+	InternPool pool;
+	std::vector<std::string> strings = words("word", 5000);
+
+	for (std::size_t i = 0; i < strings.size(); ++i) {
+		InternHandle handle = pool.intern(StringView{strings[i].c_str()});
+
+		SIMPLE_CHECK(handle.valid() && handle.value() == i + 1);
+	}
+
+	for (std::size_t i = 0; i < strings.size(); ++i) {
+		InternHandle handle = pool.intern(StringView{strings[i].c_str()});
+
+		SIMPLE_CHECK(handle.value() == i + 1);
+		SIMPLE_CHECK(pool.find(StringView{strings[i].c_str()}) == handle);
+		SIMPLE_CHECK(pool.view(handle) == StringView{strings[i].c_str()});
+		SIMPLE_CHECK(StringView{pool.cstring(handle)} == StringView{strings[i].c_str()});
+	}
+
+	SIMPLE_CHECK(pool.size() == strings.size());
+	SIMPLE_CHECK(!pool.find("missing").valid());
+	SIMPLE_CHECK(pool.intern("") == pool.intern(""));
+}
+
+/*
+	Every thread interns the shared strings, in its own order, and strings only it interns; readers look
+	the shared strings up meanwhile and read them through whatever handles they find.
+*/
+void checkShardedPool() {
+
+	constexpr std::size_t WRITERS = 6;
+	constexpr std::size_t READERS = 2;
+
+	ShardedInternPool pool;
+
+	std::vector<std::string> shared = words("shared", 4000);
+	std::vector<std::vector<InternHandle>> sharedHandles(WRITERS);
+	std::vector<std::vector<std::string>> own(WRITERS);
+	std::vector<std::vector<InternHandle>> ownHandles(WRITERS);
+
+	std::atomic<bool> writing{true};
+	std::atomic<std::size_t> mismatches{0};
+
+	std::vector<std::thread> threads;
+
+	for (std::size_t writer = 0; writer < WRITERS; ++writer) {
+		own[writer] = words(("own" + std::to_string(writer) + "_").c_str(), 2000);
+
+		threads.emplace_back([&, writer] {
+			std::vector<std::size_t> order(shared.size());
+
+			for (std::size_t i = 0; i < order.size(); ++i) {
+				order[i] = i;
+			}
+
+			std::mt19937 generator{static_cast<unsigned>(writer)};
+			std::shuffle(order.begin(), order.end(), generator);
+
+			sharedHandles[writer].resize(shared.size());
+
+			for (std::size_t i = 0; i < order.size(); ++i) {
+				std::size_t index = order[i];
+				sharedHandles[writer][index] = pool.intern(StringView{shared[index].c_str()});
+
+				if (i < own[writer].size()) {
+					ownHandles[writer].push_back(pool.intern(StringView{own[writer][i].c_str()}));
+				}
+			}
+		});
+	}
+
+	for (std::size_t reader = 0; reader < READERS; ++reader) {
+		threads.emplace_back([&] {
+			do {
+				for (const std::string &string : shared) {
+					InternHandle handle = pool.find(StringView{string.c_str()});
+
+					if (handle.valid() && pool.view(handle) != StringView{string.c_str()}) {
+						mismatches.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+			} while (writing.load());
+		});
+	}
+
+	for (std::size_t writer = 0; writer < WRITERS; ++writer) {
+		threads[writer].join();
+	}
+
+	writing.store(false);
+
+	for (std::size_t reader = 0; reader < READERS; ++reader) {
+		threads[WRITERS + reader].join();
+	}
+
+	SIMPLE_CHECK(mismatches.load() == 0);
+
+	std::vector<InternHandle> distinct;
+
+	for (std::size_t i = 0; i < shared.size(); ++i) {
+		InternHandle handle = sharedHandles[0][i];
+
+		for (std::size_t writer = 1; writer < WRITERS; ++writer) {
+			SIMPLE_CHECK(sharedHandles[writer][i] == handle);
+		}
+
+		SIMPLE_CHECK(pool.view(handle) == StringView{shared[i].c_str()});
+		SIMPLE_CHECK(pool.find(StringView{shared[i].c_str()}) == handle);
+
+		distinct.push_back(handle);
+	}
+
+	for (std::size_t writer = 0; writer < WRITERS; ++writer) {
+		for (std::size_t i = 0; i < own[writer].size(); ++i) {
+			InternHandle handle = ownHandles[writer][i];
+
+			SIMPLE_CHECK(StringView{pool.cstring(handle)} == StringView{own[writer][i].c_str()});
+
+			distinct.push_back(handle);
+		}
+	}
+
+	std::sort(distinct.begin(), distinct.end());
+
+	SIMPLE_CHECK(std::adjacent_find(distinct.begin(), distinct.end()) == distinct.end());
+	SIMPLE_CHECK(pool.size() == distinct.size());
+}
+
+}
+
+
+/*
+*/
+void runInternPoolTests() {
+	checkPool();
+	checkShardedPool();
+}
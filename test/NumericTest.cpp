@@ -0,0 +1,333 @@
+#include "Test.hpp"
+#include "SimpleString.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+// Round trips through appendFloat() and parseDouble(): random bit patterns, which mostly take Grisu3 and
+// sometimes its fallback, every power of two, subnormals and the ends of the range. Parsing is compared
+// with strtod on random decimal text and on exact halfway points between neighbouring doubles, on both
+// sides of the limits of Clinger's fast path.
+
+
+namespace {
+
+using simple::ParseError;
+using simple::String;
+using simple::StringView;
+
+/*
+*/
+std::uint64_t bitsOf(double value) {
+	std::uint64_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+/*
+*/
+double doubleOf(std::uint64_t bits) {
+	double value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+/*
+*/
+float floatOf(std::uint32_t bits) {
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+/*
+*/
+bool sameDouble(double left, double right) {
+	return bitsOf(left) == bitsOf(right);
+}
+
+/*
+*/
+std::string textOf(double value) {
+	String text;
+	text.appendFloat(value);
+	return std::string{text.data(), text.size()};
+}
+
+/*
+*/
+double parse(const std::string &text, ParseError expected = ParseError::NONE) {
+
+	simple::ParseResult<double> result = StringView{text.data(), text.size()}.parseDouble();
+	SIMPLE_CHECK(result.error == expected);
+
+	return result.value;
+}
+
+/*
+	Whether text has the fewest significant digits that read back as value: one fewer, correctly rounded, does not.
+*/
+bool isShortest(double value, const std::string &text) {
+
+	std::size_t end = std::min(text.find('e'), text.size());
+	std::size_t first = text.find_first_of("123456789");
+
+	// Trailing zeros of an integer are not significant.
+	if (text.find('.') == std::string::npos) {
+		while (end > first && text[end - 1] == '0') {
+			--end;
+		}
+	}
+
+	int digits = 0;
+
+	for (std::size_t i = first; i < end; ++i) {
+		digits += text[i] >= '0' && text[i] <= '9';
+	}
+
+	if (digits <= 1) {
+		return true;
+	}
+
+	char shorter[40];
+	std::snprintf(shorter, sizeof(shorter), "%.*e", digits - 2, value);
+
+	return std::strtod(shorter, nullptr) != value;
+}
+
+/*
+*/
+void checkRoundTrip(double value, bool shortest) {
+
+	std::string text = textOf(value);
+
+	SIMPLE_CHECK(sameDouble(parse(text), value));
+	SIMPLE_CHECK(sameDouble(std::strtod(text.c_str(), nullptr), value));
+
+	if (shortest) {
+		SIMPLE_CHECK(isShortest(value, text));
+	}
+}
+
+/*
+*/
+void checkDoubles(std::mt19937_64 &generator) {
+
+	for (int i = 0; i < 1000000; ++i) {
+		double value = doubleOf(generator());
+
+		if (!std::isnan(value)) {
+			checkRoundTrip(value, i % 50 == 0);
+		}
+	}
+
+	for (int exponent = -1074; exponent <= 1023; ++exponent) {
+		double power = std::ldexp(1.0, exponent);
+
+		checkRoundTrip(power, true);
+		checkRoundTrip(std::nextafter(power, 0.0), true);
+		checkRoundTrip(std::nextafter(power, HUGE_VAL), true);
+	}
+
+	// Subnormals, whose precision shrinks towards zero.
+	for (int i = 0; i < 100000; ++i) {
+		checkRoundTrip(doubleOf(generator() & ((std::uint64_t{1} << 52) - 1)), i % 10 == 0);
+	}
+
+	const double ends[] = {DBL_MAX, -DBL_MAX, DBL_MIN, -DBL_MIN, std::numeric_limits<double>::denorm_min(),
+		std::nextafter(DBL_MAX, 0.0), std::nextafter(DBL_MIN, 0.0), 0.1, 0.2, 0.3, 1.0 / 3.0, 5e-324, 1e23, 9007199254740993.0};
+
+	for (double value : ends) {
+		checkRoundTrip(value, true);
+	}
+
+	SIMPLE_CHECK(textOf(0.0) == "0");
+	SIMPLE_CHECK(textOf(-0.0) == "-0");
+	SIMPLE_CHECK(textOf(HUGE_VAL) == "inf");
+	SIMPLE_CHECK(textOf(-HUGE_VAL) == "-inf");
+	SIMPLE_CHECK(textOf(std::numeric_limits<double>::quiet_NaN()) == "nan");
+	SIMPLE_CHECK(textOf(DBL_MAX) == "1.7976931348623157e+308");
+	SIMPLE_CHECK(textOf(5e-324) == "5e-324");
+	SIMPLE_CHECK(textOf(0.1) == "0.1");
+	SIMPLE_CHECK(textOf(1e21) == "1e+21");
+	SIMPLE_CHECK(textOf(1e-7) == "1e-7");
+}
+
+/*
+	Floats are read back with strtof, since going through a double could round twice.
+*/
+void checkFloats(std::mt19937_64 &generator) {
+
+	for (int i = 0; i < 200000; ++i) {
+		float value = floatOf(static_cast<std::uint32_t>(generator()));
+
+		if (std::isnan(value)) {
+			continue;
+		}
+
+		String text;
+		text.appendFloat(value);
+
+		SIMPLE_CHECK(std::strtof(text.cstring(), nullptr) == value && std::signbit(std::strtof(text.cstring(), nullptr)) == std::signbit(value));
+	}
+
+	const float ends[] = {FLT_MAX, FLT_MIN, std::numeric_limits<float>::denorm_min(), 0.1f, 16777217.0f};
+
+	for (float value : ends) {
+		String text;
+		text.appendFloat(value);
+
+		SIMPLE_CHECK(std::strtof(text.cstring(), nullptr) == value);
+	}
+}
+
+/*
+	Random decimal text around the fast path's limits: up to 25 significant digits, with exponents
+	both near zero and across the whole range, including subnormals and overflow.
+*/
+void checkParsing(std::mt19937_64 &generator) {
+
+	std::uniform_int_distribution<int> digitCount(1, 25);
+	std::uniform_int_distribution<int> digit(0, 9);
+	std::uniform_int_distribution<int> nearExponent(-30, 30);
+	std::uniform_int_distribution<int> farExponent(-345, 310);
+
+	for (int i = 0; i < 300000; ++i) {
+		std::string text = i % 3 == 0 ? "-" : "";
+		int count = digitCount(generator);
+
+		for (int j = 0; j < count; ++j) {
+			text += static_cast<char>('0' + digit(generator));
+
+			if (j == 0 && i % 2 == 0) {
+				text += '.';
+			}
+		}
+
+		text += 'e' + std::to_string(i % 4 == 0 ? farExponent(generator) : nearExponent(generator));
+
+		double expected = std::strtod(text.c_str(), nullptr);
+
+		if (std::isinf(expected)) {
+			parse(text, ParseError::OUT_OF_RANGE);
+		}
+		else {
+			SIMPLE_CHECK(sameDouble(parse(text), expected));
+		}
+	}
+
+	// Just past the fast path: a significand over 2^53, a twentieth digit, an exponent of 23.
+	const char *texts[] = {"9007199254740992", "9007199254740993", "9007199254740995", "12345678901234567890",
+		"1234567890123456789", "1e22", "1e23", "8.5e-22", "8.5e-23", "4.35679e+22", "0.000000000000000000000000000001e30",
+		"2.2250738585072011e-308", "2.2250738585072012e-308", "4.9406564584124654e-324", "2.4703282292062328e-324"};
+
+	for (const char *text : texts) {
+		SIMPLE_CHECK(sameDouble(parse(text), std::strtod(text, nullptr)));
+	}
+
+	// DBL_MAX written out in full, long enough to be copied to the heap for strtod.
+	SIMPLE_CHECK(sameDouble(parse("17976931348623157" + std::string(292, '0') + ".0"), DBL_MAX));
+
+	SIMPLE_CHECK(sameDouble(parse("2.4703282292062327e-324"), 0.0));
+	SIMPLE_CHECK(sameDouble(parse("-1e-400"), -0.0));
+	parse("1e309", ParseError::OUT_OF_RANGE);
+	parse("1.8e308", ParseError::OUT_OF_RANGE);
+	parse("1e", ParseError::INVALID);
+	parse(".", ParseError::INVALID);
+	parse("1.0x", ParseError::INVALID);
+	parse("", ParseError::INVALID);
+}
+
+/*
+	The exact midpoint between a double and the next one up rounds to the one with an even significand,
+	and anything past it rounds up. The midpoint has one bit more than a double, so it is written out
+	exactly from a long double when that type is wide enough.
+*/
+void checkHalfway(std::mt19937_64 &generator) {
+
+	if (std::numeric_limits<long double>::digits < 54) {
+		return;
+	}
+
+	for (int i = 0; i < 20000; ++i) {
+		std::uint64_t bits = generator() & ~(std::uint64_t{1} << 63);
+		double low = doubleOf(bits);
+
+		if (i % 4 == 0) {
+			low = std::ldexp(static_cast<double>(generator() >> 11), static_cast<int>(generator() % 200) - 100);
+		}
+
+		double high = std::nextafter(low, HUGE_VAL);
+
+		if (std::isinf(high) || std::isnan(low)) {
+			continue;
+		}
+
+		long double middle = (static_cast<long double>(low) + static_cast<long double>(high)) / 2;
+
+		char text[1200];
+		std::snprintf(text, sizeof(text), "%.1100Le", middle);
+
+		// Trailing zeros make the texts long enough for the heap copy as well.
+		double even = (bitsOf(low) & 1) == 0 ? low : high;
+
+		SIMPLE_CHECK(sameDouble(parse(text), even));
+		SIMPLE_CHECK(sameDouble(parse(text), std::strtod(text, nullptr)));
+
+		std::string above = text;
+		above.insert(above.find('e'), "1");
+
+		SIMPLE_CHECK(sameDouble(parse(above), high));
+	}
+}
+
+/*
+*/
+void checkIntegers(std::mt19937_64 &generator) {
+
+	for (int i = 0; i < 100000; ++i) {
+		long long value = static_cast<long long>(generator() >> (1 + generator() % 63));
+		value = i % 2 == 0 ? value : -value;
+
+		String text;
+		text.appendInteger(value);
+
+		SIMPLE_CHECK(text == StringView{std::to_string(value).c_str()});
+		SIMPLE_CHECK(text.parseInt<long long>().value == value);
+	}
+
+	String text;
+	text.appendInteger(std::numeric_limits<long long>::min());
+
+	SIMPLE_CHECK(text == "-9223372036854775808");
+	SIMPLE_CHECK(text.parseInt<long long>().value == std::numeric_limits<long long>::min());
+	SIMPLE_CHECK(String{"9223372036854775808"}.parseInt<long long>().error == ParseError::OUT_OF_RANGE);
+	SIMPLE_CHECK(String{"18446744073709551615"}.parseInt<unsigned long long>().value == std::numeric_limits<unsigned long long>::max());
+}
+
+}
+
+
+/*
+*/
+void runNumericTests() {
+
+	std::mt19937_64 generator{12345};
+
+	checkDoubles(generator);
+	checkFloats(generator);
+	checkParsing(generator);
+	checkHalfway(generator);
+	checkIntegers(generator);
+}
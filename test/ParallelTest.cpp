@@ -0,0 +1,224 @@
+#include "Test.hpp"
+#include "SimpleString.hpp"
+#include "SimpleStringParallel.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+
+// Compares the parallel functions with their serial counterparts. The grains are a few characters long and
+// the serial threshold is zero, so short texts are cut into many chunks, and the texts put matches across
+// chunk boundaries and self-overlapping needles next to them, which is where the speculative scans rescan.
+
+
+namespace {
+
+using simple::String;
+using simple::StringView;
+using simple::ThreadPool;
+using simple::ParallelOptions;
+
+/*
+	Occurrences of needle in text, left to right and without overlaps, counted the slow way.
+*/
+std::size_t naiveCount(const std::string &text, const std::string &needle) {
+
+	std::size_t count = 0;
+
+	for (std::size_t position = text.find(needle); position != std::string::npos; position = text.find(needle, position + needle.size())) {
+		++count;
+	}
+
+	return count;
+}
+
+/*
+*/
+std::string naiveReplaceAll(const std::string &text, const std::string &needle, const std::string &replacement) {
+
+	std::string result;
+	std::size_t last = 0;
+
+	for (std::size_t position = text.find(needle); position != std::string::npos; position = text.find(needle, position + needle.size())) {
+		result.append(text, last, position - last);
+		result += replacement;
+		last = position + needle.size();
+	}
+
+	result.append(text, last, std::string::npos);
+	return result;
+}
+
+/*
+*/
+std::string randomText(std::size_t length, const char *alphabet, std::mt19937 &generator) {
+
+	std::size_t letters = std::char_traits<char>::length(alphabet);
+	std::uniform_int_distribution<std::size_t> letter(0, letters - 1);
+
+	std::string text(length, ' ');
+
+	for (char &character : text) {
+		character = alphabet[letter(generator)];
+	}
+
+	return text;
+}
+
+/*
+	Text of filler with needle written so that it starts a little before, at and a little after every
+	multiple of grain, so some copies straddle a chunk boundary and some touch each other.
+*/
+std::string straddlingText(std::size_t length, std::size_t grain, const std::string &needle, char filler) {
+
+	std::string text(length, filler);
+
+	for (std::size_t boundary = grain; boundary < length; boundary += grain) {
+		for (std::size_t back : {needle.size() - 1, needle.size() / 2, std::size_t{0}}) {
+			std::size_t position = boundary - std::min(back, boundary);
+
+			if (position + needle.size() <= length) {
+				text.replace(position, needle.size(), needle);
+			}
+		}
+	}
+
+	return text;
+}
+
+/*
+*/
+void checkText(ThreadPool &pool, const std::string &text, const std::vector<std::string> &needles, const ParallelOptions &options) {
+
+	String string{StringView{text.data(), text.size()}};
+
+	for (char character : {'a', 'b', 'x', 'z'}) {
+		SIMPLE_CHECK(simple::parallelCount(pool, string, character, options) == static_cast<std::size_t>(std::count(text.begin(), text.end(), character)));
+
+		std::size_t position = text.find(character);
+		SIMPLE_CHECK(simple::parallelFind(pool, string, character, options) == (position == std::string::npos ? String::NOT_FOUND : position));
+	}
+
+	for (const std::string &needle : needles) {
+		StringView view{needle.data(), needle.size()};
+
+		SIMPLE_CHECK(simple::parallelCount(pool, string, view, options) == naiveCount(text, needle));
+		SIMPLE_CHECK(simple::parallelFind(pool, string, view, options) == string.find(view));
+
+		for (const char *replacement : {"", "X", "XYZW", "aa"}) {
+			String parallel = string;
+			String serial = string;
+
+			std::size_t count = simple::parallelReplaceAll(pool, parallel, view, replacement, options);
+
+			SIMPLE_CHECK(count == serial.replaceAll(view, replacement));
+			SIMPLE_CHECK(parallel == serial);
+
+			std::string expected = naiveReplaceAll(text, needle, replacement);
+			SIMPLE_CHECK(parallel == StringView{expected.data(), expected.size()});
+		}
+	}
+
+	// Needle and replacement may come from the string itself.
+	if (text.size() > 8) {
+		String parallel = string;
+		String serial = string;
+
+		std::size_t count = simple::parallelReplaceAll(pool, parallel, StringView{parallel}.substring(2, 4), StringView{parallel}.substring(0, 5), options);
+
+		SIMPLE_CHECK(count == serial.replaceAll(StringView{serial}.substring(2, 4), StringView{serial}.substring(0, 5)));
+		SIMPLE_CHECK(parallel == serial);
+	}
+}
+
+/*
+*/
+void checkCase(ThreadPool &pool, const ParallelOptions &options, std::mt19937 &generator) {
+
+	std::string text(5000, ' ');
+	std::uniform_int_distribution<int> byte(0, 255);
+
+	for (char &character : text) {
+		character = static_cast<char>(byte(generator));
+	}
+
+	String string{StringView{text.data(), text.size()}};
+
+	String lower = string;
+	simple::parallelToLower(pool, lower, options);
+	SIMPLE_CHECK(lower == string.toLower());
+
+	String upper = string;
+	simple::parallelToUpper(pool, upper, options);
+	SIMPLE_CHECK(upper == string.toUpper());
+}
+
+/*
+	Large inputs hash to a value of their own, which must not depend on the pool or the options.
+*/
+void checkHash(std::mt19937 &generator) {
+
+	std::string small = randomText(1000, "abcdefgh", generator);
+	std::string large = randomText((std::size_t{3} << 20) + 17, "abcdefgh", generator);
+
+	String smallString{StringView{small.data(), small.size()}};
+	String largeString{StringView{large.data(), large.size()}};
+
+	ThreadPool single{1};
+	ThreadPool pool{4};
+
+	SIMPLE_CHECK(simple::parallelHash(pool, smallString) == smallString.hash());
+
+	std::size_t expected = simple::parallelHash(single, largeString);
+
+	for (std::size_t grain : {std::size_t{1} << 12, std::size_t{1} << 20, std::size_t{1} << 22}) {
+		ParallelOptions options;
+		options.grainSize = grain;
+		options.serialThreshold = 0;
+
+		SIMPLE_CHECK(simple::parallelHash(pool, largeString, options) == expected);
+	}
+}
+
+}
+
+
+/*
+*/
+void runParallelTests() {
+
+	std::mt19937 generator{12345};
+
+	ThreadPool pair{2};
+	ThreadPool quad{4};
+
+	for (ThreadPool *pool : {&pair, &quad}) {
+		for (std::size_t grain : {1, 3, 7, 16, 61, 256}) {
+			ParallelOptions options;
+			options.grainSize = grain;
+			options.serialThreshold = 0;
+
+			std::vector<std::string> needles = {"a", "aa", "aaa", "ab", "aba", "abab", "bbbbbb", "zzz", std::string(300, 'a')};
+
+			checkText(*pool, randomText(3000, "ab", generator), needles, options);
+			checkText(*pool, randomText(3000, "aaaab", generator), needles, options);
+			checkText(*pool, std::string(1000, 'a'), needles, options);
+			checkText(*pool, std::string(1001, 'a'), needles, options);
+
+			for (const std::string &needle : {std::string{"abc"}, std::string{"aab"}, std::string{"xyzzy"}}) {
+				checkText(*pool, straddlingText(2000, grain, needle, 'b'), {needle, "b", "bb", "ab"}, options);
+			}
+
+			checkText(*pool, "", needles, options);
+			checkText(*pool, "ab", needles, options);
+
+			checkCase(*pool, options, generator);
+		}
+	}
+
+	checkHash(generator);
+}
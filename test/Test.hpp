@@ -0,0 +1,43 @@
+#pragma once
+#ifndef SIMPLE_TEST_HPP
+#define SIMPLE_TEST_HPP
+
+
+#include <iostream>
+
+#include <cstddef>
+
+
+// Minimal checking shared by the test files in this directory. A failed check is reported with its
+// location and counted, and the run goes on, so one failure does not hide the others.
+
+
+namespace test {
+
+
+/*
+*/
+inline std::size_t &failureCount() noexcept {
+	static std::size_t count = 0;
+	return count;
+}
+
+/*
+*/
+inline bool check(bool passed, const char *expression, const char *file, int line) {
+
+	if (!passed) {
+		++failureCount();
+		std::cerr << file << ':' << line << ": check failed: " << expression << '\n';
+	}
+
+	return passed;
+}
+
+}
+
+
+#define SIMPLE_CHECK(...) ::test::check(static_cast<bool>(__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
+
+
+#endif // SIMPLE_TEST_HPP
@@ -0,0 +1,27 @@
+#include "Test.hpp"
+
+#include <iostream>
+
+
+// Runs every test file's checks; the exit status is nonzero if any of them failed.
+
+
+void runInternPoolTests();
+void runNumericTests();
+void runParallelTests();
+
+
+int main() {
+
+	runInternPoolTests();
+	runNumericTests();
+	runParallelTests();
+
+	if (test::failureCount() != 0) {
+		std::cerr << test::failureCount() << " checks failed\n";
+		return 1;
+	}
+
+	std::cout << "all checks passed\n";
+	return 0;
+}